@@ -0,0 +1,192 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "checkreport.h"
+
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/erc/ercmsg.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace cli {
+
+using namespace librepcb::project;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CheckReport::CheckReport() noexcept {
+}
+
+CheckReport::~CheckReport() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int CheckReport::getNonApprovedCount() const noexcept {
+  int count = 0;
+  foreach (const Entry& entry, mEntries) {
+    if (!entry.approved) ++count;
+  }
+  return count;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void CheckReport::addErcMessage(const ErcMsg& msg) noexcept {
+  Entry entry;
+  entry.check = "erc";
+  switch (msg.getMsgType()) {
+    case ErcMsg::ErcMsgType_t::CircuitWarning:
+    case ErcMsg::ErcMsgType_t::SchematicWarning:
+    case ErcMsg::ErcMsgType_t::BoardWarning:
+      entry.severity = "warning";
+      break;
+    default:
+      entry.severity = "error";
+      break;
+  }
+  entry.rule     = msg.getMsgKey();
+  entry.approved = msg.isIgnored();
+  entry.message  = msg.getMsg();
+  entry.objects.append(QString(msg.getOwner().getErcMsgOwnerClassName()) %
+                       "/" % msg.getOwnerKey());
+  mEntries.append(entry);
+}
+
+void CheckReport::addDrcViolation(const Board&        board,
+                                  const DrcViolation& violation,
+                                  bool                approved) noexcept {
+  Entry entry;
+  entry.check    = "drc";
+  entry.severity = "error";
+  entry.rule     = BoardDesignRuleCheck::violationTypeToString(violation.type);
+  entry.approved = approved;
+  entry.message  = violation.message;
+  entry.board    = board.getUuid().toStr();
+  entry.layer    = violation.layerName;
+  entry.objects  = violation.objectKeys;
+  foreach (const Path& path, violation.locations) {
+    // report the center of the bounding rect of the violation area
+    if (path.getVertices().isEmpty()) continue;
+    Point min = path.getVertices().first().getPos();
+    Point max = min;
+    foreach (const Vertex& vertex, path.getVertices()) {
+      const Point& pos = vertex.getPos();
+      min.setX(qMin(min.getX(), pos.getX()));
+      min.setY(qMin(min.getY(), pos.getY()));
+      max.setX(qMax(max.getX(), pos.getX()));
+      max.setY(qMax(max.getY(), pos.getY()));
+    }
+    entry.positions.append((min + max) / 2);
+  }
+  mEntries.append(entry);
+}
+
+QByteArray CheckReport::toJson() const noexcept {
+  QJsonArray entries;
+  foreach (const Entry& entry, mEntries) {
+    QJsonObject obj;
+    obj["check"]    = entry.check;
+    obj["severity"] = entry.severity;
+    obj["rule"]     = entry.rule;
+    obj["approved"] = entry.approved;
+    obj["message"]  = entry.message;
+    if (!entry.board.isEmpty()) obj["board"] = entry.board;
+    if (!entry.layer.isEmpty()) obj["layer"] = entry.layer;
+    obj["objects"] = QJsonArray::fromStringList(entry.objects);
+    QJsonArray positions;
+    foreach (const Point& pos, entry.positions) {
+      QJsonObject posObj;
+      posObj["x"] = pos.getX().toMm();
+      posObj["y"] = pos.getY().toMm();
+      positions.append(posObj);
+    }
+    obj["positions"] = positions;
+    entries.append(obj);
+  }
+  QJsonObject root;
+  root["entries"]      = entries;
+  root["non_approved"] = getNonApprovedCount();
+  return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+QByteArray CheckReport::toSExpression() const {
+  SExpression root = SExpression::createList("librepcb_check_report");
+  root.appendChild("non_approved", getNonApprovedCount(), true);
+  foreach (const Entry& entry, mEntries) {
+    SExpression& node = root.appendList("entry", true);
+    node.appendChild(SExpression::createToken(entry.check));
+    node.appendChild("severity", SExpression::createToken(entry.severity),
+                     true);
+    node.appendChild("rule", SExpression::createToken(entry.rule), true);
+    node.appendChild("approved", entry.approved, true);
+    node.appendChild("message", entry.message, true);
+    if (!entry.board.isEmpty()) {
+      node.appendChild("board", SExpression::createToken(entry.board), true);
+    }
+    if (!entry.layer.isEmpty()) {
+      node.appendChild("layer", SExpression::createToken(entry.layer), true);
+    }
+    foreach (const QString& key, entry.objects) {
+      node.appendChild("object", key, true);
+    }
+    foreach (const Point& pos, entry.positions) {
+      pos.serialize(node.appendList("position", true));
+    }
+  }
+  return root.toByteArray();  // can throw
+}
+
+void CheckReport::writeToFile(const FilePath& fp) const {
+  QString suffix = fp.getSuffix().toLower();
+  if (suffix == "json") {
+    FileUtils::writeFile(fp, toJson());  // can throw
+  } else if (suffix == "lp") {
+    FileUtils::writeFile(fp, toSExpression());  // can throw
+  } else {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(tr("Unsupported report file extension '%1'. Supported "
+                   "extensions: %2"))
+            .arg(suffix, "json, lp"));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CLI_CHECKREPORT_H
+#define LIBREPCB_CLI_CHECKREPORT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/units/point.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+namespace project {
+class Board;
+class ErcMsg;
+}  // namespace project
+
+namespace cli {
+
+/*******************************************************************************
+ *  Class CheckReport
+ ******************************************************************************/
+
+/**
+ * @brief Machine-readable report of ERC messages and DRC violations
+ *
+ * The report is written either as JSON or as S-Expression, depending on the
+ * file extension (*.json or *.lp). Every entry contains the check which found
+ * it ("erc" or "drc"), the severity, the name of the violated rule, whether it
+ * was approved by the user, the involved objects (keys containing their UUIDs)
+ * and, for DRC violations, the board, layer and positions in millimeters.
+ */
+class CheckReport final {
+  Q_DECLARE_TR_FUNCTIONS(CheckReport)
+
+public:
+  // Types
+  typedef project::BoardDesignRuleCheck::Violation DrcViolation;
+
+  struct Entry {
+    QString        check;     ///< "erc" or "drc"
+    QString        severity;  ///< "error" or "warning"
+    QString        rule;
+    bool           approved;
+    QString        message;
+    QString        board;  ///< UUID of the board, if any
+    QString        layer;  ///< Name of the layer, if any
+    QStringList    objects;
+    QVector<Point> positions;
+  };
+
+  // Constructors / Destructor
+  CheckReport() noexcept;
+  CheckReport(const CheckReport& other) = delete;
+  ~CheckReport() noexcept;
+
+  // Getters
+  const QList<Entry>& getEntries() const noexcept { return mEntries; }
+  int                 getNonApprovedCount() const noexcept;
+
+  // General Methods
+  void       addErcMessage(const project::ErcMsg& msg) noexcept;
+  void       addDrcViolation(const project::Board& board,
+                             const DrcViolation&   violation,
+                             bool                  approved) noexcept;
+  QByteArray toJson() const noexcept;
+  QByteArray toSExpression() const;
+  void       writeToFile(const FilePath& fp) const;
+
+  // Operator Overloadings
+  CheckReport& operator=(const CheckReport& rhs) = delete;
+
+private:  // Data
+  QList<Entry> mEntries;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLI_CHECKREPORT_H
@@ -22,19 +22,27 @@
  ******************************************************************************/
 #include "commandlineinterface.h"
 
+#include "checkreport.h"
+
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/debug.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/undostack.h>
 #include <librepcb/library/elements.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardautorouter.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
 #include <librepcb/project/boards/boardfabricationoutputsettings.h>
 #include <librepcb/project/boards/boardgerberexport.h>
 #include <librepcb/project/erc/ercmsg.h>
 #include <librepcb/project/erc/ercmsglist.h>
 #include <librepcb/project/project.h>
+#include <librepcb/projecteditor/cmd/cmdapplyboardautorouterresult.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -45,6 +53,7 @@ namespace cli {
 
 using namespace librepcb::library;
 using namespace librepcb::project;
+using namespace librepcb::project::editor;
 
 /*******************************************************************************
  *  Constructors / Destructor
@@ -78,11 +87,35 @@ int CommandLineInterface::execute() noexcept {
   parser.addPositionalArgument("command", tr("The command to execute."));
 
   // Define options for "open-project"
+  QCommandLineOption autorouteOption(
+      "autoroute",
+      tr("Route all air wires of the boards (all boards or only those "
+         "specified with '--board') before running any checks or exports. "
+         "Use '--save' to keep the routed traces."));
   QCommandLineOption ercOption(
       "erc",
       tr("Run the electrical rule check, print all non-approved "
          "warnings/errors and "
          "report failure (exit code = 1) if there are non-approved messages."));
+  QCommandLineOption drcOption(
+      "drc",
+      tr("Run the design rule check on the boards (all boards or only those "
+         "specified with '--board'), print all non-approved violations and "
+         "report failure (exit code = 1) if there are non-approved "
+         "violations."));
+  QCommandLineOption reportOption(
+      "report",
+      QString(tr("Write the messages of '--erc' and '--drc' into a "
+                 "machine-readable report file. Existing files will be "
+                 "overwritten. Supported file extensions: %1"))
+          .arg("json, lp"),
+      tr("file"));
+  QCommandLineOption jobsOption(
+      "jobs",
+      tr("Maximum number of threads to use for parallelized tasks (e.g. the "
+         "design rule check or processing library elements). If not set, the "
+         "number of CPU cores is used."),
+      tr("count"));
   QCommandLineOption exportSchematicsOption(
       "export-schematics",
       QString(tr("Export schematics to given file(s). Existing files will be "
@@ -134,7 +167,11 @@ int CommandLineInterface::execute() noexcept {
                                  commands[command].second);
     parser.addPositionalArgument("project",
                                  tr("Path to project file (*.lpp[z])."));
+    parser.addOption(autorouteOption);
     parser.addOption(ercOption);
+    parser.addOption(drcOption);
+    parser.addOption(reportOption);
+    parser.addOption(jobsOption);
     parser.addOption(exportSchematicsOption);
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(pcbFabricationSettingsOption);
@@ -148,6 +185,7 @@ int CommandLineInterface::execute() noexcept {
                                  tr("Path to library directory (*.lplib)."));
     parser.addOption(libAllOption);
     parser.addOption(libSaveOption);
+    parser.addOption(jobsOption);
   } else if (!command.isEmpty()) {
     printErr(QString(tr("Unknown command '%1'.")).arg(command), 2);
     print(parser.helpText(), 0);
@@ -190,6 +228,18 @@ int CommandLineInterface::execute() noexcept {
     Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::All);
   }
 
+  // --jobs
+  if (parser.isSet(jobsOption)) {
+    bool ok   = false;
+    int  jobs = parser.value(jobsOption).toInt(&ok);
+    if ((!ok) || (jobs < 1)) {
+      printErr(QString(tr("Invalid number of jobs: '%1'"))
+                   .arg(parser.value(jobsOption)));
+      return 1;
+    }
+    QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+  }
+
   // Execute command
   bool cmdSuccess = false;
   if (command == "open-project") {
@@ -198,9 +248,19 @@ int CommandLineInterface::execute() noexcept {
       print(parser.helpText(), 0);
       return 1;
     }
+    if (parser.isSet(reportOption) && (!parser.isSet(ercOption)) &&
+        (!parser.isSet(drcOption))) {
+      printErr(tr("The option '--report' requires '--erc' and/or '--drc'."),
+               2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
     cmdSuccess = openProject(
         positionalArgs.value(0),                       // project filepath
+        parser.isSet(autorouteOption),                 // run autorouter
         parser.isSet(ercOption),                       // run ERC
+        parser.isSet(drcOption),                       // run DRC
+        parser.value(reportOption),                    // report file
         parser.values(exportSchematicsOption),         // export schematics
         parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
         parser.value(pcbFabricationSettingsOption),    // PCB fab. settings
@@ -234,8 +294,9 @@ int CommandLineInterface::execute() noexcept {
  ******************************************************************************/
 
 bool CommandLineInterface::openProject(
-    const QString& projectFile, bool runErc,
-    const QStringList& exportSchematicsFiles, bool exportPcbFabricationData,
+    const QString& projectFile, bool runAutorouter, bool runErc, bool runDrc,
+    const QString& reportFile, const QStringList& exportSchematicsFiles,
+    bool exportPcbFabricationData,
     const QString& pcbFabricationSettingsPath, const QStringList& boards,
     bool save) const noexcept {
   try {
@@ -256,21 +317,80 @@ bool CommandLineInterface::openProject(
           projectFileName = fn;
         }
       }
+    } else if (save) {
+      projectFs = TransactionalFileSystem::openRW(projectFp.getParentDir());
+      projectFileName = projectFp.getFilename();
     } else {
-      projectFs = TransactionalFileSystem::open(projectFp.getParentDir(), save);
+      projectFs =
+          TransactionalFileSystem::openROCached(projectFp.getParentDir());
       projectFileName = projectFp.getFilename();
     }
     Project project(std::unique_ptr<TransactionalDirectory>(
                         new TransactionalDirectory(projectFs)),
                     projectFileName);  // can throw
 
+    // Autoroute
+    if (runAutorouter) {
+      print(tr("Run autorouter..."));
+      QList<Board*> boardList;
+      if (boards.isEmpty()) {
+        // route all boards
+        boardList = project.getBoards();
+      } else {
+        // route specified boards
+        foreach (const QString& boardName, boards) {
+          Board* board = project.getBoardByName(boardName);
+          if (board) {
+            boardList.append(board);
+          } else {
+            printErr(QString(tr("ERROR: No board with the name '%1' found."))
+                         .arg(boardName));
+            success = false;
+          }
+        }
+      }
+      UndoStack undoStack;
+      foreach (Board* board, boardList) {
+        print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
+        BoardAutorouter::Options options;
+        options.clearance = board->getDesignRules().getCopperClearance();
+        BoardAutorouter autorouter(*board, options);
+        QElapsedTimer   timer;
+        timer.start();
+        autorouter.run();  // can throw
+        if (!autorouter.getRoutes().isEmpty()) {
+          undoStack.execCmd(new CmdApplyBoardAutorouterResult(
+              *board, autorouter.getRoutes(), options));  // can throw
+          board->rebuildAllPlanes();
+          board->forceAirWiresRebuild();
+        }
+        print("    " % QString(tr("Routed air wires: %1 of %2"))
+                           .arg(autorouter.getRoutes().count())
+                           .arg(autorouter.getAirWireCount()));
+        print("    " % QString(tr("Iterations: %1, time: %2 ms"))
+                           .arg(autorouter.getIterationCount())
+                           .arg(timer.elapsed()));
+        foreach (const auto& airWire, autorouter.getUnroutedAirWires()) {
+          // not a failure, the board is just not completely routed yet
+          printErr(QString("      - [%1] (%2, %3) -> (%4, %5)")
+                       .arg(tr("UNROUTED"))
+                       .arg(airWire.first.getX().toMmString())
+                       .arg(airWire.first.getY().toMmString())
+                       .arg(airWire.second.getX().toMmString())
+                       .arg(airWire.second.getY().toMmString()));
+        }
+      }
+    }
+
     // ERC
+    CheckReport report;
     if (runErc) {
       print(tr("Run ERC..."));
       QStringList messages;
       int         approvedMsgCount = 0;
       foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
         if (!msg->isVisible()) continue;
+        report.addErcMessage(*msg);
         if (msg->isIgnored()) {
           ++approvedMsgCount;
         } else {
@@ -299,6 +419,66 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // DRC
+    // Note: The check itself does not need any graphics items, but they are
+    // still created when loading the project since the board items own them.
+    if (runDrc) {
+      print(tr("Run DRC..."));
+      QList<Board*> boardList;
+      if (boards.isEmpty()) {
+        // check all boards
+        boardList = project.getBoards();
+      } else {
+        // check specified boards
+        foreach (const QString& boardName, boards) {
+          Board* board = project.getBoardByName(boardName);
+          if (board) {
+            boardList.append(board);
+          } else {
+            printErr(QString(tr("ERROR: No board with the name '%1' found."))
+                         .arg(boardName));
+            success = false;
+          }
+        }
+      }
+      foreach (Board* board, boardList) {
+        print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
+        BoardDesignRuleCheck& drc = board->getDesignRuleCheck();
+        drc.execute();  // can throw
+        QStringList messages;
+        int         approvedCount = 0;
+        foreach (const BoardDesignRuleCheck::Violation& v,
+                 drc.getViolations()) {
+          const ErcMsg* msg      = drc.getErcMsg(v);
+          bool          approved = msg && msg->isIgnored();
+          report.addDrcViolation(*board, v, approved);
+          if (approved) {
+            ++approvedCount;
+          } else {
+            messages.append(
+                QString("      - [%1] %2").arg(tr("ERROR"), v.message));
+          }
+        }
+        print("    " %
+              QString(tr("Approved violations: %1")).arg(approvedCount));
+        print("    " % QString(tr("Non-approved violations: %1"))
+                           .arg(messages.count()));
+        qSort(messages);  // increases readability of console output
+        foreach (const QString& msg, messages) { printErr(msg); }
+        if (messages.count() > 0) {
+          success = false;
+        }
+      }
+    }
+
+    // Write check report
+    if (!reportFile.isEmpty()) {
+      print(QString(tr("Write check report to '%1'...")).arg(reportFile));
+      FilePath reportFp(QFileInfo(reportFile).absoluteFilePath());
+      report.writeToFile(reportFp);  // can throw
+      print(QString("  => '%1'").arg(prettyPath(reportFp, reportFile)));
+    }
+
     // Export schematics
     foreach (const QString& destStr, exportSchematicsFiles) {
       print(QString(tr("Export schematics to '%1'...")).arg(destStr));
@@ -405,133 +585,87 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
     print(QString(tr("Open library '%1'...")).arg(prettyPath(libFp, libDir)));
 
     std::shared_ptr<TransactionalFileSystem> libFs =
-        TransactionalFileSystem::open(libFp, save);  // can throw
+        openFileSystem(libFp, save);  // can throw
     Library lib(std::unique_ptr<TransactionalDirectory>(
         new TransactionalDirectory(libFs)));  // can throw
 
+    // Processing time per element type
+    QStringList summary;
+
     // Open all component categories
     if (all) {
-      QStringList elements = lib.searchForElements<ComponentCategory>();
+      QStringList dirs = lib.searchForElements<ComponentCategory>();
       print(QString(tr("Process %1 component categories..."))
-                .arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        ComponentCategory element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+                .arg(dirs.count()));
+      if (!processLibraryElements<ComponentCategory>(
+              libFp, libDir, dirs, save, tr("Component categories"), summary)) {
+        success = false;
       }
     }
 
     // Open all package categories
     if (all) {
-      QStringList elements = lib.searchForElements<PackageCategory>();
-      print(QString(tr("Process %1 package categories..."))
-                .arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        PackageCategory element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+      QStringList dirs = lib.searchForElements<PackageCategory>();
+      print(QString(tr("Process %1 package categories...")).arg(dirs.count()));
+      if (!processLibraryElements<PackageCategory>(
+              libFp, libDir, dirs, save, tr("Package categories"), summary)) {
+        success = false;
       }
     }
 
     // Open all symbols
     if (all) {
-      QStringList elements = lib.searchForElements<Symbol>();
-      print(QString(tr("Process %1 symbols...")).arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Symbol element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+      QStringList dirs = lib.searchForElements<Symbol>();
+      print(QString(tr("Process %1 symbols...")).arg(dirs.count()));
+      if (!processLibraryElements<Symbol>(libFp, libDir, dirs, save,
+                                          tr("Symbols"), summary)) {
+        success = false;
       }
     }
 
     // Open all packages
     if (all) {
-      QStringList elements = lib.searchForElements<Package>();
-      print(QString(tr("Process %1 packages...")).arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Package element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+      QStringList dirs = lib.searchForElements<Package>();
+      print(QString(tr("Process %1 packages...")).arg(dirs.count()));
+      if (!processLibraryElements<Package>(libFp, libDir, dirs, save,
+                                           tr("Packages"), summary)) {
+        success = false;
       }
     }
 
     // Open all components
     if (all) {
-      QStringList elements = lib.searchForElements<Component>();
-      print(QString(tr("Process %1 components...")).arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Component element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+      QStringList dirs = lib.searchForElements<Component>();
+      print(QString(tr("Process %1 components...")).arg(dirs.count()));
+      if (!processLibraryElements<Component>(libFp, libDir, dirs, save,
+                                             tr("Components"), summary)) {
+        success = false;
       }
     }
 
     // Open all devices
     if (all) {
-      QStringList elements = lib.searchForElements<Device>();
-      print(QString(tr("Process %1 devices...")).arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Device element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        if (save) {
-          qInfo() << QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir));
-          element.save();  // can throw
-          fs->save();      // can throw
-        }
+      QStringList dirs = lib.searchForElements<Device>();
+      print(QString(tr("Process %1 devices...")).arg(dirs.count()));
+      if (!processLibraryElements<Device>(libFp, libDir, dirs, save,
+                                          tr("Devices"), summary)) {
+        success = false;
       }
     }
 
     // Save library
-    if (save) {
+    if (save && success) {
       print(QString(tr("Save library '%1'...")).arg(prettyPath(libFp, libDir)));
       lib.save();     // can throw
       libFs->save();  // can throw
     }
 
+    // Print summary
+    if (all) {
+      print(tr("Processing time:"));
+      foreach (const QString& line, summary) { print("  " % line); }
+    }
+
     return success;
   } catch (const Exception& e) {
     printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
@@ -539,6 +673,67 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
   }
 }
 
+template <typename ElementType>
+bool CommandLineInterface::processLibraryElements(
+    const FilePath& libFp, const QString& libDir, const QStringList& dirs,
+    bool save, const QString& typeName, QStringList& summary) noexcept {
+  QElapsedTimer timer;
+  timer.start();
+
+  // The elements are independent of each other, so they are processed in
+  // parallel on the global thread pool (see '--jobs'). The output is collected
+  // and printed afterwards in the original order to keep it deterministic.
+  std::function<LibraryElementResult(const QString&)> process =
+      [&libFp, &libDir, save](const QString& dir) {
+        LibraryElementResult result;
+        FilePath             fp = libFp.getPathTo(dir);
+        try {
+          result.messages.append(
+              QString(tr("Open '%1'...")).arg(prettyPath(fp, libDir)));
+          std::shared_ptr<TransactionalFileSystem> fs =
+              openFileSystem(fp, save);  // can throw
+          ElementType element(std::unique_ptr<TransactionalDirectory>(
+              new TransactionalDirectory(fs)));  // can throw
+          if (save) {
+            result.messages.append(
+                QString(tr("Save '%1'...")).arg(prettyPath(fp, libDir)));
+            element.save();  // can throw
+            fs->save();      // can throw
+          }
+        } catch (const Exception& e) {
+          result.error = QString(tr("ERROR: %1: %2"))
+                             .arg(prettyPath(fp, libDir), e.getMsg());
+        }
+        return result;
+      };
+  QList<LibraryElementResult> results =
+      QtConcurrent::blockingMapped<QList<LibraryElementResult>>(dirs, process);
+
+  bool success = true;
+  foreach (const LibraryElementResult& result, results) {
+    foreach (const QString& msg, result.messages) { qInfo() << msg; }
+    if (!result.error.isEmpty()) {
+      printErr(result.error);
+      success = false;
+    }
+  }
+  summary.append(QString(tr("%1: %2 in %3 ms"))
+                     .arg(typeName)
+                     .arg(dirs.count())
+                     .arg(timer.elapsed()));
+  return success;
+}
+
+std::shared_ptr<TransactionalFileSystem> CommandLineInterface::openFileSystem(
+    const FilePath& fp, bool writable) {
+  if (writable) {
+    return TransactionalFileSystem::openRW(fp);  // can throw
+  } else {
+    // directory listings don't change during read-only access
+    return TransactionalFileSystem::openROCached(fp);  // can throw
+  }
+}
+
 QString CommandLineInterface::prettyPath(const FilePath& path,
                                          const QString&  style) noexcept {
   if (QFileInfo(style).isAbsolute()) {
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -32,6 +34,7 @@ namespace librepcb {
 
 class Application;
 class FilePath;
+class TransactionalFileSystem;
 
 namespace cli {
 
@@ -45,6 +48,12 @@ namespace cli {
 class CommandLineInterface final {
   Q_DECLARE_TR_FUNCTIONS(CommandLineInterface);
 
+  /// Output of processing a library element, see #processLibraryElements()
+  struct LibraryElementResult {
+    QStringList messages;  ///< Verbose messages
+    QString     error;     ///< Empty on success
+  };
+
 public:
   // Constructors / Destructor
   CommandLineInterface() = delete;
@@ -55,12 +64,22 @@ public:
   int execute() noexcept;
 
 private:  // Methods
-  bool           openProject(const QString& projectFile, bool runErc,
+  bool           openProject(const QString& projectFile, bool runAutorouter,
+                             bool runErc, bool runDrc,
+                             const QString&     reportFile,
                              const QStringList& exportSchematicsFiles,
                              bool               exportPcbFabricationData,
                              const QString&     pcbFabricationSettingsPath,
                              const QStringList& boards, bool save) const noexcept;
   bool openLibrary(const QString& libDir, bool all, bool save) const noexcept;
+  template <typename ElementType>
+  static bool processLibraryElements(const FilePath&    libFp,
+                                     const QString&     libDir,
+                                     const QStringList& dirs, bool save,
+                                     const QString&     typeName,
+                                     QStringList&       summary) noexcept;
+  static std::shared_ptr<TransactionalFileSystem> openFileSystem(
+      const FilePath& fp, bool writable);
   static QString prettyPath(const FilePath& path,
                             const QString&  style) noexcept;
   static void    print(const QString& str, int newlines = 1) noexcept;
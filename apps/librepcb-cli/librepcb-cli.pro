@@ -10,7 +10,7 @@ TARGET = librepcb-cli
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets opengl network xml printsupport sql
+QT += core widgets opengl network xml printsupport sql concurrent
 
 CONFIG += console
 
@@ -70,9 +70,11 @@ RESOURCES += \
     ../../img/images.qrc
 
 SOURCES += \
+    checkreport.cpp \
     commandlineinterface.cpp \
     main.cpp \
 
 HEADERS += \
+    checkreport.h \
     commandlineinterface.h \
 
@@ -52,7 +52,9 @@ BoardDesignRules::BoardDesignRules() noexcept
     mRestringPadMax(2000000),                    // 2.0mm
     mRestringViaRatio(Ratio::percent100() / 4),  // 25%
     mRestringViaMin(200000),                     // 0.2mm
-    mRestringViaMax(2000000)                     // 2.0mm
+    mRestringViaMax(2000000),                    // 2.0mm
+    // copper
+    mCopperClearance(200000)  // 0.2mm
 {
 }
 
@@ -114,6 +116,10 @@ BoardDesignRules::BoardDesignRules(const SExpression& node)
   if (const SExpression* e = node.tryGetChildByPath("restring_via_max")) {
     mRestringViaMax = e->getValueOfFirstChild<UnsignedLength>();
   }
+  // copper
+  if (const SExpression* e = node.tryGetChildByPath("copper_clearance")) {
+    mCopperClearance = e->getValueOfFirstChild<UnsignedLength>();
+  }
 
   // force validating properties, throw exception on error
   try {
@@ -207,6 +213,8 @@ void BoardDesignRules::serialize(SExpression& root) const {
   root.appendChild("restring_via_ratio", mRestringViaRatio, true);
   root.appendChild("restring_via_min", mRestringViaMin, true);
   root.appendChild("restring_via_max", mRestringViaMax, true);
+  // copper
+  root.appendChild("copper_clearance", mCopperClearance, true);
 }
 
 /*******************************************************************************
@@ -273,6 +281,8 @@ BoardDesignRules& BoardDesignRules::operator=(
   mRestringViaRatio = rhs.mRestringViaRatio;
   mRestringViaMin   = rhs.mRestringViaMin;
   mRestringViaMax   = rhs.mRestringViaMax;
+  // copper
+  mCopperClearance = rhs.mCopperClearance;
   return *this;
 }
 
@@ -104,6 +104,11 @@ public:
     return mRestringViaMax;
   }
 
+  // Getters: Copper
+  const UnsignedLength& getCopperClearance() const noexcept {
+    return mCopperClearance;
+  }
+
   // Setters: General Attributes
   void setName(const ElementName& name) noexcept { mName = name; }
   void setDescription(const QString& desc) noexcept { mDescription = desc; }
@@ -137,6 +142,11 @@ public:
   void setRestringViaBounds(const UnsignedLength& min,
                             const UnsignedLength& max);
 
+  // Setters: Copper
+  void setCopperClearance(const UnsignedLength& clearance) noexcept {
+    mCopperClearance = clearance;
+  }
+
   // General Methods
   void restoreDefaults() noexcept;
 
@@ -176,6 +186,9 @@ private:
   UnsignedRatio  mRestringViaRatio;
   UnsignedLength mRestringViaMin;
   UnsignedLength mRestringViaMax;
+
+  // Copper
+  UnsignedLength mCopperClearance;
 };
 
 /*******************************************************************************
@@ -82,9 +82,12 @@ SOURCES += \
     graphics/circlegraphicsitem.cpp \
     graphics/defaultgraphicslayerprovider.cpp \
     graphics/graphicslayer.cpp \
+    graphics/graphicslayerbatch.cpp \
     graphics/graphicsscene.cpp \
+    graphics/graphicstilecache.cpp \
     graphics/graphicsview.cpp \
     graphics/holegraphicsitem.cpp \
+    graphics/levelofdetail.cpp \
     graphics/linegraphicsitem.cpp \
     graphics/origincrossgraphicsitem.cpp \
     graphics/polygongraphicsitem.cpp \
@@ -111,6 +114,7 @@ SOURCES += \
     units/lengthunit.cpp \
     units/point.cpp \
     units/ratio.cpp \
+    utils/boundingboxgrid.cpp \
     utils/clipperhelpers.cpp \
     utils/exclusiveactiongroup.cpp \
     utils/graphicslayerstackappearancesettings.cpp \
@@ -195,11 +199,14 @@ HEADERS += \
     graphics/circlegraphicsitem.h \
     graphics/defaultgraphicslayerprovider.h \
     graphics/graphicslayer.h \
+    graphics/graphicslayerbatch.h \
     graphics/graphicslayername.h \
     graphics/graphicsscene.h \
+    graphics/graphicstilecache.h \
     graphics/graphicsview.h \
     graphics/holegraphicsitem.h \
     graphics/if_graphicsvieweventhandler.h \
+    graphics/levelofdetail.h \
     graphics/linegraphicsitem.h \
     graphics/origincrossgraphicsitem.h \
     graphics/polygongraphicsitem.h \
@@ -209,6 +216,7 @@ HEADERS += \
     graphics/stroketextgraphicsitem.h \
     graphics/textgraphicsitem.h \
     gridproperties.h \
+    if_bulkmutationtarget.h \
     network/filedownload.h \
     network/networkaccessmanager.h \
     network/networkrequest.h \
@@ -230,6 +238,7 @@ HEADERS += \
     units/lengthunit.h \
     units/point.h \
     units/ratio.h \
+    utils/boundingboxgrid.h \
     utils/clipperhelpers.h \
     utils/exclusiveactiongroup.h \
     utils/graphicslayerstackappearancesettings.h \
@@ -85,6 +85,12 @@ namespace librepcb {
  * same address over the whole lifetime. To still minimize the risk of memory
  * leaks, `std::shared_ptr` is used instead of raw pointers.
  *
+ * Element access methods and iterators only return copies of the element
+ * pointers, so the only way to replace elements is through #insert(),
+ * #append(), #take() and #remove(). This is important as the list maintains
+ * indices for the lookup by pointer, UUID and name which would otherwise get
+ * out of sync.
+ *
  * @warning Using Qt's `foreach` keyword on a #SerializableObjectList is not
  * recommended because it always creates a deep copy of the list! You should use
  * range based for loops (since C++11) instead.
@@ -200,28 +206,14 @@ public:
 
   // Element Query
   int indexOf(const T* obj) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i].get() == obj) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mPointerIndex, obj, [](const T& o) { return &o; });
   }
   int indexOf(const Uuid& key) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getUuid() == key) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mUuidIndex, key, [](const T& o) { return o.getUuid(); });
   }
   int indexOf(const QString& name) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getName() == name) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mNameIndex, name,
+                  [](const T& o) { return toNameKey(o.getName()); });
   }
   bool contains(int index) const noexcept {
     return index >= 0 && index < mObjects.count();
@@ -255,9 +247,9 @@ public:
   std::shared_ptr<const T> at(int index) const noexcept {
     return std::const_pointer_cast<const T>(mObjects.at(index));
   }  // always read-only!
-  std::shared_ptr<T>&      first() noexcept { return mObjects.first(); }
+  std::shared_ptr<T>       first() noexcept { return mObjects.first(); }
   std::shared_ptr<const T> first() const noexcept { return mObjects.first(); }
-  std::shared_ptr<T>&      last() noexcept { return mObjects.last(); }
+  std::shared_ptr<T>       last() noexcept { return mObjects.last(); }
   std::shared_ptr<const T> last() const noexcept { return mObjects.last(); }
   std::shared_ptr<T>       get(const T* obj) {
     std::shared_ptr<T> ptr = find(obj);
@@ -409,13 +401,48 @@ public:
     return *this;
   }
 
+protected:  // Types
+  /**
+   * @brief Lazily built hash index of the list elements
+   *
+   * The index always contains the first #size() elements of the list. It is
+   * extended on demand with the elements appended in the meantime, so lookups
+   * (e.g. while loading a list from a file) don't need linear searches. If
+   * elements within the indexed range are inserted or removed, the index is
+   * cleared and will be rebuilt with the next lookup. Edited elements are only
+   * remembered and their keys are compared with the next lookup, so the index
+   * is only rebuilt if a key has actually changed.
+   */
+  template <typename K>
+  struct Index {
+    QHash<K, int>  hash;    ///< Key -> index of the first element with key
+    std::vector<K> keys;    ///< Keys of all indexed elements
+    QSet<int>      edited;  ///< Indexed elements edited since last lookup
+
+    int  size() const noexcept { return static_cast<int>(keys.size()); }
+    void invalidate(int index) noexcept {
+      if (index < size()) {
+        hash.clear();
+        keys.clear();
+        edited.clear();
+      }
+    }
+    void markEdited(int index) noexcept {
+      if (index < size()) {
+        edited.insert(index);
+      }
+    }
+  };
+
 protected:  // Methods
   void insertElement(int index, const std::shared_ptr<T>& obj) noexcept {
+    invalidateIndices(index);
     mObjects.insert(index, obj);
     obj->onEdited.attach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementAdded);
   }
   std::shared_ptr<T> takeElement(int index) noexcept {
+    invalidateIndices(index);
     std::shared_ptr<T> obj = mObjects.takeAt(index);
     obj->onEdited.detach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementRemoved);
@@ -424,6 +451,12 @@ protected:  // Methods
   void elementEditedHandler(const T& obj, OnEditedArgs... args) noexcept {
     int index = indexOf(&obj);
     if (contains(index)) {
+      // The UUID or name of the element might have been changed.
+      {
+        QMutexLocker lock(&mIndexMutex);
+        mUuidIndex.markEdited(index);
+        mNameIndex.markEdited(index);
+      }
       onElementEdited.notify(index, at(index), args...);
       onEdited.notify(index, at(index), Event::ElementEdited);
     } else {
@@ -431,6 +464,42 @@ protected:  // Methods
                      "unknown element!";
     }
   }
+  void invalidateIndices(int index) noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    mPointerIndex.invalidate(index);
+    mUuidIndex.invalidate(index);
+    mNameIndex.invalidate(index);
+  }
+  template <typename K, typename F>
+  int lookup(Index<K>& index, const K& key, F getKey) const noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    // Rebuild the index if the key of an edited element has changed.
+    foreach (int i, index.edited) {
+      if (getKey(*mObjects.at(i)) != index.keys.at(i)) {
+        index.invalidate(0);
+        break;
+      }
+    }
+    index.edited.clear();
+    // Add elements which were appended since the last lookup. Note that
+    // insert() doesn't overwrite entries, so the hash always contains the
+    // first element with a particular key (like a linear search would do).
+    for (int i = index.size(); i < mObjects.count(); ++i) {
+      K elementKey = getKey(*mObjects.at(i));
+      index.keys.push_back(elementKey);
+      if (!index.hash.contains(elementKey)) {
+        index.hash.insert(elementKey, i);
+      }
+    }
+    return index.hash.value(key, -1);
+  }
+  static const QString& toNameKey(const QString& name) noexcept {
+    return name;
+  }
+  template <typename N>
+  static QString toNameKey(const N& name) noexcept {
+    return *name;  // e.g. librepcb::CircuitIdentifier
+  }
   void throwKeyNotFoundException(const Uuid& key) const {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -453,6 +522,13 @@ protected:  // Methods
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   Slot<T, OnEditedArgs...>    mOnEditedSlot;
+
+  // Indices for the element lookup (accessed by const methods too, so they
+  // are protected by a mutex to allow concurrent lookups from several threads)
+  mutable QMutex          mIndexMutex;
+  mutable Index<const T*> mPointerIndex;
+  mutable Index<Uuid>     mUuidIndex;
+  mutable Index<QString>  mNameIndex;
 };
 
 }  // namespace librepcb
@@ -26,9 +26,11 @@
 #include "fileutils.h"
 #include "sexpression.h"
 
+#include <QtConcurrent/QtConcurrent>
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
+#include <zlib.h>
 
 /*******************************************************************************
  *  Namespace
@@ -47,7 +49,8 @@ TransactionalFileSystem::TransactionalFileSystem(const FilePath& filepath,
     mFilePath(filepath),
     mIsWritable(writable),
     mLock(filepath),
-    mRestoredFromAutosave(false) {
+    mRestoredFromAutosave(false),
+    mIsDirectoryCacheEnabled(false) {
   // Load the backup if there is one (i.e. last save operation has failed).
   FilePath backupFile = mFilePath.getPathTo(".backup/backup.lp");
   if (backupFile.isExistingFile()) {
@@ -127,16 +130,17 @@ QStringList TransactionalFileSystem::getDirs(const QString& path) const
   if (!dirpath.isEmpty()) dirpath.append("/");
 
   // add directories from file system, if not removed
-  QDir dir(mFilePath.getPathTo(path).toStr());
   foreach (const QString& dirname,
-           dir.entryList(QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot)) {
+           getDiskEntries(cleanPath(path),
+                          QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot)) {
     if (!isRemoved(dirpath % dirname % "/")) {
       dirnames.insert(dirname);
     }
   }
 
   // add directories of new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  foreach (const QString& filepath,
+           mModifiedFiles.keys() + mZipEntries.keys()) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() > 1) {
@@ -155,15 +159,16 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
   if (!dirpath.isEmpty()) dirpath.append("/");
 
   // add files from file system, if not removed
-  QDir dir(mFilePath.getPathTo(path).toStr());
-  foreach (const QString& filename, dir.entryList(QDir::Files | QDir::Hidden)) {
+  foreach (const QString& filename,
+           getDiskEntries(cleanPath(path), QDir::Files | QDir::Hidden)) {
     if (!isRemoved(dirpath % filename)) {
       filenames.insert(filename);
     }
   }
 
   // add new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  foreach (const QString& filepath,
+           mModifiedFiles.keys() + mZipEntries.keys()) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() == 1) {
@@ -177,10 +182,17 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
 
 bool TransactionalFileSystem::fileExists(const QString& path) const noexcept {
   QString cleanedPath = cleanPath(path);
-  if (mModifiedFiles.contains(cleanedPath)) {
+  if (mModifiedFiles.contains(cleanedPath) ||
+      mZipEntries.contains(cleanedPath)) {
     return true;
   } else if (isRemoved(cleanedPath)) {
     return false;
+  } else if (mIsDirectoryCacheEnabled) {
+    int     pos      = cleanedPath.lastIndexOf('/');
+    QString dirpath  = (pos >= 0) ? cleanedPath.left(pos) : QString();
+    QString filename = cleanedPath.mid(pos + 1);
+    return getDiskEntries(dirpath, QDir::Files | QDir::Hidden)
+        .contains(filename);
   } else {
     return mFilePath.getPathTo(cleanedPath).isExistingFile();
   }
@@ -190,6 +202,8 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
   QString cleanedPath = cleanPath(path);
   if (mModifiedFiles.contains(cleanedPath)) {
     return mModifiedFiles.value(cleanedPath);
+  } else if (mZipEntries.contains(cleanedPath)) {
+    return readFromZip(cleanedPath);  // can throw
   } else if (!isRemoved(cleanedPath)) {
     return FileUtils::readFile(mFilePath.getPathTo(cleanedPath));  // can throw
   } else {
@@ -203,12 +217,16 @@ void TransactionalFileSystem::write(const QString&    path,
                                     const QByteArray& content) {
   QString cleanedPath         = cleanPath(path);
   mModifiedFiles[cleanedPath] = content;
+  mZipEntries.remove(cleanedPath);
+  mInflatedZipEntries.remove(cleanedPath);
   mRemovedFiles.remove(cleanedPath);
 }
 
 void TransactionalFileSystem::removeFile(const QString& path) {
   QString cleanedPath = cleanPath(path);
   mModifiedFiles.remove(cleanedPath);
+  mZipEntries.remove(cleanedPath);
+  mInflatedZipEntries.remove(cleanedPath);
   mRemovedFiles.insert(cleanedPath);
 }
 
@@ -220,6 +238,12 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
       mModifiedFiles.remove(fp);
     }
   }
+  foreach (const QString& fp, mZipEntries.keys()) {
+    if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
+      mZipEntries.remove(fp);
+      mInflatedZipEntries.remove(fp);
+    }
+  }
   foreach (const QString& fp, mRemovedFiles) {
     if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
       mRemovedFiles.remove(fp);
@@ -232,23 +256,53 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
  *  General Methods
  ******************************************************************************/
 
+void TransactionalFileSystem::enableDirectoryCache() {
+  if (mIsWritable) {
+    throw LogicError(__FILE__, __LINE__,
+                     "The directory cache requires the read-only mode.");
+  }
+  mIsDirectoryCacheEnabled = true;
+}
+
 void TransactionalFileSystem::loadFromZip(const FilePath& fp) {
+  // Only one ZIP file can be lazily loaded at a time, so the files of a
+  // previously loaded ZIP file need to be inflated now.
+  inflateZipEntries();  // can throw
+
   QuaZip zip(fp.toStr());
   if (!zip.open(QuaZip::mdUnzip)) {
     throw RuntimeError(
         __FILE__, __LINE__,
         QString(tr("Failed to open the ZIP file '%1'.")).arg(fp.toNative()));
   }
-  QuaZipFile file(&zip);
-  for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
-    file.open(QIODevice::ReadOnly);
-    write(file.getActualFileName(), file.readAll());
-    file.close();
+
+  // Only read the central directory, the files are inflated on read(). The
+  // ZIP file is closed again to not keep it open for the lifetime of this
+  // object (e.g. it would be locked on Windows).
+  foreach (const QString& name, zip.getFileNameList()) {
+    QString cleanedPath = cleanPath(name);
+    mModifiedFiles.remove(cleanedPath);
+    mRemovedFiles.remove(cleanedPath);
+    mZipEntries.insert(cleanedPath, name);
   }
   zip.close();
+  mZipFilePath = fp;
 }
 
-void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
+void TransactionalFileSystem::exportToZip(const FilePath& fp,
+                                          ZipCompression  compression) const {
+  // If the destination is the lazily loaded ZIP file, all files need to be
+  // inflated before the ZIP file gets overwritten. Afterwards, they are
+  // always read from the cache, so the overwritten ZIP file is never opened.
+  if ((!mZipEntries.isEmpty()) && (fp == mZipFilePath)) {
+    foreach (const QString& filepath, mZipEntries.keys()) {
+      readFromZip(filepath);  // can throw
+    }
+  }
+
+  QStringList files;
+  getFilesForZip(files, fp, "");
+
   QuaZip zip(fp.toStr());
   if (!zip.open(QuaZip::mdCreate)) {
     throw RuntimeError(
@@ -257,7 +311,44 @@ void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
   }
   try {
     QuaZipFile file(&zip);
-    exportDirToZip(file, fp, "");
+    // Compress the files in parallel on the global thread pool, but write them
+    // sequentially to the ZIP file to get a deterministic output. Processing
+    // the files in batches limits the memory usage for large projects.
+    const int batchSize = qMax(QThread::idealThreadCount(), 1) * 4;
+    for (int i = 0; i < files.count(); i += batchSize) {
+      QList<QFuture<ZipEntry>> futures;
+      foreach (const QString& filepath, files.mid(i, batchSize)) {
+        bool compress = (compression == ZipCompression::ALL) ||
+                        (!isCompressedFileFormat(filepath));
+        futures.append(QtConcurrent::run(
+            &TransactionalFileSystem::compressZipEntry, filepath,
+            read(filepath), compress));  // can throw
+      }
+      foreach (QFuture<ZipEntry> future, futures) {
+        const ZipEntry& entry = future.result();
+        QuaZipNewInfo   newFileInfo(entry.filepath);
+        newFileInfo.setPermissions(
+            QFileDevice::ReadOwner | QFileDevice::ReadGroup |
+            QFileDevice::ReadOther | QFileDevice::WriteOwner);
+        newFileInfo.uncompressedSize = entry.uncompressedSize;
+        bool opened = entry.compressed
+                          ? file.open(QIODevice::WriteOnly, newFileInfo,
+                                      nullptr, entry.crc, Z_DEFLATED,
+                                      Z_DEFAULT_COMPRESSION, true)
+                          : file.open(QIODevice::WriteOnly, newFileInfo,
+                                      nullptr, 0, 0, 0);  // stored
+        if (!opened) {
+          throw RuntimeError(__FILE__, __LINE__);
+        }
+        qint64 bytesWritten = file.write(entry.data);
+        file.close();
+        if (bytesWritten != entry.data.length()) {
+          throw RuntimeError(__FILE__, __LINE__,
+                             QString(tr("Failed to write file '%1' to '%2'."))
+                                 .arg(entry.filepath, fp.toNative()));
+        }
+      }
+    }
     zip.close();
   } catch (const Exception& e) {
     // Remove ZIP file because it is not complete
@@ -268,10 +359,14 @@ void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
 }
 
 void TransactionalFileSystem::autosave() {
+  inflateZipEntries();   // can throw
   saveDiff("autosave");  // can throw
 }
 
 void TransactionalFileSystem::save() {
+  // lazily loaded files need to be saved too
+  inflateZipEntries();  // can throw
+
   // save to backup directory
   saveDiff("backup");  // can throw
 
@@ -342,20 +437,39 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
-void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
+QStringList TransactionalFileSystem::getDiskEntries(
+    const QString& dirpath, QDir::Filters filters) const noexcept {
+  if (!mIsDirectoryCacheEnabled) {
+    return QDir(mFilePath.getPathTo(dirpath).toStr()).entryList(filters);
+  }
+
+  // The directory listing on the disk does not change while we are in
+  // read-only mode, so each directory only needs to be listed once.
+  QHash<QString, QStringList>& cache =
+      filters.testFlag(QDir::Dirs) ? mCachedDirs : mCachedFiles;
+  QMutexLocker locker(&mCacheMutex);
+  auto         it = cache.constFind(dirpath);
+  if (it == cache.constEnd()) {
+    it = cache.insert(
+        dirpath, QDir(mFilePath.getPathTo(dirpath).toStr()).entryList(filters));
+  }
+  return *it;
+}
+
+void TransactionalFileSystem::getFilesForZip(QStringList&    files,
                                              const FilePath& zipFp,
                                              const QString&  dir) const {
   QString path = dir.isEmpty() ? dir : dir % "/";
 
   // export directories
-  foreach (const QString& dirname, getDirs(dir)) {
+  foreach (const QString& dirname, Toolbox::sorted(getDirs(dir))) {
     // skip dotdirs, e.g. ".git", ".svn", ".autosave", ".backup"
     if (dirname.startsWith('.')) continue;
-    exportDirToZip(file, zipFp, path % dirname);
+    getFilesForZip(files, zipFp, path % dirname);
   }
 
   // export files
-  foreach (const QString& filename, getFiles(dir)) {
+  foreach (const QString& filename, Toolbox::sorted(getFiles(dir))) {
     QString filepath = path % filename;
     if (filepath == zipFp.toRelative(mFilePath)) {
       // In case the exported ZIP file is located inside this file system,
@@ -364,25 +478,45 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
     }
     // skip lock file
     if (filename == ".lock") continue;
-    // read file content and add it to the ZIP archive
-    const QByteArray& content = read(filepath);  // can throw
-    QuaZipNewInfo     newFileInfo(filepath);
-    newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
-                               QFileDevice::ReadOther |
-                               QFileDevice::WriteOwner);
-    if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    qint64 bytesWritten = file.write(content);
-    file.close();
-    if (bytesWritten != content.length()) {
-      throw RuntimeError(__FILE__, __LINE__,
-                         QString(tr("Failed to write file '%1' to '%2'."))
-                             .arg(filepath, zipFp.toNative()));
-    }
+    files.append(filepath);
   }
 }
 
+QByteArray TransactionalFileSystem::readFromZip(
+    const QString& filepath) const {
+  QMutexLocker locker(&mZipMutex);  // read() may be called from many threads
+  auto         it = mInflatedZipEntries.constFind(filepath);
+  if (it != mInflatedZipEntries.constEnd()) {
+    return *it;
+  }
+
+  // Open the ZIP file only for this read to not exhaust file descriptors or
+  // lock the file while it is not used.
+  QString    entryName = mZipEntries.value(filepath);
+  QuaZip     zip(mZipFilePath.toStr());
+  QuaZipFile file(&zip);
+  if ((!zip.open(QuaZip::mdUnzip)) || (!zip.setCurrentFile(entryName)) ||
+      (!file.open(QIODevice::ReadOnly))) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Failed to read file '%1' from '%2'."))
+                           .arg(entryName, mZipFilePath.toNative()));
+  }
+  QByteArray content = file.readAll();
+  file.close();
+  zip.close();
+  mInflatedZipEntries.insert(filepath, content);
+  return content;
+}
+
+void TransactionalFileSystem::inflateZipEntries() {
+  foreach (const QString& filepath, mZipEntries.keys()) {
+    mModifiedFiles.insert(filepath, readFromZip(filepath));  // can throw
+    mZipEntries.remove(filepath);
+  }
+  mInflatedZipEntries.clear();
+  mZipFilePath = FilePath();
+}
+
 void TransactionalFileSystem::saveDiff(const QString& type) const {
   QDateTime dt       = QDateTime::currentDateTime();
   FilePath  dir      = mFilePath.getPathTo("." % type);
@@ -453,6 +587,54 @@ void TransactionalFileSystem::discardChanges() noexcept {
   mModifiedFiles.clear();
   mRemovedFiles.clear();
   mRemovedDirs.clear();
+  mZipEntries.clear();
+  mInflatedZipEntries.clear();
+  mZipFilePath = FilePath();
+}
+
+bool TransactionalFileSystem::isCompressedFileFormat(
+    const QString& filepath) noexcept {
+  static QStringList suffixes = {"7z",  "bz2", "gif",  "gz",  "jpeg",
+                                 "jpg", "lppz", "png", "xz",  "zip"};
+  return suffixes.contains(QFileInfo(filepath).suffix().toLower());
+}
+
+TransactionalFileSystem::ZipEntry TransactionalFileSystem::compressZipEntry(
+    const QString& filepath, const QByteArray& content,
+    bool compress) noexcept {
+  ZipEntry entry;
+  entry.filepath         = filepath;
+  entry.data             = content;
+  entry.uncompressedSize = content.size();
+  entry.crc              = crc32(0L, Z_NULL, 0);
+  entry.crc              = crc32(
+      entry.crc, reinterpret_cast<const Bytef*>(content.constData()),
+      content.size());
+  entry.compressed = false;
+  if (compress && (!content.isEmpty())) {
+    // raw deflate stream (negative window bits), as required by ZIP files
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY) == Z_OK) {
+      QByteArray buffer(deflateBound(&stream, content.size()),
+                        Qt::Uninitialized);
+      stream.next_in =
+          reinterpret_cast<Bytef*>(const_cast<char*>(content.constData()));
+      stream.avail_in  = content.size();
+      stream.next_out  = reinterpret_cast<Bytef*>(buffer.data());
+      stream.avail_out = buffer.size();
+      // only use the compressed data if it is really smaller
+      if ((deflate(&stream, Z_FINISH) == Z_STREAM_END) &&
+          (stream.total_out < static_cast<uLong>(content.size()))) {
+        buffer.resize(stream.total_out);
+        entry.data       = buffer;
+        entry.compressed = true;
+      }
+      deflateEnd(&stream);
+    }
+  }
+  return entry;
 }
 
 /*******************************************************************************
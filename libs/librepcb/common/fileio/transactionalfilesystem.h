@@ -58,7 +58,11 @@ namespace librepcb {
  *    an application crash (see @ref doc_project_autosave).
  *  - Holds all file modifications in memory and allows to write those in an
  *    atomic way to the disk (see @ref doc_project_save).
- *  - Allows to export the whole file system to a ZIP file.
+ *  - Allows to export the whole file system to a ZIP file (compressed in
+ *    parallel) and to load a ZIP file lazily, i.e. files are only inflated
+ *    when they are read for the first time.
+ *  - Optionally (read-only mode only) caches directory listings for the
+ *    lifetime of the object, see #enableDirectoryCache().
  */
 class TransactionalFileSystem final : public FileSystem {
   Q_OBJECT
@@ -71,6 +75,11 @@ public:
     ABORT,  ///< Throw a RuntimeError if a backup exists
   };
 
+  enum class ZipCompression {
+    ALL,              ///< Deflate all files
+    SKIP_COMPRESSED,  ///< Store already compressed files (e.g. PNG) as-is
+  };
+
   // Constructors / Destructor
   TransactionalFileSystem() = delete;
   TransactionalFileSystem(const FilePath& filepath, bool writable = false,
@@ -82,6 +91,9 @@ public:
   // Getters
   bool isWritable() const noexcept { return mIsWritable; }
   bool isRestoredFromAutosave() const noexcept { return mRestoredFromAutosave; }
+  bool isDirectoryCacheEnabled() const noexcept {
+    return mIsDirectoryCacheEnabled;
+  }
 
   // Inherited from FileSystem
   virtual FilePath getAbsPath(const QString& path = "") const noexcept override;
@@ -95,8 +107,28 @@ public:
   virtual void removeDirRecursively(const QString& path = "") override;
 
   // General Methods
+
+  /**
+   * @brief Cache the directory listings of the disk
+   *
+   * Afterwards, each directory on the disk is listed only once and then cached
+   * for the lifetime of this object, which speeds up #getDirs(), #getFiles()
+   * and #fileExists() when scanning large directory trees. Modifications
+   * through #write() etc. are still possible, but changes on the disk made by
+   * others are no longer detected.
+   *
+   * @note Files are not memory-mapped since each mapping would keep its file
+   *       descriptor open (the default limit is only 256 on macOS), and the
+   *       returned byte arrays would reference memory which gets unmapped
+   *       when this object is destroyed.
+   *
+   * @throw LogicError if the file system is opened in R/W mode.
+   */
+  void enableDirectoryCache();
   void loadFromZip(const FilePath& fp);
-  void exportToZip(const FilePath& fp) const;
+  void exportToZip(
+      const FilePath& fp,
+      ZipCompression  compression = ZipCompression::SKIP_COMPRESSED) const;
   void autosave();
   void save();
 
@@ -117,27 +149,64 @@ public:
       QObject* parent = nullptr) {
     return open(filepath, true, restoreMode, parent);
   }
+  static std::shared_ptr<TransactionalFileSystem> openROCached(
+      const FilePath& filepath, RestoreMode restoreMode = RestoreMode::NO,
+      QObject* parent = nullptr) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        openRO(filepath, restoreMode, parent);
+    fs->enableDirectoryCache();
+    return fs;
+  }
   static QString cleanPath(QString path) noexcept;
 
+private:  // Types
+  struct ZipEntry {
+    QString    filepath;
+    QByteArray data;  ///< Raw deflate data if compressed, otherwise content
+    qulonglong uncompressedSize;
+    quint32    crc;
+    bool       compressed;
+  };
+
 private:  // Methods
-  bool isRemoved(const QString& path) const noexcept;
-  void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
-                      const QString& dir) const;
-  void saveDiff(const QString& type) const;
-  void loadDiff(const FilePath& fp);
-  void removeDiff(const QString& type);
-  void discardChanges() noexcept;
+  bool        isRemoved(const QString& path) const noexcept;
+  QStringList getDiskEntries(const QString& dirpath,
+                             QDir::Filters  filters) const noexcept;
+  void        getFilesForZip(QStringList& files, const FilePath& zipFp,
+                             const QString& dir) const;
+  QByteArray  readFromZip(const QString& filepath) const;
+  void        inflateZipEntries();
+  void        saveDiff(const QString& type) const;
+  void        loadDiff(const FilePath& fp);
+  void        removeDiff(const QString& type);
+  void        discardChanges() noexcept;
+  static bool isCompressedFileFormat(const QString& filepath) noexcept;
+  static ZipEntry compressZipEntry(const QString&    filepath,
+                                   const QByteArray& content,
+                                   bool              compress) noexcept;
 
 private:  // Data
   FilePath      mFilePath;
   bool          mIsWritable;
   DirectoryLock mLock;
   bool          mRestoredFromAutosave;
+  bool          mIsDirectoryCacheEnabled;
+
+  // Read-only caches (only used if the directory cache is enabled)
+  mutable QMutex                      mCacheMutex;
+  mutable QHash<QString, QStringList> mCachedDirs;
+  mutable QHash<QString, QStringList> mCachedFiles;
 
   // File system modifications
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString>              mRemovedFiles;
   QSet<QString>              mRemovedDirs;
+
+  // Lazily loaded ZIP file (only inflated on read, closed between reads)
+  FilePath                           mZipFilePath;
+  QHash<QString, QString>            mZipEntries;  ///< Cleaned path -> name
+  mutable QHash<QString, QByteArray> mInflatedZipEntries;  ///< Read cache
+  mutable QMutex                     mZipMutex;
 };
 
 /*******************************************************************************
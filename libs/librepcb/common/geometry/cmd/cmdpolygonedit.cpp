@@ -47,7 +47,9 @@ CmdPolygonEdit::CmdPolygonEdit(Polygon& polygon) noexcept
     mOldIsGrabArea(polygon.isGrabArea()),
     mNewIsGrabArea(mOldIsGrabArea),
     mOldPath(polygon.getPath()),
-    mNewPath(mOldPath) {
+    mNewPath(mOldPath),
+    mNewPathIsOffset(false),
+    mNewPathOffset() {
 }
 
 CmdPolygonEdit::~CmdPolygonEdit() noexcept {
@@ -56,6 +58,18 @@ CmdPolygonEdit::~CmdPolygonEdit() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdPolygonEdit::getMemoryUsage() const noexcept {
+  qint64 usage = UndoCommand::getMemoryUsage();
+  usage += sizeof(CmdPolygonEdit) - sizeof(UndoCommand);
+  usage += mOldPath.getVertices().capacity() * sizeof(Vertex);
+  usage += mNewPath.getVertices().capacity() * sizeof(Vertex);
+  return usage;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -116,12 +130,12 @@ void CmdPolygonEdit::mirror(const Point& center, Qt::Orientation orientation,
 bool CmdPolygonEdit::performExecute() {
   performRedo();  // can throw
 
-  if (mNewLayerName != mOldLayerName) return true;
-  if (mNewLineWidth != mOldLineWidth) return true;
-  if (mNewIsFilled != mOldIsFilled) return true;
-  if (mNewIsGrabArea != mOldIsGrabArea) return true;
-  if (mNewPath != mOldPath) return true;
-  return false;
+  bool modified = (mNewLayerName != mOldLayerName) ||
+                  (mNewLineWidth != mOldLineWidth) ||
+                  (mNewIsFilled != mOldIsFilled) ||
+                  (mNewIsGrabArea != mOldIsGrabArea) || (mNewPath != mOldPath);
+  compactPaths();  // the paths will not be modified anymore
+  return modified;
 }
 
 void CmdPolygonEdit::performUndo() {
@@ -137,7 +151,28 @@ void CmdPolygonEdit::performRedo() {
   mPolygon.setLineWidth(mNewLineWidth);
   mPolygon.setIsFilled(mNewIsFilled);
   mPolygon.setIsGrabArea(mNewIsGrabArea);
-  mPolygon.setPath(mNewPath);
+  mPolygon.setPath(getNewPath());
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdPolygonEdit::compactPaths() noexcept {
+  // This command may be kept in the undo stack for a long time, so release
+  // the cached painter paths and store only the offset if the polygon was
+  // just moved (the most common modification).
+  mOldPath = Path(mOldPath.getVertices());
+  if (mNewPath.isTranslationOf(mOldPath, mNewPathOffset)) {
+    mNewPath         = Path();
+    mNewPathIsOffset = true;
+  } else {
+    mNewPath = Path(mNewPath.getVertices());
+  }
+}
+
+Path CmdPolygonEdit::getNewPath() const noexcept {
+  return mNewPathIsOffset ? mOldPath.translated(mNewPathOffset) : mNewPath;
 }
 
 /*******************************************************************************
@@ -48,6 +48,11 @@ public:
   explicit CmdPolygonEdit(Polygon& polygon) noexcept;
   ~CmdPolygonEdit() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // Setters
   void setLayerName(const GraphicsLayerName& name, bool immediate) noexcept;
   void setLineWidth(const UnsignedLength& width, bool immediate) noexcept;
@@ -74,6 +79,9 @@ private:
   /// @copydoc UndoCommand::performRedo()
   void performRedo() override;
 
+  void compactPaths() noexcept;
+  Path getNewPath() const noexcept;
+
   // Private Member Variables
 
   // Attributes from the constructor
@@ -90,6 +98,11 @@ private:
   bool              mNewIsGrabArea;
   Path              mOldPath;
   Path              mNewPath;
+
+  /// If true, #mNewPath is empty and #mOldPath translated by
+  /// #mNewPathOffset is the new path (see #compactPaths())
+  bool  mNewPathIsOffset;
+  Point mNewPathOffset;
 };
 
 /*******************************************************************************
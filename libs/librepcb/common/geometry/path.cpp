@@ -91,6 +91,22 @@ const QPainterPath& Path::toQPainterPathPx(bool close) const noexcept {
   return mPainterPathPx;
 }
 
+bool Path::isTranslationOf(const Path& other, Point& offset) const noexcept {
+  if (mVertices.isEmpty() || (mVertices.count() != other.mVertices.count())) {
+    return false;
+  }
+  Point delta = mVertices.first().getPos() - other.mVertices.first().getPos();
+  for (int i = 0; i < mVertices.count(); ++i) {
+    const Vertex& v = mVertices.at(i);
+    const Vertex& o = other.mVertices.at(i);
+    if ((v.getPos() != o.getPos() + delta) || (v.getAngle() != o.getAngle())) {
+      return false;
+    }
+  }
+  offset = delta;
+  return true;
+}
+
 /*******************************************************************************
  *  Transformations
  ******************************************************************************/
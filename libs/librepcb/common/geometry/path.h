@@ -69,6 +69,18 @@ public:
   const QVector<Vertex>& getVertices() const noexcept { return mVertices; }
   const QPainterPath&    toQPainterPathPx(bool close = false) const noexcept;
 
+  /**
+   * @brief Check whether this path is a translated copy of another path
+   *
+   * @param other   The path to compare with
+   * @param offset  Set to the offset from other to this path (only if true is
+   *                returned)
+   *
+   * @return True if both paths are not empty and all vertices are equal after
+   *         translating the other path by the offset
+   */
+  bool isTranslationOf(const Path& other, Point& offset) const noexcept;
+
   // Transformations
   Path& translate(const Point& offset) noexcept;
   Path  translated(const Point& offset) const noexcept;
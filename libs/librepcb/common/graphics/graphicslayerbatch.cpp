@@ -0,0 +1,205 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "graphicslayerbatch.h"
+
+#include "levelofdetail.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+GraphicsLayerBatch::GraphicsLayerBatch(const GraphicsLayer& layer) noexcept
+  : QGraphicsItem(),
+    mLayer(&layer),
+    mOnLayerEditedSlot(*this, &GraphicsLayerBatch::layerEdited),
+    mBuffersDirty(false) {
+  setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);  // exposedRect
+  setAcceptedMouseButtons(Qt::NoButton);
+  setVisible(mLayer->isVisible());
+  mLayer->onEdited.attach(mOnLayerEditedSlot);
+}
+
+GraphicsLayerBatch::~GraphicsLayerBatch() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void GraphicsLayerBatch::setLine(const void* obj, const QLineF& line,
+                                 qreal width) noexcept {
+  Q_ASSERT(width > 0);
+  set(obj, line, width, QPainterPath());
+}
+
+void GraphicsLayerBatch::setArea(const void*         obj,
+                                 const QPainterPath& area) noexcept {
+  set(obj, QLineF(), 0, area);
+}
+
+void GraphicsLayerBatch::remove(const void* obj) noexcept {
+  auto it = mEntries.find(obj);
+  if (it != mEntries.end()) {
+    QRectF rect = getBoundingRect(*it);
+    mEntries.erase(it);
+    mBuffersDirty = true;
+    update(rect);
+  }
+}
+
+/*******************************************************************************
+ *  Inherited from QGraphicsItem
+ ******************************************************************************/
+
+void GraphicsLayerBatch::paint(QPainter*                       painter,
+                               const QStyleOptionGraphicsItem* option,
+                               QWidget* widget) noexcept {
+  Q_UNUSED(widget);
+  if (!mLayer) {
+    return;
+  }
+  if (mBuffersDirty) {
+    updateBuffers();
+  }
+
+  const LevelOfDetail lod(*painter, *option);
+  const QColor        color = mLayer->getColor(false);
+  const QRectF        exposedRect = option->exposedRect;
+  const bool          cull = !exposedRect.contains(mBoundingRect);
+
+  // draw all lines of the same width at once
+  painter->setBrush(Qt::NoBrush);
+  for (auto it = mLineBuffers.constBegin(); it != mLineBuffers.constEnd();
+       ++it) {
+    qreal width = it.key();
+    if (lod.isTooSmall(width)) {
+      // a cosmetic pen is much faster than a wide pen with round caps
+      painter->setPen(QPen(color, 0));
+    } else {
+      painter->setPen(QPen(color, width, Qt::SolidLine, Qt::RoundCap));
+    }
+    if (cull) {
+      QVector<QLineF> visibleLines;
+      foreach (const QLineF& line, it.value()) {
+        if (exposedRect.intersects(getLineBoundingRect(line, width))) {
+          visibleLines.append(line);
+        }
+      }
+      painter->drawLines(visibleLines);
+    } else {
+      painter->drawLines(it.value());
+    }
+  }
+
+  // draw all areas with the same brush
+  painter->setPen(Qt::NoPen);
+  painter->setBrush(color);
+  foreach (const QPainterPath& area, mAreaBuffer) {
+    if ((!cull) || exposedRect.intersects(area.boundingRect())) {
+      painter->drawPath(area);
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void GraphicsLayerBatch::set(const void* obj, const QLineF& line, qreal width,
+                             const QPainterPath& area) noexcept {
+  remove(obj);  // repaints the old area, if any
+  Entry  entry = {line, width, area};
+  QRectF rect  = getBoundingRect(entry);
+  mEntries.insert(obj, entry);
+  mBuffersDirty = true;
+  if (!mBoundingRect.contains(rect)) {
+    prepareGeometryChange();
+    mBoundingRect = mBoundingRect.isNull() ? rect : mBoundingRect.united(rect);
+  }
+  update(rect);
+}
+
+void GraphicsLayerBatch::updateBuffers() noexcept {
+  mLineBuffers.clear();
+  mAreaBuffer.clear();
+  foreach (const Entry& entry, mEntries) {
+    if (entry.width > 0) {
+      mLineBuffers[entry.width].append(entry.line);
+    } else {
+      mAreaBuffer.append(entry.area);
+    }
+  }
+  mBuffersDirty = false;
+}
+
+QRectF GraphicsLayerBatch::getBoundingRect(const Entry& entry) noexcept {
+  if (entry.width > 0) {
+    return getLineBoundingRect(entry.line, entry.width);
+  } else {
+    return entry.area.boundingRect();
+  }
+}
+
+QRectF GraphicsLayerBatch::getLineBoundingRect(const QLineF& line,
+                                               qreal width) noexcept {
+  qreal r = width / 2;
+  return QRectF(line.p1(), line.p2()).normalized().adjusted(-r, -r, r, r);
+}
+
+void GraphicsLayerBatch::layerEdited(const GraphicsLayer& layer,
+                                     GraphicsLayer::Event event) noexcept {
+  Q_UNUSED(layer);
+  switch (event) {
+    case GraphicsLayer::Event::ColorChanged:
+    case GraphicsLayer::Event::HighlightColorChanged:
+      update();
+      break;
+    case GraphicsLayer::Event::VisibleChanged:
+    case GraphicsLayer::Event::EnabledChanged:
+      setVisible(mLayer->isVisible());
+      break;
+    case GraphicsLayer::Event::Destroyed:
+      mLayer = nullptr;
+      setVisible(false);
+      break;
+    default:
+      qWarning() << "Unhandled switch-case in "
+                    "GraphicsLayerBatch::layerEdited()";
+      break;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_GRAPHICSLAYERBATCH_H
+#define LIBREPCB_GRAPHICSLAYERBATCH_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "graphicslayer.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class GraphicsLayerBatch
+ ******************************************************************************/
+
+/**
+ * @brief Draws the static geometry of many objects on one layer at once
+ *
+ * Instead of letting every object paint itself with its own pen and brush
+ * set-up, objects can register their geometry (lines and filled areas) in a
+ * batch. The batch then draws all lines of the same width with a single
+ * QPainter::drawLines() call and all areas with a single brush set-up.
+ *
+ * Objects which need to be drawn differently (e.g. because they are selected
+ * or highlighted) should remove themselves from the batch and paint their
+ * geometry on their own while in this state.
+ *
+ * Each object is identified by an arbitrary, unique pointer (typically its
+ * own address) which is never dereferenced.
+ *
+ * @note The bounding rect only grows when geometry is added, it doesn't shrink
+ *       when geometry is removed. This avoids iterating over all objects on
+ *       every removal and is harmless since it's only an upper bound.
+ */
+class GraphicsLayerBatch final : public QGraphicsItem {
+public:
+  // Constructors / Destructor
+  GraphicsLayerBatch()                                = delete;
+  GraphicsLayerBatch(const GraphicsLayerBatch& other) = delete;
+  explicit GraphicsLayerBatch(const GraphicsLayer& layer) noexcept;
+  ~GraphicsLayerBatch() noexcept;
+
+  // Getters
+  const GraphicsLayer* getLayer() const noexcept { return mLayer; }
+  int                  getCount() const noexcept { return mEntries.count(); }
+  bool                 contains(const void* obj) const noexcept {
+    return mEntries.contains(obj);
+  }
+
+  // General Methods
+  void setLine(const void* obj, const QLineF& line, qreal width) noexcept;
+  void setArea(const void* obj, const QPainterPath& area) noexcept;
+  void remove(const void* obj) noexcept;
+
+  // Inherited from QGraphicsItem
+  QRectF       boundingRect() const noexcept override { return mBoundingRect; }
+  QPainterPath shape() const noexcept override { return QPainterPath(); }
+  void         paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                     QWidget* widget = 0) noexcept override;
+
+  // Operator Overloadings
+  GraphicsLayerBatch& operator=(const GraphicsLayerBatch& rhs) = delete;
+
+private:  // Types
+  struct Entry {
+    QLineF       line;   ///< Only used for lines (width > 0)
+    qreal        width;  ///< Line width, or 0 for areas
+    QPainterPath area;   ///< Only used for areas (width == 0)
+  };
+
+private:  // Methods
+  void set(const void* obj, const QLineF& line, qreal width,
+           const QPainterPath& area) noexcept;
+  void updateBuffers() noexcept;
+  static QRectF getBoundingRect(const Entry& entry) noexcept;
+  static QRectF getLineBoundingRect(const QLineF& line, qreal width) noexcept;
+  void layerEdited(const GraphicsLayer& layer,
+                   GraphicsLayer::Event event) noexcept;
+
+private:  // Data
+  const GraphicsLayer*        mLayer;
+  QHash<const void*, Entry>   mEntries;
+  QRectF                      mBoundingRect;
+  GraphicsLayer::OnEditedSlot mOnLayerEditedSlot;
+
+  // Draw buffers, rebuilt on the next paint event after any modification
+  bool                         mBuffersDirty;
+  QMap<qreal, QVector<QLineF>> mLineBuffers;  ///< Key: line width
+  QVector<QPainterPath>        mAreaBuffer;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_GRAPHICSLAYERBATCH_H
@@ -93,6 +93,19 @@ QPixmap GraphicsScene::toPixmap(const QSize&  size,
   return pixmap;
 }
 
+QImage GraphicsScene::toImage(const QSize&  size,
+                              const QColor& background) noexcept {
+  // use QImage instead of QPixmap to allow saving it in worker threads
+  QRectF rect = itemsBoundingRect();
+  QImage image(size, QImage::Format_ARGB32_Premultiplied);
+  image.fill(background);
+  QPainter painter(&image);
+  painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                         QPainter::SmoothPixmapTransform);
+  render(&painter, QRectF(), rect, Qt::KeepAspectRatio);
+  return image;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
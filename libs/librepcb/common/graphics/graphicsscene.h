@@ -56,6 +56,8 @@ public:
                    const QColor& background = Qt::transparent) noexcept;
   QPixmap toPixmap(const QSize&  size,
                    const QColor& background = Qt::transparent) noexcept;
+  QImage  toImage(const QSize&  size,
+                  const QColor& background = Qt::transparent) noexcept;
 
 private:
   QGraphicsRectItem* mSelectionRectItem;
@@ -0,0 +1,216 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "graphicstilecache.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+GraphicsTileCache::GraphicsTileCache(int tileSizePx, int maxTiles) noexcept
+  : mTileSize(tileSizePx),
+    mMaxTiles(maxTiles),
+    mScene(nullptr),
+    mDevicePixelRatio(1) {
+  Q_ASSERT(mTileSize > 0);
+}
+
+GraphicsTileCache::~GraphicsTileCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void GraphicsTileCache::setScene(QGraphicsScene* scene) noexcept {
+  if (scene != mScene) {
+    mScene = scene;
+    invalidate();
+  }
+}
+
+void GraphicsTileCache::setTransform(const QTransform& transform,
+                                     qreal devicePixelRatio) noexcept {
+  if ((transform != mTransform) || (devicePixelRatio != mDevicePixelRatio)) {
+    mTransform        = transform;
+    mDevicePixelRatio = devicePixelRatio;
+    // the tiles are aligned to the origin of the scene, any translation is
+    // applied when drawing them (see #getTileOffset())
+    mTileTransform = QTransform(transform.m11(), transform.m12(),
+                                transform.m21(), transform.m22(), 0, 0);
+    invalidate();
+  }
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void GraphicsTileCache::invalidate() noexcept {
+  mTiles.clear();
+}
+
+void GraphicsTileCache::invalidate(const QRectF& sceneRect) noexcept {
+  // add one pixel margin to take antialiasing into account
+  QRectF rect = mTileTransform.mapRect(sceneRect).adjusted(-1, -1, 1, 1);
+  int    x1   = qFloor(rect.left() / mTileSize);
+  int    x2   = qFloor(rect.right() / mTileSize);
+  int    y1   = qFloor(rect.top() / mTileSize);
+  int    y2   = qFloor(rect.bottom() / mTileSize);
+  if ((x2 - x1 + 1) * (y2 - y1 + 1) > mTiles.count()) {
+    // faster than looking up every tile in the range
+    foreach (quint64 key, mTiles.keys()) {
+      int x = static_cast<qint32>(key >> 32);
+      int y = static_cast<qint32>(key & 0xFFFFFFFF);
+      if ((x >= x1) && (x <= x2) && (y >= y1) && (y <= y2)) {
+        mTiles.remove(key);
+      }
+    }
+  } else {
+    for (int x = x1; x <= x2; ++x) {
+      for (int y = y1; y <= y2; ++y) {
+        mTiles.remove(toKey(x, y));
+      }
+    }
+  }
+}
+
+void GraphicsTileCache::draw(QPainter& painter, const QRect& viewportRect,
+                             const QTransform& viewportTransform) noexcept {
+  QRect  range  = getTileRange(viewportRect, viewportTransform);
+  QPoint offset = getTileOffset(viewportTransform);
+  removeFarTiles(range);
+  painter.save();
+  painter.resetTransform();
+  for (int x = range.left(); x <= range.right(); ++x) {
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+      painter.drawImage(QPoint(x * mTileSize, y * mTileSize) + offset,
+                        getTile(x, y));
+    }
+  }
+  painter.restore();
+}
+
+bool GraphicsTileCache::prefetch(const QRect&      viewportRect,
+                                 const QTransform& viewportTransform,
+                                 int               maxTiles) noexcept {
+  // render missing tiles in a one tile wide ring around the visible area
+  QRect range =
+      getTileRange(viewportRect, viewportTransform).adjusted(-1, -1, 1, 1);
+  int rendered = 0;
+  for (int x = range.left(); x <= range.right(); ++x) {
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+      if (!mTiles.contains(toKey(x, y))) {
+        if (rendered >= maxTiles) {
+          return true;  // more tiles to prefetch
+        }
+        getTile(x, y);
+        ++rendered;
+      }
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QRect GraphicsTileCache::getTileRange(
+    const QRect& viewportRect, const QTransform& viewportTransform) const
+    noexcept {
+  // viewport coordinates -> tile coordinates
+  QRectF rect =
+      QRectF(viewportRect).translated(-getTileOffset(viewportTransform));
+  return QRect(QPoint(qFloor(rect.left() / mTileSize),
+                      qFloor(rect.top() / mTileSize)),
+               QPoint(qFloor(rect.right() / mTileSize),
+                      qFloor(rect.bottom() / mTileSize)));
+}
+
+const QImage& GraphicsTileCache::getTile(int x, int y) noexcept {
+  quint64 key = toKey(x, y);
+  auto    it  = mTiles.find(key);
+  if (it == mTiles.end()) {
+    QImage image(QSize(mTileSize, mTileSize) * mDevicePixelRatio,
+                 QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(mDevicePixelRatio);
+    image.fill(Qt::transparent);
+    if (mScene) {
+      QRectF   tileRect(x * mTileSize, y * mTileSize, mTileSize, mTileSize);
+      QPainter painter(&image);
+      painter.setRenderHints(QPainter::Antialiasing |
+                             QPainter::SmoothPixmapTransform);
+      mScene->render(&painter, QRectF(0, 0, mTileSize, mTileSize),
+                     mTileTransform.inverted().mapRect(tileRect),
+                     Qt::IgnoreAspectRatio);
+    }
+    it = mTiles.insert(key, image);
+  }
+  return *it;
+}
+
+void GraphicsTileCache::removeFarTiles(const QRect& range) noexcept {
+  if (mTiles.count() <= mMaxTiles) {
+    return;
+  }
+
+  // remove all tiles which are not visible and not directly adjacent to the
+  // visible area
+  QRect keep = range.adjusted(-1, -1, 1, 1);
+  foreach (quint64 key, mTiles.keys()) {
+    int x = static_cast<qint32>(key >> 32);
+    int y = static_cast<qint32>(key & 0xFFFFFFFF);
+    if (!keep.contains(x, y)) {
+      mTiles.remove(key);
+    }
+  }
+}
+
+QPoint GraphicsTileCache::getTileOffset(
+    const QTransform& viewportTransform) noexcept {
+  // Position of the tile coordinates origin in the viewport. The viewport
+  // transform only differs from the tile transform by its translation (view
+  // translation and scrolling), which is rounded to draw the tiles aligned to
+  // the pixels.
+  return QPoint(qRound(viewportTransform.dx()), qRound(viewportTransform.dy()));
+}
+
+quint64 GraphicsTileCache::toKey(int x, int y) noexcept {
+  return (static_cast<quint64>(static_cast<quint32>(x)) << 32) |
+         static_cast<quint32>(y);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_GRAPHICSTILECACHE_H
+#define LIBREPCB_GRAPHICSTILECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class GraphicsTileCache
+ ******************************************************************************/
+
+/**
+ * @brief Caches the rendered items of a QGraphicsScene in square tiles
+ *
+ * The tiles are aligned to the device coordinates of the current view
+ * transformation (i.e. zoom level) without any translation, so when panning
+ * the view, already rendered tiles can just be copied to the viewport instead
+ * of painting all items again. Tiles are invalidated only where the scene has changed (see
+ * QGraphicsScene::changed()), and all tiles are discarded when the zoom level
+ * changes. Appearance changes which are not reported by the items themselves
+ * (e.g. a changed layer color) need to invalidate the cache explicitly.
+ *
+ * @note Painting QGraphicsItems is not thread-safe (they access the model
+ *       while painting), so the tiles are rendered in the GUI thread. Tiles
+ *       around the visible area can be prefetched when the event loop is idle
+ *       (see #prefetch()).
+ */
+class GraphicsTileCache final {
+public:
+  // Constructors / Destructor
+  GraphicsTileCache() = delete;
+  GraphicsTileCache(const GraphicsTileCache& other) = delete;
+  explicit GraphicsTileCache(int tileSizePx = 256,
+                             int maxTiles   = 256) noexcept;
+  ~GraphicsTileCache() noexcept;
+
+  // Getters
+  const QTransform& getTransform() const noexcept { return mTransform; }
+  int               getTileCount() const noexcept { return mTiles.count(); }
+
+  // Setters
+  void setScene(QGraphicsScene* scene) noexcept;
+  void setTransform(const QTransform& transform,
+                    qreal             devicePixelRatio) noexcept;
+
+  // General Methods
+  void invalidate() noexcept;
+  void invalidate(const QRectF& sceneRect) noexcept;
+  void draw(QPainter& painter, const QRect& viewportRect,
+            const QTransform& viewportTransform) noexcept;
+  bool prefetch(const QRect& viewportRect, const QTransform& viewportTransform,
+                int maxTiles) noexcept;
+
+  // Operator Overloadings
+  GraphicsTileCache& operator=(const GraphicsTileCache& rhs) = delete;
+
+private:  // Methods
+  QRect          getTileRange(const QRect&      viewportRect,
+                              const QTransform& viewportTransform) const
+      noexcept;
+  const QImage&  getTile(int x, int y) noexcept;
+  void           removeFarTiles(const QRect& range) noexcept;
+  static QPoint  getTileOffset(const QTransform& viewportTransform) noexcept;
+  static quint64 toKey(int x, int y) noexcept;
+
+private:  // Data
+  int                    mTileSize;
+  int                    mMaxTiles;
+  QGraphicsScene*        mScene;
+  QTransform             mTransform;      ///< View transform w/o scrolling
+  QTransform             mTileTransform;  ///< Scene to tile coordinates
+  qreal                  mDevicePixelRatio;
+  QHash<quint64, QImage> mTiles;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_GRAPHICSTILECACHE_H
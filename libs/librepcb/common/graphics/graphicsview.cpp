@@ -25,6 +25,7 @@
 #include "../gridproperties.h"
 #include "QtOpenGL"
 #include "graphicsscene.h"
+#include "graphicstilecache.h"
 #include "if_graphicsvieweventhandler.h"
 
 #include <QtCore>
@@ -48,9 +49,13 @@ GraphicsView::GraphicsView(QWidget*                     parent,
     mGridProperties(new GridProperties()),
     mOriginCrossVisible(true),
     mUseOpenGl(false),
-    mPanningActive(false) {
+    mPanningActive(false),
+    mTileCache(nullptr),
+    mTilePrefetchTimer(new QTimer(this)) {
   setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-  setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+  // Only repaint the changed regions instead of the whole viewport, which
+  // makes e.g. moving a single item on a large board much faster.
+  setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
   setOptimizationFlags(QGraphicsView::DontSavePainterState);
   setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
   setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
@@ -60,9 +65,18 @@ GraphicsView::GraphicsView(QWidget*                     parent,
   mZoomAnimation = new QVariantAnimation();
   connect(mZoomAnimation, &QVariantAnimation::valueChanged, this,
           &GraphicsView::zoomAnimationValueChanged);
+  connect(mZoomAnimation, &QVariantAnimation::finished, this,
+          &GraphicsView::zoomAnimationFinished);
+
+  mTilePrefetchTimer->setSingleShot(true);
+  mTilePrefetchTimer->setInterval(0);  // as soon as the event loop is idle
+  connect(mTilePrefetchTimer, &QTimer::timeout, this,
+          &GraphicsView::prefetchTiles);
 }
 
 GraphicsView::~GraphicsView() noexcept {
+  delete mTileCache;
+  mTileCache = nullptr;
   delete mZoomAnimation;
   mZoomAnimation = nullptr;
   delete mGridProperties;
@@ -92,6 +106,18 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept {
   }
 }
 
+void GraphicsView::setTileCacheEnabled(bool enabled) noexcept {
+  if (enabled && (!mTileCache)) {
+    mTileCache = new GraphicsTileCache();
+    mTileCache->setScene(mScene);
+  } else if ((!enabled) && mTileCache) {
+    delete mTileCache;
+    mTileCache = nullptr;
+  }
+  updateSceneChangedConnection();
+  viewport()->update();
+}
+
 void GraphicsView::setGridProperties(
     const GridProperties& properties) noexcept {
   *mGridProperties = properties;
@@ -99,9 +125,17 @@ void GraphicsView::setGridProperties(
 }
 
 void GraphicsView::setScene(GraphicsScene* scene) noexcept {
-  if (mScene) mScene->removeEventFilter(this);
+  if (mScene) {
+    mScene->removeEventFilter(this);
+    disconnect(mScene, &GraphicsScene::changed, this,
+               &GraphicsView::sceneChanged);
+  }
   mScene = scene;
-  if (mScene) mScene->installEventFilter(this);
+  if (mScene) {
+    mScene->installEventFilter(this);
+  }
+  updateSceneChangedConnection();
+  if (mTileCache) mTileCache->setScene(mScene);
   QGraphicsView::setScene(mScene);
 }
 
@@ -181,6 +215,7 @@ void GraphicsView::zoomAll() noexcept {
   mZoomAnimation->setEasingCurve(QEasingCurve::InOutCubic);
   mZoomAnimation->setStartValue(getVisibleSceneRect());
   mZoomAnimation->setEndValue(rect);
+  setAntialiasingEnabled(false);  // for a smooth animation
   mZoomAnimation->start();
 }
 
@@ -193,6 +228,33 @@ void GraphicsView::zoomAnimationValueChanged(const QVariant& value) noexcept {
     fitInView(value.toRectF(), Qt::KeepAspectRatio);  // zoom smoothly
 }
 
+void GraphicsView::zoomAnimationFinished() noexcept {
+  setAntialiasingEnabled(true);
+}
+
+void GraphicsView::invalidateTileCache() noexcept {
+  if (mTileCache) {
+    mTileCache->invalidate();
+    viewport()->update();
+  }
+}
+
+void GraphicsView::sceneChanged(const QList<QRectF>& region) noexcept {
+  if (mTileCache) {
+    foreach (const QRectF& rect, region) { mTileCache->invalidate(rect); }
+  }
+}
+
+void GraphicsView::prefetchTiles() noexcept {
+  if (mTileCache && mScene &&
+      (mTileCache->getTransform() == transform())) {
+    // render only a few tiles at once to keep the GUI responsive
+    if (mTileCache->prefetch(viewport()->rect(), viewportTransform(), 4)) {
+      mTilePrefetchTimer->start();
+    }
+  }
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsView
  ******************************************************************************/
@@ -206,6 +268,7 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event) {
       if (e->button() == Qt::MiddleButton) {
         mCursorBeforePanning = cursor();
         setCursor(Qt::ClosedHandCursor);
+        setAntialiasingEnabled(false);  // for smooth panning
       } else if (mEventHandlerObject) {
         mEventHandlerObject->graphicsViewEventHandler(event);
       }
@@ -217,6 +280,7 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event) {
       Q_ASSERT(e);
       if (e->button() == Qt::MiddleButton) {
         setCursor(mCursorBeforePanning);
+        setAntialiasingEnabled(true);
       } else if (mEventHandlerObject) {
         mEventHandlerObject->graphicsViewEventHandler(event);
       }
@@ -277,7 +341,7 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
   painter->setPen(gridPen);
   painter->setBrush(Qt::NoBrush);
   qreal gridIntervalPixels = mGridProperties->getInterval()->toPx();
-  qreal scaleFactor        = width() / rect.width();
+  qreal scaleFactor        = painter->transform().m11();
   if (gridIntervalPixels * scaleFactor >= (qreal)5) {
     qreal left, right, top, bottom;
     left   = qFloor(rect.left() / gridIntervalPixels) * gridIntervalPixels;
@@ -311,6 +375,34 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
   }
 }
 
+void GraphicsView::paintEvent(QPaintEvent* event) {
+  if ((!mTileCache) || (!mScene)) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+
+  if (mTileCache->getTransform() != transform()) {
+    // The zoom level has changed (maybe it is still changing, e.g. during the
+    // zoom animation), so paint directly and render the tiles afterwards.
+    mTileCache->setTransform(transform(), viewport()->devicePixelRatio());
+    QGraphicsView::paintEvent(event);
+    mTilePrefetchTimer->start();
+    return;
+  }
+
+  QPainter   painter(viewport());
+  QTransform viewportTrans = viewportTransform();
+  QRectF     exposedRect =
+      viewportTrans.inverted().mapRect(QRectF(event->rect()));
+  painter.setRenderHints(renderHints());
+  painter.setTransform(viewportTrans);
+  drawBackground(&painter, exposedRect);
+  mTileCache->draw(painter, event->rect(), viewportTrans);
+  painter.setTransform(viewportTrans);
+  drawForeground(&painter, exposedRect);
+  mTilePrefetchTimer->start();
+}
+
 void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
   Q_UNUSED(rect);
 
@@ -325,6 +417,31 @@ void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void GraphicsView::setAntialiasingEnabled(bool enabled) noexcept {
+  // Antialiasing is expensive, but only needed for a still image. So it's
+  // temporarily disabled while the view is moving (zoom animation, panning).
+  // Note that QGraphicsView::setRenderHint() repaints the viewport if needed.
+  setRenderHint(QPainter::Antialiasing, enabled);
+}
+
+void GraphicsView::updateSceneChangedConnection() noexcept {
+  // Connecting to QGraphicsScene::changed() disables the direct item-to-view
+  // update optimization of Qt (all views are then updated by the scene with
+  // the accumulated change regions), so only connect it if the tile cache is
+  // really used.
+  if (!mScene) return;
+  disconnect(mScene, &GraphicsScene::changed, this,
+             &GraphicsView::sceneChanged);
+  if (mTileCache) {
+    connect(mScene, &GraphicsScene::changed, this,
+            &GraphicsView::sceneChanged);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
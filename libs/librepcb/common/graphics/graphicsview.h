@@ -35,6 +35,7 @@ namespace librepcb {
 
 class IF_GraphicsViewEventHandler;
 class GraphicsScene;
+class GraphicsTileCache;
 class GridProperties;
 
 /*******************************************************************************
@@ -58,12 +59,14 @@ public:
   GraphicsScene*        getScene() const noexcept { return mScene; }
   QRectF                getVisibleSceneRect() const noexcept;
   bool                  getUseOpenGl() const noexcept { return mUseOpenGl; }
+  bool isTileCacheEnabled() const noexcept { return mTileCache != nullptr; }
   const GridProperties& getGridProperties() const noexcept {
     return *mGridProperties;
   }
 
   // Setters
   void setUseOpenGl(bool useOpenGl) noexcept;
+  void setTileCacheEnabled(bool enabled) noexcept;
   void setGridProperties(const GridProperties& properties) noexcept;
   void setScene(GraphicsScene* scene) noexcept;
   void setVisibleSceneRect(const QRectF& rect) noexcept;
@@ -76,6 +79,15 @@ public:
                                bool mapToGrid) const noexcept;
   void  handleMouseWheelEvent(QGraphicsSceneWheelEvent* event) noexcept;
 
+  /**
+   * @brief Discard all cached tiles and repaint the whole viewport
+   *
+   * Must be called whenever the appearance of items changes without the
+   * items calling QGraphicsItem::update(), for example when the color or
+   * visibility of a layer changes. Does nothing if the tile cache is disabled.
+   */
+  void invalidateTileCache() noexcept;
+
 public slots:
 
   // Public Slots
@@ -95,6 +107,9 @@ private slots:
 
   // Private Slots
   void zoomAnimationValueChanged(const QVariant& value) noexcept;
+  void zoomAnimationFinished() noexcept;
+  void sceneChanged(const QList<QRectF>& region) noexcept;
+  void prefetchTiles() noexcept;
 
 private:
   // make some methods inaccessible...
@@ -105,6 +120,11 @@ private:
   bool eventFilter(QObject* obj, QEvent* event);
   void drawBackground(QPainter* painter, const QRectF& rect);
   void drawForeground(QPainter* painter, const QRectF& rect);
+  void paintEvent(QPaintEvent* event);
+
+  // Private Methods
+  void setAntialiasingEnabled(bool enabled) noexcept;
+  void updateSceneChangedConnection() noexcept;
 
   // General Attributes
   IF_GraphicsViewEventHandler* mEventHandlerObject;
@@ -115,6 +135,8 @@ private:
   bool                         mUseOpenGl;
   volatile bool                mPanningActive;
   QCursor                      mCursorBeforePanning;
+  GraphicsTileCache*           mTileCache;  ///< nullptr if disabled
+  QTimer*                      mTilePrefetchTimer;
 
   // Static Variables
   static constexpr qreal sZoomStepFactor = 1.3;
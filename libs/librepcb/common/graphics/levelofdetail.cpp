@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "levelofdetail.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Static Variables
+ ******************************************************************************/
+
+constexpr qreal LevelOfDetail::sMinDetailSizePx;
+constexpr qreal LevelOfDetail::sMinTextSizePx;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LevelOfDetail::LevelOfDetail(const QPainter&                 painter,
+                             const QStyleOptionGraphicsItem& option) noexcept
+  : mLod(option.levelOfDetailFromTransform(painter.worldTransform())),
+    mIsPrinter(painter.device() &&
+               (painter.device()->devType() == QInternal::Printer)) {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool LevelOfDetail::isTooSmall(const QRectF& rect) const noexcept {
+  return isTooSmall(qMax(rect.width(), rect.height()));
+}
+
+bool LevelOfDetail::isTooSmall(qreal sizePx) const noexcept {
+  return (!mIsPrinter) && (sizePx * mLod < sMinDetailSizePx);
+}
+
+bool LevelOfDetail::isTextVisible(qreal textHeightPx) const noexcept {
+  return mIsPrinter || (textHeightPx * mLod >= sMinTextSizePx);
+}
+
+int LevelOfDetail::getZoomBucket() const noexcept {
+  // one bucket per power of two, so cached renderings (e.g. rasterized
+  // planes) only need to be updated after zooming by a factor of two
+  return qFloor(std::log2(qMax(mLod, qreal(1e-6))));
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void LevelOfDetail::drawProxy(QPainter& painter, const QRectF& rect,
+                              const QColor& color) const noexcept {
+  painter.setPen(Qt::NoPen);
+  painter.setBrush(color);
+  painter.drawRect(rect);
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+qreal LevelOfDetail::getZoomBucketScale(int bucket) noexcept {
+  return std::pow(qreal(2), bucket);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
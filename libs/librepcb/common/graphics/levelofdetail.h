@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LEVELOFDETAIL_H
+#define LIBREPCB_LEVELOFDETAIL_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class LevelOfDetail
+ ******************************************************************************/
+
+/**
+ * @brief Helper to decide how detailed a graphics item needs to be painted
+ *
+ * Graphics items create an instance of this class at the beginning of their
+ * QGraphicsItem::paint() implementation. If an item (or a part of it) is
+ * smaller than #sMinDetailSizePx pixels on the screen, it should draw a
+ * simplified proxy (e.g. its bounding rect) instead of the full geometry.
+ * Texts smaller than #sMinTextSizePx pixels should not be drawn at all.
+ *
+ * When painting on a printer (e.g. PDF export), nothing is ever simplified.
+ */
+class LevelOfDetail final {
+public:
+  // Constructors / Destructor
+  LevelOfDetail() = delete;
+  LevelOfDetail(const LevelOfDetail& other) noexcept = default;
+  LevelOfDetail(const QPainter& painter,
+                const QStyleOptionGraphicsItem& option) noexcept;
+  ~LevelOfDetail() noexcept = default;
+
+  // Getters
+  qreal getLod() const noexcept { return mLod; }
+  bool  isPrinter() const noexcept { return mIsPrinter; }
+  bool  isTooSmall(const QRectF& rect) const noexcept;
+  bool  isTooSmall(qreal sizePx) const noexcept;
+  bool  isTextVisible(qreal textHeightPx) const noexcept;
+  int   getZoomBucket() const noexcept;
+
+  // General Methods
+  void drawProxy(QPainter& painter, const QRectF& rect,
+                 const QColor& color) const noexcept;
+
+  // Static Methods
+  static qreal getZoomBucketScale(int bucket) noexcept;
+
+  // Operator Overloadings
+  LevelOfDetail& operator=(const LevelOfDetail& rhs) noexcept = default;
+
+  // Static Variables
+  static constexpr qreal sMinDetailSizePx = 3;  ///< Minimum detailed size
+  static constexpr qreal sMinTextSizePx   = 1;  ///< Minimum text height
+
+private:  // Data
+  qreal mLod;
+  bool  mIsPrinter;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_LEVELOFDETAIL_H
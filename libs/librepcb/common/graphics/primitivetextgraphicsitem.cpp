@@ -23,6 +23,7 @@
 #include "primitivetextgraphicsitem.h"
 
 #include "../application.h"
+#include "levelofdetail.h"
 
 #include <QtCore>
 #include <QtWidgets>
@@ -124,6 +125,11 @@ void PrimitiveTextGraphicsItem::paint(QPainter*                       painter,
                                       const QStyleOptionGraphicsItem* option,
                                       QWidget* widget) noexcept {
   Q_UNUSED(widget);
+  const LevelOfDetail lod(*painter, *option);
+  if (!lod.isTextVisible(mFont.pixelSize())) {
+    return;  // text is smaller than a pixel, no need to draw it
+  }
+
   painter->setFont(mFont);
   if (option->state.testFlag(QStyle::State_Selected)) {
     painter->setPen(mPenHighlighted);
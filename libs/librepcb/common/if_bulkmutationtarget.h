@@ -0,0 +1,66 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef LIBREPCB_IF_BULKMUTATIONTARGET_H
+#define LIBREPCB_IF_BULKMUTATIONTARGET_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Interface IF_BulkMutationTarget
+ ******************************************************************************/
+
+/**
+ * @brief The IF_BulkMutationTarget class is implemented by objects which can
+ *        coalesce the notifications of many modifications
+ *
+ * Between #beginBulkMutation() and #endBulkMutation(), the target may defer
+ * expensive per-item updates (e.g. repainting graphics items or rebuilding air
+ * wires). All deferred updates must be processed once when the outermost bulk
+ * mutation ends. Calls may be nested.
+ *
+ * @see ::librepcb::UndoCommandGroup::addBulkMutationTarget()
+ */
+class IF_BulkMutationTarget {
+public:
+  // Constructors / Destructor
+  explicit IF_BulkMutationTarget() noexcept {}
+  virtual ~IF_BulkMutationTarget() noexcept {}
+
+  virtual void beginBulkMutation() noexcept = 0;
+  virtual void endBulkMutation() noexcept   = 0;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_IF_BULKMUTATIONTARGET_H
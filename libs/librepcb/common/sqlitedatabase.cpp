@@ -59,12 +59,15 @@ SQLiteDatabase::TransactionScopeGuard::~TransactionScopeGuard() noexcept {
  *  Constructors / Destructor
  ******************************************************************************/
 
-SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
+SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, bool readOnly)
   : QObject(nullptr)  //, mNestedTransactionCount(0)
 {
   // create database (use random UUID as connection name)
   mDb = QSqlDatabase::addDatabase("QSQLITE", Uuid::createRandom().toStr());
   mDb.setDatabaseName(filepath.toStr());
+  if (readOnly) {
+    mDb.setConnectOptions("QSQLITE_OPEN_READONLY");
+  }
 
   // check if database is valid
   if (!mDb.isValid()) {
@@ -80,9 +83,12 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
                            .arg(filepath.toNative()));
   }
 
-  // set SQLite options
+  // set SQLite options (the journal mode is persistent, so read-only
+  // connections use WAL as well once it was enabled by a writer)
   exec("PRAGMA foreign_keys = ON");  // can throw
-  enableSqliteWriteAheadLogging();   // can throw
+  if (!readOnly) {
+    enableSqliteWriteAheadLogging();  // can throw
+  }
 
   // check if all required features are available
   Q_ASSERT(mDb.driver() && mDb.driver()->hasFeature(QSqlDriver::Transactions));
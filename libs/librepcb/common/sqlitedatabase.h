@@ -66,7 +66,7 @@ public:
   // Constructors / Destructor
   SQLiteDatabase()                            = delete;
   SQLiteDatabase(const SQLiteDatabase& other) = delete;
-  SQLiteDatabase(const FilePath& filepath);
+  SQLiteDatabase(const FilePath& filepath, bool readOnly = false);
   ~SQLiteDatabase() noexcept;
 
   // SQL Commands
@@ -75,6 +75,10 @@ void UndoCommand::redo() {
   mRedoCount++;
 }
 
+qint64 UndoCommand::getMemoryUsage() const noexcept {
+  return sizeof(UndoCommand) + mText.capacity() * sizeof(QChar);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
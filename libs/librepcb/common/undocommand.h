@@ -80,6 +80,18 @@ public:
    */
   bool isCurrentlyExecuted() const noexcept { return mRedoCount > mUndoCount; }
 
+  /**
+   * @brief Get the approximate amount of memory used by this command
+   *
+   * Used by #librepcb::UndoStack to limit the memory used by the undo history.
+   * The default implementation only accounts for the base class, so derived
+   * classes which store large data (e.g. paths or child commands) should
+   * override this method and add their own data.
+   *
+   * @return Number of bytes (not necessarily exact)
+   */
+  virtual qint64 getMemoryUsage() const noexcept;
+
   // General Methods
 
   /**
@@ -132,6 +144,63 @@ protected:
    */
   virtual void performRedo() = 0;
 
+  /**
+   * @brief Get the memory usage of an item which was detached from its parent
+   *        by this command
+   *
+   * Items removed from their parent (e.g. from a board) are owned by the undo
+   * commands which reference them, so they belong to the undo history.
+   *
+   * @param item          The item added or removed by this command (may be
+   *                      nullptr)
+   * @param whenExecuted  True if the item is detached while this command is
+   *                      executed (remove commands), false if it is detached
+   *                      while this command is undone (add commands)
+   *
+   * @return Memory usage of the item, or 0 if it is currently not detached
+   */
+  template <typename T>
+  qint64 getDetachedItemMemoryUsage(const T* item, bool whenExecuted) const
+      noexcept {
+    if (item && (isCurrentlyExecuted() == whenExecuted)) {
+      return item->getMemoryUsage();
+    } else {
+      return 0;
+    }
+  }
+
+  /**
+   * @copydoc getDetachedItemMemoryUsage(const T*, bool) const
+   */
+  template <typename T>
+  qint64 getDetachedItemMemoryUsage(const QList<T*>& items,
+                                    bool whenExecuted) const noexcept {
+    qint64 usage = 0;
+    foreach (const T* item, items) {
+      usage += getDetachedItemMemoryUsage(item, whenExecuted);
+    }
+    return usage;
+  }
+
+  /**
+   * @brief Release an item referenced by this command
+   *
+   * Must be called once for every item registered with
+   * `registerUndoCommand()`, typically in the destructor. The last command
+   * referencing the item deletes it if it is not contained in its parent
+   * anymore, i.e. if the item was removed and nothing can add it again.
+   *
+   * @param item          The item to release
+   * @param parentItems   The items currently contained in the parent of the
+   *                      item (e.g. all holes of the board)
+   */
+  template <typename T, typename TContainer>
+  static void releaseItem(T& item, const TContainer& parentItems) noexcept {
+    if (item.unregisterUndoCommand() && (!parentItems.contains(&item))) {
+      delete &item;
+    }
+  }
+
 private:
   QString mText;
   bool    mIsExecuted;  ///< @brief Shows whether #execute() was called or not
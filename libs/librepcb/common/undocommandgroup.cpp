@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "undocommandgroup.h"
 
+#include "if_bulkmutationtarget.h"
+#include "scopeguard.h"
 #include "scopeguardlist.h"
 
 #include <QtCore>
@@ -60,6 +62,8 @@ bool UndoCommandGroup::appendChild(UndoCommand* cmd) {
   }
 
   if (wasEverExecuted()) {
+    beginBulkMutation();
+    auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
     if (cmdScopeGuard->execute()) {  // can throw
       mChilds.append(cmdScopeGuard.take());
       return true;
@@ -73,11 +77,28 @@ bool UndoCommandGroup::appendChild(UndoCommand* cmd) {
   return false;
 }
 
+qint64 UndoCommandGroup::getMemoryUsage() const noexcept {
+  qint64 usage = UndoCommand::getMemoryUsage();
+  usage += mChilds.count() * sizeof(UndoCommand*);
+  foreach (const UndoCommand* cmd, mChilds) { usage += cmd->getMemoryUsage(); }
+  return usage;
+}
+
+void UndoCommandGroup::addBulkMutationTarget(
+    IF_BulkMutationTarget& target) noexcept {
+  if (!mBulkMutationTargets.contains(&target)) {
+    mBulkMutationTargets.append(&target);
+  }
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
 
 bool UndoCommandGroup::performExecute() {
+  beginBulkMutation();
+  auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
+
   bool           modified = false;
   ScopeGuardList sgl(mChilds.count());
   for (int i = 0; i < mChilds.count(); ++i) {  // from bottom to top
@@ -92,6 +113,9 @@ bool UndoCommandGroup::performExecute() {
 }
 
 void UndoCommandGroup::performUndo() {
+  beginBulkMutation();
+  auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
+
   ScopeGuardList sgl(mChilds.count());
   for (int i = mChilds.count() - 1; i >= 0; --i) {  // from top to bottom
     UndoCommand* cmd = mChilds.at(i);
@@ -102,6 +126,9 @@ void UndoCommandGroup::performUndo() {
 }
 
 void UndoCommandGroup::performRedo() {
+  beginBulkMutation();
+  auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
+
   ScopeGuardList sgl(mChilds.count());
   for (int i = 0; i < mChilds.count(); ++i) {  // from bottom to top
     UndoCommand* cmd = mChilds.at(i);
@@ -130,6 +157,19 @@ void UndoCommandGroup::execNewChildCmd(UndoCommand* cmd) {
   }
 }
 
+void UndoCommandGroup::beginBulkMutation() noexcept {
+  foreach (IF_BulkMutationTarget* target, mBulkMutationTargets) {
+    target->beginBulkMutation();
+  }
+}
+
+void UndoCommandGroup::endBulkMutation() noexcept {
+  // in reverse order, like nested scopes
+  for (int i = mBulkMutationTargets.count() - 1; i >= 0; --i) {
+    mBulkMutationTargets.at(i)->endBulkMutation();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -32,6 +32,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+class IF_BulkMutationTarget;
+
 /*******************************************************************************
  *  Class UndoCommandGroup
  ******************************************************************************/
@@ -56,6 +58,9 @@ public:
   // Getters
   int getChildCount() const noexcept { return mChilds.count(); }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // General Methods
 
   /**
@@ -75,6 +80,18 @@ public:
    */
   bool appendChild(UndoCommand* cmd);
 
+  /**
+   * @brief Coalesce the notifications of all child commands on a target
+   *
+   * While the child commands are executed, undone or redone, the target is in
+   * bulk mutation mode. So it processes its updates only once for the whole
+   * group instead of once per child command (e.g. a board repaints moved
+   * traces and rebuilds air wires only once after moving 1000 items).
+   *
+   * @param target    The target to notify (must outlive this command)
+   */
+  void addBulkMutationTarget(IF_BulkMutationTarget& target) noexcept;
+
   // Operator Overloadings
   UndoCommandGroup& operator=(const UndoCommandGroup& rhs) = delete;
 
@@ -97,6 +114,21 @@ protected:
    */
   void execNewChildCmd(UndoCommand* cmd);
 
+  /**
+   * @brief Put all targets added with #addBulkMutationTarget() into bulk
+   *        mutation mode
+   *
+   * Derived classes which override #performExecute() should call this at the
+   * beginning of it, and #endBulkMutation() at the end (also in case of
+   * exceptions).
+   */
+  void beginBulkMutation() noexcept;
+
+  /**
+   * @brief End the bulk mutation started with #beginBulkMutation()
+   */
+  void endBulkMutation() noexcept;
+
 private:
   /**
    * @brief All child commands
@@ -105,6 +137,8 @@ private:
    * command is at the top of the list.
    */
   QList<UndoCommand*> mChilds;
+
+  QList<IF_BulkMutationTarget*> mBulkMutationTargets;
 };
 
 /*******************************************************************************
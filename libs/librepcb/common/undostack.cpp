@@ -77,7 +77,11 @@ UndoStack::UndoStack() noexcept
   : QObject(nullptr),
     mCurrentIndex(0),
     mCleanIndex(0),
-    mActiveCommandGroup(nullptr) {
+    mActiveCommandGroup(nullptr),
+    mBulkMutationDepth(0),
+    mStateModifiedPending(false),
+    mMemoryUsage(0),
+    mMemoryLimit(0) {
 }
 
 UndoStack::~UndoStack() noexcept {
@@ -130,6 +134,11 @@ void UndoStack::setClean() noexcept {
   emit cleanChanged(true);
 }
 
+void UndoStack::setMemoryLimit(qint64 bytes) noexcept {
+  mMemoryLimit = qMax(bytes, qint64(0));
+  trimToMemoryLimit();
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -159,12 +168,15 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
     // --> in reverse order (from top to bottom)!
     while (mCurrentIndex < mCommands.count()) {
       delete mCommands.takeLast();
+      mMemoryUsage -= mCommandMemoryUsage.takeLast();
     }
     Q_ASSERT(mCurrentIndex == mCommands.count());
 
     // add command to the command stack
     mCommands.append(
         cmdScopeGuard.take());  // move ownership of "cmd" to "mCommands"
+    mCommandMemoryUsage.append(0);
+    updateMemoryUsage(mCurrentIndex);
     mCurrentIndex++;
 
     // emit signals
@@ -173,7 +185,10 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
     emit canUndoChanged(true);
     emit canRedoChanged(false);
     emit cleanChanged(false);
-    emit stateModified();
+    notifyStateModified();
+
+    // delete the oldest commands if the history gets too large
+    trimToMemoryLimit();
   } else {
     // the command has done nothing, so we will just discard it
     cmd->undo();  // only to be sure the command has executed nothing...
@@ -215,7 +230,7 @@ bool UndoStack::appendToCmdGroup(UndoCommand* cmd) {
       mActiveCommandGroup->appendChild(cmdScopeGuard.take());  // can throw
 
   // emit signals
-  emit stateModified();
+  notifyStateModified();
   return commandHasDoneSomething;
 }
 
@@ -236,6 +251,10 @@ bool UndoStack::commitCmdGroup() {
   // the currently active command group
   mActiveCommandGroup = nullptr;
 
+  // the group has grown since it was pushed, update the memory accounting
+  updateMemoryUsage(mCurrentIndex - 1);
+  trimToMemoryLimit();
+
   // emit signals
   emit canUndoChanged(canUndo());
   emit commandGroupEnded();
@@ -256,6 +275,7 @@ void UndoStack::abortCmdGroup() {
     mCurrentIndex--;
     delete mCommands.takeLast();  // delete and remove the aborted command group
                                   // from the stack
+    mMemoryUsage -= mCommandMemoryUsage.takeLast();
   } catch (Exception& e) {
     qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
     throw;
@@ -268,7 +288,7 @@ void UndoStack::abortCmdGroup() {
   emit canRedoChanged(false);
   emit cleanChanged(isClean());
   emit commandGroupAborted();  // this is important!
-  emit stateModified();
+  notifyStateModified();
 }
 
 void UndoStack::undo() {
@@ -279,6 +299,7 @@ void UndoStack::undo() {
   try {
     mCommands[mCurrentIndex - 1]->undo();  // can throw (but should usually not)
     mCurrentIndex--;
+    updateMemoryUsage(mCurrentIndex);  // undo may attach or detach items
   } catch (Exception& e) {
     qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
     throw;
@@ -290,7 +311,10 @@ void UndoStack::undo() {
   emit canUndoChanged(canUndo());
   emit canRedoChanged(canRedo());
   emit cleanChanged(isClean());
-  emit stateModified();
+  notifyStateModified();
+
+  // delete the oldest commands if the history got too large
+  trimToMemoryLimit();
 }
 
 void UndoStack::redo() {
@@ -300,6 +324,7 @@ void UndoStack::redo() {
 
   try {
     mCommands[mCurrentIndex]->redo();  // can throw (but should usually not)
+    updateMemoryUsage(mCurrentIndex);  // redo may attach or detach items
     mCurrentIndex++;
   } catch (Exception& e) {
     qCritical() << "UndoCommand::redo() has thrown an exception:" << e.getMsg();
@@ -312,7 +337,10 @@ void UndoStack::redo() {
   emit canUndoChanged(canUndo());
   emit canRedoChanged(canRedo());
   emit cleanChanged(isClean());
-  emit stateModified();
+  notifyStateModified();
+
+  // delete the oldest commands if the history got too large
+  trimToMemoryLimit();
 }
 
 void UndoStack::clear() noexcept {
@@ -334,6 +362,8 @@ void UndoStack::clear() noexcept {
     delete mCommands.takeLast();
   }
 
+  mCommandMemoryUsage.clear();
+  mMemoryUsage        = 0;
   mCurrentIndex       = 0;
   mCleanIndex         = 0;
   mActiveCommandGroup = nullptr;
@@ -346,6 +376,56 @@ void UndoStack::clear() noexcept {
   emit cleanChanged(true);
 }
 
+/*******************************************************************************
+ *  Inherited from IF_BulkMutationTarget
+ ******************************************************************************/
+
+void UndoStack::beginBulkMutation() noexcept {
+  ++mBulkMutationDepth;
+}
+
+void UndoStack::endBulkMutation() noexcept {
+  Q_ASSERT(mBulkMutationDepth > 0);
+  if ((--mBulkMutationDepth == 0) && mStateModifiedPending) {
+    mStateModifiedPending = false;
+    emit stateModified();
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void UndoStack::notifyStateModified() noexcept {
+  if (mBulkMutationDepth > 0) {
+    mStateModifiedPending = true;
+  } else {
+    emit stateModified();
+  }
+}
+
+void UndoStack::updateMemoryUsage(int index) noexcept {
+  qint64 usage = mCommands.at(index)->getMemoryUsage();
+  mMemoryUsage += usage - mCommandMemoryUsage.at(index);
+  mCommandMemoryUsage[index] = usage;
+}
+
+void UndoStack::trimToMemoryLimit() noexcept {
+  // Delete the oldest commands, but always keep the last executed command (and
+  // all commands which can be redone).
+  while ((mMemoryLimit > 0) && (mMemoryUsage > mMemoryLimit) &&
+         (mCurrentIndex > 1)) {
+    delete mCommands.takeFirst();
+    mMemoryUsage -= mCommandMemoryUsage.takeFirst();
+    mCurrentIndex--;
+    if (mCleanIndex > 0) {
+      mCleanIndex--;
+    } else {
+      mCleanIndex = -1;  // the clean state can no longer be reached
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "exceptions.h"
+#include "if_bulkmutationtarget.h"
 
 #include <QtCore>
 
@@ -117,7 +118,7 @@ private:
  * destroying an #UndoStack object while the current index is not the index of
  * the last command?
  */
-class UndoStack final : public QObject {
+class UndoStack final : public QObject, public IF_BulkMutationTarget {
   Q_OBJECT
 
 public:
@@ -180,6 +181,20 @@ public:
    */
   bool isCommandGroupActive() const noexcept;
 
+  /**
+   * @brief Get the approximate memory used by all commands in the stack
+   *
+   * @return Number of bytes (see UndoCommand#getMemoryUsage())
+   */
+  qint64 getMemoryUsage() const noexcept { return mMemoryUsage; }
+
+  /**
+   * @brief Get the memory limit (see #setMemoryLimit())
+   *
+   * @return Number of bytes (0 = unlimited)
+   */
+  qint64 getMemoryLimit() const noexcept { return mMemoryLimit; }
+
   // Setters
 
   /**
@@ -187,6 +202,18 @@ public:
    */
   void setClean() noexcept;
 
+  /**
+   * @brief Limit the memory used by the undo history
+   *
+   * If the commands in the stack use more memory than the limit, the oldest
+   * commands are deleted (thus can no longer be undone) until the limit is
+   * respected again. The last executed command is always kept, even if it
+   * exceeds the limit on its own.
+   *
+   * @param bytes     The memory limit in bytes (0 = unlimited, the default)
+   */
+  void setMemoryLimit(qint64 bytes) noexcept;
+
   // General Methods
 
   /**
@@ -293,6 +320,23 @@ public:
    */
   void clear() noexcept;
 
+  // Inherited from IF_BulkMutationTarget
+
+  /**
+   * @brief Begin a sequence of stack modifications
+   *
+   * Until the outermost #endBulkMutation() call, the signal #stateModified()
+   * is emitted at most once (at the end) instead of once per modification.
+   * Useful when appending many commands to a command group in a row, since
+   * listeners of #stateModified() (e.g. air wire rebuilds) may be expensive.
+   */
+  void beginBulkMutation() noexcept override;
+
+  /**
+   * @brief End the sequence started with #beginBulkMutation()
+   */
+  void endBulkMutation() noexcept override;
+
 signals:
   void undoTextChanged(const QString& text);
   void redoTextChanged(const QString& text);
@@ -304,6 +348,10 @@ signals:
   void stateModified();
 
 private:
+  void notifyStateModified() noexcept;
+  void updateMemoryUsage(int index) noexcept;
+  void trimToMemoryLimit() noexcept;
+
   /**
    * @brief This list holds all commands of the undo stack
    *
@@ -337,6 +385,14 @@ private:
    * nullptr.
    */
   UndoCommandGroup* mActiveCommandGroup;
+
+  int  mBulkMutationDepth;     ///< Nesting level of #beginBulkMutation()
+  bool mStateModifiedPending;  ///< #stateModified() needs to be emitted
+
+  // Memory accounting
+  QList<qint64> mCommandMemoryUsage;  ///< Usage of each item in #mCommands
+  qint64        mMemoryUsage;         ///< Sum of #mCommandMemoryUsage
+  qint64        mMemoryLimit;         ///< 0 = unlimited
 };
 
 /*******************************************************************************
@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boundingboxgrid.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoundingBoxGrid::BoundingBoxGrid(const PositiveLength& cellSize) noexcept
+  : mCellSize(cellSize->toNm()) {
+}
+
+BoundingBoxGrid::~BoundingBoxGrid() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoundingBoxGrid::insert(int id, const ClipperLib::IntRect& rect) noexcept {
+  remove(id);
+  if ((rect.left > rect.right) || (rect.top > rect.bottom)) {
+    return;  // empty object
+  }
+  mRects.insert(id, rect);
+  QRect range = getCellRange(rect);
+  if (getCellCount(range) > sMaxCellsPerObject) {
+    mLargeObjects.insert(id);
+    return;
+  }
+  for (int x = range.left(); x <= range.right(); ++x) {
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+      mCells[getCellKey(x, y)].append(id);
+    }
+  }
+}
+
+void BoundingBoxGrid::remove(int id) noexcept {
+  auto it = mRects.find(id);
+  if (it == mRects.end()) {
+    return;
+  }
+  if (!mLargeObjects.remove(id)) {
+    QRect range = getCellRange(*it);
+    for (int x = range.left(); x <= range.right(); ++x) {
+      for (int y = range.top(); y <= range.bottom(); ++y) {
+        auto cell = mCells.find(getCellKey(x, y));
+        if (cell != mCells.end()) {
+          cell->removeOne(id);
+          if (cell->isEmpty()) {
+            mCells.erase(cell);
+          }
+        }
+      }
+    }
+  }
+  mRects.erase(it);
+}
+
+void BoundingBoxGrid::clear() noexcept {
+  mRects.clear();
+  mCells.clear();
+  mLargeObjects.clear();
+}
+
+QVector<int> BoundingBoxGrid::query(const ClipperLib::IntRect& rect) const
+    noexcept {
+  QVector<int> ids;
+  if ((rect.left > rect.right) || (rect.top > rect.bottom)) {
+    return ids;
+  }
+  QRect range = getCellRange(rect);
+  if (getCellCount(range) > mCells.count()) {
+    // the queried area is larger than the occupied area, so it's faster to
+    // check all objects
+    for (auto it = mRects.constBegin(); it != mRects.constEnd(); ++it) {
+      if (overlaps(*it, rect)) {
+        ids.append(it.key());
+      }
+    }
+  } else {
+    for (int x = range.left(); x <= range.right(); ++x) {
+      for (int y = range.top(); y <= range.bottom(); ++y) {
+        foreach (int id, mCells.value(getCellKey(x, y))) {
+          if (overlaps(mRects.value(id), rect)) {
+            ids.append(id);
+          }
+        }
+      }
+    }
+    foreach (int id, mLargeObjects) {
+      if (overlaps(mRects.value(id), rect)) {
+        ids.append(id);
+      }
+    }
+  }
+  // objects spanning several cells are found multiple times
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QRect BoundingBoxGrid::getCellRange(const ClipperLib::IntRect& rect) const
+    noexcept {
+  auto toCell = [this](ClipperLib::cInt value) {
+    // round towards negative infinity, also for negative coordinates
+    ClipperLib::cInt cell = value / mCellSize;
+    if ((value % mCellSize) < 0) --cell;
+    return static_cast<int>(qBound(
+        ClipperLib::cInt(std::numeric_limits<int>::min() / 2), cell,
+        ClipperLib::cInt(std::numeric_limits<int>::max() / 2)));
+  };
+  return QRect(QPoint(toCell(rect.left), toCell(rect.top)),
+               QPoint(toCell(rect.right), toCell(rect.bottom)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
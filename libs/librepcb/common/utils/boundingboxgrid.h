@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_BOUNDINGBOXGRID_H
+#define LIBREPCB_BOUNDINGBOXGRID_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../units/length.h"
+
+#include <clipper/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class BoundingBoxGrid
+ ******************************************************************************/
+
+/**
+ * @brief A uniform grid of integer bounding boxes to quickly find the objects
+ *        which possibly overlap with a given area
+ *
+ * Each object is registered in all grid cells covered by its bounding box, so
+ * a query only needs to look at the objects in the cells covered by the
+ * queried area instead of all objects. Objects covering a lot of cells (e.g.
+ * the outline of a large package) are kept in a separate list which is
+ * checked by every query, to keep the memory usage low.
+ *
+ * The bounding boxes are in nanometers, as used by
+ * ::librepcb::ClipperHelpers, so the exact (expensive) intersection test of
+ * the found candidates can be done with Clipper.
+ */
+class BoundingBoxGrid final {
+public:
+  // Constructors / Destructor
+  BoundingBoxGrid()                             = delete;
+  BoundingBoxGrid(const BoundingBoxGrid& other) = default;
+  explicit BoundingBoxGrid(const PositiveLength& cellSize) noexcept;
+  ~BoundingBoxGrid() noexcept;
+
+  // Getters
+  int  getCount() const noexcept { return mRects.count(); }
+  bool isEmpty() const noexcept { return mRects.isEmpty(); }
+
+  // General Methods
+
+  /**
+   * @brief Add an object
+   *
+   * @param id    An arbitrary ID of the object, returned by #query()
+   * @param rect  The bounding box of the object (left <= right and
+   *              top <= bottom, otherwise the object is ignored)
+   */
+  void insert(int id, const ClipperLib::IntRect& rect) noexcept;
+
+  /**
+   * @brief Remove an object which was added with #insert()
+   *
+   * @param id    The ID of the object
+   */
+  void remove(int id) noexcept;
+
+  /**
+   * @brief Remove all objects
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Get all objects whose bounding box overlaps with a given area
+   *
+   * @param rect  The area to query
+   *
+   * @return IDs of the overlapping objects (each only once, sorted ascending)
+   */
+  QVector<int> query(const ClipperLib::IntRect& rect) const noexcept;
+
+  // Static Methods
+  static bool overlaps(const ClipperLib::IntRect& a,
+                       const ClipperLib::IntRect& b) noexcept {
+    return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+        (b.top <= a.bottom);
+  }
+
+  // Operator Overloadings
+  BoundingBoxGrid& operator=(const BoundingBoxGrid& rhs) = default;
+
+private:  // Methods
+  QRect getCellRange(const ClipperLib::IntRect& rect) const noexcept;
+  static qint64 getCellCount(const QRect& range) noexcept {
+    return (qint64(range.right()) - range.left() + 1) *
+        (qint64(range.bottom()) - range.top() + 1);
+  }
+  static quint64 getCellKey(int x, int y) noexcept {
+    return (static_cast<quint64>(static_cast<quint32>(x)) << 32) |
+        static_cast<quint32>(y);
+  }
+
+private:  // Data
+  ClipperLib::cInt                mCellSize;
+  QHash<int, ClipperLib::IntRect> mRects;         ///< All objects by ID
+  QHash<quint64, QVector<int>>    mCells;         ///< Object IDs per cell
+  QSet<int>                       mLargeObjects;  ///< Not in #mCells
+
+  /// Objects covering more cells are added to #mLargeObjects
+  static constexpr int sMaxCellsPerObject = 64;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_BOUNDINGBOXGRID_H
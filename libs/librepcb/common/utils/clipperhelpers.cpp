@@ -45,6 +45,121 @@ void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
   }
 }
 
+ClipperLib::Paths ClipperHelpers::stroke(
+    const Path& path, const PositiveLength& width,
+    const PositiveLength& maxArcTolerance) {
+  // Same shape as QPainterPathStroker with Qt's default pen (square caps and
+  // bevel joins), as used for the graphics items. ClipperOffset doesn't
+  // support bevel joins, so the stroke is built as the union of a rectangle
+  // per segment and a triangle filling the outer side of each join.
+  try {
+    ClipperLib::Path points = convert(path, maxArcTolerance);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    bool closed = (points.size() > 2) && (points.front() == points.back());
+    if (closed) {
+      points.pop_back();
+    }
+    const int   count     = static_cast<int>(points.size());
+    const qreal halfWidth = width->toNm() / qreal(2);
+    auto toPoint = [](const QPointF& p) {
+      return ClipperLib::IntPoint(qRound64(p.x()), qRound64(p.y()));
+    };
+
+    ClipperLib::Paths areas;
+    if (count == 1) {
+      QPointF p(points.front().X, points.front().Y);
+      areas.push_back({toPoint(p + QPointF(-halfWidth, -halfWidth)),
+                       toPoint(p + QPointF(halfWidth, -halfWidth)),
+                       toPoint(p + QPointF(halfWidth, halfWidth)),
+                       toPoint(p + QPointF(-halfWidth, halfWidth))});
+    }
+
+    // segments, extended by half the width at the ends of open paths
+    const int segments = closed ? count : (count - 1);
+    QVector<QPointF> directions;  // unit vectors of all segments
+    for (int i = 0; i < segments; ++i) {
+      const ClipperLib::IntPoint& a = points.at(i);
+      const ClipperLib::IntPoint& b = points.at((i + 1) % count);
+      QPointF dir(b.X - a.X, b.Y - a.Y);
+      dir /= std::hypot(dir.x(), dir.y());
+      directions.append(dir);
+      QPointF normal(-dir.y() * halfWidth, dir.x() * halfWidth);
+      QPointF start(a.X, a.Y);
+      QPointF end(b.X, b.Y);
+      if ((!closed) && (i == 0)) start -= dir * halfWidth;
+      if ((!closed) && (i == segments - 1)) end += dir * halfWidth;
+      areas.push_back({toPoint(start + normal), toPoint(end + normal),
+                       toPoint(end - normal), toPoint(start - normal)});
+    }
+
+    // bevel joins, on the outer side of each corner
+    for (int i = closed ? 0 : 1; i < (closed ? count : (count - 1)); ++i) {
+      const QPointF& in  = directions.at((i + segments - 1) % segments);
+      const QPointF& out = directions.at(i % segments);
+      qreal cross = (in.x() * out.y()) - (in.y() * out.x());
+      if (cross == 0) {
+        continue;  // straight, the rectangles already cover it
+      }
+      qreal   side = (cross > 0) ? -halfWidth : halfWidth;
+      QPointF p(points.at(i).X, points.at(i).Y);
+      areas.push_back({points.at(i),
+                       toPoint(p + QPointF(-in.y(), in.x()) * side),
+                       toPoint(p + QPointF(-out.y(), out.x()) * side)});
+    }
+
+    // unify the orientation, otherwise overlapping areas could cancel out
+    for (ClipperLib::Path& area : areas) {
+      if (!ClipperLib::Orientation(area)) {
+        ClipperLib::ReversePath(area);
+      }
+    }
+    ClipperLib::Paths   result;
+    ClipperLib::Clipper c;
+    c.AddPaths(areas, ClipperLib::ptSubject, true);
+    c.Execute(ClipperLib::ctUnion, result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString(tr("Failed to stroke a path: %1")).arg(e.what()));
+  }
+}
+
+bool ClipperHelpers::intersects(const ClipperLib::Paths& p1,
+                                const ClipperLib::Paths& p2) {
+  try {
+    ClipperLib::Paths   intersections;
+    ClipperLib::Clipper c;
+    c.AddPaths(p1, ClipperLib::ptSubject, true);
+    c.AddPaths(p2, ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctIntersection, intersections,
+              ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    return !intersections.empty();
+  } catch (const std::exception& e) {
+    throw LogicError(
+        __FILE__, __LINE__,
+        QString(tr("Failed to intersect paths: %1")).arg(e.what()));
+  }
+}
+
+ClipperLib::IntRect ClipperHelpers::getBoundingRect(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect;
+  rect.left   = std::numeric_limits<ClipperLib::cInt>::max();
+  rect.top    = std::numeric_limits<ClipperLib::cInt>::max();
+  rect.right  = std::numeric_limits<ClipperLib::cInt>::min();
+  rect.bottom = std::numeric_limits<ClipperLib::cInt>::min();
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      rect.left   = std::min(rect.left, p.X);
+      rect.top    = std::min(rect.top, p.Y);
+      rect.right  = std::max(rect.right, p.X);
+      rect.bottom = std::max(rect.bottom, p.Y);
+    }
+  }
+  return rect;
+}
+
 ClipperLib::Paths ClipperHelpers::flattenTree(
     const ClipperLib::PolyNode& node) {
   ClipperLib::Paths paths;
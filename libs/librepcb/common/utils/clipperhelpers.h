@@ -53,6 +53,12 @@ public:
   static void offset(ClipperLib::Paths& paths, const Length& offset,
                      const PositiveLength& maxArcTolerance);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
+  static ClipperLib::Paths stroke(const Path& path, const PositiveLength& width,
+                                  const PositiveLength& maxArcTolerance);
+  static bool intersects(const ClipperLib::Paths& p1,
+                         const ClipperLib::Paths& p2);
+  static ClipperLib::IntRect getBoundingRect(
+      const ClipperLib::Paths& paths) noexcept;
 
   // Type Conversions
   static QVector<Path>     convert(const ClipperLib::Paths& paths) noexcept;
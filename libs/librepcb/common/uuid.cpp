@@ -22,7 +22,6 @@
  ******************************************************************************/
 #include "uuid.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -30,39 +29,53 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char hexDigits[] = "0123456789abcdef";
+  QString           str(36, Qt::Uninitialized);
+  QChar*            out = str.data();
+  for (int i = 0; i < 32; ++i) {
+    if ((i == 8) || (i == 12) || (i == 16) || (i == 20)) {
+      *out++ = QLatin1Char('-');
+    }
+    quint64 value  = (i < 16) ? mHigh : mLow;
+    int     nibble = (value >> (60 - 4 * (i % 16))) & 0xF;
+    *out++         = QLatin1Char(hexDigits[nibble]);
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 bool Uuid::isValid(const QString& str) noexcept {
-  // check format of string (only accept EXACT matches!)
-  QRegularExpression re(
-      "^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$");
-  QRegularExpressionMatch match =
-      re.match(str, 0, QRegularExpression::PartialPreferCompleteMatch);
-  if (!match.hasMatch()) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
-  return true;
+  quint64 high, low;
+  return parse(str, high, low);
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  QByteArray bytes = QUuid::createUuid().toRfc4122();  // big endian
+  quint64    high  = 0;
+  quint64    low   = 0;
+  for (int i = 0; (i < 8) && (bytes.size() == 16); ++i) {
+    high = (high << 8) | static_cast<quint8>(bytes.at(i));
+    low  = (low << 8) | static_cast<quint8>(bytes.at(i + 8));
+  }
+  if (isValidType(high, low)) {
+    return Uuid(high, low);
   } else {
     qFatal("Not able to generate valid random UUID!");  // calls abort()!
   }
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -71,13 +84,51 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& high, quint64& low) noexcept {
+  // check format of string (only accept EXACT matches, i.e. lowercase hex
+  // digits and dashes at the right positions!)
+  if (str.length() != 36) return false;
+  quint64 values[2] = {0, 0};
+  int     nibbles   = 0;
+  for (int i = 0; i < 36; ++i) {
+    ushort c = str.at(i).unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (c != '-') return false;
+    } else if ((c >= '0') && (c <= '9')) {
+      values[nibbles / 16] = (values[nibbles / 16] << 4) | (c - '0');
+      ++nibbles;
+    } else if ((c >= 'a') && (c <= 'f')) {
+      values[nibbles / 16] = (values[nibbles / 16] << 4) | (c - 'a' + 10);
+      ++nibbles;
+    } else {
+      return false;
+    }
+  }
+  high = values[0];
+  low  = values[1];
+
+  // check type of uuid
+  return isValidType(high, low);
+}
+
+bool Uuid::isValidType(quint64 high, quint64 low) noexcept {
+  bool isVersion4 = ((high >> 12) & 0xF) == 4;   // random UUID
+  bool isDce      = ((low >> 62) & 0x3) == 0x2;  // variant "10x"
+  return isVersion4 && isDce;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -52,6 +52,12 @@ namespace librepcb {
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
  *
+ * Internally, the UUID is stored as a 128-bit value (two 64-bit integers)
+ * since UUIDs are used as keys everywhere, so comparing and hashing them
+ * needs to be fast. The string representation is only created on demand with
+ * #toStr(), e.g. for serialization. The ordering of the 128-bit values is
+ * the same as the (lexicographical) ordering of their string representation.
+ *
  * @see https://de.wikipedia.org/wiki/Universally_Unique_Identifier
  * @see https://tools.ietf.org/html/rfc4122
  */
@@ -71,7 +77,7 @@ public:
    *
    * @param other     Another #Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -85,7 +91,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -93,18 +99,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same result as comparing them as
+   *         strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow  = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -150,14 +162,23 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its 128-bit value
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param high      The first 64 bits of the UUID
+   * @param low       The last 64 bits of the UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  static bool parse(const QString& str, quint64& high, quint64& low) noexcept;
+  static bool isValidType(quint64 high, quint64 low) noexcept;
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 
-private:          // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+private:  // Data
+  // Guaranteed to always contain a valid UUID (stored in big-endian order,
+  // i.e. mHigh contains the first 16 characters of the string representation)
+  quint64 mHigh;  ///< The first 64 bits of the UUID
+  quint64 mLow;   ///< The last 64 bits of the UUID
 };
 
 /*******************************************************************************
@@ -206,7 +227,8 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  // the bits of a (random) UUID are uniformly distributed anyway
+  return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 /*******************************************************************************
@@ -50,6 +50,7 @@ SOURCES += \
     librarybaseelement.cpp \
     librarybaseelementcheck.cpp \
     libraryelement.cpp \
+    libraryelementcache.cpp \
     libraryelementcheck.cpp \
     msg/libraryelementcheckmessage.cpp \
     msg/msgmissingauthor.cpp \
@@ -122,6 +123,7 @@ HEADERS += \
     librarybaseelement.h \
     librarybaseelementcheck.h \
     libraryelement.h \
+    libraryelementcache.h \
     libraryelementcheck.h \
     msg/libraryelementcheckmessage.h \
     msg/msgmissingauthor.h \
@@ -164,14 +164,7 @@ LibraryElementCheckMessageList LibraryBaseElement::runChecks() const {
 }
 
 void LibraryBaseElement::save() {
-  // save S-Expressions file
-  mDirectory->write(
-      mLongElementName % ".lp",
-      serializeToDomElement("librepcb_" % mLongElementName).toByteArray());
-
-  // save version number file
-  mDirectory->write(".librepcb-" % mShortElementName,
-                    VersionFile(qApp->getFileFormatVersion()).toByteArray());
+  writeTo(*mDirectory);  // can throw
 }
 
 void LibraryBaseElement::saveTo(TransactionalDirectory& dest) {
@@ -194,6 +187,17 @@ void LibraryBaseElement::moveIntoParentDirectory(TransactionalDirectory& dest) {
   moveTo(dir);  // can throw
 }
 
+void LibraryBaseElement::writeTo(TransactionalDirectory& dest) const {
+  // save S-Expressions file
+  dest.write(
+      mLongElementName % ".lp",
+      serializeToDomElement("librepcb_" % mLongElementName).toByteArray());
+
+  // save version number file
+  dest.write(".librepcb-" % mShortElementName,
+             VersionFile(qApp->getFileFormatVersion()).toByteArray());
+}
+
 /*******************************************************************************
  *  Protected Methods
  ******************************************************************************/
@@ -112,6 +112,17 @@ public:
   virtual void saveIntoParentDirectory(TransactionalDirectory& dest);
   virtual void moveIntoParentDirectory(TransactionalDirectory& dest);
 
+  /**
+   * @brief Write the files of this element into a directory
+   *
+   * In contrast to #saveTo(), only the main file and the version file are
+   * written (other files in the element's directory are not copied) and the
+   * element is not moved to the destination directory.
+   *
+   * @param dest  The destination directory
+   */
+  void writeTo(TransactionalDirectory& dest) const;
+
   // Operator Overloadings
   LibraryBaseElement& operator=(const LibraryBaseElement& rhs) = delete;
 
@@ -77,6 +77,14 @@ LibraryElementCheckMessageList LibraryElement::runChecks() const {
  *  Protected Methods
  ******************************************************************************/
 
+void LibraryElement::copyAttributesFrom(const LibraryElement& other) noexcept {
+  setDeprecated(other.isDeprecated());
+  setNames(other.getNames());
+  setDescriptions(other.getDescriptions());
+  setKeywords(other.getKeywords());
+  setCategories(other.getCategories());
+}
+
 void LibraryElement::serialize(SExpression& root) const {
   LibraryBaseElement::serialize(root);
   foreach (const Uuid& uuid, Toolbox::sortedQSet(mCategories)) {
@@ -75,6 +75,14 @@ public:
 protected:
   // Protected Methods
 
+  /**
+   * @brief Copy all attributes of another element, except those which are
+   *        passed to the constructor (UUID, version and author)
+   *
+   * @param other   The element to copy the attributes from
+   */
+  void copyAttributesFrom(const LibraryElement& other) noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   virtual void serialize(SExpression& root) const override;
 
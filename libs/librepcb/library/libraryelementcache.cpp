@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "libraryelementcache.h"
+
+#include "librarybaseelement.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryElementCache::LibraryElementCache() noexcept {
+}
+
+LibraryElementCache::~LibraryElementCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QMap<QString, LibraryElementCache::Statistics>
+    LibraryElementCache::getStatistics() const noexcept {
+  QMutexLocker              lock(&mMutex);
+  QMap<QString, Statistics> statistics;
+  foreach (const Entry& entry, mEntries) {
+    long references = entry.element.use_count();
+    if (references > 0) {
+      Statistics& s = statistics[entry.type];
+      s.elements += 1;
+      s.references += references;
+      s.fileSize += entry.fileSize;
+    }
+  }
+  return statistics;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+LibraryElementCache* LibraryElementCache::instance() noexcept {
+  // Intentionally leaked: Elements release themselves from the cache when
+  // they are destroyed, which might happen after static objects have already
+  // been destroyed at application exit.
+  static LibraryElementCache* cache = new LibraryElementCache();
+  return cache;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<LibraryBaseElement> LibraryElementCache::load(
+    const TransactionalDirectory& dir, const QString& type,
+    const Factory& factory) {
+  // Read all files of the element to determine its key. The files are
+  // needed anyway to load the element.
+  QString                    dirName = dir.getAbsPath().getFilename();
+  QHash<QString, QByteArray> files;
+  qint64                     fileSize = 0;
+  QCryptographicHash         hash(QCryptographicHash::Sha256);
+  QStringList                fileNames = dir.getFiles();
+  fileNames.sort();
+  foreach (const QString& fileName, fileNames) {
+    QByteArray content = dir.read(fileName);  // can throw
+    hash.addData(fileName.toUtf8());
+    hash.addData(QByteArray::number(content.size()));
+    hash.addData(content);
+    files.insert(fileName, content);
+    fileSize += content.size();
+  }
+  QString key =
+      type % "/" % dirName % "/" % QString::fromLatin1(hash.result().toHex());
+
+  {
+    QMutexLocker                        lock(&mMutex);
+    std::shared_ptr<LibraryBaseElement> element =
+        mEntries.value(key).element.lock();
+    if (element) {
+      return element;
+    }
+  }
+
+  // Load the element from an in-memory copy of its files, to avoid keeping
+  // the file system it was loaded from alive as long as the element exists.
+  TransactionalDirectory                  root;
+  std::unique_ptr<TransactionalDirectory> copy(
+      new TransactionalDirectory(root, dirName));
+  for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+    copy->write(it.key(), it.value());  // can throw
+  }
+  std::shared_ptr<LibraryBaseElement> element(
+      factory(std::move(copy)),  // can throw
+      [this, key](LibraryBaseElement* e) {
+        release(key);
+        delete e;
+      });
+
+  QMutexLocker lock(&mMutex);
+  Entry&       entry = mEntries[key];
+  if (std::shared_ptr<LibraryBaseElement> existing = entry.element.lock()) {
+    // Loaded by another thread in the meantime. Note that our own copy gets
+    // released after the mutex was unlocked, so release() doesn't deadlock.
+    return existing;
+  }
+  entry.type     = type;
+  entry.element  = element;
+  entry.fileSize = fileSize;
+  return element;
+}
+
+void LibraryElementCache::release(const QString& key) noexcept {
+  QMutexLocker lock(&mMutex);
+  auto         it = mEntries.find(key);
+  if ((it != mEntries.end()) && it->element.expired()) {
+    mEntries.erase(it);
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+#define LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/transactionaldirectory.h>
+
+#include <QtCore>
+
+#include <functional>
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+
+class LibraryBaseElement;
+
+/*******************************************************************************
+ *  Class LibraryElementCache
+ ******************************************************************************/
+
+/**
+ * @brief Process-wide pool of loaded library elements to avoid duplicates
+ *
+ * Loading a library element directory which has already been loaded (and is
+ * still in use) returns the same element instance instead of parsing the
+ * files again. Elements are identified by their type, UUID and a hash of
+ * their file contents (which includes the version), so a modified element
+ * is never mixed up with an older copy of it.
+ *
+ * The loaded elements do not keep a reference to the directory they were
+ * loaded from (they are loaded from an in-memory copy of their files), so
+ * they can outlive the file system of the project they were loaded from. An
+ * element is removed from the cache as soon as its last user releases it.
+ *
+ * @warning Elements returned by this cache are shared between all users, so
+ *          they must not be modified! To write their files into another
+ *          directory, use ::librepcb::library::LibraryBaseElement::writeTo().
+ */
+class LibraryElementCache final {
+  Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
+
+public:
+  // Types
+  struct Statistics {
+    int    elements   = 0;  ///< Number of distinct elements in memory
+    int    references = 0;  ///< Number of users of these elements
+    qint64 fileSize   = 0;  ///< Size of the elements' files [bytes]
+  };
+
+  // Constructors / Destructor
+  LibraryElementCache(const LibraryElementCache& other) = delete;
+  ~LibraryElementCache() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get statistics about the elements in memory
+   *
+   * @return Statistics per element type (key: short element name)
+   */
+  QMap<QString, Statistics> getStatistics() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Load a library element, or get it from memory if already loaded
+   *
+   * @param dir   The directory of the element to load
+   *
+   * @return The (shared) element
+   *
+   * @throw Exception if the element could not be loaded
+   */
+  template <typename ElementType>
+  std::shared_ptr<ElementType> load(const TransactionalDirectory& dir) {
+    return std::static_pointer_cast<ElementType>(load(
+        dir, ElementType::getShortElementName(),
+        [](std::unique_ptr<TransactionalDirectory> copy) {
+          return new ElementType(std::move(copy));  // can throw
+        }));
+  }
+
+  // Operator Overloadings
+  LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
+
+  // Static Methods
+  static LibraryElementCache* instance() noexcept;
+
+private:  // Types
+  typedef std::function<LibraryBaseElement*(
+      std::unique_ptr<TransactionalDirectory>)>
+      Factory;
+  struct Entry {
+    QString                           type;
+    std::weak_ptr<LibraryBaseElement> element;
+    qint64                            fileSize;
+  };
+
+private:  // Methods
+  LibraryElementCache() noexcept;
+  std::shared_ptr<LibraryBaseElement> load(
+      const TransactionalDirectory& dir, const QString& type,
+      const Factory& factory);
+  void release(const QString& key) noexcept;
+
+private:  // Data
+  mutable QMutex        mMutex;
+  QHash<QString, Entry> mEntries;  ///< Key: type, UUID and content hash
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
+
+#endif  // LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
@@ -62,6 +62,16 @@ Package::~Package() noexcept {
  *  General Methods
  ******************************************************************************/
 
+std::unique_ptr<Package> Package::clone() const {
+  std::unique_ptr<Package> copy(new Package(
+      getUuid(), getVersion(), getAuthor(), getNames().getDefaultValue(),
+      getDescriptions().getDefaultValue(), getKeywords().getDefaultValue()));
+  copy->copyAttributesFrom(*this);
+  copy->mPads       = mPads;
+  copy->mFootprints = mFootprints;
+  return copy;
+}
+
 LibraryElementCheckMessageList Package::runChecks() const {
   PackageCheck check(*this);
   return check.runChecks();  // can throw
@@ -75,6 +75,16 @@ public:
   // General Methods
   virtual LibraryElementCheckMessageList runChecks() const override;
 
+  /**
+   * @brief Create a copy of this package
+   *
+   * The copy is not associated with the directory of this package, but gets
+   * a new temporary directory.
+   *
+   * @return The copied package
+   */
+  std::unique_ptr<Package> clone() const;
+
   // Operator Overloadings
   Package& operator=(const Package& rhs) = delete;
 
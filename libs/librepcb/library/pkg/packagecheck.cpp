@@ -31,7 +31,8 @@
 #include "package.h"
 
 #include <librepcb/common/graphics/graphicslayer.h>
-#include <librepcb/common/toolbox.h>
+#include <librepcb/common/utils/boundingboxgrid.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 
 #include <QtCore>
 
@@ -124,28 +125,39 @@ void PackageCheck::checkWrongTextLayers(MsgList& msgs) const {
 }
 
 void PackageCheck::checkPadsOverlapWithPlacement(MsgList& msgs) const {
+  const PositiveLength maxArcTolerance(1000);  // 1 µm
+  const PositiveLength gridCellSize(1000000);  // 1 mm, about a pad's size
   for (auto itFtp = mPackage.getFootprints().begin();
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    QPainterPath topPlacement;
-    QPainterPath botPlacement;
+    // Convert the placement polygons to integer areas and add them to a grid,
+    // so each pad is only intersected with the few areas nearby instead of
+    // the whole placement layer.
+    QVector<ClipperLib::Paths> areas;
+    BoundingBoxGrid            topPlacement(gridCellSize);
+    BoundingBoxGrid            botPlacement(gridCellSize);
     for (const Polygon& polygon : footprint->getPolygons()) {
-      QPen pen(Qt::NoPen);
+      BoundingBoxGrid* grid = nullptr;
+      if (polygon.getLayerName() == GraphicsLayer::sTopPlacement) {
+        grid = &topPlacement;
+      } else if (polygon.getLayerName() == GraphicsLayer::sBotPlacement) {
+        grid = &botPlacement;
+      } else {
+        continue;
+      }
       if (polygon.getLineWidth() > 0) {
-        pen.setStyle(Qt::SolidLine);
-        pen.setWidthF(polygon.getLineWidth()->toPx());
+        ClipperLib::Paths area = ClipperHelpers::stroke(
+            polygon.getPath(), PositiveLength(*polygon.getLineWidth()),
+            maxArcTolerance);  // can throw
+        grid->insert(areas.count(), ClipperHelpers::getBoundingRect(area));
+        areas.append(area);
       }
-      QBrush brush(Qt::NoBrush);
       if (polygon.isFilled()) {
-        brush.setStyle(Qt::SolidPattern);
-      }
-      QPainterPath area = Toolbox::shapeFromPath(
-          polygon.getPath().toQPainterPathPx(), pen, brush);
-      if (polygon.getLayerName() == GraphicsLayer::sTopPlacement) {
-        topPlacement.addPath(area);
-      } else if (polygon.getLayerName() == GraphicsLayer::sBotPlacement) {
-        botPlacement.addPath(area);
+        ClipperLib::Paths area{
+            ClipperHelpers::convert(polygon.getPath(), maxArcTolerance)};
+        grid->insert(areas.count(), ClipperHelpers::getBoundingRect(area));
+        areas.append(area);
       }
     }
 
@@ -158,14 +170,23 @@ void PackageCheck::checkPadsOverlapWithPlacement(MsgList& msgs) const {
       Length tolerance(10);      // 0.01 µm, to avoid rounding issues
       Path   stopMaskPath = pad->getOutline(clearance - tolerance);
       stopMaskPath.rotate(pad->getRotation()).translate(pad->getPosition());
-      QPainterPath stopMask = stopMaskPath.toQPainterPathPx();
-      if (pad->isOnLayer(GraphicsLayer::sTopCopper) &&
-          stopMask.intersects(topPlacement)) {
-        msgs.append(std::make_shared<MsgPadOverlapsWithPlacement>(
-            footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
-            clearance));
-      } else if (pad->isOnLayer(GraphicsLayer::sBotCopper) &&
-                 stopMask.intersects(botPlacement)) {
+      ClipperLib::Paths stopMask{
+          ClipperHelpers::convert(stopMaskPath, maxArcTolerance)};
+      ClipperLib::IntRect stopMaskRect =
+          ClipperHelpers::getBoundingRect(stopMask);
+      auto overlaps = [&](const BoundingBoxGrid& placement) {
+        foreach (int index, placement.query(stopMaskRect)) {
+          if (ClipperHelpers::intersects(stopMask,
+                                         areas.at(index))) {  // can throw
+            return true;
+          }
+        }
+        return false;
+      };
+      if ((pad->isOnLayer(GraphicsLayer::sTopCopper) &&
+           overlaps(topPlacement)) ||
+          (pad->isOnLayer(GraphicsLayer::sBotCopper) &&
+           overlaps(botPlacement))) {
         msgs.append(std::make_shared<MsgPadOverlapsWithPlacement>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
@@ -88,6 +88,18 @@ Symbol::~Symbol() noexcept {
  *  General Methods
  ******************************************************************************/
 
+std::unique_ptr<Symbol> Symbol::clone() const {
+  std::unique_ptr<Symbol> copy(new Symbol(
+      getUuid(), getVersion(), getAuthor(), getNames().getDefaultValue(),
+      getDescriptions().getDefaultValue(), getKeywords().getDefaultValue()));
+  copy->copyAttributesFrom(*this);
+  copy->mPins     = mPins;
+  copy->mPolygons = mPolygons;
+  copy->mCircles  = mCircles;
+  copy->mTexts    = mTexts;
+  return copy;
+}
+
 LibraryElementCheckMessageList Symbol::runChecks() const {
   SymbolCheck check(*this);
   return check.runChecks();  // can throw
@@ -89,6 +89,16 @@ public:
 
   // General Methods
   virtual LibraryElementCheckMessageList runChecks() const override;
+
+  /**
+   * @brief Create a copy of this symbol
+   *
+   * The copy is not associated with the directory of this symbol, but gets
+   * a new temporary directory.
+   *
+   * @return The copied symbol
+   */
+  std::unique_ptr<Symbol> clone() const;
   void registerGraphicsItem(SymbolGraphicsItem& item) noexcept;
   void unregisterGraphicsItem(SymbolGraphicsItem& item) noexcept;
 
@@ -156,22 +156,14 @@ void ComponentChooserDialog::setSelectedCategory(
 
   mSelectedCategoryUuid = uuid;
   try {
-    QSet<Uuid> components =
-        mWorkspace.getLibraryDb().getComponentsByCategory(uuid);  // can throw
-    foreach (const Uuid& uuid, components) {
-      try {
-        FilePath fp =
-            mWorkspace.getLibraryDb().getLatestComponent(uuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getElementTranslations<Component>(
-            fp, localeOrder(),
-            &name);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setData(Qt::UserRole, uuid.toStr());
-        mUi->listComponents->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> components =
+        mWorkspace.getLibraryDb().getElementInfosByCategory<Component>(
+            uuid, localeOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             components) {
+      QListWidgetItem* item = new QListWidgetItem(info.name);
+      item->setData(Qt::UserRole, info.uuid.toStr());
+      mUi->listComponents->addItem(item);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load components"), e.getMsg());
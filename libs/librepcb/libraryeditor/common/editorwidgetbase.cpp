@@ -29,6 +29,7 @@
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -53,8 +54,11 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
         TransactionalFileSystem::RestoreMode::ASK)),  // can throw
     mUndoStackActionGroup(nullptr),
     mToolsActionGroup(nullptr),
-    mIsInterfaceBroken(false) {
+    mIsInterfaceBroken(false),
+    mCheckResultOutdated(false) {
   mUndoStack.reset(new UndoStack());
+  mUndoStack->setMemoryLimit(
+      mContext.workspace.getSettings().getUndoMemoryLimit().getLimitBytes());
   connect(mUndoStack.data(), &UndoStack::cleanChanged, this,
           &EditorWidgetBase::undoStackCleanChanged);
   connect(mUndoStack.data(), &UndoStack::stateModified, this,
@@ -62,11 +66,29 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
 
   mCommandToolBarProxy.reset(new ToolBarProxy());
 
+  // Don't run check immediately when requested. Sometimes when the undo stack
+  // reports changes, it's just in the middle of a bigger change, so the whole
+  // change is not done yet. In that case, running checks would lead to wrong
+  // results. In addition, a lot of modifications in a short time (e.g. while
+  // dragging items) would lead to a lot of useless check runs. So the timer
+  // is restarted on every modification, and the checks are run as soon as
+  // the element was not modified for some time. But don't wait too long,
+  // otherwise it would feel like a lagging user interface.
+  mCheckTimer.setSingleShot(true);
+  mCheckTimer.setInterval(200);
+  connect(&mCheckTimer, &QTimer::timeout, this,
+          &EditorWidgetBase::updateCheckMessages);
+  connect(&mCheckWatcher,
+          &QFutureWatcher<LibraryElementCheckMessageList>::finished, this,
+          &EditorWidgetBase::backgroundChecksFinished);
+
   // Run checks, but delay it because the subclass is not loaded yet!
   scheduleLibraryElementChecks();
 }
 
 EditorWidgetBase::~EditorWidgetBase() noexcept {
+  // The running checks reference mCheckFunction, so wait until they are done.
+  mCheckWatcher.waitForFinished();
 }
 
 /*******************************************************************************
@@ -207,30 +229,36 @@ void EditorWidgetBase::undoStackCleanChanged(bool clean) noexcept {
 }
 
 void EditorWidgetBase::scheduleLibraryElementChecks() noexcept {
-  // Don't run check immediately when requested. Sometimes when the undo stack
-  // reports changes, it's just in the middle of a bigger change, so the whole
-  // change is not done yet. In that case, running checks would lead to wrong
-  // results. Instead, just delay checks for some time to get more stable
-  // messages. But also don't wait too long, otherwise it would feel like a
-  // lagging user interface.
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
-  QTimer::singleShot(50, this, &EditorWidgetBase::updateCheckMessages);
-#else
-  QTimer::singleShot(50, this, SLOT(updateCheckMessages()));
-#endif
+  if (mCheckWatcher.isRunning()) {
+    // The element has been modified since the running checks were started,
+    // so their result will be discarded.
+    mCheckResultOutdated = true;
+  }
+  mCheckTimer.start();  // restarts the timer if it is already active
 }
 
 void EditorWidgetBase::updateCheckMessages() noexcept {
+  if (mCheckWatcher.isRunning()) {
+    // Checks can't be aborted, so let them finish and start a new run
+    // afterwards. This avoids piling up outdated check runs in the thread pool.
+    mCheckResultOutdated = true;
+    return;
+  }
   try {
+    std::function<LibraryElementCheckMessageList()> checks =
+        prepareChecks();  // can throw
     LibraryElementCheckMessageList msgs;
-    if (runChecks(msgs)) {  // can throw
-      int errors = 0;
-      foreach (const auto& msg, msgs) {
-        if (msg->getSeverity() == LibraryElementCheckMessage::Severity::Error) {
-          ++errors;
-        }
-      }
-      emit errorsAvailableChanged(errors > 0);
+    if (checks) {
+      // The worker thread only references the function, so it (and the copied
+      // element it holds) is destroyed in this thread, not in the thread pool.
+      mCheckFunction       = checks;
+      mCheckResultOutdated = false;
+      const std::function<LibraryElementCheckMessageList()>* function =
+          &mCheckFunction;
+      mCheckWatcher.setFuture(
+          QtConcurrent::run([function]() { return (*function)(); }));
+    } else if (runChecks(msgs)) {  // can throw
+      checkMessagesAvailable(msgs);
     } else {
       // Failed to run checks (for example because a command is active), try it
       // later again.
@@ -241,6 +269,34 @@ void EditorWidgetBase::updateCheckMessages() noexcept {
   }
 }
 
+void EditorWidgetBase::backgroundChecksFinished() noexcept {
+  mCheckFunction = nullptr;  // release the copied element
+  if (mCheckResultOutdated) {
+    // The element has been modified in the meantime, run the checks again.
+    mCheckResultOutdated = false;
+    scheduleLibraryElementChecks();
+    return;
+  }
+  try {
+    LibraryElementCheckMessageList msgs = mCheckWatcher.result();  // can throw
+    setCheckMessages(msgs);
+    checkMessagesAvailable(msgs);
+  } catch (const Exception& e) {
+    qCritical() << "Failed to run checks:" << e.getMsg();
+  }
+}
+
+void EditorWidgetBase::checkMessagesAvailable(
+    const LibraryElementCheckMessageList& msgs) noexcept {
+  int errors = 0;
+  foreach (const auto& msg, msgs) {
+    if (msg->getSeverity() == LibraryElementCheckMessage::Severity::Error) {
+      ++errors;
+    }
+  }
+  emit errorsAvailableChanged(errors > 0);
+}
+
 bool EditorWidgetBase::libraryElementCheckFixAvailable(
     std::shared_ptr<const LibraryElementCheckMessage> msg) noexcept {
   try {
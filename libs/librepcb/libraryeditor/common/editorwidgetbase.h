@@ -32,6 +32,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -139,13 +141,39 @@ protected:  // Methods
   const QStringList& getLibLocaleOrder() const noexcept;
   QString            getWorkspaceSettingsUserName() noexcept;
 
+  /**
+   * @brief Prepare running the library element checks in a worker thread
+   *
+   * Editors of elements with expensive checks override this method to return
+   * a function which checks an immutable copy of the element, so the editor
+   * doesn't get blocked while the checks are running. The results are passed
+   * to #setCheckMessages() afterwards.
+   *
+   * @note The returned function is executed in another thread, so it must
+   *       neither access this widget nor the edited element.
+   *
+   * @return The check function, or an empty function to run the checks
+   *         synchronously with #runChecks() instead.
+   */
+  virtual std::function<LibraryElementCheckMessageList()> prepareChecks()
+      const {
+    return nullptr;
+  }
+  virtual void setCheckMessages(
+      const LibraryElementCheckMessageList& msgs) noexcept {
+    Q_UNUSED(msgs);
+  }
+
 private slots:
   void updateCheckMessages() noexcept;
+  void backgroundChecksFinished() noexcept;
 
 private:  // Methods
   void         toolActionGroupChangeTriggered(const QVariant& newTool) noexcept;
   void         undoStackCleanChanged(bool clean) noexcept;
   void         scheduleLibraryElementChecks() noexcept;
+  void         checkMessagesAvailable(
+      const LibraryElementCheckMessageList& msgs) noexcept;
   virtual bool processCheckMessage(
       std::shared_ptr<const LibraryElementCheckMessage> msg, bool applyFix) = 0;
   bool libraryElementCheckFixAvailable(
@@ -171,6 +199,14 @@ protected:  // Data
   ExclusiveActionGroup*                    mToolsActionGroup;
   QScopedPointer<ToolBarProxy>             mCommandToolBarProxy;
   bool                                     mIsInterfaceBroken;
+
+private:  // Data
+  QTimer mCheckTimer;  ///< Delays checks until modifications are finished
+  QFutureWatcher<LibraryElementCheckMessageList> mCheckWatcher;
+  bool mCheckResultOutdated;  ///< Element modified while checks were running
+
+  /// Checks currently running in a worker thread (see #prepareChecks())
+  std::function<LibraryElementCheckMessageList()> mCheckFunction;
 };
 
 /*******************************************************************************
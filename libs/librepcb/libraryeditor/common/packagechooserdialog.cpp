@@ -29,6 +29,7 @@
 #include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
+#include <librepcb/workspace/library/librarythumbnailcache.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
@@ -73,6 +74,10 @@ PackageChooserDialog::PackageChooserDialog(
           &PackageChooserDialog::listPackages_itemDoubleClicked);
   connect(mUi->edtSearch, &QLineEdit::textChanged, this,
           &PackageChooserDialog::searchEditTextChanged);
+  mUi->listPackages->setIconSize(QSize(48, 48));
+  connect(&mWorkspace.getLibraryThumbnailCache(),
+          &workspace::LibraryThumbnailCache::thumbnailAvailable, this,
+          &PackageChooserDialog::thumbnailAvailable);
 
   setSelectedPackage(tl::nullopt);
 }
@@ -131,18 +136,37 @@ void PackageChooserDialog::searchPackages(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> packages =
-        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Package>(input);
-    foreach (const Uuid& uuid, packages) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatestPackage(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getElementTranslations<Package>(
-          fp, localeOrder(),
-          &name);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setData(Qt::UserRole, uuid.toStr());
-      mUi->listPackages->addItem(item);
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> packages =
+        mWorkspace.getLibraryDb().getElementInfosBySearchKeyword<Package>(
+            input, localeOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             packages) {
+      addPackageItem(info);
+    }
+  }
+}
+
+void PackageChooserDialog::addPackageItem(
+    const workspace::WorkspaceLibraryDb::ElementInfo& info) noexcept {
+  QListWidgetItem* item = new QListWidgetItem(info.name);
+  item->setData(Qt::UserRole, info.uuid.toStr());
+  item->setData(Qt::UserRole + 1, info.filePath.toStr());
+  // if not cached yet, the icon is set later in thumbnailAvailable()
+  QImage thumbnail =
+      mWorkspace.getLibraryThumbnailCache().getThumbnail<Package>(info);
+  if (!thumbnail.isNull()) {
+    item->setIcon(QPixmap::fromImage(thumbnail));
+  }
+  mUi->listPackages->addItem(item);
+}
+
+void PackageChooserDialog::thumbnailAvailable(const FilePath& fp,
+                                              const QImage&   image) noexcept {
+  QIcon icon = image.isNull() ? QIcon() : QIcon(QPixmap::fromImage(image));
+  for (int i = 0; i < mUi->listPackages->count(); ++i) {
+    QListWidgetItem* item = mUi->listPackages->item(i);
+    if (item->data(Qt::UserRole + 1).toString() == fp.toStr()) {
+      item->setIcon(icon);
     }
   }
 }
@@ -157,22 +181,12 @@ void PackageChooserDialog::setSelectedCategory(
   mSelectedCategoryUuid = uuid;
 
   try {
-    QSet<Uuid> packages =
-        mWorkspace.getLibraryDb().getPackagesByCategory(uuid);  // can throw
-    foreach (const Uuid& pkgUuid, packages) {
-      try {
-        FilePath fp =
-            mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-        QString name;
-        mWorkspace.getLibraryDb().getElementTranslations<Package>(
-            fp, localeOrder(),
-            &name);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(name);
-        item->setData(Qt::UserRole, pkgUuid.toStr());
-        mUi->listPackages->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> packages =
+        mWorkspace.getLibraryDb().getElementInfosByCategory<Package>(
+            uuid, localeOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             packages) {
+      addPackageItem(info);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load packages"), e.getMsg());
@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 
 #include <QtCore>
 #include <QtWidgets>
@@ -90,6 +91,9 @@ private:  // Methods
                                        QListWidgetItem* previous) noexcept;
   void listPackages_itemDoubleClicked(QListWidgetItem* item) noexcept;
   void searchPackages(const QString& input);
+  void addPackageItem(
+      const workspace::WorkspaceLibraryDb::ElementInfo& info) noexcept;
+  void thumbnailAvailable(const FilePath& fp, const QImage& image) noexcept;
   void setSelectedCategory(const tl::optional<Uuid>& uuid) noexcept;
   void setSelectedPackage(const tl::optional<Uuid>& uuid) noexcept;
   void updatePreview(const FilePath& fp) noexcept;
@@ -29,6 +29,7 @@
 #include <librepcb/library/sym/symbol.h>
 #include <librepcb/library/sym/symbolgraphicsitem.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
+#include <librepcb/workspace/library/librarythumbnailcache.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
@@ -72,6 +73,10 @@ SymbolChooserDialog::SymbolChooserDialog(
           &SymbolChooserDialog::listSymbols_itemDoubleClicked);
   connect(mUi->edtSearch, &QLineEdit::textChanged, this,
           &SymbolChooserDialog::searchEditTextChanged);
+  mUi->listSymbols->setIconSize(QSize(48, 48));
+  connect(&mWorkspace.getLibraryThumbnailCache(),
+          &workspace::LibraryThumbnailCache::thumbnailAvailable, this,
+          &SymbolChooserDialog::thumbnailAvailable);
 
   setSelectedSymbol(FilePath());
 }
@@ -148,18 +153,36 @@ void SymbolChooserDialog::searchSymbols(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    QList<Uuid> symbols =
-        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Symbol>(input);
-    foreach (const Uuid& uuid, symbols) {
-      FilePath fp =
-          mWorkspace.getLibraryDb().getLatestSymbol(uuid);  // can throw
-      QString name;
-      mWorkspace.getLibraryDb().getElementTranslations<Symbol>(
-          fp, localeOrder(),
-          &name);  // can throw
-      QListWidgetItem* item = new QListWidgetItem(name);
-      item->setData(Qt::UserRole, fp.toStr());
-      mUi->listSymbols->addItem(item);
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> symbols =
+        mWorkspace.getLibraryDb().getElementInfosBySearchKeyword<Symbol>(
+            input, localeOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             symbols) {
+      addSymbolItem(info);
+    }
+  }
+}
+
+void SymbolChooserDialog::addSymbolItem(
+    const workspace::WorkspaceLibraryDb::ElementInfo& info) noexcept {
+  QListWidgetItem* item = new QListWidgetItem(info.name);
+  item->setData(Qt::UserRole, info.filePath.toStr());
+  // if not cached yet, the icon is set later in thumbnailAvailable()
+  QImage thumbnail =
+      mWorkspace.getLibraryThumbnailCache().getThumbnail<Symbol>(info);
+  if (!thumbnail.isNull()) {
+    item->setIcon(QPixmap::fromImage(thumbnail));
+  }
+  mUi->listSymbols->addItem(item);
+}
+
+void SymbolChooserDialog::thumbnailAvailable(const FilePath& fp,
+                                             const QImage&   image) noexcept {
+  QIcon icon = image.isNull() ? QIcon() : QIcon(QPixmap::fromImage(image));
+  for (int i = 0; i < mUi->listSymbols->count(); ++i) {
+    QListWidgetItem* item = mUi->listSymbols->item(i);
+    if (item->data(Qt::UserRole).toString() == fp.toStr()) {
+      item->setIcon(icon);
     }
   }
 }
@@ -174,21 +197,12 @@ void SymbolChooserDialog::setSelectedCategory(
   mSelectedCategoryUuid = uuid;
 
   try {
-    QSet<Uuid> symbols =
-        mWorkspace.getLibraryDb().getSymbolsByCategory(uuid);  // can throw
-    foreach (const Uuid& symbolUuid, symbols) {
-      try {
-        QString  symName;
-        FilePath symFp =
-            mWorkspace.getLibraryDb().getLatestSymbol(symbolUuid);  // can throw
-        mWorkspace.getLibraryDb().getElementTranslations<Symbol>(
-            symFp, localeOrder(), &symName);  // can throw
-        QListWidgetItem* item = new QListWidgetItem(symName);
-        item->setData(Qt::UserRole, symFp.toStr());
-        mUi->listSymbols->addItem(item);
-      } catch (const Exception& e) {
-        continue;  // should we do something here?
-      }
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> symbols =
+        mWorkspace.getLibraryDb().getElementInfosByCategory<Symbol>(
+            uuid, localeOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             symbols) {
+      addSymbolItem(info);
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Could not load symbols"), e.getMsg());
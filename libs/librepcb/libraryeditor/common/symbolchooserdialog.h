@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 
 #include <QtCore>
 #include <QtWidgets>
@@ -90,6 +91,9 @@ private:  // Methods
                                       QListWidgetItem* previous) noexcept;
   void listSymbols_itemDoubleClicked(QListWidgetItem* item) noexcept;
   void searchSymbols(const QString& input);
+  void addSymbolItem(
+      const workspace::WorkspaceLibraryDb::ElementInfo& info) noexcept;
+  void thumbnailAvailable(const FilePath& fp, const QImage& image) noexcept;
   void setSelectedCategory(const tl::optional<Uuid>& uuid) noexcept;
   void setSelectedSymbol(const FilePath& fp) noexcept;
   void accept() noexcept override;
@@ -279,14 +279,13 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
 
   try {
     // get all library element names
-    QList<FilePath> elements =
-        mContext.workspace.getLibraryDb().getLibraryElements<ElementType>(
-            mLibrary->getDirectory().getAbsPath());  // can throw
-    foreach (const FilePath& filepath, elements) {
-      QString name;
-      mContext.workspace.getLibraryDb().getElementTranslations<ElementType>(
-          filepath, getLibLocaleOrder(), &name);  // can throw
-      elementNames.insert(filepath, name);
+    QList<workspace::WorkspaceLibraryDb::ElementInfo> elements =
+        mContext.workspace.getLibraryDb().getLibraryElementInfos<ElementType>(
+            mLibrary->getDirectory().getAbsPath(),
+            getLibLocaleOrder());  // can throw
+    foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+             elements) {
+      elementNames.insert(info.filePath, info.name);
     }
   } catch (const Exception& e) {
     listWidget.clear();
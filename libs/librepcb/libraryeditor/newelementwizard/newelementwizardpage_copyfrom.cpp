@@ -126,18 +126,13 @@ void NewElementWizardPage_CopyFrom::setSelectedCategory(
     if (mIsCategoryElement) {
       setSelectedElement(getCategoryFilePath(uuid));  // can throw
     } else {
-      QSet<Uuid> elements = getElementsByCategory(uuid);  // can throw
-      foreach (const Uuid& elementUuid, elements) {
-        try {
-          FilePath fp;
-          QString  name;
-          getElementMetadata(elementUuid, fp, name);
-          QListWidgetItem* item = new QListWidgetItem(name);
-          item->setData(Qt::UserRole, fp.toStr());
-          mUi->listWidget->addItem(item);
-        } catch (const Exception& e) {
-          continue;  // should we do something here?
-        }
+      QList<workspace::WorkspaceLibraryDb::ElementInfo> elements =
+          getElementsByCategory(uuid);  // can throw
+      foreach (const workspace::WorkspaceLibraryDb::ElementInfo& info,
+               elements) {
+        QListWidgetItem* item = new QListWidgetItem(info.name);
+        item->setData(Qt::UserRole, info.filePath.toStr());
+        mUi->listWidget->addItem(item);
       }
     }
   } catch (const Exception& e) {
@@ -189,54 +184,25 @@ FilePath NewElementWizardPage_CopyFrom::getCategoryFilePath(
   }
 }
 
-QSet<Uuid> NewElementWizardPage_CopyFrom::getElementsByCategory(
-    const tl::optional<Uuid>& category) const {
-  switch (mContext.mElementType) {
-    case NewElementWizardContext::ElementType::Symbol:
-      return mContext.getWorkspace().getLibraryDb().getSymbolsByCategory(
-          category);
-    case NewElementWizardContext::ElementType::Component:
-      return mContext.getWorkspace().getLibraryDb().getComponentsByCategory(
-          category);
-    case NewElementWizardContext::ElementType::Device:
-      return mContext.getWorkspace().getLibraryDb().getDevicesByCategory(
-          category);
-    case NewElementWizardContext::ElementType::Package:
-      return mContext.getWorkspace().getLibraryDb().getPackagesByCategory(
-          category);
-    default:
-      throw LogicError(__FILE__, __LINE__);
-  }
-}
-
-void NewElementWizardPage_CopyFrom::getElementMetadata(const Uuid& uuid,
-                                                       FilePath&   fp,
-                                                       QString&    name) const {
+QList<workspace::WorkspaceLibraryDb::ElementInfo>
+    NewElementWizardPage_CopyFrom::getElementsByCategory(
+        const tl::optional<Uuid>& category) const {
+  const workspace::WorkspaceLibraryDb& db =
+      mContext.getWorkspace().getLibraryDb();
+  const QStringList& localeOrder = mContext.getLibLocaleOrder();
   switch (mContext.mElementType) {
     case NewElementWizardContext::ElementType::Symbol:
-      fp = mContext.getWorkspace().getLibraryDb().getLatestSymbol(
-          uuid);  // can throw
-      mContext.getWorkspace().getLibraryDb().getElementTranslations<Symbol>(
-          fp, mContext.getLibLocaleOrder(), &name);  // can throw
-      return;
+      return db.getElementInfosByCategory<Symbol>(category,
+                                                  localeOrder);  // can throw
     case NewElementWizardContext::ElementType::Component:
-      fp = mContext.getWorkspace().getLibraryDb().getLatestComponent(
-          uuid);  // can throw
-      mContext.getWorkspace().getLibraryDb().getElementTranslations<Component>(
-          fp, mContext.getLibLocaleOrder(), &name);  // can throw
-      return;
+      return db.getElementInfosByCategory<Component>(category,
+                                                     localeOrder);  // can throw
     case NewElementWizardContext::ElementType::Device:
-      fp = mContext.getWorkspace().getLibraryDb().getLatestDevice(
-          uuid);  // can throw
-      mContext.getWorkspace().getLibraryDb().getElementTranslations<Device>(
-          fp, mContext.getLibLocaleOrder(), &name);  // can throw
-      return;
+      return db.getElementInfosByCategory<Device>(category,
+                                                  localeOrder);  // can throw
     case NewElementWizardContext::ElementType::Package:
-      fp = mContext.getWorkspace().getLibraryDb().getLatestPackage(
-          uuid);  // can throw
-      mContext.getWorkspace().getLibraryDb().getElementTranslations<Package>(
-          fp, mContext.getLibLocaleOrder(), &name);  // can throw
-      return;
+      return db.getElementInfosByCategory<Package>(category,
+                                                   localeOrder);  // can throw
     default:
       throw LogicError(__FILE__, __LINE__);
   }
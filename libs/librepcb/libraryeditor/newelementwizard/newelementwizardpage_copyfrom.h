@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "newelementwizardcontext.h"
 
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -87,8 +89,8 @@ private:  // Methods
   void       setSelectedElement(const FilePath& fp) noexcept;
   void       setCategoryTreeModel(QAbstractItemModel* model) noexcept;
   FilePath   getCategoryFilePath(const tl::optional<Uuid>& category) const;
-  QSet<Uuid> getElementsByCategory(const tl::optional<Uuid>& category) const;
-  void getElementMetadata(const Uuid& uuid, FilePath& fp, QString& name) const;
+  QList<workspace::WorkspaceLibraryDb::ElementInfo> getElementsByCategory(
+      const tl::optional<Uuid>& category) const;
   void initializePage() noexcept override;
   void cleanupPage() noexcept override;
 
@@ -411,6 +411,23 @@ bool PackageEditorWidget::runChecks(
   return true;
 }
 
+std::function<LibraryElementCheckMessageList()>
+    PackageEditorWidget::prepareChecks() const {
+  if ((mFsm->getCurrentTool() != NONE) && (mFsm->getCurrentTool() != SELECT)) {
+    return nullptr;  // see runChecks()
+  }
+
+  // Run the checks on a copy of the package since they are executed in a worker
+  // thread while the user is able to continue editing the original.
+  std::shared_ptr<const Package> copy = mPackage->clone();  // can throw
+  return [copy]() { return copy->runChecks(); };  // can throw
+}
+
+void PackageEditorWidget::setCheckMessages(
+    const LibraryElementCheckMessageList& msgs) noexcept {
+  mUi->lstMessages->setMessages(msgs);
+}
+
 template <>
 void PackageEditorWidget::fixMsg(const MsgNameNotTitleCase& msg) {
   mUi->edtName->setText(*msg.getFixedName());
@@ -451,9 +468,9 @@ void PackageEditorWidget::fixMsg(const MsgMissingFootprintValue& msg) {
 template <>
 void PackageEditorWidget::fixMsg(const MsgWrongFootprintTextLayer& msg) {
   std::shared_ptr<Footprint> footprint =
-      mPackage->getFootprints().get(msg.getFootprint().get());
+      mPackage->getFootprints().get(msg.getFootprint()->getUuid());
   std::shared_ptr<StrokeText> text =
-      footprint->getStrokeTexts().get(msg.getText().get());
+      footprint->getStrokeTexts().get(msg.getText()->getUuid());
   QScopedPointer<CmdStrokeTextEdit> cmd(new CmdStrokeTextEdit(*text));
   cmd->setLayerName(GraphicsLayerName(msg.getExpectedLayerName()), false);
   mUndoStack->execCmd(cmd.take());
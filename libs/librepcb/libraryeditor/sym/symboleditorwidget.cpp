@@ -374,6 +374,23 @@ bool SymbolEditorWidget::runChecks(LibraryElementCheckMessageList& msgs) const {
   return true;
 }
 
+std::function<LibraryElementCheckMessageList()>
+    SymbolEditorWidget::prepareChecks() const {
+  if ((mFsm->getCurrentTool() != NONE) && (mFsm->getCurrentTool() != SELECT)) {
+    return nullptr;  // see runChecks()
+  }
+
+  // Run the checks on a copy of the symbol since they are executed in a worker
+  // thread while the user is able to continue editing the original.
+  std::shared_ptr<const Symbol> copy = mSymbol->clone();  // can throw
+  return [copy]() { return copy->runChecks(); };  // can throw
+}
+
+void SymbolEditorWidget::setCheckMessages(
+    const LibraryElementCheckMessageList& msgs) noexcept {
+  mUi->lstMessages->setMessages(msgs);
+}
+
 template <>
 void SymbolEditorWidget::fixMsg(const MsgNameNotTitleCase& msg) {
   mUi->edtName->setText(*msg.getFixedName());
@@ -407,7 +424,8 @@ void SymbolEditorWidget::fixMsg(const MsgMissingSymbolValue& msg) {
 
 template <>
 void SymbolEditorWidget::fixMsg(const MsgWrongSymbolTextLayer& msg) {
-  std::shared_ptr<Text> text = mSymbol->getTexts().get(msg.getText().get());
+  std::shared_ptr<Text> text =
+      mSymbol->getTexts().get(msg.getText()->getUuid());
   QScopedPointer<CmdTextEdit> cmd(new CmdTextEdit(*text));
   cmd->setLayerName(GraphicsLayerName(msg.getExpectedLayerName()), false);
   mUndoStack->execCmd(cmd.take());
@@ -415,7 +433,8 @@ void SymbolEditorWidget::fixMsg(const MsgWrongSymbolTextLayer& msg) {
 
 template <>
 void SymbolEditorWidget::fixMsg(const MsgSymbolPinNotOnGrid& msg) {
-  std::shared_ptr<SymbolPin> pin = mSymbol->getPins().get(msg.getPin().get());
+  std::shared_ptr<SymbolPin> pin =
+      mSymbol->getPins().get(msg.getPin()->getUuid());
   Point newPos = pin->getPosition().mappedToGrid(msg.getGridInterval());
   QScopedPointer<CmdSymbolPinEdit> cmd(new CmdSymbolPinEdit(*pin));
   cmd->setPosition(newPos, false);
@@ -105,6 +105,10 @@ private:  // Methods
   bool toolChangeRequested(Tool newTool) noexcept override;
   bool isInterfaceBroken() const noexcept override;
   bool runChecks(LibraryElementCheckMessageList& msgs) const override;
+  std::function<LibraryElementCheckMessageList()> prepareChecks()
+      const override;
+  void setCheckMessages(
+      const LibraryElementCheckMessageList& msgs) noexcept override;
   template <typename MessageType>
   void fixMsg(const MessageType& msg);
   template <typename MessageType>
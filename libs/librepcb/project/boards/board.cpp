@@ -28,6 +28,7 @@
 #include "../erc/ercmsg.h"
 #include "../project.h"
 #include "boardairwiresbuilder.h"
+#include "boarddesignrulecheck.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
 #include "boardselectionquery.h"
@@ -49,6 +50,7 @@
 #include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayerbatch.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
@@ -76,11 +78,16 @@ Board::Board(const Board&                            other,
     mProject(other.getProject()),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mBatchedRenderingEnabled(false),
+    mBulkMutationDepth(0),
+    mPlanesRebuildPending(false),
+    mAirWiresRebuildPending(false),
     mUuid(Uuid::createRandom()),
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
 
     // copy layer stack
     mLayerStack.reset(new BoardLayerStack(*this, *other.mLayerStack));
@@ -91,6 +98,9 @@ Board::Board(const Board&                            other,
     // copy design rules
     mDesignRules.reset(new BoardDesignRules(*other.mDesignRules));
 
+    // copy design rule check options
+    mDesignRuleCheck->setOptions(other.mDesignRuleCheck->getOptions());
+
     // copy fabrication output settings
     mFabricationOutputSettings.reset(
         new BoardFabricationOutputSettings(*other.mFabricationOutputSettings));
@@ -176,6 +186,7 @@ Board::Board(const Board&                            other,
     mDesignRules.reset();
     mGridProperties.reset();
     mLayerStack.reset();
+    mDesignRuleCheck.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -188,10 +199,15 @@ Board::Board(Project&                                project,
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mBatchedRenderingEnabled(false),
+    mBulkMutationDepth(0),
+    mPlanesRebuildPending(false),
+    mAirWiresRebuildPending(false),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
   try {
     mGraphicsScene.reset(new GraphicsScene());
+    mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
 
     // try to open/create the board file
     if (create) {
@@ -356,6 +372,7 @@ Board::Board(Project&                                project,
     mDesignRules.reset();
     mGridProperties.reset();
     mLayerStack.reset();
+    mDesignRuleCheck.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -364,6 +381,7 @@ Board::Board(Project&                                project,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  mDesignRuleCheck.reset();
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -382,6 +400,8 @@ Board::~Board() noexcept {
   mNetSegments.clear();
   qDeleteAll(mDeviceInstances);
   mDeviceInstances.clear();
+  qDeleteAll(mGraphicsLayerBatches);
+  mGraphicsLayerBatches.clear();
 
   mUserSettings.reset();
   mFabricationOutputSettings.reset();
@@ -406,79 +426,90 @@ bool Board::isEmpty() const noexcept {
 }
 
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QPointF         scenePosPx = pos.toPxQPointF();
+  QList<BI_Base*> candidates = getItemsFromSpatialIndex(scenePosPx);
   QList<BI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
   // vias
-  foreach (BI_Via* via, getViasAtScenePos(pos, nullptr)) { list.append(via); }
+  foreach (BI_Base* item, candidates) {
+    if ((item->getType() == BI_Base::Type_t::Via) && item->isSelectable() &&
+        item->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(item);
+    }
+  }
   // netpoints
-  foreach (BI_NetPoint* netpoint,
-           getNetPointsAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netpoint);
+  foreach (BI_Base* item, candidates) {
+    if ((item->getType() == BI_Base::Type_t::NetPoint) &&
+        item->isSelectable() &&
+        item->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(item);
+    }
   }
   // netlines
-  foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netline);
-  }
-  // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
-    BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
-        footprint.getGrabAreaScenePx().contains(scenePosPx)) {
-      if (footprint.getIsMirrored()) {
-        list.append(&footprint);
-      } else {
-        list.prepend(&footprint);
-      }
+  foreach (BI_Base* item, candidates) {
+    if ((item->getType() == BI_Base::Type_t::NetLine) && item->isSelectable() &&
+        item->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(item);
     }
-    foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(scenePosPx)) {
-        if (pad->getIsMirrored()) {
-          list.append(pad);
-        } else {
-          list.insert(1, pad);
-        }
-      }
+  }
+  // footprints & pads & texts of footprints, grouped by footprint and in the
+  // order of the devices (the pads are inserted right after their footprint)
+  QMap<Uuid, BI_Footprint*> footprints;  // key: component instance UUID
+  QSet<BI_Base*>            footprintItems;
+  foreach (BI_Base* item, candidates) {
+    BI_Footprint* footprint = nullptr;
+    if (item->getType() == BI_Base::Type_t::Footprint) {
+      footprint = static_cast<BI_Footprint*>(item);
+    } else if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      footprint = &static_cast<BI_FootprintPad*>(item)->getFootprint();
+    } else if (item->getType() == BI_Base::Type_t::StrokeText) {
+      footprint = static_cast<BI_StrokeText*>(item)->getFootprint();
     }
-    foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
-          text->getGrabAreaScenePx().contains(scenePosPx)) {
-        if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
-          list.prepend(text);
-        } else {
-          list.append(text);
-        }
-      }
+    if (footprint && item->isSelectable() &&
+        item->getGrabAreaScenePx().contains(scenePosPx)) {
+      footprints.insert(footprint->getComponentInstanceUuid(), footprint);
+      footprintItems.insert(item);
     }
   }
-  // planes
-  foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
-        planes->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(planes);
+  foreach (BI_Footprint* footprint, footprints) {
+    if (footprintItems.contains(footprint)) {
+      if (footprint->getIsMirrored()) {
+        list.append(footprint);
+      } else {
+        list.prepend(footprint);
+      }
     }
-  }
-  // polygons
-  foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelectable() &&
-        polygon->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(polygon);
+    foreach (BI_FootprintPad* pad, footprint->getPads()) {
+      if (!footprintItems.contains(pad)) continue;
+      if (pad->getIsMirrored()) {
+        list.append(pad);
+      } else {
+        list.insert(qMin(1, list.count()), pad);
+      }
     }
-  }
-  // texts
-  foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
-        text->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(text);
+    foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+      if (!footprintItems.contains(text)) continue;
+      if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
+        list.prepend(text);
+      } else {
+        list.append(text);
+      }
     }
   }
-  // holes
-  foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelectable() &&
-        hole->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(hole);
+  // planes, polygons, texts & holes
+  foreach (BI_Base::Type_t type,
+           QList<BI_Base::Type_t>{BI_Base::Type_t::Plane,
+                                  BI_Base::Type_t::Polygon,
+                                  BI_Base::Type_t::StrokeText,
+                                  BI_Base::Type_t::Hole}) {
+    foreach (BI_Base* item, candidates) {
+      if ((item->getType() == type) && item->isSelectable() &&
+          item->getGrabAreaScenePx().contains(scenePosPx) &&
+          ((type != BI_Base::Type_t::StrokeText) ||
+           (!static_cast<BI_StrokeText*>(item)->getFootprint()))) {
+        list.append(item);
+      }
     }
   }
   return list;
@@ -487,10 +518,16 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
+  QPointF        scenePosPx = pos.toPxQPointF();
   QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+  foreach (BI_Base* item, getItemsFromSpatialIndex(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::Via) {
+      BI_Via* via = static_cast<BI_Via*>(item);
+      if (via->isSelectable() &&
+          ((!netsignal) || (&via->getNetSignalOfNetSegment() == netsignal)) &&
+          via->getGrabAreaScenePx().contains(scenePosPx)) {
+        list.append(via);
+      }
     }
   }
   return list;
@@ -499,10 +536,18 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF             scenePosPx = pos.toPxQPointF();
   QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getItemsFromSpatialIndex(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::NetPoint) {
+      BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+      if (netpoint->isSelectable() &&
+          ((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+          ((!netsignal) ||
+           (&netpoint->getNetSignalOfNetSegment() == netsignal)) &&
+          netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
+        list.append(netpoint);
+      }
     }
   }
   return list;
@@ -511,10 +556,18 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF            scenePosPx = pos.toPxQPointF();
   QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getItemsFromSpatialIndex(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::NetLine) {
+      BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+      if (netline->isSelectable() &&
+          ((!layer) || (&netline->getLayer() == layer)) &&
+          ((!netsignal) ||
+           (&netline->getNetSignalOfNetSegment() == netsignal)) &&
+          netline->getGrabAreaScenePx().contains(scenePosPx)) {
+        list.append(netline);
+      }
     }
   }
   return list;
@@ -523,13 +576,15 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF                 scenePosPx = pos.toPxQPointF();
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
-    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+  foreach (BI_Base* item, getItemsFromSpatialIndex(scenePosPx)) {
+    if (item->getType() == BI_Base::Type_t::FootprintPad) {
+      BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
       if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
           ((!layer) || (pad->isOnLayer(layer->getName()))) &&
-          ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
+          ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)) &&
+          pad->getGrabAreaScenePx().contains(scenePosPx)) {
         list.append(pad);
       }
     }
@@ -560,10 +615,44 @@ QList<BI_Base*> Board::getAllItems() const noexcept {
  *  Setters: General
  ******************************************************************************/
 
+GraphicsLayerBatch* Board::getGraphicsLayerBatch(const GraphicsLayer& layer,
+                                                 qreal zValue) noexcept {
+  if (!mBatchedRenderingEnabled) {
+    return nullptr;
+  }
+  GraphicsLayerBatch* batch = mGraphicsLayerBatches.value(&layer);
+  if (!batch) {
+    batch = new GraphicsLayerBatch(layer);
+    batch->setZValue(zValue);
+    mGraphicsScene->addItem(*batch);
+    mGraphicsLayerBatches.insert(&layer, batch);
+  }
+  return batch;
+}
+
 void Board::setGridProperties(const GridProperties& grid) noexcept {
   *mGridProperties = grid;
 }
 
+void Board::setBatchedRenderingEnabled(bool enabled) noexcept {
+  if (enabled == mBatchedRenderingEnabled) {
+    return;
+  }
+  mBatchedRenderingEnabled = enabled;
+
+  // move the geometry of all items into the batches, or vice versa
+  foreach (BI_NetSegment* netsegment, mNetSegments) {
+    foreach (BI_NetLine* netline, netsegment->getNetLines()) {
+      netline->updateLine();
+    }
+    foreach (BI_Via* via, netsegment->getVias()) { via->updateVia(); }
+  }
+  if (!enabled) {
+    qDeleteAll(mGraphicsLayerBatches);
+    mGraphicsLayerBatches.clear();
+  }
+}
+
 /*******************************************************************************
  *  DeviceInstance Methods
  ******************************************************************************/
@@ -664,6 +753,11 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
+  if (isBulkMutationActive()) {
+    mPlanesRebuildPending = true;
+    return;
+  }
+
   QList<BI_Plane*> planes = mPlanes;
   qSort(planes.begin(), planes.end(),
         [](const BI_Plane* p1, const BI_Plane* p2) {
@@ -743,6 +837,10 @@ void Board::triggerAirWiresRebuild() noexcept {
   if (!mIsAddedToProject) {
     return;
   }
+  if (isBulkMutationActive()) {
+    mAirWiresRebuildPending = true;
+    return;
+  }
 
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
@@ -813,6 +911,7 @@ void Board::removeFromProject() {
     sgl.add([item]() { item->addToBoard(); });
   }
   mIsAddedToProject = false;
+  mDesignRuleCheck->clear();
   updateErcMessages();
   sgl.dismiss();
 }
@@ -842,45 +941,37 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-    foreach (BI_Device* component, mDeviceInstances) {
-      BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
-      footprint.setSelected(selectFootprint);
-      foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
+
+    QSet<BI_Base*> items;
+    foreach (BI_Base* item, getItemsFromSpatialIndex(rectPx)) {
+      if ((item->getType() == BI_Base::Type_t::AirWire) ||
+          (!item->isSelectable()) ||
+          (!item->getGrabAreaScenePx().intersects(rectPx))) {
+        continue;
       }
-      foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+      items.insert(item);
+      if (item->getType() == BI_Base::Type_t::Footprint) {
+        // pads and texts of selected footprints are selected too
+        BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+        foreach (BI_FootprintPad* pad, footprint->getPads()) {
+          items.insert(pad);
+        }
+        foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+          items.insert(text);
+        }
       }
     }
-    foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
-    }
-    foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
-                    plane->getGrabAreaScenePx().intersects(rectPx);
-      plane->setSelected(select);
+    // Only items which entered or left the rect need to be updated, all other
+    // items were already deselected when the selection rect was started.
+    foreach (BI_Base* item, mItemsInSelectionRect - items) {
+      item->setSelected(false);
     }
-    foreach (BI_Polygon* polygon, mPolygons) {
-      bool select = polygon->isSelectable() &&
-                    polygon->getGrabAreaScenePx().intersects(rectPx);
-      polygon->setSelected(select);
-    }
-    foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
-    }
-    foreach (BI_Hole* hole, mHoles) {
-      bool select =
-          hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
-      hole->setSelected(select);
+    foreach (BI_Base* item, items - mItemsInSelectionRect) {
+      item->setSelected(true);
     }
+    mItemsInSelectionRect = items;
+  } else {
+    mItemsInSelectionRect.clear();
   }
 }
 
@@ -918,10 +1009,63 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const
   return QVector<const AttributeProvider*>{&mProject};
 }
 
+/*******************************************************************************
+ *  Inherited from IF_BulkMutationTarget
+ ******************************************************************************/
+
+void Board::beginBulkMutation() noexcept {
+  ++mBulkMutationDepth;
+}
+
+void Board::endBulkMutation() noexcept {
+  Q_ASSERT(mBulkMutationDepth > 0);
+  if (--mBulkMutationDepth > 0) {
+    return;  // not the outermost bulk mutation
+  }
+
+  // update each net line only once, even if both of its anchors were moved
+  QSet<BI_NetLine*> netlines;
+  netlines.swap(mNetLinesToUpdate);
+  foreach (BI_NetLine* netline, netlines) { netline->updateLine(); }
+
+  if (mPlanesRebuildPending) {
+    mPlanesRebuildPending = false;
+    rebuildAllPlanes();
+  }
+  if (mAirWiresRebuildPending) {
+    mAirWiresRebuildPending = false;
+    triggerAirWiresRebuild();
+  }
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+QList<BI_Base*> Board::getItemsFromSpatialIndex(const QPointF& posPx) const
+    noexcept {
+  return getItemsOfGraphicsItems(mGraphicsScene->items(
+      posPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<BI_Base*> Board::getItemsFromSpatialIndex(const QRectF& rectPx) const
+    noexcept {
+  return getItemsOfGraphicsItems(mGraphicsScene->items(
+      rectPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<BI_Base*> Board::getItemsOfGraphicsItems(
+    const QList<QGraphicsItem*>& graphicsItems) noexcept {
+  QList<BI_Base*> items;
+  items.reserve(graphicsItems.count());
+  foreach (const QGraphicsItem* graphicsItem, graphicsItems) {
+    if (BI_Base* item = BI_Base::fromGraphicsItem(*graphicsItem)) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
 void Board::updateIcon() noexcept {
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
@@ -31,6 +31,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/transactionaldirectory.h>
+#include <librepcb/common/if_bulkmutationtarget.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/uuid.h>
 
@@ -48,6 +49,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class GraphicsLayer;
+class GraphicsLayerBatch;
 class BoardDesignRules;
 
 namespace project {
@@ -67,6 +69,7 @@ class BI_Hole;
 class BI_Plane;
 class BI_AirWire;
 class BoardLayerStack;
+class BoardDesignRuleCheck;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
@@ -82,7 +85,8 @@ class BoardSelectionQuery;
 class Board final : public QObject,
                     public AttributeProvider,
                     public IF_ErcMsgProvider,
-                    public SerializableObject {
+                    public SerializableObject,
+                    public IF_BulkMutationTarget {
   Q_OBJECT
   DECLARE_ERC_MSG_CLASS_NAME(Board)
 
@@ -140,6 +144,12 @@ public:
   const BoardDesignRules& getDesignRules() const noexcept {
     return *mDesignRules;
   }
+  BoardDesignRuleCheck& getDesignRuleCheck() noexcept {
+    return *mDesignRuleCheck;
+  }
+  const BoardDesignRuleCheck& getDesignRuleCheck() const noexcept {
+    return *mDesignRuleCheck;
+  }
   BoardFabricationOutputSettings& getFabricationOutputSettings() noexcept {
     return *mFabricationOutputSettings;
   }
@@ -165,9 +175,35 @@ public:
       noexcept;
   QList<BI_Base*> getAllItems() const noexcept;
 
+  // Getters: Rendering
+  bool isBatchedRenderingEnabled() const noexcept {
+    return mBatchedRenderingEnabled;
+  }
+  GraphicsLayerBatch* getGraphicsLayerBatch(const GraphicsLayer& layer,
+                                            qreal zValue) noexcept;
+
   // Setters: General
   void setGridProperties(const GridProperties& grid) noexcept;
 
+  // Setters: Rendering
+
+  /**
+   * @brief Enable or disable drawing items in per-layer batches
+   *
+   * If enabled, netlines and vias are painted by one
+   * ::librepcb::GraphicsLayerBatch per layer instead of painting themselves
+   * (except selected or highlighted ones, and vias with stop mask openings).
+   *
+   * @note Footprint pads, polygons and texts are not batched. Pads always
+   *       paint stop and cream masks below and above their copper, so they
+   *       have the same layering problem as vias with stop mask openings.
+   *       Polygons and texts are drawn by the generic graphics items of the
+   *       common library, which don't support batches.
+   *
+   * @param enabled   Whether batched rendering is enabled or not
+   */
+  void setBatchedRenderingEnabled(bool enabled) noexcept;
+
   // Getters: Attributes
   const Uuid&        getUuid() const noexcept { return mUuid; }
   const ElementName& getName() const noexcept { return mName; }
@@ -222,6 +258,17 @@ public:
   void triggerAirWiresRebuild() noexcept;
   void forceAirWiresRebuild() noexcept;
 
+  // Bulk Mutation Methods
+  bool isBulkMutationActive() const noexcept {
+    return (mBulkMutationDepth > 0);
+  }
+  void scheduleNetLineUpdate(BI_NetLine& netline) noexcept {
+    mNetLinesToUpdate.insert(&netline);
+  }
+  bool unscheduleNetLineUpdate(BI_NetLine& netline) noexcept {
+    return mNetLinesToUpdate.remove(&netline);
+  }
+
   // General Methods
   void addToProject();
   void removeFromProject();
@@ -241,6 +288,24 @@ public:
   QVector<const AttributeProvider*> getAttributeProviderParents() const
       noexcept override;
 
+  // Inherited from IF_BulkMutationTarget
+
+  /**
+   * @brief Begin modifying many items at once
+   *
+   * Until the outermost #endBulkMutation() call, the graphics items of moved
+   * net lines are not updated, and #rebuildAllPlanes() and
+   * #triggerAirWiresRebuild() are postponed. So a net line whose both anchors
+   * are moved is updated only once, and planes and air wires are rebuilt only
+   * once instead of once per modified item.
+   */
+  void beginBulkMutation() noexcept override;
+
+  /**
+   * @brief End modifying many items and process all postponed updates
+   */
+  void endBulkMutation() noexcept override;
+
   // Operator Overloadings
   Board& operator=(const Board& rhs) = delete;
   bool   operator==(const Board& rhs) noexcept { return (this == &rhs); }
@@ -265,6 +330,25 @@ private:
   void updateIcon() noexcept;
   void updateErcMessages() noexcept;
 
+  /**
+   * @brief Get all items whose graphics item bounding rect intersects a point
+   *        or rect, using the spatial index of the graphics scene
+   *
+   * The index (a BSP tree) is updated incrementally by Qt whenever items are
+   * added, removed, moved or change their geometry, so this is much faster
+   * than iterating over all items of the board. The items are returned
+   * topmost first.
+   *
+   * @note This relies on the grab area of each item being located within the
+   *       bounding rect of its graphics item, as required by QGraphicsItem.
+   */
+  QList<BI_Base*> getItemsFromSpatialIndex(const QPointF& posPx) const
+      noexcept;
+  QList<BI_Base*> getItemsFromSpatialIndex(const QRectF& rectPx) const
+      noexcept;
+  static QList<BI_Base*> getItemsOfGraphicsItems(
+      const QList<QGraphicsItem*>& graphicsItems) noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
@@ -277,10 +361,22 @@ private:
   QScopedPointer<BoardLayerStack>                mLayerStack;
   QScopedPointer<GridProperties>                 mGridProperties;
   QScopedPointer<BoardDesignRules>               mDesignRules;
+  QScopedPointer<BoardDesignRuleCheck>           mDesignRuleCheck;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QScopedPointer<BoardUserSettings>              mUserSettings;
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  QSet<BI_Base*>   mItemsInSelectionRect;
+
+  // Rendering
+  bool                                             mBatchedRenderingEnabled;
+  QHash<const GraphicsLayer*, GraphicsLayerBatch*> mGraphicsLayerBatches;
+
+  // Bulk mutations
+  int               mBulkMutationDepth;  ///< Nesting of #beginBulkMutation()
+  QSet<BI_NetLine*> mNetLinesToUpdate;   ///< Postponed BI_NetLine::updateLine()
+  bool              mPlanesRebuildPending;
+  bool              mAirWiresRebuildPending;
 
   // Attributes
   Uuid        mUuid;
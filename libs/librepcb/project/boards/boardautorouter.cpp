@@ -0,0 +1,992 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardautorouter.h"
+
+#include "../circuit/circuit.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "board.h"
+#include "boardairwiresbuilder.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+constexpr qint32 BoardAutorouter::sFree;
+constexpr qint32 BoardAutorouter::sBlocked;
+constexpr float  BoardAutorouter::sRipUpCost;
+constexpr qint64 BoardAutorouter::sMaxCellCount;
+
+/*******************************************************************************
+ *  Struct Options
+ ******************************************************************************/
+
+BoardAutorouter::Options::Options() noexcept
+  : gridInterval(250000),      // 0.25mm
+    traceWidth(250000),        // 0.25mm
+    clearance(200000),         // 0.2mm
+    viaSize(700000),           // 0.7mm
+    viaDrillDiameter(300000),  // 0.3mm
+    viaCost(10),
+    maxIterations(5) {
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardAutorouter::BoardAutorouter(const Board&   board,
+                                 const Options& options) noexcept
+  : mBoard(board),
+    mOptions(options),
+    mGridWidth(0),
+    mGridHeight(0),
+    mIterationCount(0),
+    mAborted(false) {
+}
+
+BoardAutorouter::~BoardAutorouter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardAutorouter::run() {
+  prepare();  // can throw
+  route();
+}
+
+void BoardAutorouter::prepare() {
+  mIterationCount = 0;
+  mAborted        = false;
+  collectLayersAndNets();
+  collectConnections();  // can throw
+  if ((!mConnections.isEmpty()) && (!mLayerNames.isEmpty())) {
+    initializeGrid();  // can throw
+    rasterizeObstacles();
+    rasterizeBoardOutline();
+  }
+}
+
+void BoardAutorouter::route() noexcept {
+  if ((!mConnections.isEmpty()) && (!mLayerNames.isEmpty())) {
+    routeNetsInParallel();
+    ripUpAndReroute();
+  }
+  buildResult();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardAutorouter::collectLayersAndNets() {
+  mLayerNames.clear();
+  foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+    if (layer->isCopperLayer() && layer->isEnabled()) {
+      mLayerNames.append(layer->getName());
+    }
+  }
+  if (mLayerNames.count() > 64) {
+    throw LogicError(__FILE__, __LINE__, "Too many copper layers.");
+  }
+
+  mNetSignals.clear();
+  mNetIndices.clear();
+  foreach (NetSignal* netsignal,
+           mBoard.getProject().getCircuit().getNetSignals()) {
+    mNetIndices.insert(netsignal, mNetSignals.count());
+    mNetSignals.append(netsignal);
+  }
+}
+
+void BoardAutorouter::collectConnections() {
+  mConnections.clear();
+  mConnectionsOfNet.clear();
+  mConnectionsOfNet.resize(mNetSignals.count());
+  for (int net = 0; net < mNetSignals.count(); ++net) {
+    QVector<QPair<Point, Point>> airWires =
+        BoardAirWiresBuilder(mBoard, *mNetSignals.at(net))
+            .buildAirWires();  // can throw
+
+    // short air wires first, they have the least alternatives
+    std::sort(airWires.begin(), airWires.end(),
+              [](const QPair<Point, Point>& a, const QPair<Point, Point>& b) {
+                return (a.second - a.first).getLength() <
+                       (b.second - b.first).getLength();
+              });
+    foreach (const auto& airWire, airWires) {
+      Connection connection;
+      connection.net         = net;
+      connection.start       = airWire.first;
+      connection.end         = airWire.second;
+      connection.startLayers = getLayersAtPosition(net, airWire.first);
+      connection.endLayers   = getLayersAtPosition(net, airWire.second);
+      mConnectionsOfNet[net].append(mConnections.count());
+      mConnections.append(connection);
+    }
+  }
+}
+
+void BoardAutorouter::initializeGrid() {
+  // the grid covers the board outline, or the air wires if there is none
+  QRectF rect;
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    const Polygon& p = polygon->getPolygon();
+    if (*p.getLayerName() != GraphicsLayer::sBoardOutlines) continue;
+    foreach (const QPointF& vertex, flatten(p.getPath())) {
+      rect |= QRectF(vertex, vertex).adjusted(-1, -1, 1, 1);
+    }
+  }
+  if (rect.isEmpty()) {
+    foreach (const Connection& connection, mConnections) {
+      rect |= QRectF(toNm(connection.start), toNm(connection.end))
+                  .normalized()
+                  .adjusted(-1e7, -1e7, 1e7, 1e7);  // 10mm margin
+    }
+  }
+  qreal  pitch  = mOptions.gridInterval->toNm();
+  qint64 left   = static_cast<qint64>(std::floor(rect.left() / pitch));
+  qint64 right  = static_cast<qint64>(std::ceil(rect.right() / pitch));
+  qint64 top    = static_cast<qint64>(std::floor(rect.top() / pitch));
+  qint64 bottom = static_cast<qint64>(std::ceil(rect.bottom() / pitch));
+  qint64 width  = right - left + 1;
+  qint64 height = bottom - top + 1;
+  if (width * height * mLayerNames.count() > sMaxCellCount) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("The board is too large for the grid interval of %1 mm.")
+            .arg(mOptions.gridInterval->toMmString()));
+  }
+  mGridOrigin = Point(Length(left * mOptions.gridInterval->toNm()),
+                      Length(top * mOptions.gridInterval->toNm()));
+  mGridWidth  = static_cast<int>(width);
+  mGridHeight = static_cast<int>(height);
+
+  int count = mGridWidth * mGridHeight * mLayerNames.count();
+  mFixedNet.fill(sFree, count);
+  mHistoryCost.fill(0, count);
+  mRoutedCount.assign(count, 0);
+  mRoutedNetSum.assign(count, 0);
+  mRoutedNetSquareSum.assign(count, 0);
+
+  // Areas around routed points where other nets must not place a trace
+  // center, and the area around a via which must be passable for its net.
+  qreal w       = mOptions.traceWidth->toNm();
+  qreal c       = mOptions.clearance->toNm();
+  qreal viaSize = mOptions.viaSize->toNm();
+  mTraceDisc    = getDisc((w + c) / pitch);
+  mViaDisc      = getDisc((viaSize / 2 + c + w / 2) / pitch);
+  mViaCheckDisc = getDisc(qMax(viaSize / 2 - w / 2, qreal(0)) / pitch);
+
+  // the search windows of the air wires
+  QRect grid(0, 0, mGridWidth, mGridHeight);
+  for (Connection& connection : mConnections) {
+    QRect window(getNearestGridPoint(connection.start),
+                 getNearestGridPoint(connection.end));
+    window     = window.normalized();
+    int margin = qMax(20, qMax(window.width(), window.height()) / 4);
+    connection.window =
+        window.adjusted(-margin, -margin, margin, margin) & grid;
+  }
+}
+
+void BoardAutorouter::rasterizeObstacles() noexcept {
+  qreal   expansion = mOptions.clearance->toNm() +
+                    mOptions.traceWidth->toNm() / qreal(2);
+  quint64 allLayers = getAllLayers();
+
+  // traces and vias
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    qint32 net = mNetIndices.value(&netsegment->getNetSignal(), sBlocked);
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      int layer = mLayerNames.indexOf(netline->getLayer().getName());
+      if (layer < 0) continue;
+      Obstacle obstacle;
+      obstacle.vertices.append(toNm(netline->getStartPoint().getPosition()));
+      obstacle.vertices.append(toNm(netline->getEndPoint().getPosition()));
+      obstacle.radius = netline->getWidth()->toNm() / qreal(2);
+      obstacle.filled = false;
+      obstacle.layers = quint64(1) << layer;
+      obstacle.net    = net;
+      rasterize(obstacle, expansion);
+    }
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      Obstacle obstacle;
+      obstacle.vertices.append(toNm(via->getPosition()));
+      obstacle.radius = via->getSize()->toNm() / qreal(2);
+      obstacle.filled = false;
+      obstacle.layers = allLayers;
+      obstacle.net    = net;
+      rasterize(obstacle, expansion);
+    }
+  }
+
+  // pads and holes of footprints
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      Obstacle obstacle;
+      obstacle.vertices = flatten(pad->getSceneOutline());
+      obstacle.radius   = 0;
+      obstacle.filled   = true;
+      obstacle.layers   = 0;
+      for (int i = 0; i < mLayerNames.count(); ++i) {
+        if (pad->isOnLayer(mLayerNames.at(i))) {
+          obstacle.layers |= quint64(1) << i;
+        }
+      }
+      const NetSignal* netsignal = pad->getCompSigInstNetSignal();
+      obstacle.net =
+          netsignal ? mNetIndices.value(netsignal, sBlocked) : sBlocked;
+      rasterize(obstacle, expansion);
+    }
+    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+      Obstacle obstacle;
+      obstacle.vertices.append(toNm(footprint.mapToScene(hole.getPosition())));
+      obstacle.radius = hole.getDiameter()->toNm() / qreal(2);
+      obstacle.filled = false;
+      obstacle.layers = allLayers;
+      obstacle.net    = sBlocked;
+      rasterize(obstacle, expansion);
+    }
+  }
+
+  // polygons (not connected to any net)
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    const Polygon& p     = polygon->getPolygon();
+    int            layer = mLayerNames.indexOf(*p.getLayerName());
+    if (layer < 0) continue;
+    Obstacle obstacle;
+    obstacle.vertices = flatten(p.getPath());
+    obstacle.radius   = p.getLineWidth()->toNm() / qreal(2);
+    obstacle.filled   = p.isFilled();
+    obstacle.layers   = quint64(1) << layer;
+    obstacle.net      = sBlocked;
+    rasterize(obstacle, expansion);
+  }
+
+  // board holes
+  foreach (const BI_Hole* hole, mBoard.getHoles()) {
+    Obstacle obstacle;
+    obstacle.vertices.append(toNm(hole->getHole().getPosition()));
+    obstacle.radius = hole->getHole().getDiameter()->toNm() / qreal(2);
+    obstacle.filled = false;
+    obstacle.layers = allLayers;
+    obstacle.net    = sBlocked;
+    rasterize(obstacle, expansion);
+  }
+}
+
+void BoardAutorouter::rasterizeBoardOutline() noexcept {
+  qreal   expansion = mOptions.clearance->toNm() +
+                    mOptions.traceWidth->toNm() / qreal(2);
+  quint64 allLayers = getAllLayers();
+
+  // keep the clearance to the outline itself
+  QVector<QVector<QPointF>> outlines;
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    const Polygon& p = polygon->getPolygon();
+    if (*p.getLayerName() != GraphicsLayer::sBoardOutlines) continue;
+    Obstacle obstacle;
+    obstacle.vertices = flatten(p.getPath());
+    if (obstacle.vertices.count() < 2) continue;
+    if (obstacle.vertices.first() != obstacle.vertices.last()) {
+      obstacle.vertices.append(obstacle.vertices.first());
+    }
+    obstacle.radius = p.getLineWidth()->toNm() / qreal(2);
+    obstacle.filled = false;
+    obstacle.layers = allLayers;
+    obstacle.net    = sBlocked;
+    rasterize(obstacle, expansion);
+    outlines.append(obstacle.vertices);
+  }
+  if (outlines.isEmpty()) {
+    return;
+  }
+
+  // block everything outside (even-odd rule, so cutouts are blocked too)
+  qreal   pitch  = mOptions.gridInterval->toNm();
+  QPointF origin = toNm(mGridOrigin);
+  for (int y = 0; y < mGridHeight; ++y) {
+    qreal          py = origin.y() + y * pitch;
+    QVector<qreal> crossings;
+    foreach (const QVector<QPointF>& outline, outlines) {
+      for (int i = 0, k = outline.count() - 1; i < outline.count(); k = i++) {
+        const QPointF& a = outline.at(i);
+        const QPointF& b = outline.at(k);
+        if ((a.y() > py) != (b.y() > py)) {
+          crossings.append(a.x() +
+                           (py - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+        }
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    bool inside = false;
+    int  i      = 0;
+    for (int x = 0; x < mGridWidth; ++x) {
+      qreal px = origin.x() + x * pitch;
+      while ((i < crossings.count()) && (crossings.at(i) < px)) {
+        inside = !inside;
+        ++i;
+      }
+      if (!inside) {
+        for (int layer = 0; layer < mLayerNames.count(); ++layer) {
+          mFixedNet[getCellIndex(x, y, layer)] = sBlocked;
+        }
+      }
+    }
+  }
+}
+
+void BoardAutorouter::rasterize(const Obstacle& obstacle,
+                                qreal           expansion) noexcept {
+  const QVector<QPointF>& v = obstacle.vertices;
+  if (v.isEmpty() || (obstacle.layers == 0)) return;
+  qreal radius = obstacle.radius + expansion;
+
+  // all grid points within the expanded bounding rect of the obstacle
+  QRectF rect(v.first(), v.first());
+  foreach (const QPointF& p, v) { rect |= QRectF(p, p); }
+  rect = rect.adjusted(-radius, -radius, radius, radius);
+  qreal   pitch  = mOptions.gridInterval->toNm();
+  QPointF origin = toNm(mGridOrigin);
+  int x1 = qMax(0, static_cast<int>(std::ceil((rect.left() - origin.x()) /
+                                               pitch)));
+  int x2 = qMin(mGridWidth - 1,
+                static_cast<int>(std::floor((rect.right() - origin.x()) /
+                                            pitch)));
+  int y1 = qMax(0, static_cast<int>(std::ceil((rect.top() - origin.y()) /
+                                               pitch)));
+  int y2 = qMin(mGridHeight - 1,
+                static_cast<int>(std::floor((rect.bottom() - origin.y()) /
+                                            pitch)));
+
+  for (int y = y1; y <= y2; ++y) {
+    for (int x = x1; x <= x2; ++x) {
+      QPointF p(origin.x() + x * pitch, origin.y() + y * pitch);
+      bool    hit = false;
+      if (v.count() == 1) {
+        hit = getDistanceSquared(p, v.first(), v.first()) < radius * radius;
+      }
+      for (int i = 1; (i < v.count()) && (!hit); ++i) {
+        hit = getDistanceSquared(p, v.at(i - 1), v.at(i)) < radius * radius;
+      }
+      if (obstacle.filled && (!hit)) {
+        hit = (getDistanceSquared(p, v.last(), v.first()) < radius * radius) ||
+              contains(v, p);
+      }
+      if (!hit) continue;
+      for (int layer = 0; layer < mLayerNames.count(); ++layer) {
+        if (!(obstacle.layers & (quint64(1) << layer))) continue;
+        qint32& cell = mFixedNet[getCellIndex(x, y, layer)];
+        if (cell == sFree) {
+          cell = obstacle.net;
+        } else if (cell != obstacle.net) {
+          cell = sBlocked;  // too close to copper of different nets
+        }
+      }
+    }
+  }
+}
+
+void BoardAutorouter::routeNetsInParallel() noexcept {
+  // route nets with short air wires first, they have the least alternatives
+  QVector<int>   nets;
+  QVector<qreal> lengths(mNetSignals.count(), 0);
+  QVector<QRect> windows(mNetSignals.count());
+  for (int net = 0; net < mNetSignals.count(); ++net) {
+    if (mConnectionsOfNet.at(net).isEmpty()) continue;
+    foreach (int i, mConnectionsOfNet.at(net)) {
+      const Connection& connection = mConnections.at(i);
+      lengths[net] += (connection.end - connection.start).getLength().toNm();
+    }
+    windows[net] = getGuardedWindow(net);
+    nets.append(net);
+  }
+  std::stable_sort(nets.begin(), nets.end(), [&lengths](int a, int b) {
+    return lengths.at(a) < lengths.at(b);
+  });
+
+  // Nets whose guarded windows do not overlap only read and write disjoint
+  // parts of the grid, thus each batch of them is routed in parallel.
+  Connection* connections = mConnections.data();  // detach before threading
+  while ((!nets.isEmpty()) && (!mAborted)) {
+    QVector<int> batch;
+    QVector<int> remaining;
+    foreach (int net, nets) {
+      bool overlaps = false;
+      foreach (int other, batch) {
+        if (windows.at(net).intersects(windows.at(other))) {
+          overlaps = true;
+          break;
+        }
+      }
+      if (overlaps) {
+        remaining.append(net);
+      } else {
+        batch.append(net);
+      }
+    }
+    if (batch.count() == 1) {
+      routeNet(batch.first(), connections);
+    } else {
+      QList<QFuture<void>> futures;
+      foreach (int net, batch) {
+        futures.append(QtConcurrent::run(
+            [this, net, connections]() { routeNet(net, connections); }));
+      }
+      foreach (QFuture<void> future, futures) { future.waitForFinished(); }
+    }
+    nets = remaining;
+  }
+  mIterationCount = 1;
+}
+
+void BoardAutorouter::routeNet(int net, Connection* connections) noexcept {
+  foreach (int i, mConnectionsOfNet.at(net)) {
+    if (mAborted) return;
+    Connection& connection = connections[i];
+    if (routeConnection(connection, false, nullptr)) {
+      markPath(connection);
+    }
+  }
+}
+
+void BoardAutorouter::ripUpAndReroute() noexcept {
+  while ((mIterationCount < mOptions.maxIterations) && (!mAborted)) {
+    QVector<int> failed;
+    for (int i = 0; i < mConnections.count(); ++i) {
+      if (mConnections.at(i).path.isEmpty()) {
+        failed.append(i);
+      }
+    }
+    if (failed.isEmpty()) {
+      break;
+    }
+    ++mIterationCount;
+
+    // don't rip up anything in the last iteration, it would stay unrouted
+    bool ripUp = (mIterationCount < mOptions.maxIterations);
+    foreach (int i, failed) {
+      if (mAborted) return;
+      Connection& connection = mConnections[i];
+      if (routeConnection(connection, false, nullptr)) {
+        markPath(connection);
+        continue;
+      }
+      QSet<int> crossedCells;
+      if ((!ripUp) || (!routeConnection(connection, true, &crossedCells))) {
+        continue;
+      }
+
+      // rip up the routes of other nets which are in the way
+      for (Connection& other : mConnections) {
+        if ((other.net == connection.net) || other.path.isEmpty()) continue;
+        foreach (int cell, other.markedCells) {
+          if (crossedCells.contains(cell)) {
+            unmarkPath(other);
+            break;
+          }
+        }
+      }
+
+      // make contested cells more expensive for the next iterations
+      foreach (int cell, crossedCells) { mHistoryCost[cell] += 1; }
+      markPath(connection);
+    }
+  }
+}
+
+bool BoardAutorouter::routeConnection(Connection& connection, bool ripUp,
+                                      QSet<int>* crossedCells) const
+    noexcept {
+  connection.path.clear();
+  const QRect& window = connection.window;
+  int          layers = mLayerNames.count();
+  int          area   = window.width() * window.height();
+  QPoint       start  = getNearestGridPoint(connection.start);
+  QPoint       end    = getNearestGridPoint(connection.end);
+  int          net    = connection.net;
+  if ((area <= 0) || (!window.contains(start)) || (!window.contains(end))) {
+    return false;
+  }
+
+  // A* search on the grid points within the window, on all layers
+  auto getIndex = [&window, area](int x, int y, int layer) {
+    return layer * area + (y - window.top()) * window.width() +
+           (x - window.left());
+  };
+  auto getHeuristic = [&end](int x, int y) {
+    int dx = std::abs(x - end.x());
+    int dy = std::abs(y - end.y());
+    return float(qMax(dx, dy) - qMin(dx, dy)) +
+           float(M_SQRT2) * float(qMin(dx, dy));
+  };
+  typedef std::pair<float, int> Item;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  QVector<float> costs(area * layers, std::numeric_limits<float>::max());
+  QVector<int>   parents(area * layers, -1);
+  QVector<bool>  closed(area * layers, false);
+  for (int layer = 0; layer < layers; ++layer) {
+    if (connection.startLayers & (quint64(1) << layer)) {
+      int index    = getIndex(start.x(), start.y(), layer);
+      costs[index] = 0;
+      queue.push(Item(getHeuristic(start.x(), start.y()), index));
+    }
+  }
+
+  static const int dx[] = {1, -1, 0, 0, 1, 1, -1, -1};
+  static const int dy[] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+  int found = -1;
+  while (!queue.empty()) {
+    int index = queue.top().second;
+    queue.pop();
+    if (closed.at(index)) continue;
+    closed[index] = true;
+    int layer     = index / area;
+    int x         = (index % area) % window.width() + window.left();
+    int y         = (index % area) / window.width() + window.top();
+    if ((x == end.x()) && (y == end.y()) &&
+        (connection.endLayers & (quint64(1) << layer))) {
+      found = index;
+      break;
+    }
+
+    // move on the same layer
+    for (int i = 0; i < 8; ++i) {
+      int nx = x + dx[i];
+      int ny = y + dy[i];
+      if (!window.contains(nx, ny)) continue;
+      int next = getIndex(nx, ny, layer);
+      if (closed.at(next)) continue;
+      float cost = ((nx == end.x()) && (ny == end.y()))
+          ? 1
+          : getCellCost(net, nx, ny, layer, ripUp);
+      if (cost < 0) continue;
+      if ((i >= 4) && ((getCellCost(net, nx, y, layer, ripUp) < 0) ||
+                       (getCellCost(net, x, ny, layer, ripUp) < 0))) {
+        continue;  // don't cut corners, the trace could touch other copper
+      }
+      float g = costs.at(index) + ((i < 4) ? cost : float(M_SQRT2) * cost);
+      if (g < costs.at(next)) {
+        costs[next]   = g;
+        parents[next] = index;
+        queue.push(Item(g + getHeuristic(nx, ny), next));
+      }
+    }
+
+    // change the layer with a via (not within the pads to connect)
+    if ((layers > 1) && (QPoint(x, y) != start) && (QPoint(x, y) != end)) {
+      float cost = getViaCost(net, x, y, ripUp);
+      if (cost < 0) continue;
+      for (int other = 0; other < layers; ++other) {
+        int next = getIndex(x, y, other);
+        if ((other == layer) || closed.at(next)) continue;
+        float g = costs.at(index) + cost;
+        if (g < costs.at(next)) {
+          costs[next]   = g;
+          parents[next] = index;
+          queue.push(Item(g + getHeuristic(x, y), next));
+        }
+      }
+    }
+  }
+  if (found < 0) {
+    return false;
+  }
+
+  // trace back the path
+  for (int index = found; index >= 0; index = parents.at(index)) {
+    int layer = index / area;
+    int x     = (index % area) % window.width() + window.left();
+    int y     = (index % area) / window.width() + window.top();
+    connection.path.append(Node{x, y, layer});
+  }
+  std::reverse(connection.path.begin(), connection.path.end());
+
+  // the stubs to the (usually off-grid) air wire end points must be free too
+  if ((!isStubFree(net, connection.start, connection.path.first(), ripUp)) ||
+      (!isStubFree(net, connection.end, connection.path.last(), ripUp))) {
+    connection.path.clear();
+    return false;
+  }
+
+  // collect the cells where routes of other nets were crossed
+  if (crossedCells) {
+    QSet<int> cells;
+    for (int i = 0; i < connection.path.count(); ++i) {
+      const Node& node = connection.path.at(i);
+      addDisc(cells, QVector<QPoint>{QPoint(0, 0)}, node.x, node.y,
+              node.layer);
+      if ((i > 0) && (connection.path.at(i - 1).layer != node.layer)) {
+        for (int layer = 0; layer < layers; ++layer) {
+          addDisc(cells, mViaCheckDisc, node.x, node.y, layer);
+        }
+      }
+    }
+    foreach (int cell, cells) {
+      if (isRoutedByOtherNet(cell, net)) {
+        crossedCells->insert(cell);
+      }
+    }
+  }
+  return true;
+}
+
+float BoardAutorouter::getCellCost(int net, int x, int y, int layer,
+                                   bool ripUp) const noexcept {
+  int    index = getCellIndex(x, y, layer);
+  qint32 fixed = mFixedNet.at(index);
+  if ((fixed != sFree) && (fixed != net)) {
+    return -1;  // existing copper of another net, or blocked
+  }
+  float cost = 1 + mHistoryCost.at(index);
+  if (isRoutedByOtherNet(index, net)) {
+    if (!ripUp) {
+      return -1;
+    }
+    cost += sRipUpCost;
+  }
+  return cost;
+}
+
+float BoardAutorouter::getViaCost(int net, int x, int y, bool ripUp) const
+    noexcept {
+  float penalty = 0;
+  for (int layer = 0; layer < mLayerNames.count(); ++layer) {
+    foreach (const QPoint& offset, mViaCheckDisc) {
+      int cx = x + offset.x();
+      int cy = y + offset.y();
+      if ((cx < 0) || (cy < 0) || (cx >= mGridWidth) || (cy >= mGridHeight)) {
+        return -1;
+      }
+      float cost = getCellCost(net, cx, cy, layer, ripUp);
+      if (cost < 0) {
+        return -1;
+      }
+      penalty = qMax(penalty, cost - 1);
+    }
+  }
+  return mOptions.viaCost + penalty;
+}
+
+bool BoardAutorouter::isStubFree(int net, const Point& pos, const Node& node,
+                                 bool ripUp) const noexcept {
+  // check the grid points nearest to the stub like any other routed point
+  QPointF a      = toNm(getPoint(node.x, node.y));
+  QPointF b      = toNm(pos);
+  qreal   length = std::hypot(b.x() - a.x(), b.y() - a.y());
+  qreal   pitch  = mOptions.gridInterval->toNm();
+  int     steps  = qMax(1, static_cast<int>(std::ceil(4 * length / pitch)));
+  for (int i = 0; i <= steps; ++i) {
+    QPointF p    = a + (b - a) * (qreal(i) / steps);
+    QPoint  cell = getNearestGridPoint(
+        Point(Length(qRound64(p.x())), Length(qRound64(p.y()))));
+    if (getCellCost(net, cell.x(), cell.y(), node.layer, ripUp) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BoardAutorouter::isRoutedByOtherNet(int index, int net) const noexcept {
+  qint64 count = mRoutedCount[index];
+  qint64 id    = net + 1;
+  return (count > 0) && ((mRoutedNetSum[index] != count * id) ||
+                         (mRoutedNetSquareSum[index] != count * id * id));
+}
+
+void BoardAutorouter::markPath(Connection& connection) noexcept {
+  QSet<int> cells;
+  for (int i = 0; i < connection.path.count(); ++i) {
+    const Node& node = connection.path.at(i);
+    addDisc(cells, mTraceDisc, node.x, node.y, node.layer);
+    if ((i > 0) && (connection.path.at(i - 1).layer != node.layer)) {
+      for (int layer = 0; layer < mLayerNames.count(); ++layer) {
+        addDisc(cells, mViaDisc, node.x, node.y, layer);
+      }
+    }
+  }
+  qint64 id = connection.net + 1;
+  connection.markedCells.clear();
+  connection.markedCells.reserve(cells.count());
+  foreach (int index, cells) {
+    mRoutedCount[index] += 1;
+    mRoutedNetSum[index] += id;
+    mRoutedNetSquareSum[index] += id * id;
+    connection.markedCells.append(index);
+  }
+}
+
+void BoardAutorouter::unmarkPath(Connection& connection) noexcept {
+  qint64 id = connection.net + 1;
+  foreach (int index, connection.markedCells) {
+    mRoutedCount[index] -= 1;
+    mRoutedNetSum[index] -= id;
+    mRoutedNetSquareSum[index] -= id * id;
+  }
+  connection.markedCells.clear();
+  connection.path.clear();
+}
+
+void BoardAutorouter::addDisc(QSet<int>& cells, const QVector<QPoint>& disc,
+                              int x, int y, int layer) const noexcept {
+  foreach (const QPoint& offset, disc) {
+    int cx = x + offset.x();
+    int cy = y + offset.y();
+    if ((cx >= 0) && (cy >= 0) && (cx < mGridWidth) && (cy < mGridHeight)) {
+      cells.insert(getCellIndex(cx, cy, layer));
+    }
+  }
+}
+
+void BoardAutorouter::buildResult() noexcept {
+  mRoutes.clear();
+  mUnroutedAirWires.clear();
+  foreach (const Connection& connection, mConnections) {
+    if (connection.path.isEmpty()) {
+      mUnroutedAirWires.append(qMakePair(connection.start, connection.end));
+      continue;
+    }
+
+    // the end points of air wires are usually not on the grid
+    QVector<RouteVertex> vertices;
+    vertices.append(RouteVertex{
+        connection.start, mLayerNames.at(connection.path.first().layer)});
+    foreach (const Node& node, connection.path) {
+      vertices.append(
+          RouteVertex{getPoint(node.x, node.y), mLayerNames.at(node.layer)});
+    }
+    vertices.append(RouteVertex{
+        connection.end, mLayerNames.at(connection.path.last().layer)});
+
+    // remove duplicate and collinear vertices
+    Route route;
+    route.netSignal = mNetSignals.at(connection.net);
+    foreach (const RouteVertex& v, vertices) {
+      int n = route.vertices.count();
+      if ((n > 0) && (route.vertices.last().position == v.position) &&
+          (route.vertices.last().layerName == v.layerName)) {
+        continue;
+      }
+      if ((n > 1) && (route.vertices.at(n - 2).layerName == v.layerName) &&
+          (route.vertices.at(n - 1).layerName == v.layerName) &&
+          (route.vertices.at(n - 2).position !=
+           route.vertices.at(n - 1).position)) {
+        QPointF a     = toNm(route.vertices.at(n - 2).position);
+        QPointF b     = toNm(route.vertices.at(n - 1).position);
+        QPointF c     = toNm(v.position);
+        QPointF ab    = b - a;
+        QPointF bc    = c - b;
+        qreal   cross = ab.x() * bc.y() - ab.y() * bc.x();
+        qreal   scale = std::hypot(ab.x(), ab.y()) * std::hypot(bc.x(), bc.y());
+        if ((std::abs(cross) <= 1e-9 * scale) &&
+            (QPointF::dotProduct(ab, bc) > 0)) {
+          route.vertices.last() = v;
+          continue;
+        }
+      }
+      route.vertices.append(v);
+    }
+    mRoutes.append(route);
+  }
+}
+
+QRect BoardAutorouter::getGuardedWindow(int net) const noexcept {
+  // cells around a window which may be read or written while routing in it
+  int guard = 0;
+  foreach (const QPoint& p, mTraceDisc + mViaDisc + mViaCheckDisc) {
+    guard = qMax(guard, qMax(std::abs(p.x()), std::abs(p.y())));
+  }
+  guard = 2 * guard + 2;
+
+  QRect window;
+  foreach (int i, mConnectionsOfNet.at(net)) {
+    window |= mConnections.at(i).window;
+  }
+  return window.adjusted(-guard, -guard, guard, guard);
+}
+
+Point BoardAutorouter::getPoint(int x, int y) const noexcept {
+  return mGridOrigin + Point(Length(mOptions.gridInterval->toNm() * x),
+                             Length(mOptions.gridInterval->toNm() * y));
+}
+
+QPoint BoardAutorouter::getNearestGridPoint(const Point& pos) const noexcept {
+  qreal pitch = mOptions.gridInterval->toNm();
+  Point delta = pos - mGridOrigin;
+  int   x     = static_cast<int>(std::lround(delta.getX().toNm() / pitch));
+  int   y     = static_cast<int>(std::lround(delta.getY().toNm() / pitch));
+  return QPoint(qBound(0, x, mGridWidth - 1), qBound(0, y, mGridHeight - 1));
+}
+
+quint64 BoardAutorouter::getAllLayers() const noexcept {
+  quint64 layers = 0;
+  for (int i = 0; i < mLayerNames.count(); ++i) {
+    layers |= quint64(1) << i;
+  }
+  return layers;
+}
+
+quint64 BoardAutorouter::getLayersAtPosition(int          net,
+                                             const Point& pos) const
+    noexcept {
+  quint64          layers    = 0;
+  const NetSignal* netsignal = mNetSignals.at(net);
+  foreach (const ComponentSignalInstance* signal,
+           netsignal->getComponentSignals()) {
+    foreach (const BI_FootprintPad* pad, signal->getRegisteredFootprintPads()) {
+      if ((&pad->getBoard() != &mBoard) || (pad->getPosition() != pos)) {
+        continue;
+      }
+      for (int i = 0; i < mLayerNames.count(); ++i) {
+        if (pad->isOnLayer(mLayerNames.at(i))) {
+          layers |= quint64(1) << i;
+        }
+      }
+    }
+  }
+  foreach (const BI_NetSegment* netsegment, netsignal->getBoardNetSegments()) {
+    if (&netsegment->getBoard() != &mBoard) continue;
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      if (via->getPosition() == pos) {
+        return getAllLayers();
+      }
+    }
+    foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+      const GraphicsLayer* layer = netpoint->getLayerOfLines();
+      if (layer && (netpoint->getPosition() == pos)) {
+        int i = mLayerNames.indexOf(layer->getName());
+        if (i >= 0) {
+          layers |= quint64(1) << i;
+        }
+      }
+    }
+  }
+  return layers ? layers : getAllLayers();
+}
+
+QVector<QPoint> BoardAutorouter::getDisc(qreal radius) noexcept {
+  QVector<QPoint> disc;
+  int             r = static_cast<int>(std::floor(radius));
+  for (int y = -r; y <= r; ++y) {
+    for (int x = -r; x <= r; ++x) {
+      if (x * x + y * y <= radius * radius) {
+        disc.append(QPoint(x, y));
+      }
+    }
+  }
+  return disc;
+}
+
+QVector<QPointF> BoardAutorouter::flatten(const Path& path) noexcept {
+  QVector<QPointF>       result;
+  const QVector<Vertex>& vertices = path.getVertices();
+  for (int i = 0; i < vertices.count(); ++i) {
+    if ((i > 0) && (vertices.at(i - 1).getAngle() != Angle::deg0())) {
+      // approximate arcs with a tolerance of 5um
+      Path arc = Path::flatArc(vertices.at(i - 1).getPos(),
+                               vertices.at(i).getPos(),
+                               vertices.at(i - 1).getAngle(),
+                               PositiveLength(5000));
+      for (int k = 1; k < arc.getVertices().count(); ++k) {
+        result.append(toNm(arc.getVertices().at(k).getPos()));
+      }
+    } else {
+      result.append(toNm(vertices.at(i).getPos()));
+    }
+  }
+  return result;
+}
+
+QPointF BoardAutorouter::toNm(const Point& p) noexcept {
+  return QPointF(p.getX().toNm(), p.getY().toNm());
+}
+
+qreal BoardAutorouter::getDistanceSquared(const QPointF& p, const QPointF& s1,
+                                          const QPointF& s2) noexcept {
+  QPointF s      = s2 - s1;
+  qreal   length = QPointF::dotProduct(s, s);
+  qreal   t      = 0;
+  if (length > 0) {
+    t = qBound(qreal(0), QPointF::dotProduct(p - s1, s) / length, qreal(1));
+  }
+  QPointF diff = p - (s1 + s * t);
+  return QPointF::dotProduct(diff, diff);
+}
+
+bool BoardAutorouter::contains(const QVector<QPointF>& polygon,
+                               const QPointF&          p) noexcept {
+  // even-odd rule
+  bool inside = false;
+  for (int i = 0, k = polygon.count() - 1; i < polygon.count(); k = i++) {
+    const QPointF& a = polygon.at(i);
+    const QPointF& b = polygon.at(k);
+    if (((a.y() > p.y()) != (b.y() > p.y())) &&
+        (p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,288 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDAUTOROUTER_H
+#define LIBREPCB_PROJECT_BOARDAUTOROUTER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+
+#include <atomic>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardAutorouter
+ ******************************************************************************/
+
+/**
+ * @brief The BoardAutorouter class routes the air wires of a board
+ *
+ * This is a grid based (maze) router working on all enabled copper layers:
+ *
+ *   1. The existing copper (traces, vias, pads, polygons), holes and the board
+ *      outline are rasterized into a grid. Every grid point gets the net which
+ *      may place a trace center there, or is blocked for all nets.
+ *   2. Each air wire (see ::librepcb::project::BoardAirWiresBuilder) is routed
+ *      with A* search along the grid points, changing layers with vias. Every
+ *      found route is rasterized into the grid as well.
+ *   3. Nets whose search windows do not overlap are routed in parallel, since
+ *      they read and write disjoint parts of the grid.
+ *   4. Air wires which could not be routed are routed again with the routes of
+ *      other nets being passable at a high cost. The routes which are crossed
+ *      are ripped up and rerouted in the next iteration (rip-up and reroute).
+ *      Frequently contested grid points get more expensive with every
+ *      iteration, so the nets negotiate who gets them.
+ *
+ * The board is not modified, the results (#getRoutes()) need to be added to
+ * the board with an undo command.
+ */
+class BoardAutorouter final {
+  Q_DECLARE_TR_FUNCTIONS(BoardAutorouter)
+
+public:
+  // Types
+  struct Options {
+    PositiveLength gridInterval;  ///< Should be <= traceWidth + clearance
+    PositiveLength traceWidth;
+    UnsignedLength clearance;
+    PositiveLength viaSize;
+    PositiveLength viaDrillDiameter;
+    int            viaCost;        ///< Cost of a via, in grid intervals
+    int            maxIterations;  ///< Including the initial routing pass
+
+    Options() noexcept;
+  };
+
+  struct RouteVertex {
+    Point   position;
+    QString layerName;
+  };
+
+  /**
+   * @brief A routed air wire
+   *
+   * Two subsequent vertices at the same position but on different layers
+   * represent a via.
+   */
+  struct Route {
+    NetSignal*           netSignal;
+    QVector<RouteVertex> vertices;  ///< From start to end of the air wire
+  };
+
+  // Constructors / Destructor
+  BoardAutorouter()                             = delete;
+  BoardAutorouter(const BoardAutorouter& other) = delete;
+  BoardAutorouter(const Board& board, const Options& options) noexcept;
+  ~BoardAutorouter() noexcept;
+
+  // Getters
+  const Options&      getOptions() const noexcept { return mOptions; }
+  const QList<Route>& getRoutes() const noexcept { return mRoutes; }
+  const QVector<QPair<Point, Point>>& getUnroutedAirWires() const noexcept {
+    return mUnroutedAirWires;
+  }
+  int getAirWireCount() const noexcept { return mConnections.count(); }
+  int getIterationCount() const noexcept { return mIterationCount; }
+
+  // General Methods
+
+  /**
+   * @brief Route all air wires of the board
+   *
+   * Same as calling #prepare() and #route().
+   *
+   * @throw Exception if the board cannot be routed at all (e.g. too large)
+   */
+  void run();
+
+  /**
+   * @brief Collect the air wires and rasterize the board into the grid
+   *
+   * @note Must be called from the thread the board lives in. The board must
+   *       not be modified until #route() has finished.
+   *
+   * @throw Exception if the board cannot be routed at all (e.g. too large)
+   */
+  void prepare();
+
+  /**
+   * @brief Route the air wires collected by #prepare()
+   *
+   * Doesn't access the board anymore, thus it may be called from a worker
+   * thread to keep the GUI responsive.
+   */
+  void route() noexcept;
+
+  /**
+   * @brief Stop a running #route() as soon as possible (thread-safe)
+   *
+   * The air wires which have not been routed yet are reported as unrouted.
+   */
+  void abort() noexcept { mAborted = true; }
+
+  // Operator Overloadings
+  BoardAutorouter& operator=(const BoardAutorouter& rhs) = delete;
+
+private:  // Types
+  /// A grid point on a specific layer
+  struct Node {
+    int x;
+    int y;
+    int layer;
+  };
+
+  struct Connection {
+    int           net;          ///< Index in #mNetSignals
+    Point         start;        ///< Start point of the air wire
+    Point         end;          ///< End point of the air wire
+    quint64       startLayers;  ///< Bit mask of the layers allowed at start
+    quint64       endLayers;    ///< Bit mask of the layers allowed at end
+    QRect         window;       ///< Search area (in grid points)
+    QVector<Node> path;         ///< Empty if not routed
+    QVector<int>  markedCells;  ///< Cells marked as occupied by the path
+  };
+
+  /// An existing object to rasterize into the grid
+  struct Obstacle {
+    QVector<QPointF> vertices;  ///< In nanometers, one vertex is a circle
+    qreal            radius;    ///< Half width of the polyline
+    bool             filled;    ///< Whether the polyline is a filled area
+    quint64          layers;    ///< Bit mask of the layers
+    qint32           net;       ///< Index in #mNetSignals or #sBlocked
+  };
+
+  static constexpr qint32 sFree    = -1;
+  static constexpr qint32 sBlocked = -2;
+
+  /// Additional cost of crossing a route of another net (rip-up mode)
+  static constexpr float sRipUpCost = 30;
+
+  /// Maximum number of grid points (over all layers) to limit memory usage
+  static constexpr qint64 sMaxCellCount = 10000000;
+
+private:  // Methods
+  void    collectLayersAndNets();
+  void    collectConnections();
+  void    initializeGrid();
+  void    rasterizeObstacles() noexcept;
+  void    rasterizeBoardOutline() noexcept;
+  void    rasterize(const Obstacle& obstacle, qreal expansion) noexcept;
+  void    routeNetsInParallel() noexcept;
+  void    routeNet(int net, Connection* connections) noexcept;
+  void    ripUpAndReroute() noexcept;
+  bool    routeConnection(Connection& connection, bool ripUp,
+                          QSet<int>* crossedCells) const noexcept;
+  float   getCellCost(int net, int x, int y, int layer, bool ripUp) const
+      noexcept;
+  float   getViaCost(int net, int x, int y, bool ripUp) const noexcept;
+  bool    isStubFree(int net, const Point& pos, const Node& node,
+                     bool ripUp) const noexcept;
+  bool    isRoutedByOtherNet(int index, int net) const noexcept;
+  void    markPath(Connection& connection) noexcept;
+  void    unmarkPath(Connection& connection) noexcept;
+  void    addDisc(QSet<int>& cells, const QVector<QPoint>& disc, int x, int y,
+                  int layer) const noexcept;
+  void    buildResult() noexcept;
+  QRect   getGuardedWindow(int net) const noexcept;
+  Point   getPoint(int x, int y) const noexcept;
+  QPoint  getNearestGridPoint(const Point& pos) const noexcept;
+  quint64 getAllLayers() const noexcept;
+  quint64 getLayersAtPosition(int net, const Point& pos) const noexcept;
+  int     getCellIndex(int x, int y, int layer) const noexcept {
+    return (layer * mGridHeight + y) * mGridWidth + x;
+  }
+  static QVector<QPoint>  getDisc(qreal radius) noexcept;
+  static QVector<QPointF> flatten(const Path& path) noexcept;
+  static QPointF          toNm(const Point& p) noexcept;
+  static qreal            getDistanceSquared(const QPointF& p,
+                                             const QPointF& s1,
+                                             const QPointF& s2) noexcept;
+  static bool contains(const QVector<QPointF>& polygon,
+                       const QPointF&          p) noexcept;
+
+private:  // Data
+  const Board& mBoard;
+  Options      mOptions;
+
+  // Input
+  QStringList                  mLayerNames;  ///< Enabled copper layers
+  QVector<NetSignal*>          mNetSignals;
+  QHash<const NetSignal*, int> mNetIndices;
+  QVector<Connection>          mConnections;
+  QVector<QVector<int>>        mConnectionsOfNet;
+
+  // The grid
+  Point           mGridOrigin;
+  int             mGridWidth;
+  int             mGridHeight;
+  QVector<qint32> mFixedNet;      ///< Net of existing copper, or #sBlocked
+  QVector<float>  mHistoryCost;   ///< Increased whenever a cell is contested
+  QVector<QPoint> mTraceDisc;     ///< Cells occupied around a trace point
+  QVector<QPoint> mViaDisc;       ///< Cells occupied around a via
+  QVector<QPoint> mViaCheckDisc;  ///< Cells which must be passable for a via
+
+  /**
+   * Routes occupy the cells where other nets must not place a trace center.
+   * Since the occupied areas of several nets may overlap, each cell counts
+   * the number n of markings, the sum of (net index + 1) and the sum of
+   * (net index + 1)^2. A cell is only occupied by net k if both sums are
+   * equal to n * (k + 1) and n * (k + 1)^2 (i.e. the variance is zero).
+   * Unlike a list of nets per cell, this allows to unmark routes (rip-up)
+   * and to update disjoint parts of the grid from several threads.
+   *
+   * Since the non-const accessors of QVector may detach (i.e. modify the
+   * vector itself) which is not thread-safe, everything written by the worker
+   * threads of #routeNetsInParallel() is accessed without them: These arrays
+   * are std::vectors, and #mConnections is accessed through a pointer which is
+   * obtained before starting the threads.
+   */
+  std::vector<qint32> mRoutedCount;
+  std::vector<qint64> mRoutedNetSum;
+  std::vector<qint64> mRoutedNetSquareSum;
+
+  // Output
+  QList<Route>                 mRoutes;
+  QVector<QPair<Point, Point>> mUnroutedAirWires;
+  int                          mIterationCount;
+  std::atomic<bool>            mAborted;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDAUTOROUTER_H
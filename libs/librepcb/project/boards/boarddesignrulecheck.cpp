@@ -0,0 +1,684 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boarddesignrulecheck.h"
+
+#include "../circuit/componentinstance.h"
+#include "../circuit/netsignal.h"
+#include "../erc/ercmsg.h"
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_plane.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/library/pkg/packagepad.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+#include <algorithm>
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Struct Options
+ ******************************************************************************/
+
+BoardDesignRuleCheck::Options::Options() noexcept
+  : minCopperWidth(200000),
+    minDrillDiameter(300000),
+    minAnnularRing(150000),
+    minOutlineClearance(300000) {
+}
+
+bool BoardDesignRuleCheck::Options::operator==(const Options& rhs) const
+    noexcept {
+  return (minCopperWidth == rhs.minCopperWidth) &&
+         (minDrillDiameter == rhs.minDrillDiameter) &&
+         (minAnnularRing == rhs.minAnnularRing) &&
+         (minOutlineClearance == rhs.minOutlineClearance);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board) noexcept
+  : mBoard(board),
+    mOptions(),
+    mViolations(),
+    mErcMessages(),
+    mCacheValid(false),
+    mCachedOptions(),
+    mCachedCopperClearance(0),
+    mCachedBoardArea(),
+    mCachedObjects(),
+    mConvertedAreas() {
+}
+
+BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
+  clear();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::execute() {
+  run(false);  // can throw
+}
+
+void BoardDesignRuleCheck::update() {
+  run(true);  // can throw
+}
+
+const ErcMsg* BoardDesignRuleCheck::getErcMsg(
+    const Violation& violation) const noexcept {
+  return mErcMessages.value(getErcMsgKey(violation, nullptr, nullptr));
+}
+
+void BoardDesignRuleCheck::clear() noexcept {
+  mViolations.clear();
+  qDeleteAll(mErcMessages);
+  mErcMessages.clear();
+  mCacheValid = false;
+  mCachedBoardArea.clear();
+  mCachedObjects.clear();
+  mConvertedAreas.clear();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QString BoardDesignRuleCheck::violationTypeToString(
+    ViolationType type) noexcept {
+  switch (type) {
+    case ViolationType::CopperClearance:
+      return "copper_clearance";
+    case ViolationType::CopperWidth:
+      return "copper_width";
+    case ViolationType::DrillDiameter:
+      return "drill_diameter";
+    case ViolationType::AnnularRing:
+      return "annular_ring";
+    case ViolationType::OutlineClearance:
+      return "outline_clearance";
+    default:
+      Q_ASSERT(false);
+      return QString();
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::run(bool incremental) {
+  // Collect the copper geometry in this thread since the board items are not
+  // thread-safe, then check each copper layer in a separate worker thread.
+  QList<LayerJob>   jobs      = collectCopperObjects();
+  ClipperLib::Paths boardArea = getBoardArea();
+  Options           options   = mOptions;
+  UnsignedLength    clearance = mBoard.getDesignRules().getCopperClearance();
+  if ((!mCacheValid) || (options != mCachedOptions) ||
+      (clearance != mCachedCopperClearance) ||
+      (boardArea != mCachedBoardArea)) {
+    incremental = false;  // all cached results are outdated
+  }
+  mCacheValid = false;  // the cache is consumed now
+
+  // Reuse the cached expanded geometry of all unmodified objects. Objects
+  // which were modified or removed invalidate all their violations.
+  QHash<QString, QSet<QString>> invalidatedKeys;  // by layer
+  if (incremental) {
+    for (LayerJob& job : jobs) {
+      QHash<QString, CopperObject> cached =
+          mCachedObjects.take(job.layerName);
+      QSet<QString>& invalidated = invalidatedKeys[job.layerName];
+      for (CopperObject& obj : job.objects) {
+        auto it = cached.find(obj.key);
+        if ((it != cached.end()) && (it->netSignal == obj.netSignal) &&
+            (it->area == obj.area)) {
+          obj.expandedArea.swap(it->expandedArea);
+          obj.expandedRect = it->expandedRect;
+          obj.modified     = false;
+        } else {
+          invalidated.insert(obj.key);
+        }
+        cached.remove(obj.key);
+      }
+      invalidated += QSet<QString>::fromList(cached.keys());  // removed
+    }
+  }
+
+  QList<QFuture<void>> futures;
+  for (int i = 0; i < jobs.count(); ++i) {
+    LayerJob* job = &jobs[i];
+    futures.append(QtConcurrent::run([job, options, clearance, &boardArea]() {
+      checkLayer(*job, options, clearance, boardArea);
+    }));
+  }
+  foreach (QFuture<void> future, futures) { future.waitForFinished(); }
+  foreach (const LayerJob& job, jobs) {
+    if (!job.error.isEmpty()) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString(tr("Failed to check layer \"%1\": %2"))
+              .arg(job.layerName, job.error));
+    }
+  }
+
+  // keep the violations between unmodified objects
+  QList<Violation> keptViolations;
+  if (incremental) {
+    foreach (const Violation& violation, mViolations) {
+      if ((violation.type != ViolationType::CopperClearance) &&
+          (violation.type != ViolationType::OutlineClearance)) {
+        continue;  // not checked incrementally
+      }
+      if (!invalidatedKeys.contains(violation.layerName)) continue;
+      const QSet<QString>& invalidated = invalidatedKeys[violation.layerName];
+      bool                 valid       = true;
+      foreach (const QString& key, violation.objectKeys) {
+        if (invalidated.contains(key)) valid = false;
+      }
+      if (valid) keptViolations.append(violation);
+    }
+  }
+
+  // the cheap checks don't need to run in parallel or incrementally
+  mViolations.clear();
+  checkMinimumWidths();
+  checkDrillsAndAnnularRings();
+  mViolations.append(keptViolations);
+  mCachedObjects.clear();
+  foreach (const LayerJob& job, jobs) {
+    mViolations.append(job.violations);
+    QHash<QString, CopperObject>& cached = mCachedObjects[job.layerName];
+    foreach (const CopperObject& obj, job.objects) {
+      cached.insert(obj.key, obj);
+    }
+  }
+  mCacheValid      = true;
+  mCachedOptions         = options;
+  mCachedCopperClearance = clearance;
+  mCachedBoardArea       = boardArea;
+  updateErcMessages();
+}
+
+void BoardDesignRuleCheck::checkMinimumWidths() noexcept {
+  const UnsignedLength& minWidth = mOptions.minCopperWidth;
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (*netline->getWidth() < *minWidth) {
+        addViolation(
+            ViolationType::CopperWidth, netline->getLayer().getName(),
+            "netline:" % netline->getUuid().toStr(),
+            QString(tr("Trace of net \"%1\" is thinner than %2 mm"))
+                .arg(*netsegment->getNetSignal().getName(),
+                     minWidth->toMmString()),
+            netline->getSceneOutline());
+      }
+    }
+  }
+  foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+    if (*plane->getMinWidth() < *minWidth) {
+      addViolation(
+          ViolationType::CopperWidth, *plane->getLayerName(),
+          "plane:" % plane->getUuid().toStr(),
+          QString(tr("Minimum width of plane \"%1\" is less than %2 mm"))
+              .arg(*plane->getNetSignal().getName(), minWidth->toMmString()),
+          plane->getOutline());
+    }
+  }
+}
+
+void BoardDesignRuleCheck::checkDrillsAndAnnularRings() noexcept {
+  const UnsignedLength& minDrill = mOptions.minDrillDiameter;
+  const UnsignedLength& minRing  = mOptions.minAnnularRing;
+
+  // vias
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      QString key = "via:" % via->getUuid().toStr();
+      QString net = *netsegment->getNetSignal().getName();
+      if (*via->getDrillDiameter() < *minDrill) {
+        addViolation(ViolationType::DrillDiameter, QString(), key,
+                     QString(tr("Drill of via in net \"%1\" is smaller than "
+                                "%2 mm"))
+                         .arg(net, minDrill->toMmString()),
+                     via->getSceneOutline());
+      }
+      Length ring = (*via->getSize() - *via->getDrillDiameter()) / 2;
+      if (ring < *minRing) {
+        addViolation(ViolationType::AnnularRing, QString(), key,
+                     QString(tr("Annular ring of via in net \"%1\" is smaller "
+                                "than %2 mm"))
+                         .arg(net, minRing->toMmString()),
+                     via->getSceneOutline());
+      }
+    }
+  }
+
+  // pads and holes of devices
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    QString             name      = *device->getComponentInstance().getName();
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      const library::FootprintPad& libPad = pad->getLibPad();
+      if ((libPad.getBoardSide() != library::FootprintPad::BoardSide::THT) ||
+          (*libPad.getDrillDiameter() == 0)) {
+        continue;
+      }
+      QString key     = QString("pad:%1:%2")
+                        .arg(device->getComponentInstanceUuid().toStr(),
+                             pad->getLibPadUuid().toStr());
+      QString padName = name % ":" % *pad->getLibPackagePad().getName();
+      if (*libPad.getDrillDiameter() < *minDrill) {
+        addViolation(ViolationType::DrillDiameter, QString(), key,
+                     QString(tr("Drill of pad \"%1\" is smaller than %2 mm"))
+                         .arg(padName, minDrill->toMmString()),
+                     pad->getSceneOutline());
+      }
+      Length size = qMin(*libPad.getWidth(), *libPad.getHeight());
+      Length ring = (size - *libPad.getDrillDiameter()) / 2;
+      if (ring < *minRing) {
+        addViolation(ViolationType::AnnularRing, QString(), key,
+                     QString(tr("Annular ring of pad \"%1\" is smaller than "
+                                "%2 mm"))
+                         .arg(padName, minRing->toMmString()),
+                     pad->getSceneOutline());
+      }
+    }
+    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+      if (*hole.getDiameter() < *minDrill) {
+        Point pos = footprint.mapToScene(hole.getPosition());
+        addViolation(ViolationType::DrillDiameter, QString(),
+                     QString("hole:%1:%2")
+                         .arg(device->getComponentInstanceUuid().toStr(),
+                              hole.getUuid().toStr()),
+                     QString(tr("Hole of \"%1\" is smaller than %2 mm"))
+                         .arg(name, minDrill->toMmString()),
+                     Path::circle(hole.getDiameter()).translated(pos));
+      }
+    }
+  }
+
+  // board holes
+  foreach (const BI_Hole* hole, mBoard.getHoles()) {
+    if (*hole->getHole().getDiameter() < *minDrill) {
+      addViolation(ViolationType::DrillDiameter, QString(),
+                   "hole:" % hole->getUuid().toStr(),
+                   QString(tr("Hole is smaller than %1 mm"))
+                       .arg(minDrill->toMmString()),
+                   Path::circle(hole->getHole().getDiameter())
+                       .translated(hole->getHole().getPosition()));
+    }
+  }
+}
+
+QList<BoardDesignRuleCheck::LayerJob>
+    BoardDesignRuleCheck::collectCopperObjects() noexcept {
+  QList<LayerJob> jobs;
+  foreach (const GraphicsLayer* layer,
+           mBoard.getLayerStack().getAllLayers()) {
+    if (layer->isCopperLayer() && layer->isEnabled()) {
+      LayerJob job;
+      job.layerName = layer->getName();
+      jobs.append(job);
+    }
+  }
+
+  // Flattening arcs is expensive, thus reuse the integer polygons of objects
+  // whose geometry is unchanged since the last run. Entries of objects which
+  // no longer exist are dropped by only keeping the entries used in this run.
+  QHash<QString, ConvertedArea> converted;
+  auto convert = [this, &converted](
+                     const QString&       key,
+                     const QVector<Path>& source) -> ClipperLib::Paths {
+    auto it = converted.constFind(key);  // e.g. THT pads on several layers
+    if ((it != converted.constEnd()) && (it->source == source)) {
+      return it->area;
+    }
+    ConvertedArea entry = mConvertedAreas.take(key);
+    if (entry.source != source) {
+      entry.source = source;
+      entry.area.clear();
+      foreach (const Path& path, source) {
+        entry.area.push_back(ClipperHelpers::convert(path, maxArcTolerance()));
+      }
+    }
+    converted.insert(key, entry);
+    return entry.area;
+  };
+
+  // vias are on all copper layers, thus convert them only once
+  QVector<CopperObject> vias;
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      CopperObject obj;
+      obj.key       = "via:" % via->getUuid().toStr();
+      obj.name      = tr("via");
+      obj.netSignal = netsegment->getNetSignal().getUuid();
+      obj.modified  = true;
+      obj.area      = convert(obj.key, {via->getSceneOutline()});
+      vias.append(obj);
+    }
+  }
+
+  for (LayerJob& job : jobs) {
+    const QString& layer = job.layerName;
+    job.objects += vias;
+
+    // traces
+    foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+      foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+        if (netline->getLayer().getName() != layer) continue;
+        CopperObject obj;
+        obj.key       = "netline:" % netline->getUuid().toStr();
+        obj.name      = tr("trace");
+        obj.netSignal = netsegment->getNetSignal().getUuid();
+        obj.modified  = true;
+        obj.area      = convert(obj.key, {netline->getSceneOutline()});
+        job.objects.append(obj);
+      }
+    }
+
+    // pads
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+      QString name = *device->getComponentInstance().getName();
+      foreach (const BI_FootprintPad* pad,
+               device->getFootprint().getPads()) {
+        if (!pad->isOnLayer(layer)) continue;
+        const NetSignal* netSignal = pad->getCompSigInstNetSignal();
+        CopperObject     obj;
+        obj.key       = QString("pad:%1:%2")
+                      .arg(device->getComponentInstanceUuid().toStr(),
+                           pad->getLibPadUuid().toStr());
+        obj.name      = QString(tr("pad %1:%2"))
+                       .arg(name, *pad->getLibPackagePad().getName());
+        obj.netSignal = netSignal ? tl::make_optional(netSignal->getUuid())
+                                  : tl::optional<Uuid>();
+        obj.modified  = true;
+        obj.area      = convert(obj.key, {pad->getSceneOutline()});
+        job.objects.append(obj);
+      }
+    }
+
+    // planes
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+      if (*plane->getLayerName() != layer) continue;
+      if (plane->getFragments().isEmpty()) continue;
+      CopperObject obj;
+      obj.key       = "plane:" % plane->getUuid().toStr();
+      obj.name      = tr("plane");
+      obj.netSignal = plane->getNetSignal().getUuid();
+      obj.modified  = true;
+      obj.area      = convert(obj.key, plane->getFragments());
+      job.objects.append(obj);
+    }
+
+    // polygons (not connected to any net)
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+      const Polygon& p = polygon->getPolygon();
+      if (*p.getLayerName() != layer) continue;
+      QVector<Path> outlines;
+      if (p.isFilled()) {
+        outlines.append(p.getPath());
+      }
+      if (*p.getLineWidth() > 0) {
+        PositiveLength         width(*p.getLineWidth());
+        const QVector<Vertex>& vertices = p.getPath().getVertices();
+        for (int i = 1; i < vertices.count(); ++i) {
+          const Vertex& v0 = vertices.at(i - 1);
+          const Vertex& v1 = vertices.at(i);
+          Path segment = Path::flatArc(v0.getPos(), v1.getPos(), v0.getAngle(),
+                                       maxArcTolerance());
+          for (int k = 1; k < segment.getVertices().count(); ++k) {
+            outlines.append(
+                Path::obround(segment.getVertices().at(k - 1).getPos(),
+                              segment.getVertices().at(k).getPos(), width));
+          }
+        }
+      }
+      CopperObject obj;
+      obj.key       = "polygon:" % polygon->getUuid().toStr();
+      obj.name      = tr("polygon");
+      obj.netSignal = tl::nullopt;
+      obj.modified  = true;
+      obj.area      = convert(obj.key, outlines);
+      job.objects.append(obj);
+    }
+  }
+  mConvertedAreas = converted;
+  return jobs;
+}
+
+ClipperLib::Paths BoardDesignRuleCheck::getBoardArea() const noexcept {
+  ClipperLib::Paths   boardArea;
+  ClipperLib::Clipper c;
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      ClipperLib::Path path = ClipperHelpers::convert(
+          polygon->getPolygon().getPath(), maxArcTolerance());
+      c.AddPath(path, ClipperLib::ptSubject, true);
+    }
+  }
+  c.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
+            ClipperLib::pftEvenOdd);
+  return boardArea;
+}
+
+void BoardDesignRuleCheck::updateErcMessages() noexcept {
+  QHash<QString, ErcMsg*> messages;
+  foreach (const Violation& violation, mViolations) {
+    QString ownerKey, msgKey;
+    QString key = getErcMsgKey(violation, &ownerKey, &msgKey);
+    if (messages.contains(key)) continue;
+    ErcMsg* ercMsg = mErcMessages.take(key);
+    if (!ercMsg) {
+      ercMsg = new ErcMsg(mBoard.getProject(), mBoard, ownerKey, msgKey,
+                          ErcMsg::ErcMsgType_t::BoardError);
+    }
+    ercMsg->setMsg(
+        QString("%1 (Board: %2)").arg(violation.message, *mBoard.getName()));
+    ercMsg->setVisible(true);
+    messages.insert(key, ercMsg);
+  }
+  qDeleteAll(mErcMessages);  // violations which no longer exist
+  mErcMessages = messages;
+}
+
+QString BoardDesignRuleCheck::getErcMsgKey(const Violation& violation,
+                                           QString*         ownerKey,
+                                           QString*         msgKey) const
+    noexcept {
+  QString owner = QString("%1/%2").arg(mBoard.getUuid().toStr(),
+                                       violation.objectKeys.join("/"));
+  QString msg   = "Drc_" % violationTypeToString(violation.type);
+  if (!violation.layerName.isEmpty()) {
+    msg += "_" % violation.layerName;
+  }
+  if (ownerKey) *ownerKey = owner;
+  if (msgKey) *msgKey = msg;
+  return owner % "|" % msg;
+}
+
+void BoardDesignRuleCheck::addViolation(ViolationType  type,
+                                        const QString& layerName,
+                                        const QString& objectKey,
+                                        const QString& message,
+                                        const Path&    location) noexcept {
+  Violation violation;
+  violation.type       = type;
+  violation.layerName  = layerName;
+  violation.objectKeys = QStringList{objectKey};
+  violation.message    = message;
+  violation.locations.append(location);
+  mViolations.append(violation);
+}
+
+void BoardDesignRuleCheck::checkLayer(
+    LayerJob& job, const Options& options,
+    const UnsignedLength& copperClearance,
+    const ClipperLib::Paths& boardArea) noexcept {
+  try {
+    expandObjects(job, copperClearance);              // can throw
+    checkCopperClearances(job, copperClearance);      // can throw
+    checkOutlineClearances(job, options, boardArea);  // can throw
+  } catch (const Exception& e) {
+    job.error = e.getMsg();
+  } catch (const std::exception& e) {
+    job.error = e.what();  // Clipper throws std::exceptions
+  }
+}
+
+void BoardDesignRuleCheck::expandObjects(
+    LayerJob& job, const UnsignedLength& copperClearance) {
+  // Expand all objects by half of the clearance, thus every overlap of two
+  // expanded objects is a clearance violation. A small tolerance avoids
+  // reporting objects which are exactly at the minimum clearance.
+  const Length tolerance(10);
+  const Length expansion = (copperClearance / 2) - tolerance;
+  for (CopperObject& obj : job.objects) {
+    if (!obj.modified) continue;  // already expanded in a previous run
+    obj.expandedArea = obj.area;
+    if (expansion > 0) {
+      ClipperHelpers::offset(obj.expandedArea, expansion,
+                             maxArcTolerance());  // can throw
+    }
+    obj.expandedRect = ClipperHelpers::getBoundingRect(obj.expandedArea);
+  }
+}
+
+void BoardDesignRuleCheck::checkCopperClearances(
+    LayerJob& job, const UnsignedLength& copperClearance) {
+  if (*copperClearance == 0) return;
+
+  // broad phase: sweep and prune along the x axis
+  QVector<int> indices;
+  for (int i = 0; i < job.objects.count(); ++i) {
+    if (!job.objects.at(i).expandedArea.empty()) indices.append(i);
+  }
+  std::sort(indices.begin(), indices.end(), [&job](int a, int b) {
+    return job.objects.at(a).expandedRect.left <
+        job.objects.at(b).expandedRect.left;
+  });
+  for (int i = 0; i < indices.count(); ++i) {
+    const CopperObject&        objA  = job.objects.at(indices.at(i));
+    const ClipperLib::IntRect& rectA = objA.expandedRect;
+    for (int k = i + 1; k < indices.count(); ++k) {
+      const CopperObject&        objB  = job.objects.at(indices.at(k));
+      const ClipperLib::IntRect& rectB = objB.expandedRect;
+      if (rectB.left > rectA.right) break;  // no more candidates
+      if ((rectB.top > rectA.bottom) || (rectB.bottom < rectA.top)) continue;
+      if ((!objA.modified) && (!objB.modified)) continue;  // still valid
+      if (objA.netSignal && (objA.netSignal == objB.netSignal)) continue;
+      if (objA.key == objB.key) continue;
+
+      // narrow phase: intersect the expanded areas
+      ClipperLib::Paths   intersections;
+      ClipperLib::Clipper c;
+      c.AddPaths(objA.expandedArea, ClipperLib::ptSubject, true);
+      c.AddPaths(objB.expandedArea, ClipperLib::ptClip, true);
+      c.Execute(ClipperLib::ctIntersection, intersections,
+                ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+      if (intersections.empty()) continue;
+
+      Violation violation;
+      violation.type       = ViolationType::CopperClearance;
+      violation.layerName  = job.layerName;
+      violation.objectKeys = QStringList{objA.key, objB.key};
+      violation.objectKeys.sort();  // for stable ERC message keys
+      violation.message =
+          QString(tr("Clearance between %1 and %2 on layer \"%3\" is less "
+                     "than %4 mm"))
+              .arg(objA.name, objB.name, job.layerName,
+                   copperClearance->toMmString());
+      violation.locations = ClipperHelpers::convert(intersections);
+      job.violations.append(violation);
+    }
+  }
+}
+
+void BoardDesignRuleCheck::checkOutlineClearances(
+    LayerJob& job, const Options& options, const ClipperLib::Paths& boardArea) {
+  if (boardArea.empty()) return;
+
+  // all copper must be located within the shrinked board area
+  const Length      tolerance(10);
+  ClipperLib::Paths allowedArea = boardArea;
+  if (*options.minOutlineClearance > tolerance) {
+    ClipperHelpers::offset(allowedArea,
+                           tolerance - *options.minOutlineClearance,
+                           maxArcTolerance());  // can throw
+  }
+  foreach (const CopperObject& obj, job.objects) {
+    if ((!obj.modified) || obj.area.empty()) continue;
+    ClipperLib::Paths   outside;
+    ClipperLib::Clipper c;
+    c.AddPaths(obj.area, ClipperLib::ptSubject, true);
+    c.AddPaths(allowedArea, ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctDifference, outside, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    if (outside.empty()) continue;
+
+    Violation violation;
+    violation.type       = ViolationType::OutlineClearance;
+    violation.layerName  = job.layerName;
+    violation.objectKeys = QStringList{obj.key};
+    violation.message =
+        QString(tr("Clearance between %1 and board outline on layer \"%2\" is "
+                   "less than %3 mm"))
+            .arg(obj.name, job.layerName,
+                 options.minOutlineClearance->toMmString());
+    violation.locations = ClipperHelpers::convert(outside);
+    job.violations.append(violation);
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
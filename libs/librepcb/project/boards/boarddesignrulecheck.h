@@ -0,0 +1,268 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <clipper/clipper.hpp>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class ErcMsg;
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheck
+ ******************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheck class checks the copper of a board against
+ *        manufacturing rules (DRC)
+ *
+ * Following rules are checked:
+ *
+ *   - Clearance between copper objects of different nets on the same layer
+ *     (traces, vias, pads, planes and polygons)
+ *   - Minimum width of traces and planes
+ *   - Minimum diameter of via, pad and hole drills
+ *   - Minimum annular ring of vias and THT pads
+ *   - Clearance between copper objects and the board outline
+ *
+ * The copper geometry is collected from the board items in the caller's
+ * thread and converted to integer polygons. Then each copper layer is checked
+ * in a separate worker thread. For the clearance check, the bounding boxes of
+ * all objects of a layer are sorted along the x axis (sweep and prune), so
+ * only pairs of objects with overlapping bounding boxes are passed to the
+ * expensive polygon intersection of Clipper.
+ *
+ * All found violations are reported as ::librepcb::project::ErcMsg objects of
+ * the board, so they appear in the ERC messages dock. Messages of violations
+ * which still exist after a re-run are kept, thus they remain ignored if the
+ * user has ignored them.
+ *
+ * For interactive use, #update() rechecks only the objects which have been
+ * modified since the last run: The expanded geometry of all objects is cached,
+ * and only pairs of objects where at least one of them has been added or
+ * modified are intersected again. Violations between unmodified objects are
+ * kept as they are. In addition, the integer polygons of each object are
+ * cached together with the geometry they were converted from, so arcs of
+ * unmodified objects are not flattened again. The caches are keyed by the
+ * UUIDs of the objects and don't keep pointers to board items, since these
+ * might be deleted at any time (e.g. by undo commands).
+ *
+ * The check only reads the geometry of the board items and never creates or
+ * accesses any graphics items, so it can be run headless (e.g. by the command
+ * line interface). Note however that loading a project still creates the
+ * graphics items of all board items because they own them.
+ */
+class BoardDesignRuleCheck final {
+  Q_DECLARE_TR_FUNCTIONS(BoardDesignRuleCheck)
+
+public:
+  // Types
+  /**
+   * @brief Options of the checks
+   *
+   * The minimum copper clearance is not an option since it is taken from the
+   * board design rules (::librepcb::BoardDesignRules::getCopperClearance()),
+   * which are also used by the trace router.
+   */
+  struct Options {
+    UnsignedLength minCopperWidth;
+    UnsignedLength minDrillDiameter;
+    UnsignedLength minAnnularRing;
+    UnsignedLength minOutlineClearance;
+
+    Options() noexcept;
+    bool operator==(const Options& rhs) const noexcept;
+    bool operator!=(const Options& rhs) const noexcept {
+      return !(*this == rhs);
+    }
+  };
+
+  enum class ViolationType {
+    CopperClearance,
+    CopperWidth,
+    DrillDiameter,
+    AnnularRing,
+    OutlineClearance,
+  };
+
+  struct Violation {
+    ViolationType type;
+    QString       layerName;   ///< Empty if not related to a specific layer
+    QStringList   objectKeys;  ///< Unique keys of the involved objects
+    QString       message;
+    QVector<Path> locations;  ///< Areas where the violation occurs
+  };
+
+  // Constructors / Destructor
+  BoardDesignRuleCheck()                                  = delete;
+  BoardDesignRuleCheck(const BoardDesignRuleCheck& other) = delete;
+  explicit BoardDesignRuleCheck(Board& board) noexcept;
+  ~BoardDesignRuleCheck() noexcept;
+
+  // Getters
+  const Options&          getOptions() const noexcept { return mOptions; }
+  const QList<Violation>& getViolations() const noexcept {
+    return mViolations;
+  }
+
+  // Setters
+  void setOptions(const Options& options) noexcept { mOptions = options; }
+
+  // General Methods
+
+  /**
+   * @brief Check the whole board and update the ERC messages
+   *
+   * @note Must be called from the thread the board lives in.
+   *
+   * @throw Exception if the geometry could not be processed.
+   */
+  void execute();
+
+  /**
+   * @brief Recheck only the objects modified since the last check and update
+   *        the ERC messages in place
+   *
+   * If the options, the copper clearance of the board design rules or the
+   * board outline have been changed since the last run (or there was no run
+   * yet), the whole board is checked.
+   *
+   * @note Must be called from the thread the board lives in.
+   *
+   * @throw Exception if the geometry could not be processed.
+   */
+  void update();
+
+  /**
+   * @brief Get the ERC message of a violation
+   *
+   * @param violation   One of the violations returned by #getViolations().
+   *
+   * @return The ERC message (e.g. to check whether it is ignored) or nullptr.
+   */
+  const ErcMsg* getErcMsg(const Violation& violation) const noexcept;
+
+  /**
+   * @brief Remove all violations and their ERC messages
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  BoardDesignRuleCheck& operator=(const BoardDesignRuleCheck& rhs) = delete;
+
+  // Static Methods
+  static QString violationTypeToString(ViolationType type) noexcept;
+
+private:  // Types
+  /// A copper area on a specific layer, prepared for the worker threads
+  struct CopperObject {
+    QString             key;
+    QString             name;
+    tl::optional<Uuid>  netSignal;     ///< nullopt if not connected to a net
+    ClipperLib::Paths   area;
+    ClipperLib::Paths   expandedArea;  ///< Expanded by half the clearance
+    ClipperLib::IntRect expandedRect;  ///< Bounding rect of expandedArea
+    bool                modified;      ///< Whether it needs to be checked
+  };
+
+  /// The input and output data of a worker thread
+  struct LayerJob {
+    QString               layerName;
+    QVector<CopperObject> objects;
+    QList<Violation>      violations;
+    QString               error;
+  };
+
+  /// Integer polygons of an object and the geometry they were converted from
+  struct ConvertedArea {
+    QVector<Path>     source;
+    ClipperLib::Paths area;
+  };
+
+private:  // Methods
+  void              run(bool incremental);
+  void              checkMinimumWidths() noexcept;
+  void              checkDrillsAndAnnularRings() noexcept;
+  QList<LayerJob>   collectCopperObjects() noexcept;
+  ClipperLib::Paths getBoardArea() const noexcept;
+  void              updateErcMessages() noexcept;
+  QString           getErcMsgKey(const Violation& violation, QString* ownerKey,
+                                 QString* msgKey) const noexcept;
+  void              addViolation(ViolationType type, const QString& layerName,
+                                 const QString& objectKey,
+                                 const QString& message,
+                                 const Path&    location) noexcept;
+
+  static void checkLayer(LayerJob& job, const Options& options,
+                         const UnsignedLength&    copperClearance,
+                         const ClipperLib::Paths& boardArea) noexcept;
+  static void expandObjects(LayerJob&             job,
+                            const UnsignedLength& copperClearance);
+  static void checkCopperClearances(LayerJob&             job,
+                                    const UnsignedLength& copperClearance);
+  static void checkOutlineClearances(LayerJob& job, const Options& options,
+                                     const ClipperLib::Paths& boardArea);
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. It is
+   * small compared to typical clearances, thus it doesn't hide violations.
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+private:  // Data
+  Board&                  mBoard;
+  Options                 mOptions;
+  QList<Violation>        mViolations;
+  QHash<QString, ErcMsg*> mErcMessages;  ///< key: owner key + message key
+
+  // Cache of the last run, used by #update()
+  bool              mCacheValid;
+  Options           mCachedOptions;
+  UnsignedLength    mCachedCopperClearance;
+  ClipperLib::Paths mCachedBoardArea;
+  QHash<QString, QHash<QString, CopperObject>> mCachedObjects;  ///< by layer
+  QHash<QString, ConvertedArea> mConvertedAreas;  ///< by object key
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
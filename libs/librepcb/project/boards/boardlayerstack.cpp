@@ -222,6 +222,8 @@ void BoardLayerStack::addLayer(const QString& name, bool disable) noexcept {
 void BoardLayerStack::addLayer(GraphicsLayer* layer) noexcept {
   connect(layer, &GraphicsLayer::attributesChanged, this,
           &BoardLayerStack::layerAttributesChanged, Qt::QueuedConnection);
+  connect(layer, &GraphicsLayer::attributesChanged, this,
+          &BoardLayerStack::layerAttributesModified);
   mLayers.append(layer);
 }
 
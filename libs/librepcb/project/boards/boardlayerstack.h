@@ -90,6 +90,13 @@ public:
   // Operator Overloadings
   BoardLayerStack& operator=(const BoardLayerStack& rhs) = delete;
 
+signals:
+  /**
+   * @brief Emitted (synchronously) whenever an attribute of any layer has
+   *        changed, e.g. its color or visibility
+   */
+  void layerAttributesModified();
+
 private slots:
   void layerAttributesChanged() noexcept;
   void boardAttributesChanged() noexcept;
@@ -0,0 +1,394 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardtracerouter.h"
+
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/library/pkg/footprint.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+constexpr qreal BoardTraceRouter::sCellSize;
+constexpr int   BoardTraceRouter::sMaxCellsPerObstacle;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardTraceRouter::BoardTraceRouter(const Board& board, const QString& layerName,
+                                   const NetSignal&      netsignal,
+                                   const UnsignedLength& clearance) noexcept
+  : mLayerName(layerName), mClearance(clearance), mQueryCounter(0) {
+  // traces and vias of other nets
+  foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+    if (&netsegment->getNetSignal() == &netsignal) continue;
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().getName() != layerName) continue;
+      addObstacle(Path::line(netline->getStartPoint().getPosition(),
+                             netline->getEndPoint().getPosition()),
+                  *netline->getWidth(), false);
+    }
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      addObstacle(via->getPosition(), *via->getSize());
+    }
+  }
+
+  // pads of other nets and holes of footprints
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      if (pad->getCompSigInstNetSignal() == &netsignal) continue;
+      if (!pad->isOnLayer(layerName)) continue;
+      addObstacle(pad->getSceneOutline(), Length(0), true);
+    }
+    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+      addObstacle(footprint.mapToScene(hole.getPosition()),
+                  *hole.getDiameter());
+    }
+  }
+
+  // polygons (not connected to any net)
+  foreach (const BI_Polygon* polygon, board.getPolygons()) {
+    const Polygon& p = polygon->getPolygon();
+    if (*p.getLayerName() != layerName) continue;
+    addObstacle(p.getPath(), *p.getLineWidth(), p.isFilled());
+  }
+
+  // board holes
+  foreach (const BI_Hole* hole, board.getHoles()) {
+    addObstacle(hole->getHole().getPosition(), *hole->getHole().getDiameter());
+  }
+
+  mVisitedInQuery.fill(0, mObstacles.count());
+}
+
+BoardTraceRouter::~BoardTraceRouter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool BoardTraceRouter::isFree(const Point& p1, const Point& p2,
+                              const PositiveLength& width) const noexcept {
+  return !collides(toNm(p1), toNm(p2), width->toNm() / qreal(2), QSet<int>());
+}
+
+BoardTraceRouter::Result BoardTraceRouter::route(
+    const Point& start, const QVector<Point>& middlePoints, const Point& end,
+    const PositiveLength& width) const noexcept {
+  Q_ASSERT(!middlePoints.isEmpty());
+  qreal   radius  = width->toNm() / qreal(2);
+  QPointF startNm = toNm(start);
+  QPointF endNm   = toNm(end);
+
+  // ignore obstacles which are already too close to the start point
+  QSet<int> ignored = getCollisions(startNm, radius);
+
+  // walk around obstacles by taking the first collision-free bend
+  foreach (const Point& middle, middlePoints) {
+    QPointF middleNm = toNm(middle);
+    if ((!collides(startNm, middleNm, radius, ignored)) &&
+        (!collides(middleNm, endNm, radius, ignored))) {
+      return Result{middle, end, false};
+    }
+  }
+
+  // hug the first obstacle along the preferred path
+  const Point& middle = middlePoints.first();
+  Point        p = findLastFreePoint(start, middle, radius, ignored);
+  if (p != middle) {
+    return Result{p, p, true};
+  } else {
+    return Result{middle, findLastFreePoint(middle, end, radius, ignored),
+                  true};
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardTraceRouter::addObstacle(const Path& path, const Length& width,
+                                   bool filled) noexcept {
+  Obstacle obstacle;
+  obstacle.radius = width.toNm() / qreal(2);
+  obstacle.filled = filled;
+  const QVector<Vertex>& vertices = path.getVertices();
+  for (int i = 0; i < vertices.count(); ++i) {
+    if ((i > 0) && (vertices.at(i - 1).getAngle() != Angle::deg0())) {
+      // approximate arcs with a tolerance of 5um
+      Path arc = Path::flatArc(vertices.at(i - 1).getPos(),
+                               vertices.at(i).getPos(),
+                               vertices.at(i - 1).getAngle(),
+                               PositiveLength(5000));
+      for (int k = 1; k < arc.getVertices().count(); ++k) {
+        obstacle.vertices.append(toNm(arc.getVertices().at(k).getPos()));
+      }
+    } else {
+      obstacle.vertices.append(toNm(vertices.at(i).getPos()));
+    }
+  }
+  if ((obstacle.radius > 0) || (filled && (obstacle.vertices.count() > 2))) {
+    addObstacle(obstacle);
+  }
+}
+
+void BoardTraceRouter::addObstacle(const Point&  pos,
+                                   const Length& diameter) noexcept {
+  Obstacle obstacle;
+  obstacle.vertices.append(toNm(pos));
+  obstacle.radius = diameter.toNm() / qreal(2);
+  obstacle.filled = false;
+  addObstacle(obstacle);
+}
+
+void BoardTraceRouter::addObstacle(Obstacle obstacle) noexcept {
+  if (obstacle.vertices.isEmpty()) return;
+  qreal left   = obstacle.vertices.first().x();
+  qreal right  = left;
+  qreal top    = obstacle.vertices.first().y();
+  qreal bottom = top;
+  foreach (const QPointF& p, obstacle.vertices) {
+    left   = qMin(left, p.x());
+    right  = qMax(right, p.x());
+    top    = qMin(top, p.y());
+    bottom = qMax(bottom, p.y());
+  }
+  obstacle.rect = QRectF(QPointF(left, top), QPointF(right, bottom))
+                      .adjusted(-obstacle.radius, -obstacle.radius,
+                                obstacle.radius, obstacle.radius);
+
+  // Insert the obstacle into all cells touched by its rect expanded by the
+  // clearance. Then the cells touched by a trace are all that need to be
+  // checked for collisions with it.
+  int    index = mObstacles.count();
+  qreal  c     = mClearance->toNm();
+  QRectF rect  = obstacle.rect.adjusted(-c, -c, c, c);
+  int    x1    = static_cast<int>(std::floor(rect.left() / sCellSize));
+  int    x2    = static_cast<int>(std::floor(rect.right() / sCellSize));
+  int    y1    = static_cast<int>(std::floor(rect.top() / sCellSize));
+  int    y2    = static_cast<int>(std::floor(rect.bottom() / sCellSize));
+  mObstacles.append(obstacle);
+  if ((qint64(x2 - x1 + 1) * qint64(y2 - y1 + 1)) > sMaxCellsPerObstacle) {
+    mLargeObstacles.append(index);
+  } else {
+    for (int x = x1; x <= x2; ++x) {
+      for (int y = y1; y <= y2; ++y) {
+        mGrid[getCellKey(x, y)].append(index);
+      }
+    }
+  }
+}
+
+bool BoardTraceRouter::collides(const QPointF& p1, const QPointF& p2,
+                                qreal            radius,
+                                const QSet<int>& ignored) const noexcept {
+  foreach (int index, getCandidates(p1, p2, radius)) {
+    if ((!ignored.contains(index)) &&
+        collides(mObstacles.at(index), p1, p2, radius)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QSet<int> BoardTraceRouter::getCollisions(const QPointF& pos,
+                                          qreal radius) const noexcept {
+  QSet<int> indices;
+  foreach (int index, getCandidates(pos, pos, radius)) {
+    if (collides(mObstacles.at(index), pos, pos, radius)) {
+      indices.insert(index);
+    }
+  }
+  return indices;
+}
+
+QVector<int> BoardTraceRouter::getCandidates(const QPointF& p1,
+                                             const QPointF& p2,
+                                             qreal radius) const noexcept {
+  QRectF rect =
+      QRectF(p1, p2).normalized().adjusted(-radius, -radius, radius, radius);
+  int x1 = static_cast<int>(std::floor(rect.left() / sCellSize));
+  int x2 = static_cast<int>(std::floor(rect.right() / sCellSize));
+  int y1 = static_cast<int>(std::floor(rect.top() / sCellSize));
+  int y2 = static_cast<int>(std::floor(rect.bottom() / sCellSize));
+
+  // only the obstacles in the cells touched by the trace's bounding rect
+  ++mQueryCounter;
+  QVector<int> indices = mLargeObstacles;
+  for (int x = x1; x <= x2; ++x) {
+    for (int y = y1; y <= y2; ++y) {
+      auto it = mGrid.constFind(getCellKey(x, y));
+      if (it == mGrid.constEnd()) continue;
+      foreach (int index, *it) {
+        if (mVisitedInQuery[index] != mQueryCounter) {
+          mVisitedInQuery[index] = mQueryCounter;
+          indices.append(index);
+        }
+      }
+    }
+  }
+  return indices;
+}
+
+bool BoardTraceRouter::collides(const Obstacle& obstacle, const QPointF& p1,
+                                const QPointF& p2, qreal radius) const
+    noexcept {
+  qreal  c = mClearance->toNm();
+  qreal  d = radius + obstacle.radius + c;
+  QRectF rect =
+      QRectF(p1, p2).normalized().adjusted(-radius - c, -radius - c,
+                                           radius + c, radius + c);
+  if (!rect.intersects(obstacle.rect)) {
+    return false;  // fast path, far away
+  }
+  const QVector<QPointF>& v = obstacle.vertices;
+  if (v.count() == 1) {
+    return getDistanceSquared(v.first(), p1, p2) < d * d;
+  }
+  for (int i = 1; i < v.count(); ++i) {
+    if (getDistanceSquared(v.at(i - 1), v.at(i), p1, p2) < d * d) {
+      return true;
+    }
+  }
+  if (obstacle.filled) {
+    return (getDistanceSquared(v.last(), v.first(), p1, p2) < d * d) ||
+           contains(v, p1);
+  }
+  return false;
+}
+
+Point BoardTraceRouter::findLastFreePoint(const Point& p1, const Point& p2,
+                                          qreal            radius,
+                                          const QSet<int>& ignored) const
+    noexcept {
+  QPointF p1Nm = toNm(p1);
+  QPointF p2Nm = toNm(p2);
+  if (!collides(p1Nm, p2Nm, radius, ignored)) {
+    return p2;
+  }
+
+  // binary search along the line, with a resolution of 1um
+  Point delta  = p2 - p1;
+  qreal length = std::sqrt(std::pow(delta.getX().toNm(), 2) +
+                           std::pow(delta.getY().toNm(), 2));
+  qreal lower  = 0;  // free
+  qreal upper  = 1;  // collides
+  while ((upper - lower) * length > 1000) {
+    qreal   t = (lower + upper) / 2;
+    QPointF p = p1Nm + (p2Nm - p1Nm) * t;
+    if (collides(p1Nm, p, radius, ignored)) {
+      upper = t;
+    } else {
+      lower = t;
+    }
+  }
+
+  // truncate towards p1 to not end up in the obstacle due to rounding
+  LengthBase_t dx = static_cast<LengthBase_t>(delta.getX().toNm() * lower);
+  LengthBase_t dy = static_cast<LengthBase_t>(delta.getY().toNm() * lower);
+  return p1 + Point(dx, dy);
+}
+
+QPointF BoardTraceRouter::toNm(const Point& p) noexcept {
+  return QPointF(p.getX().toNm(), p.getY().toNm());
+}
+
+quint64 BoardTraceRouter::getCellKey(int x, int y) noexcept {
+  return (quint64(quint32(x)) << 32) | quint64(quint32(y));
+}
+
+qreal BoardTraceRouter::getDistanceSquared(const QPointF& p, const QPointF& s1,
+                                           const QPointF& s2) noexcept {
+  QPointF s      = s2 - s1;
+  qreal   length = QPointF::dotProduct(s, s);
+  qreal   t      = 0;
+  if (length > 0) {
+    t = qBound(qreal(0), QPointF::dotProduct(p - s1, s) / length, qreal(1));
+  }
+  QPointF diff = p - (s1 + s * t);
+  return QPointF::dotProduct(diff, diff);
+}
+
+qreal BoardTraceRouter::getDistanceSquared(const QPointF& a1,
+                                           const QPointF& a2,
+                                           const QPointF& b1,
+                                           const QPointF& b2) noexcept {
+  // if the segments intersect, the distance is zero
+  auto cross = [](const QPointF& o, const QPointF& a, const QPointF& b) {
+    return (a.x() - o.x()) * (b.y() - o.y()) -
+           (a.y() - o.y()) * (b.x() - o.x());
+  };
+  qreal d1 = cross(b1, b2, a1);
+  qreal d2 = cross(b1, b2, a2);
+  qreal d3 = cross(a1, a2, b1);
+  qreal d4 = cross(a1, a2, b2);
+  if ((((d1 > 0) && (d2 < 0)) || ((d1 < 0) && (d2 > 0))) &&
+      (((d3 > 0) && (d4 < 0)) || ((d3 < 0) && (d4 > 0)))) {
+    return 0;
+  }
+  return qMin(
+      qMin(getDistanceSquared(a1, b1, b2), getDistanceSquared(a2, b1, b2)),
+      qMin(getDistanceSquared(b1, a1, a2), getDistanceSquared(b2, a1, a2)));
+}
+
+bool BoardTraceRouter::contains(const QVector<QPointF>& polygon,
+                                const QPointF&          p) noexcept {
+  // even-odd rule
+  bool inside = false;
+  for (int i = 0, k = polygon.count() - 1; i < polygon.count(); k = i++) {
+    const QPointF& a = polygon.at(i);
+    const QPointF& b = polygon.at(k);
+    if (((a.y() > p.y()) != (b.y() > p.y())) &&
+        (p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,187 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+#define LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardTraceRouter
+ ******************************************************************************/
+
+/**
+ * @brief The BoardTraceRouter class avoids obstacles while interactively
+ *        drawing a trace
+ *
+ * On construction, the copper objects of all other nets on a layer (traces,
+ * vias, pads and polygons) and all holes are collected once and stored in a
+ * uniform grid. Afterwards, #route() only checks the trace against the
+ * obstacles in the grid cells it touches, thus it is fast enough to be called
+ * on every mouse move, even on dense boards.
+ *
+ * A trace consists of a fixed start point, a middle point and the end point
+ * (the cursor position). #route() tries the given middle points in order and
+ * returns the first path which keeps the clearance to all obstacles (walk
+ * around). If all of them collide, the path with the first middle point is
+ * shortened to end right in front of the first obstacle, keeping exactly the
+ * required clearance (hug).
+ *
+ * Obstacles which already violate the clearance at the start point are
+ * ignored, otherwise it would not be possible to start a trace there.
+ *
+ * @note Objects of the routed net and planes (which are refilled around
+ *       traces anyway) are not obstacles. The obstacles are not updated when
+ *       the board is modified, so create a new router for each trace segment.
+ *
+ * @warning #route() and #isFree() are not thread-safe.
+ */
+class BoardTraceRouter final {
+public:
+  // Types
+  struct Result {
+    Point middlePoint;
+    Point endPoint;
+    bool  blocked;  ///< Whether the end point was pulled back (hugging)
+  };
+
+  // Constructors / Destructor
+  BoardTraceRouter()                              = delete;
+  BoardTraceRouter(const BoardTraceRouter& other) = delete;
+  BoardTraceRouter(const Board& board, const QString& layerName,
+                   const NetSignal&      netsignal,
+                   const UnsignedLength& clearance) noexcept;
+  ~BoardTraceRouter() noexcept;
+
+  // Getters
+  const QString&        getLayerName() const noexcept { return mLayerName; }
+  const UnsignedLength& getClearance() const noexcept { return mClearance; }
+  int getObstacleCount() const noexcept { return mObstacles.count(); }
+
+  // General Methods
+
+  /**
+   * @brief Check whether a straight trace keeps the clearance to all obstacles
+   *
+   * @param p1      Start point of the trace
+   * @param p2      End point of the trace
+   * @param width   Width of the trace
+   *
+   * @return True if there are no collisions, false otherwise
+   */
+  bool isFree(const Point& p1, const Point& p2,
+              const PositiveLength& width) const noexcept;
+
+  /**
+   * @brief Route a trace with one bend from a start point to an end point
+   *
+   * @param start         The fixed start point
+   * @param middlePoints  Candidates for the bend, in order of preference
+   *                      (must not be empty)
+   * @param end           The desired end point (e.g. the cursor position)
+   * @param width         Width of the trace
+   *
+   * @return The chosen middle point and the (maybe pulled back) end point
+   */
+  Result route(const Point& start, const QVector<Point>& middlePoints,
+               const Point& end, const PositiveLength& width) const noexcept;
+
+  // Operator Overloadings
+  BoardTraceRouter& operator=(const BoardTraceRouter& rhs) = delete;
+
+private:  // Types
+  /// An obstacle in nanometers, i.e. a (filled) polyline with a width
+  struct Obstacle {
+    QVector<QPointF> vertices;  ///< A single vertex represents a circle
+    qreal            radius;    ///< Half of the polyline width
+    bool             filled;    ///< Whether the polyline is a filled area
+    QRectF           rect;      ///< Bounding rect, including the radius
+  };
+
+private:  // Methods
+  void addObstacle(const Path& path, const Length& width, bool filled) noexcept;
+  void addObstacle(const Point& pos, const Length& diameter) noexcept;
+  void addObstacle(Obstacle obstacle) noexcept;
+  bool collides(const QPointF& p1, const QPointF& p2, qreal radius,
+                const QSet<int>& ignored) const noexcept;
+  QSet<int>    getCollisions(const QPointF& pos, qreal radius) const noexcept;
+  QVector<int> getCandidates(const QPointF& p1, const QPointF& p2,
+                             qreal radius) const noexcept;
+  bool         collides(const Obstacle& obstacle, const QPointF& p1,
+                        const QPointF& p2, qreal radius) const noexcept;
+  Point        findLastFreePoint(const Point& p1, const Point& p2, qreal radius,
+                                 const QSet<int>& ignored) const noexcept;
+  static QPointF toNm(const Point& p) noexcept;
+  static quint64 getCellKey(int x, int y) noexcept;
+  static qreal   getDistanceSquared(const QPointF& p, const QPointF& s1,
+                                    const QPointF& s2) noexcept;
+  static qreal   getDistanceSquared(const QPointF& a1, const QPointF& a2,
+                                    const QPointF& b1,
+                                    const QPointF& b2) noexcept;
+  static bool contains(const QVector<QPointF>& polygon,
+                       const QPointF&          p) noexcept;
+
+private:  // Data
+  QString        mLayerName;
+  UnsignedLength mClearance;
+
+  /// All obstacles
+  QVector<Obstacle> mObstacles;
+
+  /// Indices of obstacles by grid cell (see #getCellKey())
+  QHash<quint64, QVector<int>> mGrid;
+
+  /// Indices of obstacles which are too large to be stored in the grid
+  QVector<int> mLargeObstacles;
+
+  /// For each obstacle, the number of the last query which visited it
+  mutable QVector<quint32> mVisitedInQuery;
+  mutable quint32          mQueryCounter;
+
+  /// Size of grid cells in nanometers
+  static constexpr qreal sCellSize = 1000000;
+
+  /// Obstacles covering more grid cells are stored in #mLargeObstacles
+  static constexpr int sMaxCellsPerObstacle = 256;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDTRACEROUTER_H
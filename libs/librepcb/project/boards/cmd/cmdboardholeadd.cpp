@@ -41,9 +41,20 @@ CmdBoardHoleAdd::CmdBoardHoleAdd(BI_Hole& hole) noexcept
   : UndoCommand(tr("Add hole to board")),
     mBoard(hole.getBoard()),
     mHole(&hole) {
+  mHole->registerUndoCommand();
 }
 
 CmdBoardHoleAdd::~CmdBoardHoleAdd() noexcept {
+  releaseItem(*mHole, mBoard.getHoles());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardHoleAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mHole, false);
 }
 
 /*******************************************************************************
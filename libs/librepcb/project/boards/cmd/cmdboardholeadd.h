@@ -52,6 +52,9 @@ public:
   // Getters
   BI_Hole* getHole() const noexcept { return mHole; }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -41,9 +41,20 @@ CmdBoardHoleRemove::CmdBoardHoleRemove(BI_Hole& hole) noexcept
   : UndoCommand(tr("Remove hole from board")),
     mBoard(hole.getBoard()),
     mHole(hole) {
+  mHole.registerUndoCommand();
 }
 
 CmdBoardHoleRemove::~CmdBoardHoleRemove() noexcept {
+  releaseItem(mHole, mBoard.getHoles());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardHoleRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mHole, true);
 }
 
 /*******************************************************************************
@@ -49,6 +49,11 @@ public:
   explicit CmdBoardHoleRemove(BI_Hole& hole) noexcept;
   ~CmdBoardHoleRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
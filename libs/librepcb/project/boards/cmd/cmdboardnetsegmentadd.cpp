@@ -42,6 +42,7 @@ CmdBoardNetSegmentAdd::CmdBoardNetSegmentAdd(BI_NetSegment& segment) noexcept
     mBoard(segment.getBoard()),
     mNetSignal(segment.getNetSignal()),
     mNetSegment(&segment) {
+  mNetSegment->registerUndoCommand();
 }
 
 CmdBoardNetSegmentAdd::CmdBoardNetSegmentAdd(Board&     board,
@@ -53,6 +54,18 @@ CmdBoardNetSegmentAdd::CmdBoardNetSegmentAdd(Board&     board,
 }
 
 CmdBoardNetSegmentAdd::~CmdBoardNetSegmentAdd() noexcept {
+  if (mNetSegment) {
+    releaseItem(*mNetSegment, mBoard.getNetSegments());
+  }
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardNetSegmentAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mNetSegment, false);
 }
 
 /*******************************************************************************
@@ -63,6 +76,7 @@ bool CmdBoardNetSegmentAdd::performExecute() {
   if (!mNetSegment) {
     // create new net segment
     mNetSegment = new BI_NetSegment(mBoard, mNetSignal);  // can throw
+    mNetSegment->registerUndoCommand();
   }
 
   performRedo();  // can throw
@@ -54,6 +54,9 @@ public:
   // Getters
   BI_NetSegment* getNetSegment() const noexcept { return mNetSegment; }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
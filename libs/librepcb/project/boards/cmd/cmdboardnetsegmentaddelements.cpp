@@ -25,6 +25,7 @@
 #include "../items/bi_netline.h"
 #include "../items/bi_netpoint.h"
 #include "../items/bi_netsegment.h"
+#include "../items/bi_via.h"
 
 #include <QtCore>
 
@@ -41,9 +42,18 @@ namespace project {
 CmdBoardNetSegmentAddElements::CmdBoardNetSegmentAddElements(
     BI_NetSegment& segment) noexcept
   : UndoCommand(tr("Add net segment elements")), mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdBoardNetSegmentAddElements::~CmdBoardNetSegmentAddElements() noexcept {
+  foreach (BI_NetLine* netline, mNetLines) {
+    releaseItem(*netline, mNetSegment.getNetLines());
+  }
+  foreach (BI_NetPoint* netpoint, mNetPoints) {
+    releaseItem(*netpoint, mNetSegment.getNetPoints());
+  }
+  foreach (BI_Via* via, mVias) { releaseItem(*via, mNetSegment.getVias()); }
+  releaseItem(mNetSegment, mNetSegment.getBoard().getNetSegments());
 }
 
 /*******************************************************************************
@@ -51,6 +61,7 @@ CmdBoardNetSegmentAddElements::~CmdBoardNetSegmentAddElements() noexcept {
  ******************************************************************************/
 
 BI_Via* CmdBoardNetSegmentAddElements::addVia(BI_Via& via) {
+  via.registerUndoCommand();
   mVias.append(&via);
   return &via;
 }
@@ -63,6 +74,7 @@ BI_Via* CmdBoardNetSegmentAddElements::addVia(
 }
 
 BI_NetPoint* CmdBoardNetSegmentAddElements::addNetPoint(BI_NetPoint& netpoint) {
+  netpoint.registerUndoCommand();
   mNetPoints.append(&netpoint);
   return &netpoint;
 }
@@ -73,6 +85,7 @@ BI_NetPoint* CmdBoardNetSegmentAddElements::addNetPoint(const Point& position) {
 }
 
 BI_NetLine* CmdBoardNetSegmentAddElements::addNetLine(BI_NetLine& netline) {
+  netline.registerUndoCommand();
   mNetLines.append(&netline);
   return &netline;
 }
@@ -85,6 +98,17 @@ BI_NetLine* CmdBoardNetSegmentAddElements::addNetLine(
   return addNetLine(*netline);
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardNetSegmentAddElements::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mVias, false) +
+         getDetachedItemMemoryUsage(mNetPoints, false) +
+         getDetachedItemMemoryUsage(mNetLines, false);
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
@@ -66,6 +66,11 @@ public:
                           BI_NetLineAnchor& endPoint, GraphicsLayer& layer,
                           const PositiveLength& width);
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
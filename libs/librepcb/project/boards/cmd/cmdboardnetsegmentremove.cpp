@@ -42,9 +42,20 @@ CmdBoardNetSegmentRemove::CmdBoardNetSegmentRemove(
   : UndoCommand(tr("Remove net segment")),
     mBoard(segment.getBoard()),
     mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdBoardNetSegmentRemove::~CmdBoardNetSegmentRemove() noexcept {
+  releaseItem(mNetSegment, mBoard.getNetSegments());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardNetSegmentRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mNetSegment, true);
 }
 
 /*******************************************************************************
@@ -26,6 +26,7 @@
 #include "../items/bi_netline.h"
 #include "../items/bi_netpoint.h"
 #include "../items/bi_netsegment.h"
+#include "../items/bi_via.h"
 
 #include <QtCore>
 
@@ -42,9 +43,18 @@ namespace project {
 CmdBoardNetSegmentRemoveElements::CmdBoardNetSegmentRemoveElements(
     BI_NetSegment& segment) noexcept
   : UndoCommand(tr("Remove net segment elements")), mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdBoardNetSegmentRemoveElements::~CmdBoardNetSegmentRemoveElements() noexcept {
+  foreach (BI_NetLine* netline, mNetLines) {
+    releaseItem(*netline, mNetSegment.getNetLines());
+  }
+  foreach (BI_NetPoint* netpoint, mNetPoints) {
+    releaseItem(*netpoint, mNetSegment.getNetPoints());
+  }
+  foreach (BI_Via* via, mVias) { releaseItem(*via, mNetSegment.getVias()); }
+  releaseItem(mNetSegment, mNetSegment.getBoard().getNetSegments());
 }
 
 /*******************************************************************************
@@ -52,17 +62,31 @@ CmdBoardNetSegmentRemoveElements::~CmdBoardNetSegmentRemoveElements() noexcept {
  ******************************************************************************/
 
 void CmdBoardNetSegmentRemoveElements::removeVia(BI_Via& via) {
+  via.registerUndoCommand();
   mVias.append(&via);
 }
 
 void CmdBoardNetSegmentRemoveElements::removeNetPoint(BI_NetPoint& netpoint) {
+  netpoint.registerUndoCommand();
   mNetPoints.append(&netpoint);
 }
 
 void CmdBoardNetSegmentRemoveElements::removeNetLine(BI_NetLine& netline) {
+  netline.registerUndoCommand();
   mNetLines.append(&netline);
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardNetSegmentRemoveElements::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mVias, true) +
+         getDetachedItemMemoryUsage(mNetPoints, true) +
+         getDetachedItemMemoryUsage(mNetLines, true);
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
@@ -56,6 +56,11 @@ public:
   void removeNetPoint(BI_NetPoint& netpoint);
   void removeNetLine(BI_NetLine& netline);
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
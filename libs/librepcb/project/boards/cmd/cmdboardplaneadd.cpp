@@ -41,9 +41,20 @@ CmdBoardPlaneAdd::CmdBoardPlaneAdd(BI_Plane& plane) noexcept
   : UndoCommand(tr("Add plane to board")),
     mBoard(plane.getBoard()),
     mPlane(plane) {
+  mPlane.registerUndoCommand();
 }
 
 CmdBoardPlaneAdd::~CmdBoardPlaneAdd() noexcept {
+  releaseItem(mPlane, mBoard.getPlanes());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPlaneAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mPlane, false);
 }
 
 /*******************************************************************************
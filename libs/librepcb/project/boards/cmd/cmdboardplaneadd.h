@@ -51,6 +51,11 @@ public:
   explicit CmdBoardPlaneAdd(BI_Plane& plane) noexcept;
   ~CmdBoardPlaneAdd() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:  // Methods
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
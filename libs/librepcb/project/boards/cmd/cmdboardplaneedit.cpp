@@ -58,7 +58,9 @@ CmdBoardPlaneEdit::CmdBoardPlaneEdit(BI_Plane& plane,
     mOldPriority(plane.getPriority()),
     mNewPriority(mOldPriority),
     mOldKeepOrphans(plane.getKeepOrphans()),
-    mNewKeepOrphans(mOldKeepOrphans) {
+    mNewKeepOrphans(mOldKeepOrphans),
+    mNewOutlineIsOffset(false),
+    mNewOutlineOffset() {
 }
 
 CmdBoardPlaneEdit::~CmdBoardPlaneEdit() noexcept {
@@ -68,6 +70,18 @@ CmdBoardPlaneEdit::~CmdBoardPlaneEdit() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPlaneEdit::getMemoryUsage() const noexcept {
+  qint64 usage = UndoCommand::getMemoryUsage();
+  usage += sizeof(CmdBoardPlaneEdit) - sizeof(UndoCommand);
+  usage += mOldOutline.getVertices().capacity() * sizeof(Vertex);
+  usage += mNewOutline.getVertices().capacity() * sizeof(Vertex);
+  return usage;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -146,15 +160,16 @@ void CmdBoardPlaneEdit::setKeepOrphans(bool keepOrphans) noexcept {
 bool CmdBoardPlaneEdit::performExecute() {
   performRedo();  // can throw
 
-  if (mNewOutline != mOldOutline) return true;
-  if (mNewLayerName != mOldLayerName) return true;
-  if (mNewNetSignal != mOldNetSignal) return true;
-  if (mNewMinWidth != mOldMinWidth) return true;
-  if (mNewMinClearance != mOldMinClearance) return true;
-  if (mNewConnectStyle != mOldConnectStyle) return true;
-  if (mNewPriority != mOldPriority) return true;
-  if (mNewKeepOrphans != mOldKeepOrphans) return true;
-  return false;
+  bool modified = (mNewOutline != mOldOutline) ||
+                  (mNewLayerName != mOldLayerName) ||
+                  (mNewNetSignal != mOldNetSignal) ||
+                  (mNewMinWidth != mOldMinWidth) ||
+                  (mNewMinClearance != mOldMinClearance) ||
+                  (mNewConnectStyle != mOldConnectStyle) ||
+                  (mNewPriority != mOldPriority) ||
+                  (mNewKeepOrphans != mOldKeepOrphans);
+  compactOutlines();  // the outlines will not be modified anymore
+  return modified;
 }
 
 void CmdBoardPlaneEdit::performUndo() {
@@ -173,7 +188,7 @@ void CmdBoardPlaneEdit::performUndo() {
 
 void CmdBoardPlaneEdit::performRedo() {
   mPlane.setNetSignal(*mNewNetSignal);  // can throw
-  mPlane.setOutline(mNewOutline);
+  mPlane.setOutline(getNewOutline());
   mPlane.setLayerName(mNewLayerName);
   mPlane.setMinWidth(mNewMinWidth);
   mPlane.setMinClearance(mNewMinClearance);
@@ -185,6 +200,28 @@ void CmdBoardPlaneEdit::performRedo() {
   if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdBoardPlaneEdit::compactOutlines() noexcept {
+  // This command may be kept in the undo stack for a long time, so release
+  // the cached painter paths and store only the offset if the plane was just
+  // moved (the most common modification).
+  mOldOutline = Path(mOldOutline.getVertices());
+  if (mNewOutline.isTranslationOf(mOldOutline, mNewOutlineOffset)) {
+    mNewOutline         = Path();
+    mNewOutlineIsOffset = true;
+  } else {
+    mNewOutline = Path(mNewOutline.getVertices());
+  }
+}
+
+Path CmdBoardPlaneEdit::getNewOutline() const noexcept {
+  return mNewOutlineIsOffset ? mOldOutline.translated(mNewOutlineOffset)
+                             : mNewOutline;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -51,6 +51,11 @@ public:
   CmdBoardPlaneEdit(BI_Plane& plane, bool rebuildOnChanges) noexcept;
   ~CmdBoardPlaneEdit() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
   // Setters
   void translate(const Point& deltaPos, bool immediate) noexcept;
   void rotate(const Angle& angle, const Point& center, bool immediate) noexcept;
@@ -78,6 +83,9 @@ private:
   /// @copydoc UndoCommand::performRedo()
   void performRedo() override;
 
+  void compactOutlines() noexcept;
+  Path getNewOutline() const noexcept;
+
   // Private Member Variables
 
   // Attributes from the constructor
@@ -101,6 +109,11 @@ private:
   int                    mNewPriority;
   bool                   mOldKeepOrphans;
   bool                   mNewKeepOrphans;
+
+  /// If true, #mNewOutline is empty and #mOldOutline translated by
+  /// #mNewOutlineOffset is the new outline (see #compactOutlines())
+  bool  mNewOutlineIsOffset;
+  Point mNewOutlineOffset;
 };
 
 /*******************************************************************************
@@ -41,9 +41,20 @@ CmdBoardPlaneRemove::CmdBoardPlaneRemove(BI_Plane& plane) noexcept
   : UndoCommand(tr("Remove plane from board")),
     mBoard(plane.getBoard()),
     mPlane(plane) {
+  mPlane.registerUndoCommand();
 }
 
 CmdBoardPlaneRemove::~CmdBoardPlaneRemove() noexcept {
+  releaseItem(mPlane, mBoard.getPlanes());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPlaneRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mPlane, true);
 }
 
 /*******************************************************************************
@@ -41,9 +41,20 @@ CmdBoardPolygonAdd::CmdBoardPolygonAdd(BI_Polygon& polygon) noexcept
   : UndoCommand(tr("Add polygon to board")),
     mBoard(polygon.getBoard()),
     mPolygon(polygon) {
+  mPolygon.registerUndoCommand();
 }
 
 CmdBoardPolygonAdd::~CmdBoardPolygonAdd() noexcept {
+  releaseItem(mPolygon, mBoard.getPolygons());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPolygonAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mPolygon, false);
 }
 
 /*******************************************************************************
@@ -54,6 +54,9 @@ public:
   // Getters
   // BI_Device* getDeviceInstance() const noexcept {return mDeviceInstance;}
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:  // Methods
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
@@ -41,9 +41,20 @@ CmdBoardPolygonRemove::CmdBoardPolygonRemove(BI_Polygon& polygon) noexcept
   : UndoCommand(tr("Remove polygon from board")),
     mBoard(polygon.getBoard()),
     mPolygon(polygon) {
+  mPolygon.registerUndoCommand();
 }
 
 CmdBoardPolygonRemove::~CmdBoardPolygonRemove() noexcept {
+  releaseItem(mPolygon, mBoard.getPolygons());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardPolygonRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mPolygon, true);
 }
 
 /*******************************************************************************
@@ -49,6 +49,11 @@ public:
   explicit CmdBoardPolygonRemove(BI_Polygon& polygon) noexcept;
   ~CmdBoardPolygonRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
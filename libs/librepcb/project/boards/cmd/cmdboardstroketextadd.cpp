@@ -41,9 +41,20 @@ CmdBoardStrokeTextAdd::CmdBoardStrokeTextAdd(BI_StrokeText& text) noexcept
   : UndoCommand(tr("Add text to board")),
     mBoard(text.getBoard()),
     mStrokeText(&text) {
+  mStrokeText->registerUndoCommand();
 }
 
 CmdBoardStrokeTextAdd::~CmdBoardStrokeTextAdd() noexcept {
+  releaseItem(*mStrokeText, mBoard.getStrokeTexts());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardStrokeTextAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mStrokeText, false);
 }
 
 /*******************************************************************************
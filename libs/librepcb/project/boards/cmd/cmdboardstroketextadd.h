@@ -52,6 +52,9 @@ public:
   // Getters
   BI_StrokeText* getStrokeText() const noexcept { return mStrokeText; }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -41,9 +41,20 @@ CmdBoardStrokeTextRemove::CmdBoardStrokeTextRemove(BI_StrokeText& text) noexcept
   : UndoCommand(tr("Remove text from board")),
     mBoard(text.getBoard()),
     mText(text) {
+  mText.registerUndoCommand();
 }
 
 CmdBoardStrokeTextRemove::~CmdBoardStrokeTextRemove() noexcept {
+  releaseItem(mText, mBoard.getStrokeTexts());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdBoardStrokeTextRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mText, true);
 }
 
 /*******************************************************************************
@@ -49,6 +49,11 @@ public:
   explicit CmdBoardStrokeTextRemove(BI_StrokeText& text) noexcept;
   ~CmdBoardStrokeTextRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
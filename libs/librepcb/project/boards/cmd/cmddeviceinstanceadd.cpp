@@ -39,9 +39,21 @@ namespace project {
 
 CmdDeviceInstanceAdd::CmdDeviceInstanceAdd(BI_Device& device) noexcept
   : UndoCommand(tr("Add device to board")), mDeviceInstance(device) {
+  mDeviceInstance.registerUndoCommand();
 }
 
 CmdDeviceInstanceAdd::~CmdDeviceInstanceAdd() noexcept {
+  releaseItem(mDeviceInstance,
+              mDeviceInstance.getBoard().getDeviceInstances().values());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdDeviceInstanceAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mDeviceInstance, false);
 }
 
 /*******************************************************************************
@@ -57,6 +57,11 @@ public:
   explicit CmdDeviceInstanceAdd(BI_Device& device) noexcept;
   ~CmdDeviceInstanceAdd() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:  // Methods
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmddeviceinstanceeditall.h"
 
+#include "../board.h"
 #include "../items/bi_device.h"
 #include "../items/bi_footprint.h"
 #include "../items/bi_stroketext.h"
@@ -43,6 +44,8 @@ namespace project {
 
 CmdDeviceInstanceEditAll::CmdDeviceInstanceEditAll(BI_Device& dev) noexcept
   : UndoCommandGroup(tr("Edit device instance")), mDevEditCmd(nullptr) {
+  addBulkMutationTarget(dev.getBoard());
+
   mDevEditCmd = new CmdDeviceInstanceEdit(dev);
   appendChild(mDevEditCmd);
 
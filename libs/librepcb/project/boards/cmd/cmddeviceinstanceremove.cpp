@@ -41,9 +41,20 @@ CmdDeviceInstanceRemove::CmdDeviceInstanceRemove(BI_Device& dev) noexcept
   : UndoCommand(tr("Remove device instance")),
     mBoard(dev.getBoard()),
     mDevice(dev) {
+  mDevice.registerUndoCommand();
 }
 
 CmdDeviceInstanceRemove::~CmdDeviceInstanceRemove() noexcept {
+  releaseItem(mDevice, mBoard.getDeviceInstances().values());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdDeviceInstanceRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mDevice, true);
 }
 
 /*******************************************************************************
@@ -49,6 +49,11 @@ public:
   CmdDeviceInstanceRemove(BI_Device& dev) noexcept;
   ~CmdDeviceInstanceRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
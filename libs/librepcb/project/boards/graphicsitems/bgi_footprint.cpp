@@ -28,6 +28,7 @@
 #include "../items/bi_device.h"
 #include "../items/bi_footprint.h"
 
+#include <librepcb/common/graphics/levelofdetail.h>
 #include <librepcb/common/graphics/stroketextgraphicsitem.h>
 #include <librepcb/library/pkg/footprint.h>
 
@@ -123,13 +124,19 @@ void BGI_Footprint::updateCacheAndRepaint() noexcept {
 void BGI_Footprint::paint(QPainter*                       painter,
                           const QStyleOptionGraphicsItem* option,
                           QWidget*                        widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
 
   const GraphicsLayer* layer    = 0;
   const bool           selected = mFootprint.isSelected();
   const bool           deviceIsPrinter =
       (dynamic_cast<QPrinter*>(painter->device()) != 0);
+  const LevelOfDetail  lod(*painter, *option);
+
+  // Skip all details if the whole footprint is tiny on the screen. The pads
+  // are separate graphics items and draw their own simplified proxies.
+  if (lod.isTooSmall(mBoundingRect)) {
+    return;
+  }
 
   // draw all polygons
   for (const Polygon& polygon : mLibFootprint.getPolygons()) {
@@ -138,6 +145,10 @@ void BGI_Footprint::paint(QPainter*                       painter,
     if (!layer) continue;
     if (!layer->isVisible()) continue;
 
+    // skip polygons which are too small to be visible
+    QPainterPath path = polygon.getPath().toQPainterPathPx();
+    if (lod.isTooSmall(path.boundingRect())) continue;
+
     // set pen
     if (polygon.getLineWidth() > 0)
       painter->setPen(QPen(layer->getColor(selected),
@@ -163,7 +174,7 @@ void BGI_Footprint::paint(QPainter*                       painter,
     }
 
     // draw polygon
-    painter->drawPath(polygon.getPath().toQPainterPathPx());
+    painter->drawPath(path);
   }
 
   // draw all circles
@@ -172,6 +183,7 @@ void BGI_Footprint::paint(QPainter*                       painter,
     layer = getLayer(*circle.getLayerName());
     if (!layer) continue;
     if (!layer->isVisible()) continue;
+    if (lod.isTooSmall(circle.getDiameter()->toPx())) continue;
 
     // set pen
     if (circle.getLineWidth() > 0)
@@ -210,6 +222,7 @@ void BGI_Footprint::paint(QPainter*                       painter,
     layer = getLayer(GraphicsLayer::sBoardDrillsNpth);
     if (!layer) continue;
     if (!layer->isVisible()) continue;
+    if (lod.isTooSmall(hole.getDiameter()->toPx())) continue;
 
     // set pen/brush
     painter->setPen(Qt::NoPen);
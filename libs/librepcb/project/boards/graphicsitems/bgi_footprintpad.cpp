@@ -33,6 +33,7 @@
 
 #include <librepcb/common/application.h>
 #include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/levelofdetail.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/package.h>
 
@@ -137,16 +138,22 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
 void BGI_FootprintPad::paint(QPainter*                       painter,
                              const QStyleOptionGraphicsItem* option,
                              QWidget*                        widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
-  // const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) !=
-  // 0); const qreal lod =
-  // option->levelOfDetailFromTransform(painter->worldTransform());
 
   const NetSignal* netsignal = mPad.getCompSigInstNetSignal();
   bool             highlight =
       mPad.isSelected() || (netsignal && netsignal->isHighlighted());
 
+  const LevelOfDetail lod(*painter, *option);
+  if (lod.isTooSmall(mBoundingRect)) {
+    // only draw a simplified proxy if the pad is tiny on the screen
+    if (mPadLayer && mPadLayer->isVisible()) {
+      lod.drawProxy(*painter, mCopper.boundingRect(),
+                    mPadLayer->getColor(highlight));
+    }
+    return;
+  }
+
   if (mBottomCreamMaskLayer && mBottomCreamMaskLayer->isVisible()) {
     // draw bottom cream mask
     painter->setPen(Qt::NoPen);
@@ -167,10 +174,12 @@ void BGI_FootprintPad::paint(QPainter*                       painter,
     painter->setBrush(mPadLayer->getColor(highlight));
     painter->drawPath(mCopper);
     // draw pad text
-    painter->setFont(mFont);
-    painter->setPen(mPadLayer->getColor(highlight).lighter(150));
-    painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
-                      mPad.getDisplayText());
+    if (lod.isTextVisible(mFont.pixelSize())) {
+      painter->setFont(mFont);
+      painter->setPen(mPadLayer->getColor(highlight).lighter(150));
+      painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
+                        mPad.getDisplayText());
+    }
   }
 
   if (mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
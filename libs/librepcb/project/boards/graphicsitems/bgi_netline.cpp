@@ -29,6 +29,9 @@
 #include "../items/bi_netline.h"
 #include "../items/bi_netpoint.h"
 
+#include <librepcb/common/graphics/graphicslayerbatch.h>
+#include <librepcb/common/graphics/levelofdetail.h>
+
 #include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
@@ -44,11 +47,14 @@ namespace project {
  ******************************************************************************/
 
 BGI_NetLine::BGI_NetLine(BI_NetLine& netline) noexcept
-  : BGI_Base(), mNetLine(netline), mLayer(nullptr) {
+  : BGI_Base(), mNetLine(netline), mLayer(nullptr), mBatch(nullptr) {
   updateCacheAndRepaint();
 }
 
 BGI_NetLine::~BGI_NetLine() noexcept {
+  if (mBatch) {
+    mBatch->remove(this);
+  }
 }
 
 /*******************************************************************************
@@ -74,20 +80,48 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept {
   mLayer = &mNetLine.getLayer();
   Q_ASSERT(mLayer);
 
-  mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
-  mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
+  Point p1 = mNetLine.getStartPoint().getPosition() +
+      mNetLine.getPreviewStartOffset();
+  Point p2 =
+      mNetLine.getEndPoint().getPosition() + mNetLine.getPreviewEndOffset();
+  mLineF.setP1(p1.toPxQPointF());
+  mLineF.setP2(p2.toPxQPointF());
   mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
   mBoundingRect.adjust(
       -mNetLine.getWidth()->toPx() / 2, -mNetLine.getWidth()->toPx() / 2,
       mNetLine.getWidth()->toPx() / 2, mNetLine.getWidth()->toPx() / 2);
   mShape = QPainterPath();
-  mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
-  mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
+  mShape.moveTo(mLineF.p1());
+  mShape.lineTo(mLineF.p2());
   QPainterPathStroker ps;
   ps.setCapStyle(Qt::RoundCap);
   PositiveLength width = qMax(mNetLine.getWidth(), PositiveLength(100000));
   ps.setWidth(width->toPx());
   mShape = ps.createStroke(mShape);
+  // the grab area may be wider than the line itself, but the bounding rect
+  // needs to contain it to find the netline in the scene's spatial index
+  mBoundingRect = mBoundingRect.united(mShape.boundingRect());
+  updateBatch();
+}
+
+void BGI_NetLine::updateBatch() noexcept {
+  // Selected or highlighted netlines are painted by this item, all others are
+  // painted at once by the batch of their layer.
+  bool highlight = mNetLine.isSelected() ||
+                   mNetLine.getNetSignalOfNetSegment().isHighlighted();
+  GraphicsLayerBatch* batch = nullptr;
+  if (scene() && (!highlight)) {
+    // slightly below this item to keep highlighted netlines on top
+    batch =
+        mNetLine.getBoard().getGraphicsLayerBatch(*mLayer, zValue() - 0.001);
+  }
+  if (mBatch && (mBatch != batch)) {
+    mBatch->remove(this);
+  }
+  mBatch = batch;
+  if (mBatch) {
+    mBatch->setLine(this, mLineF, mNetLine.getWidth()->toPx());
+  }
   update();
 }
 
@@ -98,17 +132,23 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept {
 void BGI_NetLine::paint(QPainter*                       painter,
                         const QStyleOptionGraphicsItem* option,
                         QWidget*                        widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
 
   bool highlight = mNetLine.isSelected() ||
                    mNetLine.getNetSignalOfNetSegment().isHighlighted();
 
+  const LevelOfDetail lod(*painter, *option);
+
   // draw line
-  if (mLayer->isVisible()) {
-    QPen pen(mLayer->getColor(highlight), mNetLine.getWidth()->toPx(),
-             Qt::SolidLine, Qt::RoundCap);
-    painter->setPen(pen);
+  if (mLayer->isVisible() && (!mBatch)) {
+    if (lod.isTooSmall(mNetLine.getWidth()->toPx())) {
+      // a cosmetic pen is much faster than a wide pen with round caps
+      painter->setPen(QPen(mLayer->getColor(highlight), 0));
+    } else {
+      painter->setPen(QPen(mLayer->getColor(highlight),
+                           mNetLine.getWidth()->toPx(), Qt::SolidLine,
+                           Qt::RoundCap));
+    }
     painter->drawLine(mLineF);
   }
 
@@ -125,6 +165,14 @@ void BGI_NetLine::paint(QPainter*                       painter,
 #endif
 }
 
+QVariant BGI_NetLine::itemChange(GraphicsItemChange change,
+                                 const QVariant&    value) noexcept {
+  if (change == ItemSceneHasChanged) {
+    updateBatch();  // register in or unregister from the batch of the scene
+  }
+  return QGraphicsItem::itemChange(change, value);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -34,6 +34,7 @@
 namespace librepcb {
 
 class GraphicsLayer;
+class GraphicsLayerBatch;
 
 namespace project {
 
@@ -57,6 +58,7 @@ public:
 
   // General Methods
   void updateCacheAndRepaint() noexcept;
+  void updateBatch() noexcept;
 
   // Inherited from QGraphicsItem
   QRectF       boundingRect() const { return mBoundingRect; }
@@ -64,6 +66,11 @@ public:
   void         paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                      QWidget* widget);
 
+protected:
+  // Inherited from QGraphicsItem
+  QVariant itemChange(GraphicsItemChange change,
+                      const QVariant&    value) noexcept;
+
 private:
   // make some methods inaccessible...
   BGI_NetLine()                         = delete;
@@ -74,8 +81,9 @@ private:
   GraphicsLayer* getLayer(const QString& name) const noexcept;
 
   // Attributes
-  BI_NetLine&    mNetLine;
-  GraphicsLayer* mLayer;
+  BI_NetLine&         mNetLine;
+  GraphicsLayer*      mLayer;
+  GraphicsLayerBatch* mBatch;  ///< nullptr if not painted by a batch
 
   // Cached Attributes
   QLineF       mLineF;
@@ -28,6 +28,7 @@
 #include "../items/bi_plane.h"
 
 #include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/levelofdetail.h>
 #include <librepcb/common/toolbox.h>
 
 #include <QPrinter>
@@ -40,12 +41,18 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Static Variables
+ ******************************************************************************/
+
+constexpr int BGI_Plane::sMaxRasterSizePx;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 BGI_Plane::BGI_Plane(BI_Plane& plane) noexcept
-  : BGI_Base(), mPlane(plane), mLayer(nullptr) {
+  : BGI_Base(), mPlane(plane), mLayer(nullptr), mRasterZoomBucket(0) {
   updateCacheAndRepaint();
 }
 
@@ -84,6 +91,7 @@ void BGI_Plane::updateCacheAndRepaint() noexcept {
     mAreas.append(r.toQPainterPathPx());
     mBoundingRect = mBoundingRect.united(mAreas.last().boundingRect());
   }
+  mRasterImage = QImage();  // invalidate rasterized areas
 
   update();
 }
@@ -96,24 +104,31 @@ void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                       QWidget* widget) {
   Q_UNUSED(widget);
 
-  const bool selected = mPlane.isSelected();
-  // const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) !=
-  // 0);
-  const qreal lod =
-      option->levelOfDetailFromTransform(painter->worldTransform());
-  Q_UNUSED(option);
+  const bool          selected = mPlane.isSelected();
+  const LevelOfDetail lod(*painter, *option);
 
   if (mLayer && mLayer->isVisible()) {
+    const QColor color = mLayer->getColor(selected);
+
     // draw outline
-    painter->setPen(
-        QPen(mLayer->getColor(selected), 3 / lod, Qt::DashLine, Qt::RoundCap));
-    painter->setBrush(Qt::NoBrush);
-    painter->drawPath(mOutline);
+    if (!lod.isTooSmall(mBoundingRect)) {
+      painter->setPen(
+          QPen(color, 3 / lod.getLod(), Qt::DashLine, Qt::RoundCap));
+      painter->setBrush(Qt::NoBrush);
+      painter->drawPath(mOutline);
+    }
 
     // draw plane
-    painter->setPen(Qt::NoPen);
-    painter->setBrush(mLayer->getColor(selected));
-    foreach (const QPainterPath& area, mAreas) { painter->drawPath(area); }
+    updateRasterCache(lod, color);
+    if (!mRasterImage.isNull()) {
+      // Drawing the (possibly very complex) fragments is slow, so they are
+      // rasterized once per zoom bucket and drawn as an image.
+      painter->drawImage(mBoundingRect, mRasterImage);
+    } else {
+      painter->setPen(Qt::NoPen);
+      painter->setBrush(color);
+      foreach (const QPainterPath& area, mAreas) { painter->drawPath(area); }
+    }
   }
 
 #ifdef QT_DEBUG
@@ -139,6 +154,42 @@ GraphicsLayer* BGI_Plane::getLayer(QString name) const noexcept {
   return mPlane.getBoard().getLayerStack().getLayer(name);
 }
 
+void BGI_Plane::updateRasterCache(const LevelOfDetail& lod,
+                                  const QColor&        color) noexcept {
+  if (lod.isPrinter() || mAreas.isEmpty()) {
+    mRasterImage = QImage();
+    return;
+  }
+
+  int   bucket = lod.getZoomBucket();
+  qreal scale  = LevelOfDetail::getZoomBucketScale(bucket + 1);  // oversample
+  QSize size   = (mBoundingRect.size() * scale).toSize();
+  if ((size.width() > sMaxRasterSizePx) || (size.height() > sMaxRasterSizePx) ||
+      size.isEmpty()) {
+    // zoomed in too far, drawing the vector graphics is better now
+    mRasterImage = QImage();
+    return;
+  }
+
+  if ((!mRasterImage.isNull()) && (bucket == mRasterZoomBucket) &&
+      (color == mRasterColor)) {
+    return;  // cache is still up to date
+  }
+
+  mRasterImage = QImage(size, QImage::Format_ARGB32_Premultiplied);
+  mRasterImage.fill(Qt::transparent);
+  QPainter painter(&mRasterImage);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.scale(size.width() / mBoundingRect.width(),
+                size.height() / mBoundingRect.height());
+  painter.translate(-mBoundingRect.topLeft());
+  painter.setPen(Qt::NoPen);
+  painter.setBrush(color);
+  foreach (const QPainterPath& area, mAreas) { painter.drawPath(area); }
+  mRasterZoomBucket = bucket;
+  mRasterColor      = color;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -36,6 +36,7 @@ namespace librepcb {
 class Path;
 class Polygon;
 class GraphicsLayer;
+class LevelOfDetail;
 
 namespace project {
 
@@ -77,6 +78,8 @@ private:
 
   // Private Methods
   GraphicsLayer* getLayer(QString name) const noexcept;
+  void           updateRasterCache(const LevelOfDetail& lod,
+                                   const QColor&        color) noexcept;
 
   // General Attributes
   BI_Plane& mPlane;
@@ -87,6 +90,14 @@ private:
   QPainterPath          mShape;
   QPainterPath          mOutline;
   QVector<QPainterPath> mAreas;
+
+  // Rasterized areas, updated once per zoom bucket (see LevelOfDetail)
+  QImage mRasterImage;
+  int    mRasterZoomBucket;
+  QColor mRasterColor;
+
+  // Static Variables
+  static constexpr int sMaxRasterSizePx = 2048;
 };
 
 /*******************************************************************************
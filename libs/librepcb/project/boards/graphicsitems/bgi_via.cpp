@@ -30,6 +30,8 @@
 
 #include <librepcb/common/application.h>
 #include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/graphicslayerbatch.h>
+#include <librepcb/common/graphics/levelofdetail.h>
 
 #include <QPrinter>
 #include <QtCore>
@@ -50,7 +52,8 @@ BGI_Via::BGI_Via(BI_Via& via) noexcept
     mVia(via),
     mViaLayer(nullptr),
     mTopStopMaskLayer(nullptr),
-    mBottomStopMaskLayer(nullptr) {
+    mBottomStopMaskLayer(nullptr),
+    mBatch(nullptr) {
   setZValue(Board::ZValue_Vias);
 
   mFont = qApp->getDefaultSansSerifFont();
@@ -60,6 +63,9 @@ BGI_Via::BGI_Via(BI_Via& via) noexcept
 }
 
 BGI_Via::~BGI_Via() noexcept {
+  if (mBatch) {
+    mBatch->remove(this);
+  }
 }
 
 /*******************************************************************************
@@ -95,6 +101,29 @@ void BGI_Via::updateCacheAndRepaint() noexcept {
   mStopMask     = mVia.getOutline(*stopMaskClearance).toQPainterPathPx();
   mBoundingRect = mStopMask.boundingRect();
 
+  updateBatch();
+}
+
+void BGI_Via::updateBatch() noexcept {
+  // Selected or highlighted vias are painted by this item, all others are
+  // painted at once by the batch of the via layer. Vias with stop mask
+  // openings are not batched since the stop masks need to be painted below
+  // and above the copper.
+  bool highlight = mVia.isSelected() ||
+                   mVia.getNetSignalOfNetSegment().isHighlighted();
+  GraphicsLayerBatch* batch = nullptr;
+  if (scene() && mViaLayer && (!highlight) && (!mDrawStopMask)) {
+    // below all vias to keep the netsignal names and highlighted vias on top
+    batch = mVia.getBoard().getGraphicsLayerBatch(*mViaLayer,
+                                                  Board::ZValue_Vias - 0.5);
+  }
+  if (mBatch && (mBatch != batch)) {
+    mBatch->remove(this);
+  }
+  mBatch = batch;
+  if (mBatch) {
+    mBatch->setArea(this, mCopper.translated(pos()));
+  }
   update();
 }
 
@@ -104,12 +133,22 @@ void BGI_Via::updateCacheAndRepaint() noexcept {
 
 void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                     QWidget* widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
 
   NetSignal& netsignal = mVia.getNetSignalOfNetSegment();
   bool       highlight = mVia.isSelected() || (netsignal.isHighlighted());
 
+  const LevelOfDetail lod(*painter, *option);
+
+  if (lod.isTooSmall(mBoundingRect)) {
+    // only draw a simplified proxy if the via is tiny on the screen
+    if (mViaLayer && mViaLayer->isVisible() && (!mBatch)) {
+      lod.drawProxy(*painter, mCopper.boundingRect(),
+                    mViaLayer->getColor(highlight));
+    }
+    return;
+  }
+
   if (mDrawStopMask && mBottomStopMaskLayer &&
       mBottomStopMaskLayer->isVisible()) {
     // draw bottom stop mask
@@ -120,15 +159,19 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
 
   if (mViaLayer && mViaLayer->isVisible()) {
     // draw via
-    painter->setPen(Qt::NoPen);
-    painter->setBrush(mViaLayer->getColor(highlight));
-    painter->drawPath(mCopper);
+    if (!mBatch) {
+      painter->setPen(Qt::NoPen);
+      painter->setBrush(mViaLayer->getColor(highlight));
+      painter->drawPath(mCopper);
+    }
 
     // draw netsignal name
-    painter->setFont(mFont);
-    painter->setPen(mViaLayer->getColor(highlight).lighter(150));
-    painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
-                      *netsignal.getName());
+    if (lod.isTextVisible(mFont.pixelSize())) {
+      painter->setFont(mFont);
+      painter->setPen(mViaLayer->getColor(highlight).lighter(150));
+      painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
+                        *netsignal.getName());
+    }
   }
 
   if (mDrawStopMask && mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
@@ -151,6 +194,14 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
 #endif
 }
 
+QVariant BGI_Via::itemChange(GraphicsItemChange change,
+                             const QVariant&    value) noexcept {
+  if (change == ItemSceneHasChanged) {
+    updateBatch();  // register in or unregister from the batch of the scene
+  }
+  return QGraphicsItem::itemChange(change, value);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -57,6 +57,7 @@ public:
 
   // General Methods
   void updateCacheAndRepaint() noexcept;
+  void updateBatch() noexcept;
 
   // Inherited from QGraphicsItem
   QRectF       boundingRect() const { return mBoundingRect; }
@@ -64,6 +65,11 @@ public:
   void         paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                      QWidget* widget);
 
+protected:
+  // Inherited from QGraphicsItem
+  QVariant itemChange(GraphicsItemChange change,
+                      const QVariant&    value) noexcept;
+
 private:
   // make some methods inaccessible...
   BGI_Via()                     = delete;
@@ -74,10 +80,11 @@ private:
   GraphicsLayer* getLayer(const QString& name) const noexcept;
 
   // General Attributes
-  BI_Via&        mVia;
-  GraphicsLayer* mViaLayer;
-  GraphicsLayer* mTopStopMaskLayer;
-  GraphicsLayer* mBottomStopMaskLayer;
+  BI_Via&             mVia;
+  GraphicsLayer*      mViaLayer;
+  GraphicsLayer*      mTopStopMaskLayer;
+  GraphicsLayer*      mBottomStopMaskLayer;
+  GraphicsLayerBatch* mBatch;  ///< nullptr if not painted by a batch
 
   // Cached Attributes
   bool         mDrawStopMask;
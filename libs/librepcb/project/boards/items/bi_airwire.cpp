@@ -75,6 +75,10 @@ QPainterPath BI_AirWire::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape();
 }
 
+qint64 BI_AirWire::getMemoryUsage() const noexcept {
+  return sizeof(BI_AirWire) + sizeof(BGI_AirWire);
+}
+
 void BI_AirWire::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
   mGraphicsItem->update();
@@ -67,6 +67,7 @@ public:
   const Point& getPosition() const noexcept override { return mP1; }
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
   bool         isSelectable() const noexcept override;
 
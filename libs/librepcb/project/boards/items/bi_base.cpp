@@ -41,10 +41,17 @@ namespace project {
  ******************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept
-  : QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false) {
+  : QObject(&board),
+    mBoard(board),
+    mIsAddedToBoard(false),
+    mIsSelected(false),
+    mGraphicsItemInScene(nullptr),
+    mPreviewOffset(),
+    mUndoCommandCount(0) {
 }
 
 BI_Base::~BI_Base() noexcept {
+  Q_ASSERT(mUndoCommandCount == 0);
   Q_ASSERT(!mIsAddedToBoard);
 }
 
@@ -68,6 +75,14 @@ void BI_Base::setSelected(bool selected) noexcept {
   mIsSelected = selected;
 }
 
+void BI_Base::setPreviewOffset(const Point& offset) noexcept {
+  if (mGraphicsItemInScene && (offset != mPreviewOffset)) {
+    QPointF delta = (offset - mPreviewOffset).toPxQPointF();
+    mGraphicsItemInScene->moveBy(delta.x(), delta.y());
+  }
+  mPreviewOffset = offset;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -75,17 +90,30 @@ void BI_Base::setSelected(bool selected) noexcept {
 void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToBoard);
   if (item) {
+    item->setData(sGraphicsItemDataKey,
+                  QVariant::fromValue(static_cast<void*>(this)));
     mBoard.getGraphicsScene().addItem(*item);
   }
-  mIsAddedToBoard = true;
+  mGraphicsItemInScene = item;
+  mIsAddedToBoard      = true;
 }
 
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(mIsAddedToBoard);
   if (item) {
     mBoard.getGraphicsScene().removeItem(*item);
+    item->setData(sGraphicsItemDataKey, QVariant());
   }
-  mIsAddedToBoard = false;
+  mGraphicsItemInScene = nullptr;
+  mIsAddedToBoard      = false;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BI_Base* BI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  return static_cast<BI_Base*>(item.data(sGraphicsItemDataKey).value<void*>());
 }
 
 /*******************************************************************************
@@ -86,17 +86,73 @@ public:
   virtual bool isAddedToBoard() const noexcept { return mIsAddedToBoard; }
   virtual bool isSelectable() const noexcept = 0;
   virtual bool isSelected() const noexcept { return mIsSelected; }
+  const Point& getPreviewOffset() const noexcept { return mPreviewOffset; }
+
+  /**
+   * @brief Get the approximate amount of memory used by this item
+   *
+   * Includes the graphics items and all child items, but not shared data like
+   * library elements. Used by undo commands which keep removed items alive
+   * (see librepcb::UndoCommand::getMemoryUsage()).
+   *
+   * @return Number of bytes (not necessarily exact)
+   */
+  virtual qint64 getMemoryUsage() const noexcept = 0;
 
   // Setters
   virtual void setSelected(bool selected) noexcept;
 
+  /**
+   * @brief Visually move the item without modifying it
+   *
+   * Used to preview moving items (e.g. while dragging a selection) without
+   * updating the item, its dependent items and the undo commands on every
+   * mouse move. Only the graphics item is moved, so the offset must be reset
+   * to zero before the item gets modified.
+   *
+   * @param offset  The offset relative to the actual position
+   */
+  virtual void setPreviewOffset(const Point& offset) noexcept;
+
   // General Methods
   virtual void addToBoard()      = 0;
   virtual void removeFromBoard() = 0;
 
+  // Undo Command References
+
+  /**
+   * @brief Register an undo command which holds a pointer to this item
+   *
+   * Items which were removed from the board are owned by the undo commands
+   * referencing them, see librepcb::UndoCommand::releaseItem().
+   */
+  void registerUndoCommand() noexcept { ++mUndoCommandCount; }
+
+  /**
+   * @brief Unregister an undo command which holds a pointer to this item
+   *
+   * @return True if no undo command references this item anymore
+   */
+  bool unregisterUndoCommand() noexcept {
+    Q_ASSERT(mUndoCommandCount > 0);
+    return (--mUndoCommandCount == 0);
+  }
+
   // Operator Overloadings
   BI_Base& operator=(const BI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the board item which added a graphics item to the board
+   *
+   * @param item    A graphics item of the board's graphics scene
+   *
+   * @return The board item, or nullptr if the graphics item doesn't belong to
+   *         any board item (e.g. child items or layer batches)
+   */
+  static BI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToBoard(QGraphicsItem* item) noexcept;
@@ -106,9 +162,15 @@ protected:
   Board& mBoard;
 
 private:
+  /// Key of the QGraphicsItem::data() entry which stores the BI_Base pointer
+  static constexpr int sGraphicsItemDataKey = 0;
+
   // General Attributes
-  bool mIsAddedToBoard;
-  bool mIsSelected;
+  bool           mIsAddedToBoard;
+  bool           mIsSelected;
+  QGraphicsItem* mGraphicsItemInScene;  ///< Added by #addToBoard(), or nullptr
+  Point          mPreviewOffset;
+  int            mUndoCommandCount;  ///< See #registerUndoCommand()
 };
 
 /*******************************************************************************
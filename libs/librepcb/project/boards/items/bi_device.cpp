@@ -294,6 +294,10 @@ QPainterPath BI_Device::getGrabAreaScenePx() const noexcept {
   return mFootprint->getGrabAreaScenePx();
 }
 
+qint64 BI_Device::getMemoryUsage() const noexcept {
+  return sizeof(BI_Device) + mFootprint->getMemoryUsage();
+}
+
 bool BI_Device::isSelectable() const noexcept {
   return mFootprint->isSelectable();
 }
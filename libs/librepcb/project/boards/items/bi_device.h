@@ -121,6 +121,7 @@ public:
   const Point& getPosition() const noexcept override { return mPosition; }
   bool         getIsMirrored() const noexcept override { return mIsMirrored; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Operator Overloadings
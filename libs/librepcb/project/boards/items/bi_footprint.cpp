@@ -260,6 +260,17 @@ QPainterPath BI_Footprint::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_Footprint::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(BI_Footprint) + sizeof(BGI_Footprint);
+  foreach (const BI_FootprintPad* pad, mPads) {
+    usage += pad->getMemoryUsage();
+  }
+  foreach (const BI_StrokeText* text, mStrokeTexts) {
+    usage += text->getMemoryUsage();
+  }
+  return usage;
+}
+
 bool BI_Footprint::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
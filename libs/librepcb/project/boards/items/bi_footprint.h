@@ -114,6 +114,7 @@ public:
   const Point& getPosition() const noexcept override;
   bool         getIsMirrored() const noexcept override;
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Operator Overloadings
@@ -197,6 +197,10 @@ QPainterPath BI_FootprintPad::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_FootprintPad::getMemoryUsage() const noexcept {
+  return sizeof(BI_FootprintPad) + sizeof(BGI_FootprintPad);
+}
+
 bool BI_FootprintPad::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
@@ -38,6 +38,7 @@ namespace librepcb {
 
 namespace library {
 class FootprintPad;
+class PackagePad;
 class ComponentSignal;
 }  // namespace library
 
@@ -73,6 +74,9 @@ public:
   const library::FootprintPad& getLibPad() const noexcept {
     return *mFootprintPad;
   }
+  const library::PackagePad& getLibPackagePad() const noexcept {
+    return *mPackagePad;
+  }
   ComponentSignalInstance* getComponentSignalInstance() const noexcept {
     return mComponentSignalInstance;
   }
@@ -94,6 +98,7 @@ public:
   const Point& getPosition() const noexcept override { return mPosition; }
   bool         getIsMirrored() const noexcept override;
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Inherited from BI_NetLineAnchor
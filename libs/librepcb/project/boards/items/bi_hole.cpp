@@ -99,6 +99,10 @@ QPainterPath BI_Hole::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_Hole::getMemoryUsage() const noexcept {
+  return sizeof(BI_Hole) + sizeof(Hole) + sizeof(HoleGraphicsItem);
+}
+
 const Uuid& BI_Hole::getUuid() const noexcept {
   return mHole->getUuid();
 }
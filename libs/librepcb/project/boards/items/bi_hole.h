@@ -80,6 +80,7 @@ public:
   const Point& getPosition() const noexcept override;
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Operator Overloadings
@@ -23,6 +23,7 @@
 #include "bi_netline.h"
 
 #include "../../circuit/netsignal.h"
+#include "../board.h"
 #include "../boardlayerstack.h"
 #include "bi_device.h"
 #include "bi_footprint.h"
@@ -218,6 +219,16 @@ void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   }
 }
 
+void BI_NetLine::setPreviewOffsets(const Point& startOffset,
+                                   const Point& endOffset) noexcept {
+  if ((startOffset != mPreviewStartOffset) ||
+      (endOffset != mPreviewEndOffset)) {
+    mPreviewStartOffset = startOffset;
+    mPreviewEndOffset   = endOffset;
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -233,7 +244,7 @@ void BI_NetLine::addToBoard() {
 
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { mGraphicsItem->updateBatch(); });
   BI_Base::addToBoard(mGraphicsItem.data());
   sg.dismiss();
 }
@@ -249,12 +260,20 @@ void BI_NetLine::removeFromBoard() {
 
   disconnect(mHighlightChangedConnection);
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  if (mBoard.unscheduleNetLineUpdate(*this)) {
+    // apply the postponed update, the board will not do it anymore
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   sg.dismiss();
 }
 
 void BI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-  mGraphicsItem->updateCacheAndRepaint();
+  if (isAddedToBoard() && mBoard.isBulkMutationActive()) {
+    mBoard.scheduleNetLineUpdate(*this);  // updated once at the end
+  } else {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
@@ -307,13 +326,22 @@ QPainterPath BI_NetLine::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape();
 }
 
+qint64 BI_NetLine::getMemoryUsage() const noexcept {
+  return sizeof(BI_NetLine) + sizeof(BGI_NetLine);
+}
+
 bool BI_NetLine::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
 
 void BI_NetLine::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  mGraphicsItem->updateBatch();
+}
+
+void BI_NetLine::setPreviewOffset(const Point& offset) noexcept {
+  // not moving the graphics item since it might be painted by a layer batch
+  setPreviewOffsets(offset, offset);
 }
 
 /*******************************************************************************
@@ -98,11 +98,26 @@ public:
   NetSignal& getNetSignalOfNetSegment() const noexcept;
   bool       isSelectable() const noexcept override;
   Path getSceneOutline(const Length& expansion = Length(0)) const noexcept;
+  const Point& getPreviewStartOffset() const noexcept {
+    return mPreviewStartOffset;
+  }
+  const Point& getPreviewEndOffset() const noexcept {
+    return mPreviewEndOffset;
+  }
 
   // Setters
   void setLayer(GraphicsLayer& layer);
   void setWidth(const PositiveLength& width) noexcept;
 
+  /**
+   * @brief Visually move the start and end point without modifying the line
+   *
+   * Like #setPreviewOffset(), but allows to stretch the line if only one of
+   * its anchors is moved.
+   */
+  void setPreviewOffsets(const Point& startOffset,
+                         const Point& endOffset) noexcept;
+
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
@@ -116,7 +131,9 @@ public:
   const Point& getPosition() const noexcept override { return mPosition; }
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
+  void         setPreviewOffset(const Point& offset) noexcept override;
 
   // Operator Overloadings
   BI_NetLine& operator=(const BI_NetLine& rhs) = delete;
@@ -139,6 +156,10 @@ private:
   BI_NetLineAnchor* mEndPoint;
   GraphicsLayer*    mLayer;
   PositiveLength    mWidth;
+
+  // Preview
+  Point mPreviewStartOffset;
+  Point mPreviewEndOffset;
 };
 
 /*******************************************************************************
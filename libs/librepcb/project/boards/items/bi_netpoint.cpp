@@ -169,6 +169,10 @@ QPainterPath BI_NetPoint::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+qint64 BI_NetPoint::getMemoryUsage() const noexcept {
+  return sizeof(BI_NetPoint) + sizeof(BGI_NetPoint);
+}
+
 bool BI_NetPoint::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
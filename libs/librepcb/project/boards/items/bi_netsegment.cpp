@@ -509,6 +509,18 @@ QPainterPath BI_NetSegment::getGrabAreaScenePx() const noexcept {
   return QPainterPath();
 }
 
+qint64 BI_NetSegment::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(BI_NetSegment);
+  foreach (const BI_Via* via, mVias) { usage += via->getMemoryUsage(); }
+  foreach (const BI_NetPoint* netpoint, mNetPoints) {
+    usage += netpoint->getMemoryUsage();
+  }
+  foreach (const BI_NetLine* netline, mNetLines) {
+    usage += netline->getMemoryUsage();
+  }
+  return usage;
+}
+
 bool BI_NetSegment::isSelected() const noexcept {
   if (mNetLines.isEmpty()) return false;
   foreach (const BI_NetLine* netline, mNetLines) {
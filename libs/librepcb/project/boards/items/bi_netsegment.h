@@ -123,6 +123,7 @@ public:
   }
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   bool         isSelectable() const noexcept override { return false; }
   bool         isSelected() const noexcept override;
   void         setSelected(bool selected) noexcept override;
@@ -239,6 +239,15 @@ QPainterPath BI_Plane::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_Plane::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(BI_Plane) + sizeof(BGI_Plane);
+  usage += mOutline.getVertices().capacity() * sizeof(Vertex);
+  foreach (const Path& fragment, mFragments) {
+    usage += sizeof(Path) + fragment.getVertices().capacity() * sizeof(Vertex);
+  }
+  return usage;
+}
+
 bool BI_Plane::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
@@ -112,6 +112,13 @@ QPainterPath BI_Polygon::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_Polygon::getMemoryUsage() const noexcept {
+  qint64 usage =
+      sizeof(BI_Polygon) + sizeof(Polygon) + sizeof(PolygonGraphicsItem);
+  usage += mPolygon->getPath().getVertices().capacity() * sizeof(Vertex);
+  return usage;
+}
+
 const Uuid& BI_Polygon::getUuid() const noexcept {
   return mPolygon->getUuid();
 }
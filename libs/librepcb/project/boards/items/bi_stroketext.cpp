@@ -151,6 +151,15 @@ QPainterPath BI_StrokeText::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 BI_StrokeText::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(BI_StrokeText) + sizeof(StrokeText) +
+      sizeof(StrokeTextGraphicsItem) + sizeof(LineGraphicsItem);
+  foreach (const Path& path, mText->getPaths()) {
+    usage += sizeof(Path) + path.getVertices().capacity() * sizeof(Vertex);
+  }
+  return usage;
+}
+
 const Uuid& BI_StrokeText::getUuid() const noexcept {
   return mText->getUuid();
 }
@@ -167,6 +176,12 @@ void BI_StrokeText::setSelected(bool selected) noexcept {
   updateGraphicsItems();
 }
 
+void BI_StrokeText::setPreviewOffset(const Point& offset) noexcept {
+  BI_Base::setPreviewOffset(offset);
+  // the footprint might not be moved, so hide the anchor line while previewing
+  mAnchorGraphicsItem->setVisible(offset.isOrigin());
+}
+
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
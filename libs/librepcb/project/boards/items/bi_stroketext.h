@@ -89,7 +89,9 @@ public:
   const Point& getPosition() const noexcept override;
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
+  void         setPreviewOffset(const Point& offset) noexcept override;
 
   // Operator Overloadings
   BI_StrokeText& operator=(const BI_StrokeText& rhs) = delete;
@@ -137,6 +137,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
+    mGraphicsItem->updateBatch();
     foreach (BI_NetLine* netline, mRegisteredNetLines) {
       netline->updateLine();
     }
@@ -175,7 +176,7 @@ void BI_Via::addToBoard() {
   }
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { mGraphicsItem->updateBatch(); });
   BI_Base::addToBoard(mGraphicsItem.data());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
@@ -189,6 +190,10 @@ void BI_Via::removeFromBoard() {
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
+void BI_Via::updateVia() noexcept {
+  mGraphicsItem->updateCacheAndRepaint();
+}
+
 void BI_Via::registerNetLine(BI_NetLine& netline) {
   if ((!isAddedToBoard()) || (mRegisteredNetLines.contains(&netline)) ||
       (&netline.getNetSegment() != &mNetSegment)) {
@@ -224,13 +229,17 @@ QPainterPath BI_Via::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+qint64 BI_Via::getMemoryUsage() const noexcept {
+  return sizeof(BI_Via) + sizeof(BGI_Via);
+}
+
 bool BI_Via::isSelectable() const noexcept {
   return mGraphicsItem->isSelectable();
 }
 
 void BI_Via::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  mGraphicsItem->updateBatch();
 }
 
 /*******************************************************************************
@@ -90,6 +90,7 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void updateVia() noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -99,6 +100,7 @@ public:
   const Point& getPosition() const noexcept override { return mPosition; }
   bool         getIsMirrored() const noexcept override { return false; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Inherited from BI_NetLineAnchor
@@ -289,8 +289,15 @@ void Circuit::setNetSignalName(NetSignal&               netsignal,
 }
 
 void Circuit::setHighlightedNetSignal(NetSignal* signal) noexcept {
+  bool changed = false;
   foreach (NetSignal* netsignal, mNetSignals) {
-    netsignal->setHighlighted(signal == netsignal);
+    if (netsignal->isHighlighted() != (signal == netsignal)) {
+      netsignal->setHighlighted(signal == netsignal);
+      changed = true;
+    }
+  }
+  if (changed) {
+    emit highlightedNetSignalChanged();
   }
 }
 
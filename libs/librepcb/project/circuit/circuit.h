@@ -140,6 +140,7 @@ signals:
   void netSignalRemoved(NetSignal& netsignal);
   void componentAdded(ComponentInstance& cmp);
   void componentRemoved(ComponentInstance& cmp);
+  void highlightedNetSignalChanged();
 
 private:
   /// @copydoc librepcb::SerializableObject::serialize()
@@ -56,8 +56,19 @@ void ErcMsgList::add(ErcMsg* ercMsg) noexcept {
   Q_ASSERT(ercMsg);
   Q_ASSERT(!mItems.contains(ercMsg));
   Q_ASSERT(!ercMsg->isIgnored());
+  // Messages which did not exist when the ignore state was restored (e.g.
+  // messages of the design rule check) are approved when they appear the first
+  // time. Afterwards, the usual rule applies that showing a message again
+  // resets its ignore state.
+  QString key = getKey(*ercMsg);
+  bool    wasApproved =
+      mApprovedItems.contains(key) && (!mSeenKeys.contains(key));
+  mSeenKeys.insert(key);
   mItems.append(ercMsg);
   emit ercMsgAdded(ercMsg);
+  if (wasApproved) {
+    ercMsg->setIgnored(true);
+  }
 }
 
 void ErcMsgList::remove(ErcMsg* ercMsg) noexcept {
@@ -87,7 +98,12 @@ void ErcMsgList::restoreIgnoreState() {
       ercMsg->setIgnored(false);
 
     // scan approved items and set ignore attributes
+    mApprovedItems.clear();
     foreach (const SExpression& node, root.getChildren("approved")) {
+      QStringList item = {node.getValueByPath<QString>("class"),
+                          node.getValueByPath<QString>("instance"),
+                          node.getValueByPath<QString>("message")};
+      mApprovedItems.insert(getKey(item.at(0), item.at(1), item.at(2)), item);
       foreach (ErcMsg* ercMsg, mItems) {
         if ((ercMsg->getOwner().getErcMsgOwnerClassName() ==
              node.getValueByPath<QString>("class")) &&
@@ -121,6 +137,26 @@ void ErcMsgList::serialize(SExpression& root) const {
       itemNode.appendChild("message", ercMsg->getMsgKey(), true);
     }
   }
+  // keep approvals of messages which did not appear since opening the project
+  for (auto it = mApprovedItems.constBegin(); it != mApprovedItems.constEnd();
+       ++it) {
+    if (!mSeenKeys.contains(it.key())) {
+      SExpression& itemNode = root.appendList("approved", true);
+      itemNode.appendChild("class", it.value().at(0), true);
+      itemNode.appendChild("instance", it.value().at(1), true);
+      itemNode.appendChild("message", it.value().at(2), true);
+    }
+  }
+}
+
+QString ErcMsgList::getKey(const QString& ownerClass, const QString& ownerKey,
+                           const QString& msgKey) noexcept {
+  return ownerClass % "|" % ownerKey % "|" % msgKey;
+}
+
+QString ErcMsgList::getKey(const ErcMsg& ercMsg) noexcept {
+  return getKey(ercMsg.getOwner().getErcMsgOwnerClassName(),
+                ercMsg.getOwnerKey(), ercMsg.getMsgKey());
 }
 
 /*******************************************************************************
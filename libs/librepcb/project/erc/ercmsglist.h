@@ -79,11 +79,21 @@ private:  // Methods
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
+  static QString getKey(const QString& ownerClass, const QString& ownerKey,
+                        const QString& msgKey) noexcept;
+  static QString getKey(const ErcMsg& ercMsg) noexcept;
+
   // General
   Project& mProject;
 
   // Misc
   QList<ErcMsg*> mItems;  ///< contains all visible ERC messages
+
+  /// Approved messages loaded from file (key: see #getKey())
+  QHash<QString, QStringList> mApprovedItems;
+
+  /// Keys of all messages which were visible since the project was opened
+  QSet<QString> mSeenKeys;
 };
 
 /*******************************************************************************
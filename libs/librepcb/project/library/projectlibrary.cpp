@@ -30,6 +30,7 @@
 #include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/dev/device.h>
+#include <librepcb/library/libraryelementcache.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/sym/symbol.h>
 
@@ -59,18 +60,21 @@ ProjectLibrary::ProjectLibrary(
     loadElements<Component>("cmp", "components", mComponents);
     loadElements<Device>("dev", "devices", mDevices);
   } catch (const Exception&) {
-    qDeleteAll(mAllElements);
-    mAllElements.clear();
+    mSharedElements.clear();
+    mSharedElementPaths.clear();
     throw;
   }
 
   qDebug() << "project library successfully loaded!";
+  printMemoryUsage();
 }
 
 ProjectLibrary::~ProjectLibrary() noexcept {
   // Delete all library elements.
   qDeleteAll(mAllElements);
   mAllElements.clear();
+  mSharedElements.clear();
+  mSharedElementPaths.clear();
   mElementsToUpgrade.clear();
 }
 
@@ -133,7 +137,8 @@ void ProjectLibrary::save() {
   // Save library elements to enforce a file format upgrade, but only once for
   // optimal performance.
   foreach (LibraryBaseElement* element, mElementsToUpgrade) {
-    element->save();  // can throw
+    TransactionalDirectory dir(*mDirectory, getElementPath(*element));
+    element->writeTo(dir);  // can throw
     mElementsToUpgrade.remove(element);
   }
 }
@@ -147,8 +152,9 @@ void ProjectLibrary::loadElements(const QString& dirname, const QString& type,
                                   QHash<Uuid, ElementType*>& elementList) {
   // search all subdirectories which have a valid UUID as directory name
   foreach (const QString& sub, mDirectory->getDirs(dirname)) {
+    QString                                 path = dirname % "/" % sub;
     std::unique_ptr<TransactionalDirectory> dir(
-        new TransactionalDirectory(*mDirectory, dirname % "/" % sub));
+        new TransactionalDirectory(*mDirectory, path));
 
     // check if directory is a valid library element
     if (!LibraryBaseElement::isValidElementDirectory<ElementType>(*dir, "")) {
@@ -157,9 +163,10 @@ void ProjectLibrary::loadElements(const QString& dirname, const QString& type,
       continue;
     }
 
-    // load the library element
-    QScopedPointer<ElementType> element(
-        new ElementType(std::move(dir)));  // can throw
+    // load the library element (or get it from memory if another project
+    // has already loaded exactly the same element)
+    std::shared_ptr<ElementType> element =
+        LibraryElementCache::instance()->load<ElementType>(*dir);  // can throw
     if (elementList.contains(element->getUuid())) {
       throw RuntimeError(
           __FILE__, __LINE__,
@@ -169,9 +176,10 @@ void ProjectLibrary::loadElements(const QString& dirname, const QString& type,
     }
 
     // everything is ok -> update members
-    elementList.insert(element->getUuid(), element.data());
-    mElementsToUpgrade.insert(element.data());
-    mAllElements.insert(element.take());  // Take object from smart pointer!
+    elementList.insert(element->getUuid(), element.get());
+    mElementsToUpgrade.insert(element.get());
+    mSharedElements.insert(element.get(), element);
+    mSharedElementPaths.insert(element.get(), path);
   }
 
   qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
@@ -186,23 +194,52 @@ void ProjectLibrary::addElement(ElementType&               element,
                                 "UUID in the project's library: %1"))
                          .arg(element.getUuid().toStr()));
   }
-  TransactionalDirectory dir(*mDirectory, element.getShortElementName());
-  element.saveIntoParentDirectory(dir);  // can throw
+  if (mSharedElements.contains(&element)) {
+    // re-added after removing it, don't modify the shared element
+    TransactionalDirectory dir(*mDirectory, getElementPath(element));
+    element.writeTo(dir);  // can throw
+  } else {
+    TransactionalDirectory dir(*mDirectory, element.getShortElementName());
+    element.saveIntoParentDirectory(dir);  // can throw
+    mAllElements.insert(&element);
+  }
   elementList.insert(element.getUuid(), &element);
-  mAllElements.insert(&element);
 }
 
 template <typename ElementType>
 void ProjectLibrary::removeElement(ElementType&               element,
                                    QHash<Uuid, ElementType*>& elementList) {
   Q_ASSERT(elementList.value(element.getUuid()) == &element);
-  Q_ASSERT(mAllElements.contains(&element));
-  TransactionalDirectory dir(
-      TransactionalFileSystem::openRW(FilePath::getRandomTempPath()));
-  element.moveIntoParentDirectory(dir);  // can throw
+  Q_ASSERT(mAllElements.contains(&element) ||
+           mSharedElements.contains(&element));
+  if (mSharedElements.contains(&element)) {
+    // just remove the files, the element itself is kept in memory anyway
+    mDirectory->removeDirRecursively(getElementPath(element));  // can throw
+  } else {
+    TransactionalDirectory dir(
+        TransactionalFileSystem::openRW(FilePath::getRandomTempPath()));
+    element.moveIntoParentDirectory(dir);  // can throw
+  }
   elementList.remove(element.getUuid());
 }
 
+QString ProjectLibrary::getElementPath(
+    const LibraryBaseElement& element) const noexcept {
+  Q_ASSERT(mSharedElementPaths.contains(&element));
+  return mSharedElementPaths.value(&element);
+}
+
+void ProjectLibrary::printMemoryUsage() const noexcept {
+  const QMap<QString, LibraryElementCache::Statistics> statistics =
+      LibraryElementCache::instance()->getStatistics();
+  for (auto it = statistics.constBegin(); it != statistics.constEnd(); ++it) {
+    qDebug().nospace() << "library elements in memory (" << qPrintable(it.key())
+                       << "): " << it.value().elements << " elements with "
+                       << it.value().references << " users, "
+                       << (it.value().fileSize / 1024) << " kB of files";
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -55,6 +55,13 @@ class Project;
 /**
  * @brief The ProjectLibrary class
  *
+ * The elements loaded from the project directory are obtained from the
+ * process-wide ::librepcb::library::LibraryElementCache, so identical
+ * elements used by several opened projects are kept in memory only once.
+ * Therefore these elements must never be modified, they are only written
+ * to the project directory with
+ * ::librepcb::library::LibraryBaseElement::writeTo() when needed.
+ *
  * @todo Adding and removing elements is very provisional. It does not really
  * work together with the automatic backup/restore feature of projects.
  */
@@ -124,6 +131,9 @@ private:
   template <typename ElementType>
   void removeElement(ElementType&               element,
                      QHash<Uuid, ElementType*>& elementList);
+  QString getElementPath(const library::LibraryBaseElement& element) const
+      noexcept;
+  void printMemoryUsage() const noexcept;
 
   // General
   std::unique_ptr<TransactionalDirectory> mDirectory;
@@ -134,7 +144,18 @@ private:
   QHash<Uuid, library::Component*> mComponents;
   QHash<Uuid, library::Device*>    mDevices;
 
-  QSet<library::LibraryBaseElement*> mAllElements;
+  /// Elements loaded from the project directory, obtained from
+  /// ::librepcb::library::LibraryElementCache and thus probably shared with
+  /// other projects (they must not be modified!)
+  QHash<library::LibraryBaseElement*,
+        std::shared_ptr<library::LibraryBaseElement>>
+      mSharedElements;
+
+  /// Directories of the elements in #mSharedElements, relative to
+  /// #mDirectory (since the directory names might differ from the UUIDs)
+  QHash<const library::LibraryBaseElement*, QString> mSharedElementPaths;
+
+  QSet<library::LibraryBaseElement*> mAllElements;  ///< Owned (added) elements
   QSet<library::LibraryBaseElement*> mElementsToUpgrade;
 };
 
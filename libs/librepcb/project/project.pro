@@ -22,11 +22,14 @@ INCLUDEPATH += \
 SOURCES += \
     boards/board.cpp \
     boards/boardairwiresbuilder.cpp \
+    boards/boardautorouter.cpp \
+    boards/boarddesignrulecheck.cpp \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
     boards/boardplanefragmentsbuilder.cpp \
     boards/boardselectionquery.cpp \
+    boards/boardtracerouter.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
@@ -137,11 +140,14 @@ SOURCES += \
 HEADERS += \
     boards/board.h \
     boards/boardairwiresbuilder.h \
+    boards/boardautorouter.h \
+    boards/boarddesignrulecheck.h \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
     boards/boardplanefragmentsbuilder.h \
     boards/boardselectionquery.h \
+    boards/boardtracerouter.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
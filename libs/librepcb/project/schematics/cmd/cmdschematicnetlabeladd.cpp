@@ -46,9 +46,23 @@ CmdSchematicNetLabelAdd::CmdSchematicNetLabelAdd(SI_NetSegment& segment,
     mPosition(position),
     mRotation(rotation),
     mNetLabel(nullptr) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdSchematicNetLabelAdd::~CmdSchematicNetLabelAdd() noexcept {
+  if (mNetLabel) {
+    releaseItem(*mNetLabel, mNetSegment.getNetLabels());
+  }
+  releaseItem(mNetSegment, mNetSegment.getSchematic().getNetSegments());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetLabelAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mNetLabel, false);
 }
 
 /*******************************************************************************
@@ -57,6 +71,7 @@ CmdSchematicNetLabelAdd::~CmdSchematicNetLabelAdd() noexcept {
 
 bool CmdSchematicNetLabelAdd::performExecute() {
   mNetLabel = new SI_NetLabel(mNetSegment, mPosition, mRotation);  // can throw
+  mNetLabel->registerUndoCommand();
 
   performRedo();  // can throw
 
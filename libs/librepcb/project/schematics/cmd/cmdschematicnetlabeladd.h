@@ -56,6 +56,9 @@ public:
   // Getters
   SI_NetLabel* getNetLabel() const noexcept { return mNetLabel; }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -43,9 +43,22 @@ CmdSchematicNetLabelRemove::CmdSchematicNetLabelRemove(
   : UndoCommand(tr("Remove netlabel")),
     mNetSegment(netlabel.getNetSegment()),
     mNetLabel(netlabel) {
+  mNetSegment.registerUndoCommand();
+  mNetLabel.registerUndoCommand();
 }
 
 CmdSchematicNetLabelRemove::~CmdSchematicNetLabelRemove() noexcept {
+  releaseItem(mNetLabel, mNetSegment.getNetLabels());
+  releaseItem(mNetSegment, mNetSegment.getSchematic().getNetSegments());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetLabelRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mNetLabel, true);
 }
 
 /*******************************************************************************
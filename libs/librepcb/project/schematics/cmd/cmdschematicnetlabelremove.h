@@ -50,6 +50,11 @@ public:
   CmdSchematicNetLabelRemove(SI_NetLabel& netlabel) noexcept;
   ~CmdSchematicNetLabelRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
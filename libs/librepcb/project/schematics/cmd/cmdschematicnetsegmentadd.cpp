@@ -43,6 +43,7 @@ CmdSchematicNetSegmentAdd::CmdSchematicNetSegmentAdd(
     mSchematic(segment.getSchematic()),
     mNetSignal(segment.getNetSignal()),
     mNetSegment(&segment) {
+  mNetSegment->registerUndoCommand();
 }
 
 CmdSchematicNetSegmentAdd::CmdSchematicNetSegmentAdd(
@@ -54,6 +55,18 @@ CmdSchematicNetSegmentAdd::CmdSchematicNetSegmentAdd(
 }
 
 CmdSchematicNetSegmentAdd::~CmdSchematicNetSegmentAdd() noexcept {
+  if (mNetSegment) {
+    releaseItem(*mNetSegment, mSchematic.getNetSegments());
+  }
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mNetSegment, false);
 }
 
 /*******************************************************************************
@@ -64,6 +77,7 @@ bool CmdSchematicNetSegmentAdd::performExecute() {
   if (!mNetSegment) {
     // create new net segment
     mNetSegment = new SI_NetSegment(mSchematic, mNetSignal);  // can throw
+    mNetSegment->registerUndoCommand();
   }
 
   performRedo();  // can throw
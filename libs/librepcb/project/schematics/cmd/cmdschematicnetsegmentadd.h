@@ -55,6 +55,9 @@ public:
   // Getters
   SI_NetSegment* getNetSegment() const noexcept { return mNetSegment; }
 
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
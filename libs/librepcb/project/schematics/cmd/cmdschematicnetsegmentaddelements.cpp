@@ -41,10 +41,18 @@ namespace project {
 CmdSchematicNetSegmentAddElements::CmdSchematicNetSegmentAddElements(
     SI_NetSegment& segment) noexcept
   : UndoCommand(tr("Add net segment elements")), mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdSchematicNetSegmentAddElements::
     ~CmdSchematicNetSegmentAddElements() noexcept {
+  foreach (SI_NetLine* netline, mNetLines) {
+    releaseItem(*netline, mNetSegment.getNetLines());
+  }
+  foreach (SI_NetPoint* netpoint, mNetPoints) {
+    releaseItem(*netpoint, mNetSegment.getNetPoints());
+  }
+  releaseItem(mNetSegment, mNetSegment.getSchematic().getNetSegments());
 }
 
 /*******************************************************************************
@@ -53,6 +61,7 @@ CmdSchematicNetSegmentAddElements::
 
 SI_NetPoint* CmdSchematicNetSegmentAddElements::addNetPoint(
     SI_NetPoint& netpoint) {
+  netpoint.registerUndoCommand();
   mNetPoints.append(&netpoint);
   return &netpoint;
 }
@@ -64,6 +73,7 @@ SI_NetPoint* CmdSchematicNetSegmentAddElements::addNetPoint(
 }
 
 SI_NetLine* CmdSchematicNetSegmentAddElements::addNetLine(SI_NetLine& netline) {
+  netline.registerUndoCommand();
   mNetLines.append(&netline);
   return &netline;
 }
@@ -75,6 +85,16 @@ SI_NetLine* CmdSchematicNetSegmentAddElements::addNetLine(
   return addNetLine(*netline);
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentAddElements::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mNetPoints, false) +
+         getDetachedItemMemoryUsage(mNetLines, false);
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
@@ -59,6 +59,11 @@ public:
   SI_NetLine*  addNetLine(SI_NetLineAnchor& startPoint,
                           SI_NetLineAnchor& endPoint);
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
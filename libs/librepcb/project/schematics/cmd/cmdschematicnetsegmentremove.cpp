@@ -42,9 +42,20 @@ CmdSchematicNetSegmentRemove::CmdSchematicNetSegmentRemove(
   : UndoCommand(tr("Remove net segment")),
     mSchematic(segment.getSchematic()),
     mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdSchematicNetSegmentRemove::~CmdSchematicNetSegmentRemove() noexcept {
+  releaseItem(mNetSegment, mSchematic.getNetSegments());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mNetSegment, true);
 }
 
 /*******************************************************************************
@@ -49,6 +49,11 @@ public:
   explicit CmdSchematicNetSegmentRemove(SI_NetSegment& segment) noexcept;
   ~CmdSchematicNetSegmentRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
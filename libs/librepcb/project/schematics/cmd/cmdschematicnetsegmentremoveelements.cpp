@@ -42,10 +42,18 @@ namespace project {
 CmdSchematicNetSegmentRemoveElements::CmdSchematicNetSegmentRemoveElements(
     SI_NetSegment& segment) noexcept
   : UndoCommand(tr("Remove net segment elements")), mNetSegment(segment) {
+  mNetSegment.registerUndoCommand();
 }
 
 CmdSchematicNetSegmentRemoveElements::
     ~CmdSchematicNetSegmentRemoveElements() noexcept {
+  foreach (SI_NetLine* netline, mNetLines) {
+    releaseItem(*netline, mNetSegment.getNetLines());
+  }
+  foreach (SI_NetPoint* netpoint, mNetPoints) {
+    releaseItem(*netpoint, mNetSegment.getNetPoints());
+  }
+  releaseItem(mNetSegment, mNetSegment.getSchematic().getNetSegments());
 }
 
 /*******************************************************************************
@@ -54,13 +62,25 @@ CmdSchematicNetSegmentRemoveElements::
 
 void CmdSchematicNetSegmentRemoveElements::removeNetPoint(
     SI_NetPoint& netpoint) {
+  netpoint.registerUndoCommand();
   mNetPoints.append(&netpoint);
 }
 
 void CmdSchematicNetSegmentRemoveElements::removeNetLine(SI_NetLine& netline) {
+  netline.registerUndoCommand();
   mNetLines.append(&netline);
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSchematicNetSegmentRemoveElements::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(mNetPoints, true) +
+         getDetachedItemMemoryUsage(mNetLines, true);
+}
+
 /*******************************************************************************
  *  Inherited from UndoCommand
  ******************************************************************************/
@@ -54,6 +54,11 @@ public:
   void removeNetPoint(SI_NetPoint& netpoint);
   void removeNetLine(SI_NetLine& netline);
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -41,9 +41,20 @@ namespace project {
 
 CmdSymbolInstanceAdd::CmdSymbolInstanceAdd(SI_Symbol& symbol) noexcept
   : UndoCommand(tr("Add symbol instance")), mSymbolInstance(symbol) {
+  mSymbolInstance.registerUndoCommand();
 }
 
 CmdSymbolInstanceAdd::~CmdSymbolInstanceAdd() noexcept {
+  releaseItem(mSymbolInstance, mSymbolInstance.getSchematic().getSymbols());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSymbolInstanceAdd::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mSymbolInstance, false);
 }
 
 /*******************************************************************************
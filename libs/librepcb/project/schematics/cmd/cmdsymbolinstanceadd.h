@@ -52,6 +52,11 @@ public:
   explicit CmdSymbolInstanceAdd(SI_Symbol& symbol) noexcept;
   ~CmdSymbolInstanceAdd() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:  // Methods
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
@@ -40,9 +40,20 @@ namespace project {
 CmdSymbolInstanceRemove::CmdSymbolInstanceRemove(Schematic& schematic,
                                                  SI_Symbol& symbol) noexcept
   : UndoCommand(tr("Remove symbol")), mSchematic(schematic), mSymbol(symbol) {
+  mSymbol.registerUndoCommand();
 }
 
 CmdSymbolInstanceRemove::~CmdSymbolInstanceRemove() noexcept {
+  releaseItem(mSymbol, mSchematic.getSymbols());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 CmdSymbolInstanceRemove::getMemoryUsage() const noexcept {
+  return UndoCommand::getMemoryUsage() +
+         getDetachedItemMemoryUsage(&mSymbol, true);
 }
 
 /*******************************************************************************
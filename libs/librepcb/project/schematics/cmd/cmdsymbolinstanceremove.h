@@ -49,6 +49,11 @@ public:
   CmdSymbolInstanceRemove(Schematic& schematic, SI_Symbol& symbol) noexcept;
   ~CmdSymbolInstanceRemove() noexcept;
 
+  // Getters
+
+  /// @copydoc UndoCommand::getMemoryUsage()
+  qint64 getMemoryUsage() const noexcept override;
+
 private:
   // Private Methods
 
@@ -80,6 +80,9 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept {
   UnsignedLength width = qMax(mNetLine.getWidth(), UnsignedLength(1270000));
   ps.setWidth(width->toPx());
   mShape = ps.createStroke(mShape);
+  // the grab area is wider than the line itself, but the bounding rect needs
+  // to contain it to find the netline in the scene's spatial index
+  mBoundingRect = mBoundingRect.united(mShape.boundingRect());
   update();
 }
 
@@ -30,6 +30,7 @@
 
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/graphics/levelofdetail.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/sym/symbol.h>
 
@@ -189,8 +190,18 @@ void SGI_Symbol::paint(QPainter*                       painter,
   const bool           selected = mSymbol.isSelected();
   const bool           deviceIsPrinter =
       (dynamic_cast<QPrinter*>(painter->device()) != 0);
-  const qreal lod =
-      option->levelOfDetailFromTransform(painter->worldTransform());
+  const LevelOfDetail  lod(*painter, *option);
+
+  // only draw a simplified proxy if the whole symbol is tiny on the screen
+  if (lod.isTooSmall(mBoundingRect)) {
+    layer = getLayer(GraphicsLayer::sSymbolOutlines);
+    if (layer && layer->isVisible()) {
+      painter->setPen(QPen(layer->getColor(selected), 0));
+      painter->setBrush(Qt::NoBrush);
+      painter->drawRect(mBoundingRect);
+    }
+    return;
+  }
 
   // draw all polygons
   for (const Polygon& polygon : mLibSymbol.getPolygons()) {
@@ -262,6 +273,9 @@ void SGI_Symbol::paint(QPainter*                       painter,
     if (!layer) continue;
     if (!layer->isVisible()) continue;
 
+    // skip texts which are smaller than a pixel
+    if (!lod.isTextVisible(text.getHeight()->toPx())) continue;
+
     // get cached text properties
     const CachedTextProperties_t& props = mCachedTextProperties.value(&text);
     mFont.setPixelSize(props.fontPixelSize);
@@ -280,7 +294,7 @@ void SGI_Symbol::paint(QPainter*                       painter,
     painter->translate(-text.getPosition().toPxQPointF());
     painter->scale(props.scaleFactor, props.scaleFactor);
     if (props.rotate180) painter->rotate(180);
-    if ((deviceIsPrinter) || (lod * text.getHeight()->toPx() > 8)) {
+    if ((deviceIsPrinter) || (lod.getLod() * text.getHeight()->toPx() > 8)) {
       // draw text
       painter->setPen(QPen(layer->getColor(selected), 0));
       painter->setFont(mFont);
@@ -44,10 +44,12 @@ SI_Base::SI_Base(Schematic& schematic) noexcept
   : QObject(&schematic),
     mSchematic(schematic),
     mIsAddedToSchematic(false),
-    mIsSelected(false) {
+    mIsSelected(false),
+    mUndoCommandCount(0) {
 }
 
 SI_Base::~SI_Base() noexcept {
+  Q_ASSERT(mUndoCommandCount == 0);
   Q_ASSERT(!mIsAddedToSchematic);
 }
 
@@ -78,6 +80,8 @@ void SI_Base::setSelected(bool selected) noexcept {
 void SI_Base::addToSchematic(SGI_Base* item) noexcept {
   Q_ASSERT(!mIsAddedToSchematic);
   if (item) {
+    item->setData(sGraphicsItemDataKey,
+                  QVariant::fromValue(static_cast<void*>(this)));
     mSchematic.getGraphicsScene().addItem(*item);
   }
   mIsAddedToSchematic = true;
@@ -87,10 +91,19 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
   Q_ASSERT(mIsAddedToSchematic);
   if (item) {
     mSchematic.getGraphicsScene().removeItem(*item);
+    item->setData(sGraphicsItemDataKey, QVariant());
   }
   mIsAddedToSchematic = false;
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+SI_Base* SI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  return static_cast<SI_Base*>(item.data(sGraphicsItemDataKey).value<void*>());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -81,6 +81,17 @@ public:
   }
   virtual bool isSelected() const noexcept { return mIsSelected; }
 
+  /**
+   * @brief Get the approximate amount of memory used by this item
+   *
+   * Includes the graphics items and all child items, but not shared data like
+   * library elements. Used by undo commands which keep removed items alive
+   * (see librepcb::UndoCommand::getMemoryUsage()).
+   *
+   * @return Number of bytes (not necessarily exact)
+   */
+  virtual qint64 getMemoryUsage() const noexcept = 0;
+
   // Setters
   virtual void setSelected(bool selected) noexcept;
 
@@ -88,9 +99,41 @@ public:
   virtual void addToSchematic()      = 0;
   virtual void removeFromSchematic() = 0;
 
+  // Undo Command References
+
+  /**
+   * @brief Register an undo command which holds a pointer to this item
+   *
+   * Items which were removed from the schematic are owned by the undo commands
+   * referencing them, see librepcb::UndoCommand::releaseItem().
+   */
+  void registerUndoCommand() noexcept { ++mUndoCommandCount; }
+
+  /**
+   * @brief Unregister an undo command which holds a pointer to this item
+   *
+   * @return True if no undo command references this item anymore
+   */
+  bool unregisterUndoCommand() noexcept {
+    Q_ASSERT(mUndoCommandCount > 0);
+    return (--mUndoCommandCount == 0);
+  }
+
   // Operator Overloadings
   SI_Base& operator=(const SI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the schematic item which added a graphics item to the schematic
+   *
+   * @param item    A graphics item of the schematic's graphics scene
+   *
+   * @return The schematic item, or nullptr if the graphics item doesn't belong
+   *         to any schematic item (e.g. child items)
+   */
+  static SI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToSchematic(SGI_Base* item) noexcept;
@@ -100,9 +143,13 @@ protected:
   Schematic& mSchematic;
 
 private:
+  /// Key of the QGraphicsItem::data() entry which stores the SI_Base pointer
+  static constexpr int sGraphicsItemDataKey = 0;
+
   // General Attributes
   bool mIsAddedToSchematic;
   bool mIsSelected;
+  int  mUndoCommandCount;  ///< See #registerUndoCommand()
 };
 
 /*******************************************************************************
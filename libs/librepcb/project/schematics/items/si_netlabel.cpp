@@ -148,6 +148,10 @@ QPainterPath SI_NetLabel::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 SI_NetLabel::getMemoryUsage() const noexcept {
+  return sizeof(SI_NetLabel) + sizeof(SGI_NetLabel);
+}
+
 void SI_NetLabel::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
   mGraphicsItem->update();
@@ -201,6 +201,10 @@ QPainterPath SI_NetLine::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape();
 }
 
+qint64 SI_NetLine::getMemoryUsage() const noexcept {
+  return sizeof(SI_NetLine) + sizeof(SGI_NetLine);
+}
+
 void SI_NetLine::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
   mGraphicsItem->update();
@@ -98,6 +98,7 @@ public:
   Type_t getType() const noexcept override { return SI_Base::Type_t::NetLine; }
   const Point& getPosition() const noexcept override { return mPosition; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Operator Overloadings
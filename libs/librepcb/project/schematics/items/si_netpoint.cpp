@@ -158,6 +158,10 @@ QPainterPath SI_NetPoint::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+qint64 SI_NetPoint::getMemoryUsage() const noexcept {
+  return sizeof(SI_NetPoint) + sizeof(SGI_NetPoint);
+}
+
 void SI_NetPoint::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
   mGraphicsItem->update();
@@ -83,6 +83,7 @@ public:
   Type_t getType() const noexcept override { return SI_Base::Type_t::NetPoint; }
   const Point& getPosition() const noexcept override { return mPosition; }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
   // Inherited from SI_NetLineAnchor
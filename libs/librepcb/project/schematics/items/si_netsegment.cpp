@@ -526,6 +526,20 @@ QPainterPath SI_NetSegment::getGrabAreaScenePx() const noexcept {
   return QPainterPath();
 }
 
+qint64 SI_NetSegment::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(SI_NetSegment);
+  foreach (const SI_NetPoint* netpoint, mNetPoints) {
+    usage += netpoint->getMemoryUsage();
+  }
+  foreach (const SI_NetLine* netline, mNetLines) {
+    usage += netline->getMemoryUsage();
+  }
+  foreach (const SI_NetLabel* netlabel, mNetLabels) {
+    usage += netlabel->getMemoryUsage();
+  }
+  return usage;
+}
+
 bool SI_NetSegment::isSelected() const noexcept {
   if (mNetLines.isEmpty()) return false;
   foreach (const SI_NetLine* netline, mNetLines) {
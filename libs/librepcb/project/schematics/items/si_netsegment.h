@@ -124,6 +124,7 @@ public:
     return p;
   }
   QPainterPath getGrabAreaScenePx() const noexcept override;
+  qint64       getMemoryUsage() const noexcept override;
   bool         isSelected() const noexcept override;
   void         setSelected(bool selected) noexcept override;
 
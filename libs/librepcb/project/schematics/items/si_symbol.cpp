@@ -259,6 +259,12 @@ QPainterPath SI_Symbol::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 SI_Symbol::getMemoryUsage() const noexcept {
+  qint64 usage = sizeof(SI_Symbol) + sizeof(SGI_Symbol);
+  foreach (const SI_SymbolPin* pin, mPins) { usage += pin->getMemoryUsage(); }
+  return usage;
+}
+
 void SI_Symbol::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
   mGraphicsItem->update();
@@ -221,6 +221,10 @@ QPainterPath SI_SymbolPin::getGrabAreaScenePx() const noexcept {
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+qint64 SI_SymbolPin::getMemoryUsage() const noexcept {
+  return sizeof(SI_SymbolPin) + sizeof(SGI_SymbolPin);
+}
+
 void SI_SymbolPin::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
   mGraphicsItem->update();
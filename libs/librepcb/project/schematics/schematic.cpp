@@ -37,6 +37,7 @@
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/common/scopeguardlist.h>
+#include <librepcb/common/toolbox.h>
 #include <librepcb/library/sym/symbolpin.h>
 
 #include <QtCore>
@@ -47,6 +48,21 @@
 namespace librepcb {
 namespace project {
 
+template <typename T>
+static QList<T*> filterItemsAtScenePos(const QList<SI_Base*>& items,
+                                       SI_Base::Type_t        type,
+                                       const Point&           pos) noexcept {
+  QPointF   scenePosPx = pos.toPxQPointF();
+  QList<T*> list;
+  foreach (SI_Base* item, items) {
+    if ((item->getType() == type) &&
+        item->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(static_cast<T*>(item));
+    }
+  }
+  return list;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -150,79 +166,116 @@ bool Schematic::isEmpty() const noexcept {
 }
 
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
-  QPointF scenePosPx = pos.toPxQPointF();
+  QPointF         scenePosPx = pos.toPxQPointF();
+  QList<SI_Base*> candidates;
+  foreach (SI_Base* item, getItemsFromSpatialIndex(scenePosPx)) {
+    if (item->getGrabAreaScenePx().contains(scenePosPx)) {
+      candidates.append(item);
+    }
+  }
   QList<SI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
 
   // visible netpoints
-  const QList<SI_NetPoint*> netpoints(getNetPointsAtScenePos(pos));
-  foreach (SI_NetPoint* netpoint, netpoints) {
-    if (netpoint->isVisibleJunction()) {
-      list.append(netpoint);
+  foreach (SI_Base* item, candidates) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) &&
+        static_cast<SI_NetPoint*>(item)->isVisibleJunction()) {
+      list.append(item);
     }
   }
   // hidden netpoints
-  foreach (SI_NetPoint* netpoint, netpoints) {
-    if (!netpoint->isVisibleJunction()) {
-      list.append(netpoint);
+  foreach (SI_Base* item, candidates) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) &&
+        (!static_cast<SI_NetPoint*>(item)->isVisibleJunction())) {
+      list.append(item);
     }
   }
-  // netlines
-  foreach (SI_NetLine* netline, getNetLinesAtScenePos(pos)) {
-    list.append(netline);
+  // netlines & netlabels
+  foreach (SI_Base::Type_t type,
+           QList<SI_Base::Type_t>{SI_Base::Type_t::NetLine,
+                                  SI_Base::Type_t::NetLabel}) {
+    foreach (SI_Base* item, candidates) {
+      if (item->getType() == type) {
+        list.append(item);
+      }
+    }
   }
-  // netlabels
-  foreach (SI_NetLabel* netlabel, getNetLabelsAtScenePos(pos)) {
-    list.append(netlabel);
+  // pins must come before symbols since they are drawn on top of them (the
+  // order of the spatial index is not reliable as they have the same Z value)
+  foreach (SI_Base::Type_t type,
+           QList<SI_Base::Type_t>{SI_Base::Type_t::SymbolPin,
+                                  SI_Base::Type_t::Symbol}) {
+    foreach (SI_Base* item, candidates) {
+      if (item->getType() == type) {
+        list.append(item);
+      }
+    }
   }
-  // symbols & pins
-  foreach (SI_Symbol* symbol, mSymbols) {
-    foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(scenePosPx)) list.append(pin);
+  return list;
+}
+
+QList<SI_Base*> Schematic::getItemsNearScenePos(
+    const Point& pos, const UnsignedLength& maxDistance) const noexcept {
+  QPointF      scenePosPx = pos.toPxQPointF();
+  qreal        r          = maxDistance->toPx();
+  QPainterPath circlePx;
+  circlePx.addEllipse(scenePosPx, r, r);
+  QList<QPair<Length, SI_Base*>> items;
+  foreach (SI_Base* item, getItemsFromSpatialIndex(circlePx.boundingRect())) {
+    QPainterPath grabArea = item->getGrabAreaScenePx();
+    if (!grabArea.intersects(circlePx)) {
+      continue;
     }
-    if (symbol->getGrabAreaScenePx().contains(scenePosPx)) list.append(symbol);
+    Length distance(0);
+    if (grabArea.contains(scenePosPx)) {
+      // distance is zero
+    } else if (item->getType() == SI_Base::Type_t::NetLine) {
+      SI_NetLine* netline = static_cast<SI_NetLine*>(item);
+      distance            = Toolbox::shortestDistanceBetweenPointAndLine(
+          pos, netline->getStartPoint().getPosition(),
+          netline->getEndPoint().getPosition());
+    } else {
+      distance = (item->getPosition() - pos).getLength();
+    }
+    items.append(qMakePair(distance, item));
   }
+  std::stable_sort(items.begin(), items.end(),
+                   [](const QPair<Length, SI_Base*>& a,
+                      const QPair<Length, SI_Base*>& b) {
+                     return a.first < b.first;
+                   });
+  QList<SI_Base*> list;
+  foreach (const auto& pair, items) { list.append(pair.second); }
   return list;
 }
 
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetPoint*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetPointsAtScenePos(pos, list);
-  }
-  return list;
+  return filterItemsAtScenePos<SI_NetPoint>(
+      getItemsFromSpatialIndex(pos.toPxQPointF()), SI_Base::Type_t::NetPoint,
+      pos);
 }
 
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetLine*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLinesAtScenePos(pos, list);
-  }
-  return list;
+  return filterItemsAtScenePos<SI_NetLine>(
+      getItemsFromSpatialIndex(pos.toPxQPointF()), SI_Base::Type_t::NetLine,
+      pos);
 }
 
 QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_NetLabel*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLabelsAtScenePos(pos, list);
-  }
-  return list;
+  return filterItemsAtScenePos<SI_NetLabel>(
+      getItemsFromSpatialIndex(pos.toPxQPointF()), SI_Base::Type_t::NetLabel,
+      pos);
 }
 
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
     noexcept {
-  QList<SI_SymbolPin*> list;
-  foreach (SI_Symbol* symbol, mSymbols) {
-    foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-        list.append(pin);
-    }
-  }
-  return list;
+  return filterItemsAtScenePos<SI_SymbolPin>(
+      getItemsFromSpatialIndex(pos.toPxQPointF()), SI_Base::Type_t::SymbolPin,
+      pos);
 }
 
 /*******************************************************************************
@@ -370,17 +423,31 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-    foreach (SI_Symbol* symbol, mSymbols) {
-      bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-      symbol->setSelected(selectSymbol);
-      foreach (SI_SymbolPin* pin, symbol->getPins()) {
-        bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-        pin->setSelected(selectSymbol || selectPin);
+
+    QSet<SI_Base*> items;
+    foreach (SI_Base* item, getItemsFromSpatialIndex(rectPx)) {
+      if (!item->getGrabAreaScenePx().intersects(rectPx)) {
+        continue;
       }
+      items.insert(item);
+      if (item->getType() == SI_Base::Type_t::Symbol) {
+        // pins of selected symbols are selected too
+        foreach (SI_SymbolPin* pin, static_cast<SI_Symbol*>(item)->getPins()) {
+          items.insert(pin);
+        }
+      }
+    }
+    // Only items which entered or left the rect need to be updated, all other
+    // items were already deselected when the selection rect was started.
+    foreach (SI_Base* item, mItemsInSelectionRect - items) {
+      item->setSelected(false);
     }
-    foreach (SI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+    foreach (SI_Base* item, items - mItemsInSelectionRect) {
+      item->setSelected(true);
     }
+    mItemsInSelectionRect = items;
+  } else {
+    mItemsInSelectionRect.clear();
   }
 }
 
@@ -430,6 +497,30 @@ QVector<const AttributeProvider*> Schematic::getAttributeProviderParents() const
  *  Private Methods
  ******************************************************************************/
 
+QList<SI_Base*> Schematic::getItemsFromSpatialIndex(const QPointF& posPx) const
+    noexcept {
+  return getItemsOfGraphicsItems(mGraphicsScene->items(
+      posPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<SI_Base*> Schematic::getItemsFromSpatialIndex(const QRectF& rectPx) const
+    noexcept {
+  return getItemsOfGraphicsItems(mGraphicsScene->items(
+      rectPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<SI_Base*> Schematic::getItemsOfGraphicsItems(
+    const QList<QGraphicsItem*>& graphicsItems) noexcept {
+  QList<SI_Base*> items;
+  items.reserve(graphicsItems.count());
+  foreach (const QGraphicsItem* graphicsItem, graphicsItems) {
+    if (SI_Base* item = SI_Base::fromGraphicsItem(*graphicsItem)) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
 void Schematic::updateIcon() noexcept {
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
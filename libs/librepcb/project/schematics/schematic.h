@@ -129,6 +129,25 @@ public:
   QList<SI_NetLabel*>  getNetLabelsAtScenePos(const Point& pos) const noexcept;
   QList<SI_SymbolPin*> getPinsAtScenePos(const Point& pos) const noexcept;
 
+  /**
+   * @brief Get all items close to a position, the nearest item first
+   *
+   * This is cheap even on dense pages since it uses the spatial index of the
+   * graphics scene, so it can be used for tolerance-aware snapping.
+   *
+   * @param pos           The position to search around
+   * @param maxDistance   Maximum (euclidean) distance between the position
+   *                      and the grab area of the items
+   *
+   * @return All items found, sorted by their (euclidean) distance. Items whose
+   *         grab area contains the position have the distance zero. For other
+   *         netlines, the distance to the line is used, for all other items
+   *         the distance to their position (which might be greater than
+   *         maxDistance if the grab area is large).
+   */
+  QList<SI_Base*> getItemsNearScenePos(
+      const Point& pos, const UnsignedLength& maxDistance) const noexcept;
+
   // Setters: General
   void setGridProperties(const GridProperties& grid) noexcept;
 
@@ -144,9 +163,10 @@ public:
   void              removeSymbol(SI_Symbol& symbol);
 
   // NetSegment Methods
-  SI_NetSegment* getNetSegmentByUuid(const Uuid& uuid) const noexcept;
-  void           addNetSegment(SI_NetSegment& netsegment);
-  void           removeNetSegment(SI_NetSegment& netsegment);
+  QList<SI_NetSegment*> getNetSegments() const noexcept { return mNetSegments; }
+  SI_NetSegment*        getNetSegmentByUuid(const Uuid& uuid) const noexcept;
+  void                  addNetSegment(SI_NetSegment& netsegment);
+  void                  removeNetSegment(SI_NetSegment& netsegment);
 
   // General Methods
   void addToProject();
@@ -190,6 +210,24 @@ private:
             bool create, const QString& newName);
   void updateIcon() noexcept;
 
+  /**
+   * @brief Get all items whose graphics item bounding rect intersects a point
+   *        or rect, using the spatial index of the graphics scene
+   *
+   * The index (a BSP tree) is updated incrementally by Qt whenever items are
+   * added, removed, moved or change their geometry. The items are returned
+   * topmost first.
+   *
+   * @note This relies on the grab area of each item being located within the
+   *       bounding rect of its graphics item, as required by QGraphicsItem.
+   */
+  QList<SI_Base*> getItemsFromSpatialIndex(const QPointF& posPx) const
+      noexcept;
+  QList<SI_Base*> getItemsFromSpatialIndex(const QRectF& rectPx) const
+      noexcept;
+  static QList<SI_Base*> getItemsOfGraphicsItems(
+      const QList<QGraphicsItem*>& graphicsItems) noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
@@ -201,6 +239,7 @@ private:
   QScopedPointer<GraphicsScene>  mGraphicsScene;
   QScopedPointer<GridProperties> mGridProperties;
   QRectF                         mViewRect;
+  QSet<SI_Base*>                 mItemsInSelectionRect;
 
   // Attributes
   Uuid        mUuid;
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardeditor.h"
 
+#include "../cmd/cmdapplyboardautorouterresult.h"
 #include "../dialogs/projectpropertieseditordialog.h"
 #include "../docks/ercmsgdock.h"
 #include "../projecteditor.h"
@@ -33,6 +34,7 @@
 #include "unplacedcomponentsdock.h"
 
 #include <librepcb/common/application.h>
+#include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/dialogs/aboutdialog.h>
 #include <librepcb/common/dialogs/boarddesignrulesdialog.h>
 #include <librepcb/common/dialogs/filedialog.h>
@@ -43,6 +45,9 @@
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardautorouter.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/boards/boardlayerstack.h>
 #include <librepcb/project/boards/cmd/cmdboardadd.h>
 #include <librepcb/project/boards/cmd/cmdboarddesignrulesmodify.h>
 #include <librepcb/project/boards/cmd/cmdboardremove.h>
@@ -54,6 +59,7 @@
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -76,6 +82,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
     mGraphicsView(nullptr),
     mActiveBoard(nullptr),
     mBoardListActionGroup(this),
+    mLiveDesignRuleCheckTimer(this),
     mErcMsgDock(nullptr),
     mUnplacedComponentsDock(nullptr),
     mBoardLayersDock(nullptr),
@@ -117,6 +124,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
                                   .getUseOpenGl());
   mGraphicsView->setBackgroundBrush(Qt::black);
   mGraphicsView->setForegroundBrush(Qt::white);
+  mGraphicsView->setTileCacheEnabled(true);  // boards can be very complex
   // setCentralWidget(mGraphicsView);
   mUi->centralwidget->layout()->addWidget(mGraphicsView);
 
@@ -127,6 +135,22 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   connect(&mBoardListActionGroup, &QActionGroup::triggered, this,
           &BoardEditor::boardListActionGroupTriggered);
 
+  // highlighting net signals does not update all affected graphics items, so
+  // the cached tiles of the graphics view need to be discarded
+  connect(&mProject.getCircuit(), &Circuit::highlightedNetSignalChanged,
+          mGraphicsView, &GraphicsView::invalidateTileCache);
+
+  // the live DRC rechecks the modified objects shortly after each modification
+  mLiveDesignRuleCheckTimer.setSingleShot(true);
+  mLiveDesignRuleCheckTimer.setInterval(300);
+  connect(&mLiveDesignRuleCheckTimer, &QTimer::timeout, this,
+          &BoardEditor::runLiveDesignRuleCheck);
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
+          &mLiveDesignRuleCheckTimer,
+          static_cast<void (QTimer::*)()>(&QTimer::start));
+  connect(mUi->actionLiveDesignRuleCheck, &QAction::toggled, this,
+          &BoardEditor::liveDesignRuleCheckToggled);
+
   // connect some actions which are created with the Qt Designer
   connect(mUi->actionProjectSave, &QAction::triggered, &mProjectEditor,
           &ProjectEditor::saveProject);
@@ -283,6 +307,9 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       // reasons)
       disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
                  mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+      disconnect(&mActiveBoard->getLayerStack(),
+                 &BoardLayerStack::layerAttributesModified, mGraphicsView,
+                 &GraphicsView::invalidateTileCache);
       // save current view scene rect
       mActiveBoard->saveViewSceneRect(mGraphicsView->getVisibleSceneRect());
     }
@@ -296,6 +323,12 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       mActiveBoard->triggerAirWiresRebuild();
       connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
               mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+      // layer colors and visibility are not observed by all graphics items,
+      // so discard the cached tiles of the graphics view on every change
+      connect(&mActiveBoard->getLayerStack(),
+              &BoardLayerStack::layerAttributesModified, mGraphicsView,
+              &GraphicsView::invalidateTileCache);
+      mGraphicsView->invalidateTileCache();
     } else {
       mGraphicsView->setScene(nullptr);
     }
@@ -303,6 +336,9 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
     // update dock widgets
     mUnplacedComponentsDock->setBoard(mActiveBoard);
     mBoardLayersDock->setActiveBoard(mActiveBoard);
+
+    // check the new board if the live DRC is enabled
+    mLiveDesignRuleCheckTimer.start();
   }
 
   // update GUI
@@ -343,6 +379,9 @@ void BoardEditor::boardAdded(int newIndex) {
   Q_ASSERT(board);
   if (!board) return;
 
+  // boards in the editor are painted a lot, so it's worth to batch the items
+  board->setBatchedRenderingEnabled(true);
+
   QAction* actionBefore = mBoardListActions.value(newIndex - 1);
   QAction* newAction    = new QAction(*board->getName(), this);
   newAction->setCheckable(true);
@@ -519,6 +558,66 @@ void BoardEditor::on_actionRebuildPlanes_triggered() {
   }
 }
 
+void BoardEditor::on_actionAutoroute_triggered() {
+  Board* board = getActiveBoard();
+  if (!board) return;
+
+  try {
+    BoardAutorouter::Options options;
+    options.clearance = board->getDesignRules().getCopperClearance();
+    BoardAutorouter autorouter(*board, options);
+    autorouter.prepare();  // can throw
+
+    // Route in a worker thread to keep the GUI responsive. The application
+    // modal progress dialog ensures that the board is not modified meanwhile.
+    QProgressDialog dialog(tr("Routing air wires..."), tr("Cancel"), 0, 0,
+                           this);
+    dialog.setWindowTitle(tr("Autoroute"));
+    dialog.setWindowModality(Qt::ApplicationModal);
+    dialog.show();
+    QEventLoop           loop;
+    QFutureWatcher<void> watcher;
+    connect(&watcher, &QFutureWatcher<void>::finished, &loop,
+            &QEventLoop::quit);
+    connect(&dialog, &QProgressDialog::canceled,
+            [&autorouter]() { autorouter.abort(); });
+    watcher.setFuture(
+        QtConcurrent::run([&autorouter]() { autorouter.route(); }));
+    loop.exec();
+    if (dialog.wasCanceled()) return;
+    dialog.close();
+
+    if (!autorouter.getRoutes().isEmpty()) {
+      mProjectEditor.getUndoStack().execCmd(new CmdApplyBoardAutorouterResult(
+          *board, autorouter.getRoutes(), options));  // can throw
+      board->rebuildAllPlanes();
+      board->forceAirWiresRebuild();
+    }
+    if (!autorouter.getUnroutedAirWires().isEmpty()) {
+      QMessageBox::information(
+          this, tr("Autoroute"),
+          tr("%1 of %2 air wires could not be routed.")
+              .arg(autorouter.getUnroutedAirWires().count())
+              .arg(autorouter.getAirWireCount()));
+    }
+  } catch (const Exception& e) {
+    QMessageBox::warning(this, tr("Error"), e.getMsg());
+  }
+}
+
+void BoardEditor::on_actionRunDesignRuleCheck_triggered() {
+  Board* board = getActiveBoard();
+  if (!board) return;
+
+  try {
+    board->getDesignRuleCheck().execute();  // can throw
+    mErcMsgDock->show();
+    mErcMsgDock->raise();
+  } catch (const Exception& e) {
+    QMessageBox::warning(this, tr("Error"), e.getMsg());
+  }
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index) {
   setActiveBoardIndex(index);
 }
@@ -577,6 +676,29 @@ void BoardEditor::unplacedComponentsCountChanged(int count) noexcept {
   mUi->lblUnplacedComponentsNote->setVisible(count > 0);
 }
 
+void BoardEditor::runLiveDesignRuleCheck() noexcept {
+  if ((!mActiveBoard) || (!mUi->actionLiveDesignRuleCheck->isChecked())) {
+    return;
+  }
+  try {
+    mActiveBoard->getDesignRuleCheck().update();  // can throw
+  } catch (const Exception& e) {
+    qCritical() << "Live design rule check failed:" << e.getMsg();
+  }
+}
+
+void BoardEditor::liveDesignRuleCheckToggled(bool enabled) noexcept {
+  if (enabled) {
+    mLiveDesignRuleCheckTimer.start();
+  } else {
+    // remove the messages since they would not be updated anymore
+    mLiveDesignRuleCheckTimer.stop();
+    foreach (Board* board, mProject.getBoards()) {
+      board->getDesignRuleCheck().clear();
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
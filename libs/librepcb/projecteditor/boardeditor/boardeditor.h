@@ -107,6 +107,8 @@ private slots:
   void on_actionLayerStackSetup_triggered();
   void on_actionModifyDesignRules_triggered();
   void on_actionRebuildPlanes_triggered();
+  void on_actionAutoroute_triggered();
+  void on_actionRunDesignRuleCheck_triggered();
   void on_tabBar_currentChanged(int index);
   void on_lblUnplacedComponentsNote_linkActivated();
   void boardListActionGroupTriggered(QAction* action);
@@ -121,6 +123,8 @@ private:
   bool graphicsViewEventHandler(QEvent* event);
   void toolActionGroupChangeTriggered(const QVariant& newTool) noexcept;
   void unplacedComponentsCountChanged(int count) noexcept;
+  void runLiveDesignRuleCheck() noexcept;
+  void liveDesignRuleCheckToggled(bool enabled) noexcept;
 
   // General Attributes
   ProjectEditor&                       mProjectEditor;
@@ -134,6 +138,7 @@ private:
   QPointer<Board> mActiveBoard;
   QList<QAction*> mBoardListActions;
   QActionGroup    mBoardListActionGroup;
+  QTimer          mLiveDesignRuleCheckTimer;  ///< debounces modifications
 
   // Docks
   ErcMsgDock*             mErcMsgDock;
@@ -114,8 +114,10 @@ bool BES_AddHole::exit(BEE_Base* event) noexcept {
 
   if (mUndoCmdActive) {
     try {
+      mEditCmd.reset();  // references the item which gets deleted
       mUndoStack.abortCmdGroup();
       mUndoCmdActive = false;
+      mHole          = nullptr;
     } catch (Exception& e) {
       QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
       return false;
@@ -184,8 +184,10 @@ bool BES_AddStrokeText::exit(BEE_Base* event) noexcept {
 
   if (mUndoCmdActive) {
     try {
+      mEditCmd.reset();  // references the item which gets deleted
       mUndoStack.abortCmdGroup();
       mUndoCmdActive = false;
+      mText          = nullptr;
     } catch (Exception& e) {
       QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
       return false;
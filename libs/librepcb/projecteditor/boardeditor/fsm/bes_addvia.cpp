@@ -209,8 +209,10 @@ bool BES_AddVia::exit(BEE_Base* event) noexcept {
 
   if (mUndoCmdActive) {
     try {
+      mViaEditCmd.reset();  // references the item which gets deleted
       mUndoStack.abortCmdGroup();
       mUndoCmdActive = false;
+      mCurrentVia    = nullptr;
     } catch (Exception& e) {
       QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
       return false;
@@ -26,10 +26,13 @@
 #include "../boardeditor.h"
 #include "ui_boardeditor.h"
 
+#include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/undostack.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardtracerouter.h>
 #include <librepcb/project/boards/cmd/cmdboardnetsegmentadd.h>
 #include <librepcb/project/boards/cmd/cmdboardnetsegmentaddelements.h>
 #include <librepcb/project/boards/cmd/cmdboardnetsegmentremoveelements.h>
@@ -65,7 +68,11 @@ BES_DrawTrace::BES_DrawTrace(BoardEditor& editor, Ui::BoardEditor& editorUi,
     mPositioningNetPoint1(nullptr),
     mPositioningNetLine2(nullptr),
     mPositioningNetPoint2(nullptr),
+    mAvoidObstacles(true),
+    mRouteBlocked(false),
+    mCursorPos(),
     // command toolbar actions / widgets:
+    mAvoidObstaclesAction(nullptr),
     mLayerLabel(nullptr),
     mLayerComboBox(nullptr),
     mWidthLabel(nullptr),
@@ -119,6 +126,23 @@ bool BES_DrawTrace::entry(BEE_Base* event) noexcept {
   mActionSeparators.append(mEditorUi.commandToolbar->addSeparator());
   updateWireModeActionsCheckedState();
 
+  // add the "Avoid Obstacles" action to the toolbar
+  mAvoidObstaclesAction =
+      mEditorUi.commandToolbar->addAction(tr("Avoid Obstacles"));
+  mAvoidObstaclesAction->setToolTip(
+      tr("Walk around and hug objects of other nets, keeping the copper "
+         "clearance of the board design rules."));
+  mAvoidObstaclesAction->setCheckable(true);
+  mAvoidObstaclesAction->setChecked(mAvoidObstacles);
+  connect(mAvoidObstaclesAction, &QAction::toggled, [this](bool checked) {
+    mAvoidObstacles = checked;
+    updateRouter();
+    if (mSubState == SubState_PositioningNetPoint) {
+      updateNetpointPositions(mCursorPos);  // apply the new mode immediately
+    }
+  });
+  mActionSeparators.append(mEditorUi.commandToolbar->addSeparator());
+
   // connect the wire mode actions with the slot
   // updateWireModeActionsCheckedState()
   foreach (WireMode mode, mWireModeActions.keys()) {
@@ -198,6 +222,8 @@ bool BES_DrawTrace::exit(BEE_Base* event) noexcept {
   mLayerComboBox = nullptr;
   delete mLayerLabel;
   mLayerLabel = nullptr;
+  delete mAvoidObstaclesAction;
+  mAvoidObstaclesAction = nullptr;
   qDeleteAll(mWireModeActions);
   mWireModeActions.clear();
   qDeleteAll(mActionSeparators);
@@ -447,6 +473,9 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
     mPositioningNetPoint2 = p3;
     mPositioningNetLine2  = l2;
 
+    // collect the obstacles for the new trace segment
+    updateRouter();
+
     // properly place the new netpoints/netlines according the current wire mode
     updateNetpointPositions(posOnGrid);
 
@@ -463,9 +492,17 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
   }
 }
 
-bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept {
+bool BES_DrawTrace::addNextNetPoint(Board&       board,
+                                    const Point& cursorPos) noexcept {
   Q_ASSERT(mSubState == SubState_PositioningNetPoint);
 
+  // If the router pulled back the end point in front of an obstacle, the trace
+  // does not reach the cursor, thus don't connect it to anything there.
+  Point pos = mRouteBlocked ? mPositioningNetPoint2->getPosition() : cursorPos;
+  if (mRouteBlocked && (pos == mFixedStartAnchor->getPosition())) {
+    return false;  // no space to add a trace, just ignore the click
+  }
+
   // abort if p2 == p0 (no line drawn)
   if (pos == mFixedStartAnchor->getPosition()) {
     abortPositioning(true);
@@ -474,6 +511,11 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept {
     bool finishCommand = false;
 
     try {
+      // emit UndoStack::stateModified() (which rebuilds air wires) only once
+      // for all the commands appended below
+      mUndoStack.beginBulkMutation();
+      auto bulkGuard = scopeGuard([this]() { mUndoStack.endBulkMutation(); });
+
       // find anchor under cursor
       NetSignal* netsignal = &mPositioningNetPoint2->getNetSignalOfNetSegment();
       GraphicsLayer* layer = mPositioningNetPoint2->getLayerOfLines();
@@ -599,6 +641,8 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept {
     mPositioningNetLine2  = nullptr;
     mPositioningNetPoint1 = nullptr;
     mPositioningNetPoint2 = nullptr;
+    mRouter.reset();
+    mRouteBlocked = false;
     mUndoStack.abortCmdGroup();  // can throw
     return true;
   } catch (const Exception& e) {
@@ -651,15 +695,44 @@ BI_NetLine* BES_DrawTrace::findNetLine(Board& board, const Point& pos,
 }
 
 void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept {
-  mPositioningNetPoint1->setPosition(calcMiddlePointPos(
-      mFixedStartAnchor->getPosition(), cursorPos, mCurrentWireMode));
-  mPositioningNetPoint2->setPosition(cursorPos);
+  Point start  = mFixedStartAnchor->getPosition();
+  Point middle = calcMiddlePointPos(start, cursorPos, mCurrentWireMode);
+  Point end    = cursorPos;
+  mCursorPos    = cursorPos;
+  mRouteBlocked = false;
+  if (mRouter) {
+    // prefer the current wire mode, but walk around obstacles with the others
+    QVector<Point> middlePoints = {middle};
+    for (int i = 0; i < WireMode_COUNT; ++i) {
+      Point p = calcMiddlePointPos(start, cursorPos, static_cast<WireMode>(i));
+      if (!middlePoints.contains(p)) middlePoints.append(p);
+    }
+    BoardTraceRouter::Result result =
+        mRouter->route(start, middlePoints, cursorPos, mCurrentWidth);
+    middle        = result.middlePoint;
+    end           = result.endPoint;
+    mRouteBlocked = result.blocked;
+  }
+  mPositioningNetPoint1->setPosition(middle);
+  mPositioningNetPoint2->setPosition(end);
 
   // Force updating airwires immediately as they are important for creating
   // traces.
   mPositioningNetPoint2->getBoard().triggerAirWiresRebuild();
 }
 
+void BES_DrawTrace::updateRouter() noexcept {
+  mRouter.reset();
+  mRouteBlocked = false;
+  if (mAvoidObstacles && mPositioningNetLine2) {
+    const Board& board = mPositioningNetLine2->getBoard();
+    mRouter.reset(new BoardTraceRouter(
+        board, mPositioningNetLine2->getLayer().getName(),
+        mPositioningNetLine2->getNetSegment().getNetSignal(),
+        board.getDesignRules().getCopperClearance()));
+  }
+}
+
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept {
   mCurrentLayerName = mLayerComboBox->itemData(index).toString();
   // TODO: add a via to change the layer of the current netline?
@@ -43,6 +43,7 @@ class BI_FootprintPad;
 class BI_NetPoint;
 class BI_NetLine;
 class BI_NetLineAnchor;
+class BoardTraceRouter;
 
 namespace editor {
 
@@ -100,7 +101,8 @@ private:
   ProcRetVal       processPositioningSceneEvent(BEE_Base* event) noexcept;
   bool             startPositioning(Board& board, const Point& pos,
                                     BI_NetPoint* fixedPoint = nullptr) noexcept;
-  bool             addNextNetPoint(Board& board, const Point& pos) noexcept;
+  bool             addNextNetPoint(Board&       board,
+                                   const Point& cursorPos) noexcept;
   bool             abortPositioning(bool showErrMsgBox) noexcept;
   BI_Via*          findVia(Board& board, const Point& pos,
                            NetSignal* netsignal = nullptr) const noexcept;
@@ -117,6 +119,7 @@ private:
                           NetSignal*               netsignal = nullptr,
                           const QSet<BI_NetLine*>& except = {}) const noexcept;
   void        updateNetpointPositions(const Point& cursorPos) noexcept;
+  void        updateRouter() noexcept;
   void        layerComboBoxIndexChanged(int index) noexcept;
   void        wireWidthComboBoxTextChanged(const QString& width) noexcept;
   void        updateWireModeActionsCheckedState() noexcept;
@@ -134,9 +137,14 @@ private:
   BI_NetPoint* mPositioningNetPoint1;   ///< the first netpoint to place
   BI_NetLine*  mPositioningNetLine2;    ///< line between p1 and p2
   BI_NetPoint* mPositioningNetPoint2;   ///< the second netpoint to place
+  bool         mAvoidObstacles;         ///< whether the router is enabled
+  bool         mRouteBlocked;           ///< end point pulled back by router
+  Point        mCursorPos;              ///< last cursor pos passed to router
+  QScopedPointer<BoardTraceRouter> mRouter;  ///< router of the current segment
 
   // Widgets for the command toolbar
   QHash<WireMode, QAction*> mWireModeActions;
+  QAction*                  mAvoidObstaclesAction;
   QList<QAction*>           mActionSeparators;
   QLabel*                   mLayerLabel;
   QComboBox*                mLayerComboBox;
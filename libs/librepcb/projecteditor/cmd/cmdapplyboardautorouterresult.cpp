@@ -0,0 +1,213 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "cmdapplyboardautorouterresult.h"
+
+#include "cmdcombineboardnetsegments.h"
+
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentadd.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentaddelements.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/netsignal.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CmdApplyBoardAutorouterResult::CmdApplyBoardAutorouterResult(
+    Board& board, const QList<BoardAutorouter::Route>& routes,
+    const BoardAutorouter::Options& options) noexcept
+  : UndoCommandGroup(tr("Autoroute Board")),
+    mBoard(board),
+    mRoutes(routes),
+    mOptions(options) {
+}
+
+CmdApplyBoardAutorouterResult::~CmdApplyBoardAutorouterResult() noexcept {
+}
+
+/*******************************************************************************
+ *  Inherited from UndoCommand
+ ******************************************************************************/
+
+bool CmdApplyBoardAutorouterResult::performExecute() {
+  // if an error occurs, undo all already executed child commands
+  auto undoScopeGuard = scopeGuard([&]() { performUndo(); });
+
+  foreach (const BoardAutorouter::Route& route, mRoutes) {
+    applyRoute(route);  // can throw
+  }
+
+  undoScopeGuard.dismiss();  // no undo required
+  return (getChildCount() > 0);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdApplyBoardAutorouterResult::applyRoute(
+    const BoardAutorouter::Route& route) {
+  if ((!route.netSignal) || (route.vertices.count() < 2)) {
+    throw LogicError(__FILE__, __LINE__);
+  }
+
+  // vertices at the same position are joined by a via
+  QVector<Point>       positions;
+  QVector<QStringList> layers;
+  foreach (const BoardAutorouter::RouteVertex& vertex, route.vertices) {
+    if (positions.isEmpty() || (positions.last() != vertex.position)) {
+      positions.append(vertex.position);
+      layers.append(QStringList());
+    }
+    layers.last().append(vertex.layerName);
+  }
+  if (positions.count() < 2) {
+    return;  // nothing to connect (e.g. overlapping pads)
+  }
+
+  // add the route to the netsegment it starts or ends at
+  BI_NetLineAnchor* startAnchor =
+      findAnchor(*route.netSignal, positions.first(), layers.first().first());
+  BI_NetLineAnchor* endAnchor =
+      findAnchor(*route.netSignal, positions.last(), layers.last().last());
+  BI_NetSegment* startSegment = getNetSegment(startAnchor);
+  BI_NetSegment* endSegment   = getNetSegment(endAnchor);
+  BI_NetSegment* segment      = startSegment ? startSegment : endSegment;
+  if (!segment) {
+    CmdBoardNetSegmentAdd* cmd =
+        new CmdBoardNetSegmentAdd(mBoard, *route.netSignal);
+    execNewChildCmd(cmd);  // can throw
+    segment = cmd->getNetSegment();
+    Q_ASSERT(segment);
+  }
+
+  QScopedPointer<CmdBoardNetSegmentAddElements> cmdAdd(
+      new CmdBoardNetSegmentAddElements(*segment));
+  QVector<BI_NetLineAnchor*> anchors;
+  for (int i = 0; i < positions.count(); ++i) {
+    BI_NetLineAnchor* anchor = nullptr;
+    if (i == 0) {
+      anchor = startAnchor;
+    } else if (i == positions.count() - 1) {
+      anchor = endAnchor;
+    }
+    if (anchor && ((getNetSegment(anchor) == segment) ||
+                   (getNetSegment(anchor) == nullptr))) {
+      anchors.append(anchor);  // pad or element of the same netsegment
+    } else if ((i > 0) && (i < positions.count() - 1) &&
+               (layers.at(i).count() > 1)) {
+      anchors.append(cmdAdd->addVia(positions.at(i), BI_Via::Shape::Round,
+                                    mOptions.viaSize,
+                                    mOptions.viaDrillDiameter));
+    } else {
+      anchors.append(cmdAdd->addNetPoint(positions.at(i)));
+    }
+    Q_ASSERT(anchors.last());
+  }
+  for (int i = 1; i < positions.count(); ++i) {
+    GraphicsLayer* layer =
+        mBoard.getLayerStack().getLayer(layers.at(i).first());
+    if (!layer) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          tr("Invalid layer: \"%1\"").arg(layers.at(i).first()));
+    }
+    cmdAdd->addNetLine(*anchors.at(i - 1), *anchors.at(i), *layer,
+                       mOptions.traceWidth);
+  }
+  execNewChildCmd(cmdAdd.take());  // can throw
+
+  // connect the route to the netsegment at the other end
+  if (startSegment && endSegment && (startSegment != endSegment)) {
+    execNewChildCmd(new CmdCombineBoardNetSegments(
+        *startSegment, *anchors.last(), *endSegment, *endAnchor));  // can throw
+  }
+}
+
+BI_NetLineAnchor* CmdApplyBoardAutorouterResult::findAnchor(
+    const NetSignal& netsignal, const Point& pos,
+    const QString& layerName) const noexcept {
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if ((pad->getCompSigInstNetSignal() == &netsignal) &&
+          (pad->getPosition() == pos) && pad->isOnLayer(layerName)) {
+        return pad;
+      }
+    }
+  }
+  foreach (BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
+    if (&netsegment->getBoard() != &mBoard) continue;
+    foreach (BI_Via* via, netsegment->getVias()) {
+      if (via->getPosition() == pos) {
+        return via;
+      }
+    }
+    foreach (BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+      const GraphicsLayer* layer = netpoint->getLayerOfLines();
+      if ((netpoint->getPosition() == pos) &&
+          ((!layer) || (layer->getName() == layerName))) {
+        return netpoint;
+      }
+    }
+  }
+  return nullptr;
+}
+
+BI_NetSegment* CmdApplyBoardAutorouterResult::getNetSegment(
+    BI_NetLineAnchor* anchor) noexcept {
+  if (BI_Via* via = dynamic_cast<BI_Via*>(anchor)) {
+    return &via->getNetSegment();
+  } else if (BI_NetPoint* netpoint = dynamic_cast<BI_NetPoint*>(anchor)) {
+    return &netpoint->getNetSegment();
+  } else {
+    return nullptr;  // pads do not belong to a netsegment
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,96 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef LIBREPCB_PROJECT_EDITOR_CMDAPPLYBOARDAUTOROUTERRESULT_H
+#define LIBREPCB_PROJECT_EDITOR_CMDAPPLYBOARDAUTOROUTERRESULT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/project/boards/boardautorouter.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_NetLineAnchor;
+class BI_NetSegment;
+class NetSignal;
+
+namespace editor {
+
+/*******************************************************************************
+ *  Class CmdApplyBoardAutorouterResult
+ ******************************************************************************/
+
+/**
+ * @brief This undo command adds the routes found by
+ *        ::librepcb::project::BoardAutorouter to a board
+ *
+ * Each route is added to the netsegment of the via or netpoint it starts or
+ * ends at (or to a new netsegment if it connects only pads). If the route
+ * connects two different netsegments, they get combined.
+ */
+class CmdApplyBoardAutorouterResult final : public UndoCommandGroup {
+public:
+  // Constructors / Destructor
+  CmdApplyBoardAutorouterResult() = delete;
+  CmdApplyBoardAutorouterResult(const CmdApplyBoardAutorouterResult& other) =
+      delete;
+  CmdApplyBoardAutorouterResult(
+      Board& board, const QList<BoardAutorouter::Route>& routes,
+      const BoardAutorouter::Options& options) noexcept;
+  ~CmdApplyBoardAutorouterResult() noexcept;
+
+  // Operator Overloadings
+  CmdApplyBoardAutorouterResult& operator=(
+      const CmdApplyBoardAutorouterResult& rhs) = delete;
+
+private:  // Methods
+  /// @copydoc UndoCommand::performExecute()
+  bool performExecute() override;
+
+  void                  applyRoute(const BoardAutorouter::Route& route);
+  BI_NetLineAnchor*     findAnchor(const NetSignal& netsignal, const Point& pos,
+                                   const QString& layerName) const noexcept;
+  static BI_NetSegment* getNetSegment(BI_NetLineAnchor* anchor) noexcept;
+
+private:  // Data
+  Board&                        mBoard;
+  QList<BoardAutorouter::Route> mRoutes;
+  BoardAutorouter::Options      mOptions;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_EDITOR_CMDAPPLYBOARDAUTOROUTERRESULT_H
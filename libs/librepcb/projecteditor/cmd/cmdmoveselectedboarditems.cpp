@@ -26,6 +26,7 @@
 #include <librepcb/common/geometry/cmd/cmdpolygonedit.h>
 #include <librepcb/common/geometry/cmd/cmdstroketextedit.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardselectionquery.h>
 #include <librepcb/project/boards/cmd/cmdboardnetpointedit.h>
@@ -34,7 +35,9 @@
 #include <librepcb/project/boards/cmd/cmddeviceinstanceedit.h>
 #include <librepcb/project/boards/items/bi_device.h>
 #include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
 #include <librepcb/project/boards/items/bi_hole.h>
+#include <librepcb/project/boards/items/bi_netline.h>
 #include <librepcb/project/boards/items/bi_netpoint.h>
 #include <librepcb/project/boards/items/bi_polygon.h>
 #include <librepcb/project/boards/items/bi_stroketext.h>
@@ -59,7 +62,10 @@ CmdMoveSelectedBoardItems::CmdMoveSelectedBoardItems(
   : UndoCommandGroup(tr("Move Board Elements")),
     mBoard(board),
     mStartPos(startPos),
-    mDeltaPos(0, 0) {
+    mDeltaPos(0, 0),
+    mPreviewEnabled(false) {
+  addBulkMutationTarget(mBoard);
+
   // get all selected items
   std::unique_ptr<BoardSelectionQuery> query(mBoard.createSelectionQuery());
   query->addDeviceInstancesOfSelectedFootprints();
@@ -108,9 +114,49 @@ CmdMoveSelectedBoardItems::CmdMoveSelectedBoardItems(
     CmdHoleEdit* cmd = new CmdHoleEdit(hole->getHole());
     mHoleEditCmds.append(cmd);
   }
+
+  // Moving many items on every mouse move is too slow (the items, their net
+  // lines, air wires and the undo commands are updated each time), so in this
+  // case only their graphics items are moved while dragging.
+  int itemCount = mDeviceEditCmds.count() + mViaEditCmds.count() +
+      mNetPointEditCmds.count() + mPlaneEditCmds.count() +
+      mPolygonEditCmds.count() + mStrokeTextEditCmds.count() +
+      mHoleEditCmds.count();
+  mPreviewEnabled = (itemCount >= sPreviewItemCountThreshold);
+  if (mPreviewEnabled) {
+    foreach (BI_Device* device, query->getDeviceInstances()) {
+      addPreviewItem(device->getFootprint());
+      foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+        addPreviewItem(*pad);
+        addPreviewAnchor(*pad);
+      }
+      foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
+        addPreviewItem(*text);
+      }
+    }
+    foreach (BI_Via* via, query->getVias()) {
+      addPreviewItem(*via);
+      addPreviewAnchor(*via);
+    }
+    foreach (BI_NetPoint* netpoint, query->getNetPoints()) {
+      addPreviewItem(*netpoint);
+      addPreviewAnchor(*netpoint);
+    }
+    foreach (BI_Plane* plane, query->getPlanes()) { addPreviewItem(*plane); }
+    foreach (BI_Polygon* polygon, query->getPolygons()) {
+      addPreviewItem(*polygon);
+    }
+    foreach (BI_StrokeText* text, query->getStrokeTexts()) {
+      addPreviewItem(*text);
+    }
+    foreach (BI_Hole* hole, query->getHoles()) { addPreviewItem(*hole); }
+  }
 }
 
 CmdMoveSelectedBoardItems::~CmdMoveSelectedBoardItems() noexcept {
+  if (!wasEverExecuted()) {
+    setPreviewOffset(Point(0, 0));  // drag aborted --> restore graphics items
+  }
 }
 
 /*******************************************************************************
@@ -121,8 +167,13 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
   Point delta = pos - mStartPos;
   delta.mapToGrid(mBoard.getGridProperties().getInterval());
 
-  if (delta != mDeltaPos) {
-    // move selected elements
+  if ((delta != mDeltaPos) && mPreviewEnabled) {
+    // only move the graphics items, the items are moved in performExecute()
+    mDeltaPos = delta;
+    setPreviewOffset(mDeltaPos);
+  } else if (delta != mDeltaPos) {
+    // move selected elements (update net lines only once at the end)
+    mBoard.beginBulkMutation();
     foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
       cmd->translate(delta - mDeltaPos, true);
     }
@@ -145,6 +196,7 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
       cmd->translate(delta - mDeltaPos, true);
     }
     mDeltaPos = delta;
+    mBoard.endBulkMutation();
 
     // Force updating airwires immediately as they are important while moving
     // items.
@@ -157,6 +209,9 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
  ******************************************************************************/
 
 bool CmdMoveSelectedBoardItems::performExecute() {
+  // the graphics items must be at their actual positions before moving items
+  setPreviewOffset(Point(0, 0));
+
   if (mDeltaPos.isOrigin()) {
     // no movement required --> discard all move commands
     qDeleteAll(mDeviceEditCmds);
@@ -176,6 +231,34 @@ bool CmdMoveSelectedBoardItems::performExecute() {
     return false;
   }
 
+  if (mPreviewEnabled) {
+    // the movement was only previewed so far
+    foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdBoardViaEdit* cmd, mViaEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdBoardNetPointEdit* cmd, mNetPointEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdBoardPlaneEdit* cmd, mPlaneEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdPolygonEdit* cmd, mPolygonEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdStrokeTextEdit* cmd, mStrokeTextEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+    foreach (CmdHoleEdit* cmd, mHoleEditCmds) {
+      cmd->translate(mDeltaPos, false);
+    }
+  }
+
+  beginBulkMutation();
+  auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
+
   foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
     appendChild(cmd);  // can throw
   }
@@ -202,6 +285,33 @@ bool CmdMoveSelectedBoardItems::performExecute() {
   return UndoCommandGroup::performExecute();  // can throw
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdMoveSelectedBoardItems::addPreviewItem(BI_Base& item) noexcept {
+  mPreviewItems.insert(&item);
+}
+
+void CmdMoveSelectedBoardItems::addPreviewAnchor(
+    BI_NetLineAnchor& anchor) noexcept {
+  mPreviewAnchors.insert(&anchor);
+  foreach (BI_NetLine* netline, anchor.getNetLines()) {
+    mPreviewNetLines.insert(netline);
+  }
+}
+
+void CmdMoveSelectedBoardItems::setPreviewOffset(const Point& offset) noexcept {
+  foreach (BI_Base* item, mPreviewItems) { item->setPreviewOffset(offset); }
+  // net lines are stretched if only one of their anchors is moved
+  foreach (BI_NetLine* netline, mPreviewNetLines) {
+    bool startMoved = mPreviewAnchors.contains(&netline->getStartPoint());
+    bool endMoved   = mPreviewAnchors.contains(&netline->getEndPoint());
+    netline->setPreviewOffsets(startMoved ? offset : Point(0, 0),
+                               endMoved ? offset : Point(0, 0));
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -40,6 +40,9 @@ class CmdHoleEdit;
 namespace project {
 
 class Board;
+class BI_Base;
+class BI_NetLine;
+class BI_NetLineAnchor;
 class CmdDeviceInstanceEdit;
 class CmdBoardViaEdit;
 class CmdBoardNetPointEdit;
@@ -53,6 +56,11 @@ namespace editor {
 
 /**
  * @brief The CmdMoveSelectedBoardItems class
+ *
+ * If many items are moved, #setCurrentPosition() only moves the graphics items
+ * (see ::librepcb::project::BI_Base::setPreviewOffset()) to keep dragging
+ * smooth. The items are then moved only once when the command gets executed,
+ * so the air wires are not updated while dragging.
  */
 class CmdMoveSelectedBoardItems final : public UndoCommandGroup {
 public:
@@ -69,11 +77,24 @@ private:
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
 
+  void addPreviewItem(BI_Base& item) noexcept;
+  void addPreviewAnchor(BI_NetLineAnchor& anchor) noexcept;
+  void setPreviewOffset(const Point& offset) noexcept;
+
   // Private Member Variables
   Board& mBoard;
   Point  mStartPos;
   Point  mDeltaPos;
 
+  /// Minimum count of moved items to only preview the movement while dragging
+  static constexpr int sPreviewItemCountThreshold = 50;
+
+  // Preview
+  bool                    mPreviewEnabled;
+  QSet<BI_Base*>          mPreviewItems;
+  QSet<BI_NetLineAnchor*> mPreviewAnchors;  ///< Anchors moved by the preview
+  QSet<BI_NetLine*>       mPreviewNetLines;
+
   // Move commands
   QList<CmdDeviceInstanceEdit*> mDeviceEditCmds;
   QList<CmdBoardViaEdit*>       mViaEditCmds;
@@ -62,6 +62,7 @@ namespace editor {
 
 CmdRemoveBoardItems::CmdRemoveBoardItems(Board& board) noexcept
   : UndoCommandGroup(tr("Remove Board Items")), mBoard(board) {
+  addBulkMutationTarget(mBoard);
 }
 
 CmdRemoveBoardItems::~CmdRemoveBoardItems() noexcept {
@@ -72,6 +73,9 @@ CmdRemoveBoardItems::~CmdRemoveBoardItems() noexcept {
  ******************************************************************************/
 
 bool CmdRemoveBoardItems::performExecute() {
+  beginBulkMutation();
+  auto bulkGuard = scopeGuard([this]() { endBulkMutation(); });
+
   // if an error occurs, undo all already executed child commands
   auto undoScopeGuard = scopeGuard([&]() { performUndo(); });
 
@@ -87,6 +87,13 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace,
   mUi->cbxSymbVar->hide();
   connect(mUi->edtSearch, &QLineEdit::textChanged, this,
           &AddComponentDialog::searchEditTextChanged);
+  mSearchTimer.setSingleShot(true);
+  mSearchTimer.setInterval(300);
+  connect(&mSearchTimer, &QTimer::timeout, this, [this]() {
+    searchComponents(mUi->edtSearch->text().trimmed());
+  });
+  connect(&mSearchWatcher, &QFutureWatcher<SearchResult>::finished, this,
+          &AddComponentDialog::searchFinished);
   connect(mUi->treeComponents, &QTreeWidget::currentItemChanged, this,
           &AddComponentDialog::treeComponents_currentItemChanged);
   connect(mUi->treeComponents, &QTreeWidget::itemDoubleClicked, this,
@@ -117,6 +124,7 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace,
 }
 
 AddComponentDialog::~AddComponentDialog() noexcept {
+  abortSearch();
   delete mPreviewFootprintGraphicsItem;
   mPreviewFootprintGraphicsItem = nullptr;
   qDeleteAll(mPreviewSymbolGraphicsItems);
@@ -172,10 +180,12 @@ void AddComponentDialog::searchEditTextChanged(const QString& text) noexcept {
   try {
     QModelIndex catIndex = mUi->treeCategories->currentIndex();
     if (text.trimmed().isEmpty() && catIndex.isValid()) {
+      mSearchTimer.stop();
       setSelectedCategory(
           Uuid::tryFromString(catIndex.data(Qt::UserRole).toString()));
     } else {
-      searchComponents(text.trimmed());
+      // don't search on every keystroke, wait until the user stops typing
+      mSearchTimer.start();
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Error"), e.getMsg());
@@ -189,6 +199,7 @@ void AddComponentDialog::treeCategories_currentItemChanged(
   try {
     tl::optional<Uuid> categoryUuid =
         Uuid::tryFromString(current.data(Qt::UserRole).toString());
+    mSearchTimer.stop();
     setSelectedCategory(categoryUuid);
   } catch (Exception& e) {
     QMessageBox::critical(this, tr("Error"), e.getMsg());
@@ -258,107 +269,135 @@ void AddComponentDialog::on_cbxSymbVar_currentIndexChanged(int index) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void AddComponentDialog::searchComponents(const QString& input) {
+void AddComponentDialog::searchComponents(const QString& input) noexcept {
+  abortSearch();
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
-  // min. 2 chars to avoid freeze on entering first character due to huge result
+  // min. 2 chars to avoid a huge result on entering the first character
   if (input.length() > 1) {
-    SearchResult result = searchComponentsAndDevices(input);
-    QHashIterator<FilePath, SearchResultComponent> cmpIt(result);
-    while (cmpIt.hasNext()) {
-      cmpIt.next();
-      QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
-      cmpItem->setText(0, cmpIt.value().name);
-      cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
-      QHashIterator<FilePath, SearchResultDevice> devIt(cmpIt.value().devices);
-      while (devIt.hasNext()) {
-        devIt.next();
-        QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
-        devItem->setText(0, devIt.value().name);
-        devItem->setData(0, Qt::UserRole, devIt.key().toStr());
-        devItem->setText(1, devIt.value().pkgName);
-        devItem->setTextAlignment(1, Qt::AlignRight);
-      }
-      cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
-      cmpItem->setTextAlignment(1, Qt::AlignRight);
-      cmpItem->setExpanded(!cmpIt.value().match);
-    }
+    // The search runs in a worker thread and only queries the library database,
+    // the selected elements are loaded from the file system later on demand.
+    std::shared_ptr<std::atomic<bool>> abort =
+        std::make_shared<std::atomic<bool>>(false);
+    QStringList localeOrder = mProject.getSettings().getLocaleOrder();
+    mSearchAbortFlag        = abort;
+    auto query = [input, localeOrder,
+                  abort](const workspace::WorkspaceLibraryDb& db) {
+      return searchComponentsAndDevices(db, input, localeOrder,
+                                        *abort);  // can throw
+    };
+    mSearchWatcher.setFuture(
+        mWorkspace.getLibraryDb().queryAsync<SearchResult>(query));
   }
+}
 
+void AddComponentDialog::abortSearch() noexcept {
+  // A running query can't be interrupted by QFuture, so the worker polls the
+  // flag and the (possibly still emitted) result gets discarded.
+  if (mSearchAbortFlag) {
+    *mSearchAbortFlag = true;
+    mSearchAbortFlag.reset();
+  }
+}
+
+void AddComponentDialog::searchFinished() noexcept {
+  if ((!mSearchAbortFlag) || (*mSearchAbortFlag)) {
+    return;  // search was aborted in the meantime, discard result
+  }
+  mSearchAbortFlag.reset();
+
+  SearchResult result = mSearchWatcher.result();
+  QHashIterator<FilePath, SearchResultComponent> cmpIt(result);
+  while (cmpIt.hasNext()) {
+    cmpIt.next();
+    QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
+    cmpItem->setText(0, cmpIt.value().name);
+    cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
+    QHashIterator<FilePath, SearchResultDevice> devIt(cmpIt.value().devices);
+    while (devIt.hasNext()) {
+      devIt.next();
+      QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
+      devItem->setText(0, devIt.value().name);
+      devItem->setData(0, Qt::UserRole, devIt.key().toStr());
+      devItem->setText(1, devIt.value().pkgName);
+      devItem->setTextAlignment(1, Qt::AlignRight);
+    }
+    cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
+    cmpItem->setTextAlignment(1, Qt::AlignRight);
+    cmpItem->setExpanded(!cmpIt.value().match);
+  }
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 }
 
 AddComponentDialog::SearchResult AddComponentDialog::searchComponentsAndDevices(
-    const QString& input) {
-  SearchResult       result;
-  const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
+    const workspace::WorkspaceLibraryDb& db, const QString& input,
+    const QStringList& localeOrder, const std::atomic<bool>& abort) {
+  SearchResult result;
 
   // add matching devices and their corresponding components
-  QList<Uuid> devices =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Device>(
-          input);  // can throw
-  foreach (const Uuid& devUuid, devices) {
-    FilePath devFp =
-        mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
-    if (!devFp.isValid()) continue;
+  QList<workspace::WorkspaceLibraryDb::ElementInfo> devices =
+      db.getElementInfosBySearchKeyword<library::Device>(
+          input, localeOrder);  // can throw
+  foreach (const workspace::WorkspaceLibraryDb::ElementInfo& dev, devices) {
+    if (abort) return SearchResult();
     Uuid cmpUuid = Uuid::createRandom();
     Uuid pkgUuid = Uuid::createRandom();
-    mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                &cmpUuid);  // can throw
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
+    db.getDeviceMetadata(dev.filePath, &pkgUuid, &cmpUuid);  // can throw
+    FilePath cmpFp = db.getLatestComponent(cmpUuid);         // can throw
     if (!cmpFp.isValid()) continue;
-    FilePath pkgFp =
-        mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-    SearchResultDevice& resDev = result[cmpFp].devices[devFp];
-    resDev.pkgFp               = pkgFp;
+    SearchResultDevice& resDev = result[cmpFp].devices[dev.filePath];
+    resDev.name                = dev.name;
+    resDev.pkgFp               = db.getLatestPackage(pkgUuid);  // can throw
     resDev.match               = true;
   }
 
   // add matching components and all their devices
-  QList<Uuid> components =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Component>(
-          input);  // can throw
-  foreach (const Uuid& cmpUuid, components) {
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    QSet<Uuid> devices =
-        mWorkspace.getLibraryDb().getDevicesOfComponent(cmpUuid);  // can throw
-    SearchResultComponent& resCmp = result[cmpFp];
+  QList<workspace::WorkspaceLibraryDb::ElementInfo> components =
+      db.getElementInfosBySearchKeyword<library::Component>(
+          input, localeOrder);  // can throw
+  foreach (const workspace::WorkspaceLibraryDb::ElementInfo& cmp, components) {
+    if (abort) return SearchResult();
+    SearchResultComponent& resCmp = result[cmp.filePath];
+    resCmp.name                   = cmp.name;
     resCmp.match                  = true;
+    QSet<Uuid> devices = db.getDevicesOfComponent(cmp.uuid);  // can throw
     foreach (const Uuid& devUuid, devices) {
-      FilePath devFp =
-          mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
+      FilePath devFp = db.getLatestDevice(devUuid);  // can throw
       if (!devFp.isValid()) continue;
       if (resCmp.devices.contains(devFp)) continue;
       Uuid pkgUuid = Uuid::createRandom();
-      mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                  nullptr);  // can throw
-      FilePath pkgFp =
-          mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
+      db.getDeviceMetadata(devFp, &pkgUuid, nullptr);  // can throw
       SearchResultDevice& resDev = resCmp.devices[devFp];
-      resDev.pkgFp               = pkgFp;
+      resDev.pkgFp               = db.getLatestPackage(pkgUuid);  // can throw
     }
   }
 
-  // get name of elements
+  // get missing names of elements (packages are often shared by many devices)
+  QHash<FilePath, QString>                              pkgNames;
   QMutableHashIterator<FilePath, SearchResultComponent> resultIt(result);
   while (resultIt.hasNext()) {
+    if (abort) return SearchResult();
     resultIt.next();
-    mWorkspace.getLibraryDb().getElementTranslations<library::Component>(
-        resultIt.key(), localeOrder, &resultIt.value().name);
+    if (resultIt.value().name.isNull()) {
+      db.getElementTranslations<library::Component>(
+          resultIt.key(), localeOrder, &resultIt.value().name);  // can throw
+    }
     QMutableHashIterator<FilePath, SearchResultDevice> devIt(
         resultIt.value().devices);
     while (devIt.hasNext()) {
       devIt.next();
-      mWorkspace.getLibraryDb().getElementTranslations<library::Device>(
-          devIt.key(), localeOrder, &devIt.value().name);
-      if (devIt.value().pkgFp.isValid()) {
-        mWorkspace.getLibraryDb().getElementTranslations<library::Package>(
-            devIt.value().pkgFp, localeOrder, &devIt.value().pkgName);
+      SearchResultDevice& resDev = devIt.value();
+      if (resDev.name.isNull()) {
+        db.getElementTranslations<library::Device>(
+            devIt.key(), localeOrder, &resDev.name);  // can throw
+      }
+      if (resDev.pkgFp.isValid() && (!pkgNames.contains(resDev.pkgFp))) {
+        db.getElementTranslations<library::Package>(
+            resDev.pkgFp, localeOrder,
+            &pkgNames[resDev.pkgFp]);  // can throw
       }
+      resDev.pkgName = pkgNames.value(resDev.pkgFp);
     }
   }
 
@@ -367,6 +406,7 @@ AddComponentDialog::SearchResult AddComponentDialog::searchComponentsAndDevices(
 
 void AddComponentDialog::setSelectedCategory(
     const tl::optional<Uuid>& categoryUuid) {
+  abortSearch();
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
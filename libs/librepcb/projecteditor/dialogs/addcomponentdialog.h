@@ -31,6 +31,9 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <atomic>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -52,7 +55,8 @@ class ComponentCategory;
 
 namespace workspace {
 class Workspace;
-}
+class WorkspaceLibraryDb;
+}  // namespace workspace
 
 namespace project {
 
@@ -118,9 +122,13 @@ private slots:
 
 private:
   // Private Methods
-  void         searchComponents(const QString& input);
-  SearchResult searchComponentsAndDevices(const QString& input);
-  void         setSelectedCategory(const tl::optional<Uuid>& categoryUuid);
+  void searchComponents(const QString& input) noexcept;
+  void abortSearch() noexcept;
+  void searchFinished() noexcept;
+  static SearchResult searchComponentsAndDevices(
+      const workspace::WorkspaceLibraryDb& db, const QString& input,
+      const QStringList& localeOrder, const std::atomic<bool>& abort);
+  void setSelectedCategory(const tl::optional<Uuid>& categoryUuid);
   void         setSelectedComponent(const library::Component* cmp);
   void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
   void setSelectedDevice(const library::Device* dev);
@@ -135,6 +143,11 @@ private:
   QScopedPointer<DefaultGraphicsLayerProvider> mGraphicsLayerProvider;
   workspace::ComponentCategoryTreeModel*       mCategoryTreeModel;
 
+  // Search
+  QTimer                             mSearchTimer;  ///< Delays the search
+  QFutureWatcher<SearchResult>       mSearchWatcher;
+  std::shared_ptr<std::atomic<bool>> mSearchAbortFlag;  ///< Of running search
+
   // Attributes
   tl::optional<Uuid>                         mSelectedCategoryUuid;
   const library::Component*                  mSelectedComponent;
@@ -56,6 +56,8 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
     mBoardEditor(nullptr) {
   try {
     mUndoStack = new UndoStack();
+    mUndoStack->setMemoryLimit(
+        mWorkspace.getSettings().getUndoMemoryLimit().getLimitBytes());
 
     // create the whole schematic/board editor GUI inclusive FSM and so on
     mSchematicEditor = new SchematicEditor(*this, mProject);
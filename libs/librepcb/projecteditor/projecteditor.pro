@@ -42,6 +42,7 @@ SOURCES += \
     cmd/cmdaddcomponenttocircuit.cpp \
     cmd/cmdadddevicetoboard.cpp \
     cmd/cmdaddsymboltoschematic.cpp \
+    cmd/cmdapplyboardautorouterresult.cpp \
     cmd/cmdchangenetsignalofschematicnetsegment.cpp \
     cmd/cmdcombineboardnetsegments.cpp \
     cmd/cmdcombinenetsignals.cpp \
@@ -103,6 +104,7 @@ HEADERS += \
     cmd/cmdaddcomponenttocircuit.h \
     cmd/cmdadddevicetoboard.h \
     cmd/cmdaddsymboltoschematic.h \
+    cmd/cmdapplyboardautorouterresult.h \
     cmd/cmdchangenetsignalofschematicnetsegment.h \
     cmd/cmdcombineboardnetsegments.h \
     cmd/cmdcombinenetsignals.h \
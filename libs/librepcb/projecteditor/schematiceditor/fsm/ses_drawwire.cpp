@@ -654,21 +654,28 @@ bool SES_DrawWire::abortPositioning(bool showErrMsgBox) noexcept {
 
 SI_SymbolPin* SES_DrawWire::findSymbolPin(Schematic&   schematic,
                                           const Point& pos) const noexcept {
-  QList<SI_SymbolPin*> items = schematic.getPinsAtScenePos(pos);
-  for (int i = items.count() - 1; i >= 0; --i) {
-    // only choose pins which are connected to a component signal!
-    if (!items.at(i)->getComponentSignalInstance()) {
-      items.removeAt(i);
+  foreach (SI_Base* item,
+           schematic.getItemsNearScenePos(pos, getSnapTolerance())) {
+    if (item->getType() == SI_Base::Type_t::SymbolPin) {
+      SI_SymbolPin* pin = static_cast<SI_SymbolPin*>(item);
+      // only choose pins which are connected to a component signal!
+      if (pin->getComponentSignalInstance()) {
+        return pin;
+      }
     }
   }
-  return (items.count() > 0) ? items.first() : nullptr;
+  return nullptr;
 }
 
 SI_NetPoint* SES_DrawWire::findNetPoint(Schematic& schematic, const Point& pos,
                                         SI_NetPoint* except) const noexcept {
-  QList<SI_NetPoint*> items = schematic.getNetPointsAtScenePos(pos);
-  items.removeAll(except);
-  return (items.count() > 0) ? items.first() : nullptr;
+  foreach (SI_Base* item,
+           schematic.getItemsNearScenePos(pos, getSnapTolerance())) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) && (item != except)) {
+      return static_cast<SI_NetPoint*>(item);
+    }
+  }
+  return nullptr;
 }
 
 SI_NetLine* SES_DrawWire::findNetLine(Schematic& schematic, const Point& pos,
@@ -723,6 +730,12 @@ Point SES_DrawWire::calcMiddlePointPos(const Point& p1, const Point p2,
   }
 }
 
+UnsignedLength SES_DrawWire::getSnapTolerance() const noexcept {
+  // snap to anchors which are not on the grid (e.g. pins of symbols which
+  // use another grid), but never to anchors of the neighbouring grid points
+  return UnsignedLength(*mEditor.getGridProperties().getInterval() / 2);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -106,6 +106,7 @@ private:
   void         updateWireModeActionsCheckedState() noexcept;
   Point calcMiddlePointPos(const Point& p1, const Point p2, WireMode mode) const
       noexcept;
+  UnsignedLength getSnapTolerance() const noexcept;
 
   // General Attributes
   SubState mSubState;  ///< the current substate
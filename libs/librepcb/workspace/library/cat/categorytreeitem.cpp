@@ -40,26 +40,25 @@ template <typename ElementType>
 CategoryTreeItem<ElementType>::CategoryTreeItem(
     const WorkspaceLibraryDb& library, const QStringList localeOrder,
     CategoryTreeItem* parent, const tl::optional<Uuid>& uuid,
+    const QString& name, const QString& description,
     CategoryTreeFilter::Flags filter) noexcept
   : mParent(parent),
     mUuid(uuid),
+    mName(name),
+    mDescription(description),
     mDepth(parent ? parent->getDepth() + 1 : 0),
     mExceptionMessage(),
     mIsVisible(false) {
   try {
-    if (mUuid) {
-      FilePath fp = getLatestCategory(library);
-      if (fp.isValid()) {
-        library.getElementTranslations<ElementType>(fp, localeOrder, &mName,
-                                                    &mDescription);
-      }
-    }
-
     if (mUuid || (!mParent)) {
-      QSet<Uuid> childs = getCategoryChilds(library);
-      foreach (const Uuid& childUuid, childs) {
+      // get the metadata of all childs at once
+      QList<WorkspaceLibraryDb::ElementInfo> childs =
+          library.getElementInfosByCategory<ElementType>(
+              mUuid, localeOrder);  // can throw
+      foreach (const WorkspaceLibraryDb::ElementInfo& info, childs) {
         ChildType child(new CategoryTreeItem(library, localeOrder, this,
-                                             childUuid, filter));
+                                             info.uuid, info.name,
+                                             info.description, filter));
         if (child->isVisible()) {
           mChilds.append(child);
         }
@@ -75,7 +74,8 @@ CategoryTreeItem<ElementType>::CategoryTreeItem(
     if (!mParent) {
       // add category for elements without category
       ChildType child(new CategoryTreeItem(library, localeOrder, this,
-                                           tl::nullopt, filter));
+                                           tl::nullopt, QString(), QString(),
+                                           filter));
       if (child->isVisible()) {
         mChilds.append(child);
       }
@@ -151,30 +151,6 @@ QVariant CategoryTreeItem<ElementType>::data(int role) const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-template <>
-FilePath CategoryTreeItem<library::ComponentCategory>::getLatestCategory(
-    const WorkspaceLibraryDb& lib) const {
-  return lib.getLatestComponentCategory(*mUuid);
-}
-
-template <>
-FilePath CategoryTreeItem<library::PackageCategory>::getLatestCategory(
-    const WorkspaceLibraryDb& lib) const {
-  return lib.getLatestPackageCategory(*mUuid);
-}
-
-template <>
-QSet<Uuid> CategoryTreeItem<library::ComponentCategory>::getCategoryChilds(
-    const WorkspaceLibraryDb& lib) const {
-  return lib.getComponentCategoryChilds(mUuid);
-}
-
-template <>
-QSet<Uuid> CategoryTreeItem<library::PackageCategory>::getCategoryChilds(
-    const WorkspaceLibraryDb& lib) const {
-  return lib.getPackageCategoryChilds(mUuid);
-}
-
 template <>
 bool CategoryTreeItem<library::ComponentCategory>::matchesFilter(
     const WorkspaceLibraryDb& lib, CategoryTreeFilter::Flags filter) const {
@@ -71,7 +71,8 @@ public:
   CategoryTreeItem(const CategoryTreeItem& other) = delete;
   CategoryTreeItem(const WorkspaceLibraryDb& library,
                    const QStringList localeOrder, CategoryTreeItem* parent,
-                   const tl::optional<Uuid>& uuid,
+                   const tl::optional<Uuid>& uuid, const QString& name,
+                   const QString&            description,
                    CategoryTreeFilter::Flags filter) noexcept;
   ~CategoryTreeItem() noexcept;
 
@@ -96,10 +97,8 @@ private:
   using ChildType = QSharedPointer<CategoryTreeItem<ElementType>>;
 
   // Methods
-  FilePath   getLatestCategory(const WorkspaceLibraryDb& lib) const;
-  QSet<Uuid> getCategoryChilds(const WorkspaceLibraryDb& lib) const;
-  bool       matchesFilter(const WorkspaceLibraryDb& lib,
-                           CategoryTreeFilter::Flags filter) const;
+  bool matchesFilter(const WorkspaceLibraryDb& lib,
+                     CategoryTreeFilter::Flags filter) const;
 
   // Attributes
   CategoryTreeItem*  mParent;
@@ -43,8 +43,19 @@ CategoryTreeModel<ElementType>::CategoryTreeModel(
     const WorkspaceLibraryDb& library, const QStringList& localeOrder,
     CategoryTreeFilter::Flags filter) noexcept
   : QAbstractItemModel(nullptr) {
-  mRootItem.reset(new CategoryTreeItem<ElementType>(
-      library, localeOrder, nullptr, tl::nullopt, filter));
+  // load the categories in another thread to not block the UI
+  connect(&mRootItemWatcher, &QFutureWatcher<RootItemType>::finished, this,
+          [this]() {
+            beginResetModel();
+            mRootItem = mRootItemWatcher.result();
+            endResetModel();
+          });
+  mRootItemWatcher.setFuture(library.queryAsync<RootItemType>(
+      [localeOrder, filter](const WorkspaceLibraryDb& db) {
+        return std::make_shared<CategoryTreeItem<ElementType>>(
+            db, localeOrder, nullptr, tl::nullopt, QString(), QString(),
+            filter);
+      }));
 }
 
 template <typename ElementType>
@@ -63,7 +74,7 @@ CategoryTreeItem<ElementType>* CategoryTreeModel<ElementType>::getItem(
         static_cast<CategoryTreeItem<ElementType>*>(index.internalPointer());
     if (item) return item;
   }
-  return mRootItem.data();
+  return mRootItem.get();
 }
 
 /*******************************************************************************
@@ -74,13 +85,13 @@ template <typename ElementType>
 int CategoryTreeModel<ElementType>::columnCount(
     const QModelIndex& parent) const {
   Q_UNUSED(parent);
-  return mRootItem->getColumnCount();
+  return mRootItem ? mRootItem->getColumnCount() : 1;
 }
 
 template <typename ElementType>
 int CategoryTreeModel<ElementType>::rowCount(const QModelIndex& parent) const {
   CategoryTreeItem<ElementType>* parentItem = getItem(parent);
-  return parentItem->getChildCount();
+  return parentItem ? parentItem->getChildCount() : 0;
 }
 
 template <typename ElementType>
@@ -89,7 +100,8 @@ QModelIndex CategoryTreeModel<ElementType>::index(
   if (parent.isValid() && parent.column() != 0) return QModelIndex();
 
   CategoryTreeItem<ElementType>* parentItem = getItem(parent);
-  CategoryTreeItem<ElementType>* childItem  = parentItem->getChild(row);
+  if (!parentItem) return QModelIndex();
+  CategoryTreeItem<ElementType>* childItem = parentItem->getChild(row);
 
   if (childItem)
     return createIndex(row, column, childItem);
@@ -105,7 +117,7 @@ QModelIndex CategoryTreeModel<ElementType>::parent(
   CategoryTreeItem<ElementType>* childItem  = getItem(index);
   CategoryTreeItem<ElementType>* parentItem = childItem->getParent();
 
-  if (parentItem == mRootItem.data()) return QModelIndex();
+  if (parentItem == mRootItem.get()) return QModelIndex();
 
   return createIndex(parentItem->getChildNumber(), 0, parentItem);
 }
@@ -127,7 +139,7 @@ template <typename ElementType>
 QVariant CategoryTreeModel<ElementType>::data(const QModelIndex& index,
                                               int                role) const {
   CategoryTreeItem<ElementType>* item = getItem(index);
-  return item->data(role);
+  return item ? item->data(role) : QVariant();
 }
 
 /*******************************************************************************
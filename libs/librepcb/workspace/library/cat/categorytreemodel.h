@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -41,6 +43,9 @@ class WorkspaceLibraryDb;
 
 /**
  * @brief The CategoryTreeModel class
+ *
+ * The categories are loaded asynchronously, the model is empty until they are
+ * loaded (then the model gets reset).
  */
 template <typename ElementType>
 class CategoryTreeModel final : public QAbstractItemModel {
@@ -71,8 +76,12 @@ public:
   CategoryTreeModel& operator=(const CategoryTreeModel& rhs) = delete;
 
 private:
+  // Types
+  using RootItemType = std::shared_ptr<CategoryTreeItem<ElementType>>;
+
   // Attributes
-  QScopedPointer<CategoryTreeItem<ElementType>> mRootItem;
+  RootItemType                 mRootItem;  ///< nullptr until loaded
+  QFutureWatcher<RootItemType> mRootItemWatcher;
 };
 
 typedef CategoryTreeModel<library::ComponentCategory>
@@ -0,0 +1,319 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "librarythumbnailcache.h"
+
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/sym/symbolpreviewgraphicsitem.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryThumbnailCache::LibraryThumbnailCache(const WorkspaceLibraryDb& db,
+                                             const FilePath& cacheDir,
+                                             QObject*        parent) noexcept
+  : QObject(parent),
+    mDb(db),
+    mCacheDir(cacheDir),
+    mEntries(1000),
+    mCheckIntervalMs(5000),
+    mClock(&QDateTime::currentMSecsSinceEpoch),
+    mFileTime([](const QFileInfo& info) { return info.lastModified(); }) {
+  // keep some cores free for the GUI and the library scanner
+  mThreadPool.setMaxThreadCount(qMax(QThread::idealThreadCount() / 2, 1));
+
+  // render only a few thumbnails per event loop iteration
+  mRenderTimer.setSingleShot(true);
+  mRenderTimer.setInterval(0);
+  connect(&mRenderTimer, &QTimer::timeout, this,
+          &LibraryThumbnailCache::renderPendingThumbnails);
+}
+
+LibraryThumbnailCache::~LibraryThumbnailCache() noexcept {
+  mThreadPool.clear();  // discard requests which are not started yet
+  mThreadPool.waitForDone();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+template <>
+QImage LibraryThumbnailCache::getThumbnail<Symbol>(
+    const WorkspaceLibraryDb::ElementInfo& element) noexcept {
+  return getThumbnail("symbols", element);
+}
+
+template <>
+QImage LibraryThumbnailCache::getThumbnail<Package>(
+    const WorkspaceLibraryDb::ElementInfo& element) noexcept {
+  return getThumbnail("packages", element);
+}
+
+template <>
+QImage LibraryThumbnailCache::getThumbnail<Device>(
+    const WorkspaceLibraryDb::ElementInfo& element) noexcept {
+  return getThumbnail("devices", element);
+}
+
+FilePath LibraryThumbnailCache::getThumbnailFilePath(
+    const QString& type, const Uuid& uuid, const Version& version) const
+    noexcept {
+  return mCacheDir.getPathTo(type % "/" % uuid.toStr() % "_" %
+                             version.toStr() % ".png");
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QImage LibraryThumbnailCache::getThumbnail(
+    const QString&                         type,
+    const WorkspaceLibraryDb::ElementInfo& element) noexcept {
+  QString key   = element.filePath.toStr();
+  Entry*  entry = mEntries.object(key);
+  qint64  now   = mClock();
+  if ((!entry || (now - entry->checked >= mCheckIntervalMs)) &&
+      (!mPendingRequests.contains(key))) {
+    mPendingRequests.insert(key);
+    if (entry) {
+      entry->checked = now;
+    }
+    FilePath  dir          = element.filePath;
+    Uuid      uuid         = element.uuid;
+    Version   version      = element.version;
+    QDateTime lastModified = entry ? entry->lastModified : QDateTime();
+    auto job = [this, type, dir, uuid, version, lastModified]() {
+      Lookup result = lookup(type, dir, uuid, version, lastModified);
+      QMutexLocker locker(&mMutex);
+      mFinishedLookups.append(result);
+      if (mFinishedLookups.count() == 1) {
+        QMetaObject::invokeMethod(this, "processLookups", Qt::QueuedConnection);
+      }
+    };
+#if (QT_VERSION >=     \
+     QT_VERSION_CHECK( \
+         5, 4, 0))  // QtConcurrent::run(QThreadPool*, ...) requires Qt>=5.4
+    QtConcurrent::run(&mThreadPool, job);
+#else
+    QtConcurrent::run(job);
+#endif
+  }
+  return entry ? entry->image : QImage();
+}
+
+LibraryThumbnailCache::Lookup LibraryThumbnailCache::lookup(
+    const QString& type, const FilePath& elementDir, const Uuid& uuid,
+    const Version& version, const QDateTime& knownLastModified) const {
+  Lookup result;
+  result.elementDir = elementDir;
+  result.renderType = type;
+  result.renderDir  = elementDir;
+  result.pngFile    = getThumbnailFilePath(type, uuid, version);
+  result.sourceDirs.append(elementDir);
+  result.unchanged = false;
+
+  if (type == "devices") {
+    try {
+      Uuid pkgUuid = Uuid::createRandom();
+      mDb.getDeviceMetadata(elementDir, &pkgUuid, nullptr);  // can throw
+      result.renderType = "packages";
+      result.renderDir  = mDb.getLatestPackage(pkgUuid);     // can throw
+      if (result.renderDir.isValid()) {
+        Version pkgVersion = Version::fromString("0.1");
+        mDb.getElementMetadata<Package>(result.renderDir, nullptr,
+                                        &pkgVersion);  // can throw
+        result.pngFile = getThumbnailFilePath("packages", pkgUuid, pkgVersion);
+        result.sourceDirs.append(result.renderDir);
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Failed to get package of device" << elementDir.toNative()
+                 << ":" << e.getMsg();
+      result.renderDir = FilePath();
+    }
+  }
+
+  result.lastModified = getLastModified(result.sourceDirs);
+  if (knownLastModified.isValid() &&
+      (result.lastModified <= knownLastModified)) {
+    result.unchanged = true;
+  } else if (result.renderDir.isValid()) {
+    QFileInfo info(result.pngFile.toStr());
+    if (info.exists() &&
+        (mFileTime(info) >= getLastModified({result.renderDir}))) {
+      result.image = QImage(result.pngFile.toStr());
+    }
+  }
+  return result;
+}
+
+void LibraryThumbnailCache::processLookups() noexcept {
+  QList<Lookup> lookups;
+  {
+    QMutexLocker locker(&mMutex);
+    lookups.swap(mFinishedLookups);
+  }
+  foreach (const Lookup& result, lookups) {
+    if (result.unchanged) {
+      mPendingRequests.remove(result.elementDir.toStr());
+    } else if ((!result.image.isNull()) || (!result.renderDir.isValid())) {
+      addEntry(result, result.image);
+    } else {
+      mRenderQueue.append(result);
+      mRenderTimer.start();
+    }
+  }
+}
+
+void LibraryThumbnailCache::renderPendingThumbnails() noexcept {
+  QElapsedTimer timer;
+  timer.start();
+  while ((!mRenderQueue.isEmpty()) && (timer.elapsed() < sRenderBatchTimeMs)) {
+    Lookup request = mRenderQueue.takeFirst();
+    QImage image;
+    try {
+      if (request.renderType == "symbols") {
+        image = renderSymbol(request.renderDir);  // can throw
+      } else {
+        image = renderPackage(request.renderDir);  // can throw
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Failed to render library thumbnail of"
+                 << request.renderDir.toNative() << ":" << e.getMsg();
+    }
+    if (!image.isNull()) {
+      FilePath fp  = request.pngFile;
+      auto     job = [fp, image]() {
+        try {
+          FileUtils::makePath(fp.getParentDir());  // can throw
+          if (!image.save(fp.toStr(), "PNG")) {
+            qWarning() << "Failed to write library thumbnail:"
+                       << fp.toNative();
+          }
+        } catch (const Exception& e) {
+          qWarning() << "Failed to write library thumbnail:" << e.getMsg();
+        }
+      };
+#if (QT_VERSION >=     \
+     QT_VERSION_CHECK( \
+         5, 4, 0))  // QtConcurrent::run(QThreadPool*, ...) requires Qt>=5.4
+      QtConcurrent::run(&mThreadPool, job);
+#else
+      QtConcurrent::run(job);
+#endif
+    }
+    addEntry(request, image);
+  }
+  if (!mRenderQueue.isEmpty()) {
+    mRenderTimer.start();  // continue in the next event loop iteration
+  }
+}
+
+void LibraryThumbnailCache::addEntry(const Lookup& result,
+                                     const QImage& image) noexcept {
+  QString key         = result.elementDir.toStr();
+  Entry*  entry       = new Entry();
+  entry->image        = image;
+  entry->lastModified = result.lastModified;
+  entry->checked      = mClock();
+  mEntries.insert(key, entry);
+  mPendingRequests.remove(key);
+  emit thumbnailAvailable(result.elementDir, image);
+}
+
+QImage LibraryThumbnailCache::renderSymbol(const FilePath& symbolDir) {
+  Symbol symbol(std::unique_ptr<TransactionalDirectory>(
+      new TransactionalDirectory(
+          TransactionalFileSystem::openRO(symbolDir))));  // can throw
+  DefaultGraphicsLayerProvider layerProvider;
+  GraphicsScene                scene;
+  SymbolPreviewGraphicsItem    item(layerProvider, QStringList(), symbol);
+  scene.addItem(item);
+  QImage image =
+      scene.toImage(QSize(sThumbnailSize, sThumbnailSize), Qt::white);
+  scene.removeItem(item);
+  return image;
+}
+
+QImage LibraryThumbnailCache::renderPackage(const FilePath& packageDir) {
+  Package package(std::unique_ptr<TransactionalDirectory>(
+      new TransactionalDirectory(
+          TransactionalFileSystem::openRO(packageDir))));  // can throw
+  std::shared_ptr<const Footprint> footprint =
+      package.getFootprints().value(0);
+  if (!footprint) {
+    return QImage();
+  }
+  DefaultGraphicsLayerProvider layerProvider;
+  GraphicsScene                scene;
+  FootprintPreviewGraphicsItem item(layerProvider, QStringList(), *footprint,
+                                    &package);
+  scene.addItem(item);
+  QImage image =
+      scene.toImage(QSize(sThumbnailSize, sThumbnailSize), Qt::black);
+  scene.removeItem(item);
+  return image;
+}
+
+QDateTime LibraryThumbnailCache::getLastModified(
+    const QList<FilePath>& dirs) const noexcept {
+  QDateTime lastModified;
+  foreach (const FilePath& dir, dirs) {
+    QFileInfoList infos =
+        QDir(dir.toStr()).entryInfoList(QDir::Files | QDir::Hidden);
+    infos.append(QFileInfo(dir.toStr()));
+    foreach (const QFileInfo& info, infos) {
+      QDateTime fileTime = mFileTime(info);
+      if ((!lastModified.isValid()) || (fileTime > lastModified)) {
+        lastModified = fileTime;
+      }
+    }
+  }
+  return lastModified;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,231 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WORKSPACE_LIBRARYTHUMBNAILCACHE_H
+#define LIBREPCB_WORKSPACE_LIBRARYTHUMBNAILCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibrarydb.h"
+
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/version.h>
+
+#include <QtCore>
+#include <QtGui>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*******************************************************************************
+ *  Class LibraryThumbnailCache
+ ******************************************************************************/
+
+/**
+ * @brief Pre-rendered preview images of workspace library elements
+ *
+ * Thumbnails are stored as PNG files in a cache directory, keyed by element
+ * type, UUID and version. A cached file is re-rendered if any file of the
+ * element directory is newer than the thumbnail (e.g. because it was modified
+ * in the library editor).
+ *
+ * The worker threads of the cache only check the timestamps and load or save
+ * the PNG files. Rendering requires a ::librepcb::GraphicsScene which must
+ * only be used in the GUI thread, so missing thumbnails are rendered in the
+ * GUI thread, a few of them per event loop iteration to keep the user
+ * interface responsive.
+ *
+ * #getThumbnail() never blocks: it returns the thumbnail if it is already in
+ * memory, otherwise it returns a null image and emits #thumbnailAvailable()
+ * as soon as the thumbnail was loaded or rendered. Thumbnails in memory are
+ * checked for modifications of the element in the background from time to
+ * time, and updated thumbnails are emitted with #thumbnailAvailable() again.
+ * Elements which could not be rendered are retried only after they have been
+ * modified.
+ *
+ * Devices have no graphics on their own, so the thumbnail of a device is the
+ * thumbnail of its package.
+ */
+class LibraryThumbnailCache final : public QObject {
+  Q_OBJECT
+
+public:
+  // Types
+  typedef std::function<qint64()> Clock;  ///< Returns the current time [ms]
+  typedef std::function<QDateTime(const QFileInfo&)>
+      FileTimeProvider;  ///< Returns the last modification time of a file
+
+  // Constructors / Destructor
+  LibraryThumbnailCache()                                   = delete;
+  LibraryThumbnailCache(const LibraryThumbnailCache& other) = delete;
+  LibraryThumbnailCache(const WorkspaceLibraryDb& db, const FilePath& cacheDir,
+                        QObject* parent = nullptr) noexcept;
+  ~LibraryThumbnailCache() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Check whether there are requests which are not finished yet
+   *
+   * @return True if a thumbnail lookup or rendering is still in progress
+   */
+  bool hasPendingRequests() const noexcept {
+    return !mPendingRequests.isEmpty();
+  }
+
+  // Setters
+
+  /**
+   * @brief Set the minimum time between two modification checks of an element
+   *
+   * @param ms    Interval in milliseconds (default: 5000)
+   */
+  void setCheckInterval(int ms) noexcept { mCheckIntervalMs = ms; }
+
+  /**
+   * @brief Replace the sources of time (used by the unit tests)
+   *
+   * @param clock     Provides the current time, used for the check interval
+   *                  (default: QDateTime::currentMSecsSinceEpoch())
+   * @param fileTime  Provides the last modification time of files and
+   *                  directories (default: QFileInfo::lastModified())
+   *
+   * @warning The file time provider is called from worker threads, so it must
+   *          be thread-safe and must only be set before requesting thumbnails.
+   */
+  void setClock(const Clock& clock, const FileTimeProvider& fileTime) noexcept {
+    mClock    = clock;
+    mFileTime = fileTime;
+  }
+
+  // General Methods
+
+  /**
+   * @brief Get the thumbnail of a library element
+   *
+   * Supported element types: ::librepcb::library::Symbol,
+   * ::librepcb::library::Package and ::librepcb::library::Device.
+   *
+   * @param element   The element, as returned by the
+   *                  ::librepcb::workspace::WorkspaceLibraryDb queries
+   *
+   * @return The thumbnail if available in memory, otherwise a null image
+   *         (the thumbnail will be delivered with #thumbnailAvailable() later)
+   */
+  template <typename ElementType>
+  QImage getThumbnail(const WorkspaceLibraryDb::ElementInfo& element) noexcept;
+
+  /**
+   * @brief Get the file path of the thumbnail of an element in the cache
+   *
+   * @param type      Element type ("symbols" or "packages")
+   * @param uuid      Element UUID
+   * @param version   Element version
+   *
+   * @return The PNG file (might not exist)
+   */
+  FilePath getThumbnailFilePath(const QString& type, const Uuid& uuid,
+                                const Version& version) const noexcept;
+
+  // Operator Overloadings
+  LibraryThumbnailCache& operator=(const LibraryThumbnailCache& rhs) = delete;
+
+signals:
+  /**
+   * @brief A requested thumbnail was loaded, rendered or updated
+   *
+   * @param elementDir  The directory of the requested element
+   * @param image       The thumbnail (null if it could not be rendered)
+   */
+  void thumbnailAvailable(const FilePath& elementDir, const QImage& image);
+
+private:  // Types
+  /// Result of the background lookup of a thumbnail
+  struct Lookup {
+    FilePath        elementDir;    ///< The requested element
+    QString         renderType;    ///< Type of the element to render
+    FilePath        renderDir;     ///< Element to render (invalid if none)
+    FilePath        pngFile;       ///< Thumbnail file of #renderDir
+    QList<FilePath> sourceDirs;    ///< Directories the thumbnail depends on
+    QDateTime       lastModified;  ///< Last modification of #sourceDirs
+    QImage          image;         ///< Thumbnail loaded from #pngFile
+    bool            unchanged;     ///< Thumbnail in memory is still valid
+  };
+
+  /// A thumbnail in memory
+  struct Entry {
+    QImage    image;         ///< Null if rendering failed
+    QDateTime lastModified;  ///< Last modification of the source directories
+    qint64    checked;       ///< Time of the last modification check [ms]
+  };
+
+private:  // Methods
+  QImage getThumbnail(const QString&                         type,
+                      const WorkspaceLibraryDb::ElementInfo& element) noexcept;
+  Lookup lookup(const QString& type, const FilePath& elementDir,
+                const Uuid& uuid, const Version& version,
+                const QDateTime& knownLastModified) const;
+  Q_INVOKABLE void processLookups() noexcept;
+  void             renderPendingThumbnails() noexcept;
+  void             addEntry(const Lookup& result,
+                            const QImage& image) noexcept;
+  static QImage    renderSymbol(const FilePath& symbolDir);
+  static QImage    renderPackage(const FilePath& packageDir);
+  QDateTime getLastModified(const QList<FilePath>& dirs) const noexcept;
+
+private:  // Data
+  const WorkspaceLibraryDb& mDb;
+  FilePath                  mCacheDir;
+  QThreadPool               mThreadPool;
+
+  // Accessed only from the GUI thread
+  QCache<QString, Entry> mEntries;          ///< Key: Element directory
+  QSet<QString>          mPendingRequests;  ///< Key: Element directory
+  QList<Lookup>          mRenderQueue;
+  QTimer                 mRenderTimer;
+  int                    mCheckIntervalMs;
+  Clock                  mClock;
+
+  /// Provides file modification times (called by the worker threads too)
+  FileTimeProvider mFileTime;
+
+  /// Finished lookups of the worker threads (protected by #mMutex)
+  QMutex        mMutex;
+  QList<Lookup> mFinishedLookups;
+
+  static constexpr int sThumbnailSize     = 128;  ///< Width & height [px]
+  static constexpr int sRenderBatchTimeMs = 20;   ///< Max. time per batch
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WORKSPACE_LIBRARYTHUMBNAILCACHE_H
@@ -73,6 +73,9 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
     setDbVersion(sCurrentDbVersion);           // can throw
   }
 
+  // threads for asynchronous queries
+  mReaderThreadPool.setMaxThreadCount(sReaderThreadCount);
+
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace, mFilePath));
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanStarted, this,
@@ -93,6 +96,7 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
 }
 
 WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept {
+  mReaderThreadPool.waitForDone();
 }
 
 /*******************************************************************************
@@ -101,8 +105,8 @@ WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept {
 
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getLibraries() const {
   QSqlQuery query =
-      mDb->prepareQuery("SELECT version, filepath FROM libraries");
-  mDb->exec(query);
+      getDb().prepareQuery("SELECT version, filepath FROM libraries");
+  getDb().exec(query);
 
   QMultiMap<Version, FilePath> libraries;
   while (query.next()) {
@@ -386,11 +390,11 @@ void WorkspaceLibraryDb::getElementMetadata<Device>(const FilePath elemDir,
 
 void WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
                                             QPixmap*       icon) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT icon_png FROM libraries WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   libDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.first()) {
     QByteArray blob = query.value(0).toByteArray();
@@ -405,12 +409,12 @@ void WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
 
 void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
                                            Uuid* pkgUuid, Uuid* cmpUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT package_uuid, component_uuid "
       "FROM devices WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   devDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.first()) {
     Uuid uuid = Uuid::fromString(query.value(0).toString());  // can throw
@@ -425,6 +429,160 @@ void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
   }
 }
 
+/*******************************************************************************
+ *  Getters: Metadata of many library elements at once
+ ******************************************************************************/
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<ComponentCategory>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("component_categories", "cat_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<PackageCategory>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("package_categories", "cat_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<Symbol>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("symbols", "symbol_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<Package>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("packages", "package_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<Component>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("components", "component_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos<Device>(
+        const FilePath& lib, const QStringList& localeOrder) const {
+  return getLibraryElementInfos("devices", "device_id", lib,
+                                localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<ComponentCategory>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getCategoryChildInfos("component_categories", category,
+                               localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<PackageCategory>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getCategoryChildInfos("package_categories", category,
+                               localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<Symbol>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getElementInfosByCategory("symbols", "symbol_id", category,
+                                   localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<Package>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getElementInfosByCategory("packages", "package_id", category,
+                                   localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<Component>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getElementInfosByCategory("components", "component_id", category,
+                                   localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory<Device>(
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  return getElementInfosByCategory("devices", "device_id", category,
+                                   localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<ComponentCategory>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("component_categories", "cat_id",
+                                        keyword, localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<PackageCategory>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("package_categories", "cat_id", keyword,
+                                        localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<Symbol>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("symbols", "symbol_id", keyword,
+                                        localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<Package>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("packages", "package_id", keyword,
+                                        localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<Component>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("components", "component_id", keyword,
+                                        localeOrder);  // can throw
+}
+
+template <>
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword<Device>(
+        const QString& keyword, const QStringList& localeOrder) const {
+  return getElementInfosBySearchKeyword("devices", "device_id", keyword,
+                                        localeOrder);  // can throw
+}
+
 /*******************************************************************************
  *  Getters: Special
  ******************************************************************************/
@@ -499,10 +657,10 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesByCategory(
 
 QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(
     const Uuid& component) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM devices WHERE component_uuid = :uuid");
   query.bindValue(":uuid", component.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Uuid> elements;
   while (query.next()) {
@@ -523,13 +681,25 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+SQLiteDatabase& WorkspaceLibraryDb::getDb() const {
+  if (QThread::currentThread() == thread()) {
+    return *mDb;
+  }
+
+  // SQL connections must only be used in the thread which created them
+  if (!mReaderDbs.hasLocalData()) {
+    mReaderDbs.setLocalData(new SQLiteDatabase(mFilePath, true));  // can throw
+  }
+  return *mReaderDbs.localData();
+}
+
 void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
                                                 const QString&     idRow,
                                                 const FilePath&    elemDir,
                                                 const QStringList& localeOrder,
                                                 QString* name, QString* desc,
                                                 QString* keywords) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT locale, name, description, keywords FROM " % table %
       "_tr "
       "INNER JOIN " %
@@ -539,7 +709,7 @@ void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
       table % ".filepath = :filepath");
   query.bindValue(":filepath",
                   elemDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   LocalizedNameMap        nameMap(ElementName("unknown"));
   LocalizedDescriptionMap descriptionMap("unknown");
@@ -562,11 +732,11 @@ void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
 void WorkspaceLibraryDb::getElementMetadata(const QString& table,
                                             const FilePath elemDir, Uuid* uuid,
                                             Version* version) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT uuid, version FROM " % table %
-                                      " WHERE filepath = :filepath");
+  QSqlQuery query = getDb().prepareQuery("SELECT uuid, version FROM " %
+                                         table % " WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   elemDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   while (query.next()) {
     QString uuidStr    = query.value(0).toString();
@@ -576,12 +746,124 @@ void WorkspaceLibraryDb::getElementMetadata(const QString& table,
   }
 }
 
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getLibraryElementInfos(
+        const QString& tablename, const QString& idrowname, const FilePath& lib,
+        const QStringList& localeOrder) const {
+  return getElementInfos(tablename, idrowname, "WHERE lib_id = :value",
+                         getLibraryId(lib), localeOrder, false);  // can throw
+}
+
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosByCategory(
+        const QString& tablename, const QString& idrowname,
+        const tl::optional<Uuid>& category,
+        const QStringList&        localeOrder) const {
+  QString condition = "LEFT JOIN " % tablename % "_cat ON " % tablename %
+      ".id=" % tablename % "_cat." % idrowname % " WHERE category_uuid " %
+      (category ? QString("= :value") : QString("IS NULL"));
+  return getElementInfos(tablename, idrowname, condition,
+                         category ? QVariant(category->toStr()) : QVariant(),
+                         localeOrder, true);  // can throw
+}
+
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getElementInfosBySearchKeyword(
+        const QString& tablename, const QString& idrowname,
+        const QString& keyword, const QStringList& localeOrder) const {
+  QString condition = "WHERE id IN (SELECT " % idrowname % " FROM " %
+      tablename % "_tr WHERE name LIKE :value OR keywords LIKE :value)";
+  return getElementInfos(tablename, idrowname, condition,
+                         QString("%" % keyword % "%"), localeOrder,
+                         true);  // can throw
+}
+
+QList<WorkspaceLibraryDb::ElementInfo>
+    WorkspaceLibraryDb::getCategoryChildInfos(
+        const QString& tablename, const tl::optional<Uuid>& category,
+        const QStringList& localeOrder) const {
+  QString condition = "WHERE parent_uuid " %
+      (category ? QString("= :value") : QString("IS NULL"));
+  return getElementInfos(tablename, "cat_id", condition,
+                         category ? QVariant(category->toStr()) : QVariant(),
+                         localeOrder, true);  // can throw
+}
+
+QList<WorkspaceLibraryDb::ElementInfo> WorkspaceLibraryDb::getElementInfos(
+    const QString& tablename, const QString& idrowname,
+    const QString& condition, const QVariant& conditionValue,
+    const QStringList& localeOrder, bool latestOnly) const {
+  // The locales are ranked by their priority (the default value with an empty
+  // locale comes last) to pick the best translation of each element directly
+  // in the query, instead of querying the translations of each element.
+  QStringList locales;
+  for (int i = 0; i < localeOrder.count(); ++i) {
+    locales.append(QString("(:locale%1, %1)").arg(i));
+  }
+  locales.append(QString("('', %1)").arg(localeOrder.count()));
+  auto translation = [&](const QString& column) -> QString {
+    return "COALESCE((SELECT " % column % " FROM " % tablename %
+        "_tr INNER JOIN locales USING (locale) WHERE " % tablename % "_tr." %
+        idrowname % "=" % tablename % ".id AND " % column %
+        " IS NOT NULL ORDER BY priority LIMIT 1), 'unknown')";
+  };
+  // If only the latest versions are requested, the condition only selects the
+  // matching elements, but the latest version of them is determined from all
+  // their versions in the database, even if that version doesn't match.
+  QString filter = condition;
+  if (latestOnly) {
+    filter = "WHERE " % tablename % ".uuid IN (SELECT " % tablename %
+        ".uuid FROM " % tablename % " " % condition % ")";
+  }
+  QSqlQuery query = getDb().prepareQuery(
+      "WITH locales(locale, priority) AS (VALUES " % locales.join(", ") %
+      ") SELECT " % tablename % ".filepath, " % tablename % ".uuid, " %
+      tablename % ".version, " % translation("name") % ", " %
+      translation("description") % ", " % translation("keywords") % " FROM " %
+      tablename % " " % filter);
+  for (int i = 0; i < localeOrder.count(); ++i) {
+    query.bindValue(QString(":locale%1").arg(i), localeOrder.at(i));
+  }
+  if (!conditionValue.isNull()) {
+    query.bindValue(":value", conditionValue);
+  }
+  getDb().exec(query);
+
+  QList<ElementInfo> elements;
+  QHash<Uuid, int>   indices;  ///< Index in elements, if latestOnly is set
+  while (query.next()) {
+    FilePath filepath(FilePath::fromRelative(mWorkspace.getLibrariesPath(),
+                                             query.value(0).toString()));
+    if (!filepath.isValid()) {
+      throw LogicError(__FILE__, __LINE__);
+    }
+    ElementInfo info{
+        filepath,
+        Uuid::fromString(query.value(1).toString()),     // can throw
+        Version::fromString(query.value(2).toString()),  // can throw
+        query.value(3).toString(),
+        query.value(4).toString(),
+        query.value(5).toString(),
+    };
+    if (latestOnly && indices.contains(info.uuid)) {
+      ElementInfo& existing = elements[indices.value(info.uuid)];
+      if (info.version > existing.version) {
+        existing = info;
+      }
+    } else {
+      indices.insert(info.uuid, elements.count());
+      elements.append(info);
+    }
+  }
+  return elements;
+}
+
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
     const QString& tablename, const Uuid& uuid) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT version, filepath FROM " %
-                                      tablename % " WHERE uuid = :uuid");
+  QSqlQuery query = getDb().prepareQuery("SELECT version, filepath FROM " %
+                                         tablename % " WHERE uuid = :uuid");
   query.bindValue(":uuid", uuid.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
 
   QMultiMap<Version, FilePath> elements;
   while (query.next()) {
@@ -608,11 +890,11 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
 
 QSet<Uuid> WorkspaceLibraryDb::getCategoryChilds(
     const QString& tablename, const tl::optional<Uuid>& categoryUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM " % tablename % " WHERE parent_uuid " %
       (categoryUuid ? "= '" % categoryUuid->toStr() % "'"
                     : QString("IS NULL")));
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Uuid> elements;
   while (query.next()) {
@@ -640,10 +922,10 @@ QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename,
 
 tl::optional<Uuid> WorkspaceLibraryDb::getCategoryParent(
     const QString& tablename, const Uuid& category) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT parent_uuid FROM " % tablename % " WHERE uuid = '" %
       category.toStr() % "'" % " ORDER BY version DESC" % " LIMIT 1");
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.next()) {
     QVariant value = query.value(0);
@@ -663,27 +945,27 @@ tl::optional<Uuid> WorkspaceLibraryDb::getCategoryParent(
 
 int WorkspaceLibraryDb::getCategoryChildCount(
     const QString& tablename, const tl::optional<Uuid>& category) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT COUNT(*) FROM " % tablename % " WHERE parent_uuid " %
       (category ? "= '" % category->toStr() % "'" : QString("IS NULL")));
-  return mDb->count(query);
+  return getDb().count(query);
 }
 
 int WorkspaceLibraryDb::getCategoryElementCount(
     const QString& tablename, const QString& idrowname,
     const tl::optional<Uuid>& category) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT COUNT(*) FROM " % tablename % " LEFT JOIN " % tablename % "_cat" %
       " ON " % tablename % ".id=" % tablename % "_cat." % idrowname %
       " WHERE category_uuid " %
       (category ? "= '" % category->toStr() % "'" : QString("IS NULL")));
-  return mDb->count(query);
+  return getDb().count(query);
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
     const QString& tablename, const QString& idrowname,
     const tl::optional<Uuid>& categoryUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM " % tablename % " LEFT JOIN " % tablename %
       "_cat "
       "ON " %
@@ -692,7 +974,7 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
       "WHERE category_uuid " %
       (categoryUuid ? "= '" % categoryUuid->toStr() % "'"
                     : QString("IS NULL")));
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Uuid> elements;
   while (query.next()) {
@@ -704,14 +986,15 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
     const QString& tablename, const QString& idrowname,
     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(QString("SELECT %1.uuid FROM %1, %1_tr "
-                                              "ON %1.id=%1_tr.%2 "
-                                              "WHERE %1_tr.name LIKE :keyword "
-                                              "OR %1_tr.keywords LIKE :keyword "
-                                              "ORDER BY %1_tr.name ASC ")
-                                          .arg(tablename, idrowname));
+  QSqlQuery query =
+      getDb().prepareQuery(QString("SELECT %1.uuid FROM %1, %1_tr "
+                                   "ON %1.id=%1_tr.%2 "
+                                   "WHERE %1_tr.name LIKE :keyword "
+                                   "OR %1_tr.keywords LIKE :keyword "
+                                   "ORDER BY %1_tr.name ASC ")
+                               .arg(tablename, idrowname));
   query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  getDb().exec(query);
 
   QList<Uuid> elements;
   elements.reserve(query.size());
@@ -723,13 +1006,13 @@ QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
 
 int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const {
   QString   relativeLibraryPath = lib.toRelative(mWorkspace.getLibrariesPath());
-  QSqlQuery query               = mDb->prepareQuery(
+  QSqlQuery query               = getDb().prepareQuery(
       "SELECT id FROM libraries "
       "WHERE filepath = '" %
       relativeLibraryPath %
       "'"
       "LIMIT 1");
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.next()) {
     bool ok = false;
@@ -747,10 +1030,10 @@ int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const {
 
 QList<FilePath> WorkspaceLibraryDb::getLibraryElements(
     const FilePath& lib, const QString& tablename) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT filepath FROM " % tablename %
-                                      " WHERE lib_id = :lib_id");
+  QSqlQuery query = getDb().prepareQuery("SELECT filepath FROM " %
+                                         tablename % " WHERE lib_id = :lib_id");
   query.bindValue(":lib_id", getLibraryId(lib));
-  mDb->exec(query);
+  getDb().exec(query);
 
   QList<FilePath> elements;
   while (query.next()) {
@@ -964,16 +1247,16 @@ void WorkspaceLibraryDb::createAllTables() {
 
   // execute queries
   foreach (const QString& string, queries) {
-    QSqlQuery query = mDb->prepareQuery(string);  // can throw
-    mDb->exec(query);                             // can throw
+    QSqlQuery query = getDb().prepareQuery(string);  // can throw
+    getDb().exec(query);                             // can throw
   }
 }
 
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT value_int FROM internal WHERE key = 'version'");
-    mDb->exec(query);
+    getDb().exec(query);
     if (query.next()) {
       bool ok      = false;
       int  version = query.value(0).toInt(&ok);
@@ -988,11 +1271,11 @@ int WorkspaceLibraryDb::getDbVersion() const noexcept {
 }
 
 void WorkspaceLibraryDb::setDbVersion(int version) {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "INSERT INTO internal (key, value_int) "
       "VALUES ('version', :version)");
   query.bindValue(":version", version);
-  mDb->insert(query);  // can throw
+  getDb().insert(query);  // can throw
 }
 
 /*******************************************************************************
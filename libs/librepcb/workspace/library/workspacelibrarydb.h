@@ -26,15 +26,18 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/version.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
-class Version;
 class SQLiteDatabase;
 
 namespace workspace {
@@ -48,11 +51,29 @@ class WorkspaceLibraryScanner;
 
 /**
  * @brief The WorkspaceLibraryDb class
+ *
+ * All getters may be called from any thread. Calls from other threads than
+ * the one which owns this object use their own read-only database connection,
+ * see #queryAsync().
  */
 class WorkspaceLibraryDb final : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+
+  /**
+   * @brief Metadata of a library element, in the requested locale
+   */
+  struct ElementInfo {
+    FilePath filePath;
+    Uuid     uuid;
+    Version  version;
+    QString  name;
+    QString  description;
+    QString  keywords;
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb()                                = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -113,6 +134,51 @@ public:
   void getDeviceMetadata(const FilePath& devDir, Uuid* pkgUuid = nullptr,
                          Uuid* cmpUuid = nullptr) const;
 
+  // Getters: Metadata of many library elements at once
+
+  /**
+   * @brief Get the metadata of all elements of a library with one query
+   *
+   * @param lib           The library directory
+   * @param localeOrder   Locales to use for name, description and keywords
+   *
+   * @return All elements of the specified type in the specified library
+   */
+  template <typename ElementType>
+  QList<ElementInfo> getLibraryElementInfos(
+      const FilePath& lib, const QStringList& localeOrder) const;
+
+  /**
+   * @brief Get the metadata of all elements of a category with one query
+   *
+   * For categories, the child categories of the specified category are
+   * returned.
+   *
+   * @param category      The category, or tl::nullopt for all elements
+   *                      without category (or the root categories)
+   * @param localeOrder   Locales to use for name, description and keywords
+   *
+   * @return The latest version of each element of which any version is in
+   *         the specified category
+   */
+  template <typename ElementType>
+  QList<ElementInfo> getElementInfosByCategory(
+      const tl::optional<Uuid>& category, const QStringList& localeOrder) const;
+
+  /**
+   * @brief Get the metadata of all elements matching a search keyword
+   *
+   * @param keyword       The keyword to search for in names and keywords of
+   *                      all locales
+   * @param localeOrder   Locales to use for name, description and keywords
+   *
+   * @return The latest version of each element of which any version matches
+   *         the keyword
+   */
+  template <typename ElementType>
+  QList<ElementInfo> getElementInfosBySearchKeyword(
+      const QString& keyword, const QStringList& localeOrder) const;
+
   // Getters: Special
   QSet<Uuid> getComponentCategoryChilds(const tl::optional<Uuid>& parent) const;
   QSet<Uuid> getPackageCategoryChilds(const tl::optional<Uuid>& parent) const;
@@ -131,6 +197,40 @@ public:
 
   // General Methods
 
+  /**
+   * @brief Run queries on a worker thread without blocking the caller
+   *
+   * The queries are executed by a small pool of threads, each of them with
+   * its own read-only database connection. So several queries can run
+   * concurrently, also while a library rescan is in progress.
+   *
+   * @param query   Function which runs the queries with the passed database.
+   *                If it throws an exception, the exception is logged and
+   *                a default constructed result is returned instead.
+   *
+   * @return The future result (use a QFutureWatcher to get notified)
+   */
+  template <typename T>
+  QFuture<T> queryAsync(
+      const std::function<T(const WorkspaceLibraryDb&)>& query) const {
+    const WorkspaceLibraryDb* db     = this;
+    auto                      worker = [db, query]() -> T {
+      try {
+        return query(*db);  // can throw
+      } catch (const Exception& e) {
+        qCritical() << "Library database query failed:" << e.getMsg();
+        return T();
+      }
+    };
+#if (QT_VERSION >=     \
+     QT_VERSION_CHECK( \
+         5, 4, 0))  // QtConcurrent::run(QThreadPool*, ...) requires Qt>=5.4
+    return QtConcurrent::run(&mReaderThreadPool, worker);
+#else
+    return QtConcurrent::run(worker);
+#endif
+  }
+
   /**
    * @brief Rescan the whole library directory and update the SQLite database
    */
@@ -150,12 +250,31 @@ signals:
 
 private:
   // Private Methods
+  SQLiteDatabase& getDb() const;
   void getElementTranslations(const QString& table, const QString& idRow,
                               const FilePath&    elemDir,
                               const QStringList& localeOrder, QString* name,
                               QString* desc, QString* keywords) const;
   void getElementMetadata(const QString& table, const FilePath elemDir,
                           Uuid* uuid, Version* version) const;
+  QList<ElementInfo> getLibraryElementInfos(
+      const QString& tablename, const QString& idrowname, const FilePath& lib,
+      const QStringList& localeOrder) const;
+  QList<ElementInfo> getElementInfosByCategory(
+      const QString& tablename, const QString& idrowname,
+      const tl::optional<Uuid>& category, const QStringList& localeOrder) const;
+  QList<ElementInfo> getElementInfosBySearchKeyword(
+      const QString& tablename, const QString& idrowname,
+      const QString& keyword, const QStringList& localeOrder) const;
+  QList<ElementInfo> getCategoryChildInfos(
+      const QString& tablename, const tl::optional<Uuid>& category,
+      const QStringList& localeOrder) const;
+  QList<ElementInfo> getElementInfos(const QString&     tablename,
+                                     const QString&     idrowname,
+                                     const QString&     condition,
+                                     const QVariant&    conditionValue,
+                                     const QStringList& localeOrder,
+                                     bool               latestOnly) const;
   QMultiMap<Version, FilePath> getElementFilePathsFromDb(
       const QString& tablename, const Uuid& uuid) const;
   FilePath getLatestVersionFilePath(
@@ -190,8 +309,14 @@ private:
   QScopedPointer<SQLiteDatabase> mDb;        ///< the SQLite database
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
 
+  // Asynchronous queries (the thread pool must be destroyed first to delete
+  // the connections of its threads while the thread storage still exists)
+  mutable QThreadStorage<SQLiteDatabase*> mReaderDbs;
+  mutable QThreadPool                     mReaderThreadPool;
+
   // Constants
-  static const int sCurrentDbVersion = 2;
+  static const int sCurrentDbVersion  = 2;
+  static const int sReaderThreadCount = 4;
 };
 
 /*******************************************************************************
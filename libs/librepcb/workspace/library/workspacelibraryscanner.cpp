@@ -114,9 +114,10 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // open SQLite database
     SQLiteDatabase db(mDbFilePath);  // can throw
 
-    // update list of libraries
+    // update list of libraries (directory listings are cached since they don't
+    // change during the scan)
     std::shared_ptr<TransactionalFileSystem> fs =
-        TransactionalFileSystem::openRO(mWorkspace.getLibrariesPath());
+        TransactionalFileSystem::openROCached(mWorkspace.getLibrariesPath());
     QHash<QString, std::shared_ptr<Library>> libraries;
     getLibrariesOfDirectory(fs, "local", libraries);
     getLibrariesOfDirectory(fs, "remote", libraries);
@@ -0,0 +1,103 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "wsi_undomemorylimit.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WSI_UndoMemoryLimit::WSI_UndoMemoryLimit(const SExpression& node)
+  : WSI_Base(), mLimitMb(256), mLimitMbTmp(mLimitMb) {
+  if (const SExpression* child = node.tryGetChildByPath("undo_memory_limit")) {
+    mLimitMb = child->getValueOfFirstChild<uint>();
+  }
+  mLimitMbTmp = mLimitMb;
+
+  // create a spinbox
+  mSpinBox.reset(new QSpinBox());
+  mSpinBox->setMinimum(0);
+  mSpinBox->setMaximum(16384);
+  mSpinBox->setSingleStep(64);
+  mSpinBox->setValue(mLimitMb);
+  mSpinBox->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+  connect(mSpinBox.data(),
+          static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+          &WSI_UndoMemoryLimit::spinBoxValueChanged);
+
+  // create a QWidget
+  mWidget.reset(new QWidget());
+  QHBoxLayout* layout = new QHBoxLayout(mWidget.data());
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addWidget(mSpinBox.data());
+  layout->addWidget(new QLabel(tr("MiB per editor (0 = unlimited)")));
+}
+
+WSI_UndoMemoryLimit::~WSI_UndoMemoryLimit() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void WSI_UndoMemoryLimit::restoreDefault() noexcept {
+  mLimitMbTmp = 256;
+  mSpinBox->setValue(mLimitMbTmp);
+}
+
+void WSI_UndoMemoryLimit::apply() noexcept {
+  mLimitMb = mLimitMbTmp;
+}
+
+void WSI_UndoMemoryLimit::revert() noexcept {
+  mLimitMbTmp = mLimitMb;
+  mSpinBox->setValue(mLimitMbTmp);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void WSI_UndoMemoryLimit::spinBoxValueChanged(int value) noexcept {
+  mLimitMbTmp = value;
+}
+
+void WSI_UndoMemoryLimit::serialize(SExpression& root) const {
+  root.appendChild("undo_memory_limit", mLimitMb, true);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WSI_UNDOMEMORYLIMIT_H
+#define LIBREPCB_WSI_UNDOMEMORYLIMIT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "wsi_base.h"
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*******************************************************************************
+ *  Class WSI_UndoMemoryLimit
+ ******************************************************************************/
+
+/**
+ * @brief The WSI_UndoMemoryLimit class represents the memory limit of the undo
+ * history of editors
+ *
+ * This setting is used for librepcb::UndoStack#setMemoryLimit(). If the undo
+ * history of an editor exceeds the limit, the oldest commands are deleted. A
+ * value of zero means that the undo history is not limited.
+ */
+class WSI_UndoMemoryLimit final : public WSI_Base {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  WSI_UndoMemoryLimit()                                 = delete;
+  WSI_UndoMemoryLimit(const WSI_UndoMemoryLimit& other) = delete;
+  explicit WSI_UndoMemoryLimit(const SExpression& node);
+  ~WSI_UndoMemoryLimit() noexcept;
+
+  // Getters
+  uint   getLimitMb() const noexcept { return mLimitMb; }
+  qint64 getLimitBytes() const noexcept {
+    return qint64(mLimitMb) * 1024 * 1024;
+  }
+
+  // Getters: Widgets
+  QString  getLabelText() const noexcept { return tr("Undo Memory Limit:"); }
+  QWidget* getWidget() const noexcept { return mWidget.data(); }
+
+  // General Methods
+  void restoreDefault() noexcept override;
+  void apply() noexcept override;
+  void revert() noexcept override;
+
+  /// @copydoc librepcb::SerializableObject::serialize()
+  void serialize(SExpression& root) const override;
+
+  // Operator Overloadings
+  WSI_UndoMemoryLimit& operator=(const WSI_UndoMemoryLimit& rhs) = delete;
+
+private:  // Methods
+  void spinBoxValueChanged(int value) noexcept;
+
+private:  // Data
+  // General Attributes
+
+  /**
+   * @brief The memory limit of each undo stack [MiB] (0 = unlimited)
+   *
+   * Default: 256 MiB
+   */
+  uint mLimitMb;
+  uint mLimitMbTmp;
+
+  // Widgets
+  QScopedPointer<QWidget>  mWidget;
+  QScopedPointer<QSpinBox> mSpinBox;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WSI_UNDOMEMORYLIMIT_H
@@ -59,6 +59,7 @@ WorkspaceSettings::WorkspaceSettings(const Workspace& workspace)
   loadSettingsItem(mAppLocale, root);
   loadSettingsItem(mAppDefMeasUnits, root);
   loadSettingsItem(mProjectAutosaveInterval, root);
+  loadSettingsItem(mUndoMemoryLimit, root);
   loadSettingsItem(mAppearance, root);
   loadSettingsItem(mLibraryLocaleOrder, root);
   loadSettingsItem(mLibraryNormOrder, root);
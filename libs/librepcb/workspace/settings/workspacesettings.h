@@ -37,6 +37,7 @@
 #include "items/wsi_librarynormorder.h"
 #include "items/wsi_projectautosaveinterval.h"
 #include "items/wsi_repositories.h"
+#include "items/wsi_undomemorylimit.h"
 #include "items/wsi_user.h"
 
 /*******************************************************************************
@@ -85,6 +86,9 @@ public:
   WSI_ProjectAutosaveInterval& getProjectAutosaveInterval() const noexcept {
     return *mProjectAutosaveInterval;
   }
+  WSI_UndoMemoryLimit& getUndoMemoryLimit() const noexcept {
+    return *mUndoMemoryLimit;
+  }
   WSI_Appearance& getAppearance() const noexcept { return *mAppearance; }
   WSI_LibraryLocaleOrder& getLibLocaleOrder() const noexcept {
     return *mLibraryLocaleOrder;
@@ -131,6 +135,7 @@ private:  // Data
   QScopedPointer<WSI_AppLocale> mAppLocale;
   QScopedPointer<WSI_AppDefaultMeasurementUnits> mAppDefMeasUnits;
   QScopedPointer<WSI_ProjectAutosaveInterval>    mProjectAutosaveInterval;
+  QScopedPointer<WSI_UndoMemoryLimit>            mUndoMemoryLimit;
   QScopedPointer<WSI_Appearance>                 mAppearance;
   QScopedPointer<WSI_LibraryLocaleOrder>         mLibraryLocaleOrder;
   QScopedPointer<WSI_LibraryNormOrder>           mLibraryNormOrder;
@@ -23,6 +23,7 @@
 #include "workspace.h"
 
 #include "favoriteprojectsmodel.h"
+#include "library/librarythumbnailcache.h"
 #include "library/workspacelibrarydb.h"
 #include "projecttreemodel.h"
 #include "recentprojectsmodel.h"
@@ -116,6 +117,8 @@ Workspace::Workspace(const FilePath& wsPath)
 
   // load library database
   mLibraryDb.reset(new WorkspaceLibraryDb(*this));  // can throw
+  mLibraryThumbnailCache.reset(new LibraryThumbnailCache(
+      *mLibraryDb, mLibrariesPath.getPathTo("thumbnails")));
 
   // load project models
   mRecentProjectsModel.reset(new RecentProjectsModel(*this));
@@ -48,6 +48,7 @@ class RecentProjectsModel;
 class FavoriteProjectsModel;
 class WorkspaceSettings;
 class WorkspaceLibraryDb;
+class LibraryThumbnailCache;
 
 /*******************************************************************************
  *  Class Workspace
@@ -137,6 +138,13 @@ public:
    */
   WorkspaceLibraryDb& getLibraryDb() const { return *mLibraryDb; }
 
+  /**
+   * @brief Get the thumbnail cache of the workspace library elements
+   */
+  LibraryThumbnailCache& getLibraryThumbnailCache() const {
+    return *mLibraryThumbnailCache;
+  }
+
   // Project Management
 
   /**
@@ -264,6 +272,9 @@ private:  // Data
   /// the library database
   QScopedPointer<WorkspaceLibraryDb> mLibraryDb;
 
+  /// the library thumbnails (must be destroyed before #mLibraryDb)
+  QScopedPointer<LibraryThumbnailCache> mLibraryThumbnailCache;
+
   /// a tree model for the whole projects directory
   QScopedPointer<ProjectTreeModel> mProjectTreeModel;
 
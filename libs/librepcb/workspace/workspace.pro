@@ -24,6 +24,7 @@ SOURCES += \
     fileiconprovider.cpp \
     library/cat/categorytreeitem.cpp \
     library/cat/categorytreemodel.cpp \
+    library/librarythumbnailcache.cpp \
     library/workspacelibrarydb.cpp \
     library/workspacelibraryscanner.cpp \
     projecttreemodel.cpp \
@@ -37,6 +38,7 @@ SOURCES += \
     settings/items/wsi_librarynormorder.cpp \
     settings/items/wsi_projectautosaveinterval.cpp \
     settings/items/wsi_repositories.cpp \
+    settings/items/wsi_undomemorylimit.cpp \
     settings/items/wsi_user.cpp \
     settings/workspacesettings.cpp \
     settings/workspacesettingsdialog.cpp \
@@ -47,6 +49,7 @@ HEADERS += \
     fileiconprovider.h \
     library/cat/categorytreeitem.h \
     library/cat/categorytreemodel.h \
+    library/librarythumbnailcache.h \
     library/workspacelibrarydb.h \
     library/workspacelibraryscanner.h \
     projecttreemodel.h \
@@ -60,6 +63,7 @@ HEADERS += \
     settings/items/wsi_librarynormorder.h \
     settings/items/wsi_projectautosaveinterval.h \
     settings/items/wsi_repositories.h \
+    settings/items/wsi_undomemorylimit.h \
     settings/items/wsi_user.h \
     settings/workspacesettings.h \
     settings/workspacesettingsdialog.h \
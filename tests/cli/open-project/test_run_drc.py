@@ -0,0 +1,157 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import glob
+import json
+import os
+import re
+
+"""
+Test command "open-project --drc"
+"""
+
+PROJECT_DIR = 'data/Empty Project/'
+PROJECT_PATH = PROJECT_DIR + 'Empty Project.lpp'
+HOLE_UUID = 'c4c4fdb5-9e43-4b0b-8a4d-4fb1c3a35b9e'
+
+
+def add_too_small_hole(cli):
+    """
+    Adds a hole smaller than the default minimum drill diameter (0.3mm) to the
+    board and returns the UUID of the board
+    """
+    [board] = glob.glob(cli.abspath(PROJECT_DIR + 'boards/*/board.lp'))
+    with open(board, 'r') as f:
+        content = f.read().rstrip()
+    assert content.endswith(')')
+    content = content[:-1] + \
+        ' (hole {} (diameter 0.2) (position 10.0 10.0))\n)\n'.format(HOLE_UUID)
+    with open(board, 'w') as f:
+        f.write(content)
+    return re.search(r'\(librepcb_board ([0-9a-f-]+)', content).group(1)
+
+
+def approve_hole_violation(cli, board_uuid):
+    erc = cli.abspath(PROJECT_DIR + 'circuit/erc.lp')
+    with open(erc, 'r') as f:
+        content = f.read().rstrip()
+    assert content.endswith(')')
+    content = content[:-1] + \
+        ' (approved (class "Board") (instance "{}/hole:{}")' \
+        ' (message "Drc_drill_diameter"))\n)\n'.format(board_uuid, HOLE_UUID)
+    with open(erc, 'w') as f:
+        f.write(content)
+
+
+def test_project_without_violations(cli):
+    code, stdout, stderr = cli.run('open-project', '--drc', PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 0
+    assert any(["Board 'default':" in line for line in stdout])
+    assert any(['Approved violations: 0' in line for line in stdout])
+    assert any(['Non-approved violations: 0' in line for line in stdout])
+    assert stdout[-1] == 'SUCCESS'
+
+
+def test_project_with_nonapproved_violation(cli):
+    add_too_small_hole(cli)
+    code, stdout, stderr = cli.run('open-project', '--drc', PROJECT_PATH)
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'Hole is smaller than' in stderr[0]
+    assert len(stdout) > 0
+    assert any(['Approved violations: 0' in line for line in stdout])
+    assert any(['Non-approved violations: 1' in line for line in stdout])
+    assert stdout[-1] == 'Finished with errors!'
+
+
+def test_project_with_approved_violation(cli):
+    board_uuid = add_too_small_hole(cli)
+    approve_hole_violation(cli, board_uuid)
+    code, stdout, stderr = cli.run('open-project', '--drc', PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 0
+    assert any(['Approved violations: 1' in line for line in stdout])
+    assert any(['Non-approved violations: 0' in line for line in stdout])
+    assert stdout[-1] == 'SUCCESS'
+
+
+def test_json_report(cli):
+    board_uuid = add_too_small_hole(cli)
+    report = cli.abspath('report.json')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH)
+    assert code == 1
+    assert len(stderr) == 1
+    assert stdout[-1] == 'Finished with errors!'
+    with open(report, 'r') as f:
+        data = json.load(f)
+    assert data['non_approved'] == 1
+    [entry] = [e for e in data['entries'] if e['check'] == 'drc']
+    assert entry['severity'] == 'error'
+    assert entry['rule'] == 'drill_diameter'
+    assert entry['approved'] is False
+    assert entry['board'] == board_uuid
+    assert entry['objects'] == ['hole:' + HOLE_UUID]
+    assert entry['positions'] == [{'x': 10.0, 'y': 10.0}]
+
+
+def test_json_report_with_approved_violation(cli):
+    board_uuid = add_too_small_hole(cli)
+    approve_hole_violation(cli, board_uuid)
+    report = cli.abspath('report.json')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    with open(report, 'r') as f:
+        data = json.load(f)
+    assert data['non_approved'] == 0
+    [entry] = [e for e in data['entries'] if e['check'] == 'drc']
+    assert entry['approved'] is True
+
+
+def test_sexpr_report(cli):
+    board_uuid = add_too_small_hole(cli)
+    report = cli.abspath('report.lp')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH)
+    assert code == 1
+    assert len(stderr) == 1
+    assert stdout[-1] == 'Finished with errors!'
+    with open(report, 'r') as f:
+        content = f.read()
+    assert content.startswith('(librepcb_check_report')
+    assert '(non_approved 1)' in content
+    assert '(rule drill_diameter)' in content
+    assert '(approved false)' in content
+    assert '(board {})'.format(board_uuid) in content
+    assert '(object "hole:{}")'.format(HOLE_UUID) in content
+
+
+def test_report_with_unsupported_extension_fails(cli):
+    report = cli.abspath('report.txt')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH)
+    assert code == 1
+    assert any(['Unsupported report file extension' in line
+                for line in stderr])
+    assert stdout[-1] == 'Finished with errors!'
+
+
+def test_report_without_checks_fails(cli):
+    report = cli.abspath('report.json')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH)
+    assert code == 1
+    assert any(["'--report' requires '--erc' and/or '--drc'" in line
+                for line in stderr])
+    assert not os.path.exists(report)
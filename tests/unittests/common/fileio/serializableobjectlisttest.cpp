@@ -28,6 +28,8 @@
 
 #include <QtCore>
 
+#include <type_traits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -161,6 +163,80 @@ TEST_F(SerializableObjectListTest, testIndexOfName) {
   EXPECT_EQ(2, l.indexOf(mMocks[2]->mName));
 }
 
+TEST_F(SerializableObjectListTest, testIndexOfAfterModifications) {
+  List l{mMocks[0], mMocks[1]};
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));  // builds the indices
+  l.append(mMocks[2]);
+  EXPECT_EQ(2, l.indexOf(mMocks[2]->mUuid));
+  EXPECT_EQ(2, l.indexOf(mMocks[2]->mName));
+  l.swap(0, 2);
+  EXPECT_EQ(0, l.indexOf(mMocks[2].get()));
+  EXPECT_EQ(2, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mName));
+  l.remove(0);
+  EXPECT_EQ(-1, l.indexOf(mMocks[2].get()));
+  EXPECT_EQ(-1, l.indexOf(mMocks[2]->mUuid));
+  EXPECT_EQ(0, l.indexOf(mMocks[1]->mUuid));
+  l.insert(0, mMocks[2]);
+  EXPECT_EQ(0, l.indexOf(mMocks[2]->mName));
+  EXPECT_EQ(2, l.indexOf(mMocks[0]->mName));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfReturnsFirstMatch) {
+  List l{mMocks[0], mMocks[1], std::make_shared<Mock>(*mMocks[0]),
+         std::make_shared<Mock>(*mMocks[1])};
+  EXPECT_EQ(0, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mName));
+  l.remove(0);
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(0, l.indexOf(mMocks[1]->mName));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfAfterElementEdited) {
+  List l{mMocks[0], mMocks[1], mMocks[2]};
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mName));  // builds the indices
+  mMocks[1]->mName = "renamed";
+  mMocks[1]->onEdited.notify();
+  EXPECT_EQ(1, l.indexOf(QString("renamed")));
+  EXPECT_EQ(-1, l.indexOf(QString("bar")));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfAfterElementUuidEdited) {
+  List l{mMocks[0], mMocks[1], mMocks[2]};
+  Uuid oldUuid = mMocks[2]->mUuid;
+  EXPECT_EQ(2, l.indexOf(oldUuid));  // builds the indices
+  mMocks[2]->mUuid = Uuid::createRandom();
+  mMocks[2]->onEdited.notify();
+  EXPECT_EQ(2, l.indexOf(mMocks[2]->mUuid));
+  EXPECT_EQ(-1, l.indexOf(oldUuid));
+}
+
+TEST_F(SerializableObjectListTest, testIndexOfAfterElementEditedWithSameKeys) {
+  List l{mMocks[0], mMocks[1], mMocks[2]};
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));  // builds the indices
+  mMocks[1]->onEdited.notify();               // keys are not modified
+  l.append(std::make_shared<Mock>(Uuid::createRandom(), "new"));
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mMocks[1]->mName));
+  EXPECT_EQ(3, l.indexOf(QString("new")));
+}
+
+TEST_F(SerializableObjectListTest, testElementAccessReturnsCopies) {
+  // Element pointers must not be replaceable through the accessors, otherwise
+  // the lookup indices would get out of sync.
+  static_assert(!std::is_reference<decltype(std::declval<List&>().first())>(),
+                "first() must not return a reference");
+  static_assert(!std::is_reference<decltype(std::declval<List&>().last())>(),
+                "last() must not return a reference");
+  static_assert(!std::is_reference<decltype(std::declval<List&>()[0])>(),
+                "operator[] must not return a reference");
+  List l{mMocks[0], mMocks[1]};
+  l.first() = mMocks[2];  // assigns a temporary, the list is not modified
+  EXPECT_EQ(mMocks[0], l[0]);
+  EXPECT_EQ(0, l.indexOf(mMocks[0].get()));
+  EXPECT_EQ(-1, l.indexOf(mMocks[2]->mUuid));
+}
+
 TEST_F(SerializableObjectListTest, testContainsPointer) {
   List l{mMocks[0], mMocks[1], mMocks[2]};
   EXPECT_TRUE(l.contains(mMocks[0].get()));
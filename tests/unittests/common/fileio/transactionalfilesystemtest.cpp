@@ -270,6 +270,39 @@ TEST_F(TransactionalFileSystemTest, testSaveThrowsExceptionIfNonWritable) {
   EXPECT_THROW(fs.save(), Exception);
 }
 
+TEST_F(TransactionalFileSystemTest, testEnableDirectoryCacheIfNonWritable) {
+  TransactionalFileSystem fs(mPopulatedDir, false);
+  fs.enableDirectoryCache();
+  EXPECT_TRUE(fs.isDirectoryCacheEnabled());
+}
+
+TEST_F(TransactionalFileSystemTest, testEnableDirectoryCacheThrowsIfWritable) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  EXPECT_THROW(fs.enableDirectoryCache(), Exception);
+  EXPECT_FALSE(fs.isDirectoryCacheEnabled());
+}
+
+TEST_F(TransactionalFileSystemTest, testDirectoryCacheReadOutlivesFs) {
+  QByteArray content;
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    fs.enableDirectoryCache();
+    content = fs.read("1.txt");
+  }
+  EXPECT_EQ("1", content);
+}
+
+TEST_F(TransactionalFileSystemTest, testDirectoryCacheWriteOverridesFile) {
+  TransactionalFileSystem fs(mPopulatedDir, false);
+  fs.enableDirectoryCache();
+  EXPECT_EQ("1", fs.read("1.txt"));
+  fs.write("1.txt", "new");
+  EXPECT_EQ("new", fs.read("1.txt"));
+  fs.removeFile("1.txt");
+  EXPECT_FALSE(fs.fileExists("1.txt"));
+  EXPECT_FALSE(fs.getFiles().contains("1.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testCombinationOfAllMethods) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -598,6 +631,63 @@ TEST_F(TransactionalFileSystemTest, testExportToZip) {
   EXPECT_TRUE(zipFp.isExistingFile());
 }
 
+TEST_F(TransactionalFileSystemTest, testLoadFromZip) {
+  FilePath zipFp = mTmpDir.getPathTo("export.zip");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    fs.write("image.png", QByteArray(1000, 'x'));  // stored, not deflated
+    fs.write("1/big.txt", QByteArray(1000, 'y'));  // deflated
+    fs.exportToZip(zipFp);
+  }
+  TransactionalFileSystem fs(mEmptyDir, false);
+  fs.loadFromZip(zipFp);
+  EXPECT_EQ(QStringList({"1", "a", "foo dir"}).toSet(), fs.getDirs().toSet());
+  EXPECT_EQ(QStringList({"1.txt", "2.txt", "image.png"}).toSet(),
+            fs.getFiles().toSet());
+  EXPECT_FALSE(fs.fileExists(".dot/file.txt"));  // dotdirs are not exported
+  EXPECT_EQ("1a", fs.read("1/1a.txt"));
+  EXPECT_EQ("X", fs.read("foo dir/bar dir/X"));
+  EXPECT_EQ(QByteArray(1000, 'x'), fs.read("image.png"));
+  EXPECT_EQ(QByteArray(1000, 'y'), fs.read("1/big.txt"));
+  fs.removeFile("1.txt");
+  EXPECT_FALSE(fs.fileExists("1.txt"));
+  fs.write("2.txt", "new");
+  EXPECT_EQ("new", fs.read("2.txt"));
+}
+
+TEST_F(TransactionalFileSystemTest, testLoadFromZipIsLazy) {
+  FilePath zipFp = mTmpDir.getPathTo("export.zip");
+  TransactionalFileSystem(mPopulatedDir, false).exportToZip(zipFp);
+  TransactionalFileSystem fs(mEmptyDir, false);
+  fs.loadFromZip(zipFp);
+
+  // nothing is extracted by loadFromZip(), so a modified ZIP file is visible
+  // (this also requires the ZIP file to be closed, at least on Windows)
+  TransactionalFileSystem modifiedFs(mPopulatedDir, false);
+  modifiedFs.write("1/1a.txt", "modified");
+  modifiedFs.exportToZip(zipFp);
+  EXPECT_EQ("modified", fs.read("1/1a.txt"));
+
+  // but once read, the file is cached and the ZIP file is not opened again
+  FileUtils::removeFile(zipFp);
+  EXPECT_EQ("modified", fs.read("1/1a.txt"));
+  EXPECT_THROW(fs.read("1.txt"), RuntimeError);
+}
+
+TEST_F(TransactionalFileSystemTest, testExportToLoadedZip) {
+  FilePath zipFp = mTmpDir.getPathTo("export.zip");
+  TransactionalFileSystem(mPopulatedDir, false).exportToZip(zipFp);
+  TransactionalFileSystem fs(mEmptyDir, false);
+  fs.loadFromZip(zipFp);
+  fs.write("new.txt", "new");
+  fs.exportToZip(zipFp);  // overwrite the lazily loaded ZIP
+  EXPECT_EQ("4", fs.read("1/2/3/4.txt"));
+  TransactionalFileSystem fs2(mEmptyDir, false);
+  fs2.loadFromZip(zipFp);
+  EXPECT_EQ("4", fs2.read("1/2/3/4.txt"));
+  EXPECT_EQ("new", fs2.read("new.txt"));
+}
+
 /*******************************************************************************
  *  Parametrized getSubDirs() Tests
  ******************************************************************************/
@@ -621,6 +711,15 @@ TEST_P(TransactionalFileSystemGetSubDirsTest, testGetSubDirs) {
   EXPECT_EQ(data.entries.toSet(), fs.getDirs(data.relPath).toSet());
 }
 
+TEST_P(TransactionalFileSystemGetSubDirsTest, testGetSubDirsCached) {
+  const TransactionalFileSystemGetSubDirsTestData& data = GetParam();
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo(data.root), false);
+  fs.enableDirectoryCache();
+  EXPECT_EQ(data.entries.toSet(), fs.getDirs(data.relPath).toSet());
+  EXPECT_EQ(data.entries.toSet(), fs.getDirs(data.relPath).toSet());  // cached
+}
+
 // clang-format off
 static TransactionalFileSystemGetSubDirsTestData sGetSubDirsTestData[] = {
 // root,          relPath,            entries
@@ -677,6 +776,15 @@ TEST_P(TransactionalFileSystemGetFilesInDirTest, testGetFilesInDir) {
   EXPECT_EQ(data.entries.toSet(), fs.getFiles(data.relPath).toSet());
 }
 
+TEST_P(TransactionalFileSystemGetFilesInDirTest, testGetFilesInDirCached) {
+  const TransactionalFileSystemGetFilesInDirTestData& data = GetParam();
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo(data.root), false);
+  fs.enableDirectoryCache();
+  EXPECT_EQ(data.entries.toSet(), fs.getFiles(data.relPath).toSet());
+  EXPECT_EQ(data.entries.toSet(), fs.getFiles(data.relPath).toSet());  // cached
+}
+
 // clang-format off
 static TransactionalFileSystemGetFilesInDirTestData sGetFilesInDirTestData[] = {
 // root,          relPath,            entries
@@ -743,6 +851,26 @@ TEST_P(TransactionalFileSystemFileExistsTest, testRead) {
   }
 }
 
+TEST_P(TransactionalFileSystemFileExistsTest, testFileExistsCached) {
+  const TransactionalFileSystemFileExistsTestData& data = GetParam();
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo(data.root), false);
+  fs.enableDirectoryCache();
+  EXPECT_EQ(!data.content.isNull(), fs.fileExists(data.relPath));
+}
+
+TEST_P(TransactionalFileSystemFileExistsTest, testReadCached) {
+  const TransactionalFileSystemFileExistsTestData& data = GetParam();
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo(data.root), false);
+  fs.enableDirectoryCache();
+  if (data.content.isNull()) {
+    EXPECT_THROW(fs.read(data.relPath), Exception);
+  } else {
+    EXPECT_EQ(data.content, fs.read(data.relPath));
+  }
+}
+
 // clang-format off
 static TransactionalFileSystemFileExistsTestData sFileExistsTestData[] = {
 // root,          relPath,                content
@@ -77,6 +77,26 @@ TEST_F(PathTest, testCircle) {
   EXPECT_TRUE(path.isClosed());
 }
 
+TEST_F(PathTest, testIsTranslationOf) {
+  Path  path   = Path::circle(PositiveLength(1000));
+  Point offset = Point(Length(123), Length(-456));
+  Point result;
+  EXPECT_TRUE(path.translated(offset).isTranslationOf(path, result));
+  EXPECT_EQ(offset, result);
+  EXPECT_TRUE(path.isTranslationOf(path, result));
+  EXPECT_EQ(Point(0, 0), result);
+}
+
+TEST_F(PathTest, testIsNotTranslationOf) {
+  Path  path   = Path::circle(PositiveLength(1000));
+  Path  larger = Path::circle(PositiveLength(2000));
+  Point result(Length(1), Length(2));
+  EXPECT_FALSE(Path().isTranslationOf(Path(), result));
+  EXPECT_FALSE(path.rotated(Angle::deg90()).isTranslationOf(path, result));
+  EXPECT_FALSE(larger.isTranslationOf(path, result));
+  EXPECT_EQ(Point(Length(1), Length(2)), result);  // not modified
+}
+
 /*******************************************************************************
  *  Parametrized obround(width, height) Tests
  ******************************************************************************/
@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/graphics/graphicslayerbatch.h>
+
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsLayerBatchTest : public ::testing::Test {
+protected:
+  static QImage render(GraphicsLayerBatch& batch) {
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter                 painter(&image);
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = image.rect();
+    batch.paint(&painter, &option);
+    return image;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsLayerBatchTest, testSetAndRemove) {
+  GraphicsLayer      layer(GraphicsLayer::sTopCopper);
+  GraphicsLayerBatch batch(layer);
+  int                obj1 = 0, obj2 = 0;
+  batch.setLine(&obj1, QLineF(0, 0, 10, 0), 2);
+  batch.setArea(&obj2, QPainterPath());
+  EXPECT_EQ(2, batch.getCount());
+  EXPECT_TRUE(batch.contains(&obj1));
+  batch.setLine(&obj1, QLineF(0, 0, 20, 0), 2);  // replaces the old line
+  EXPECT_EQ(2, batch.getCount());
+  batch.remove(&obj1);
+  EXPECT_EQ(1, batch.getCount());
+  EXPECT_FALSE(batch.contains(&obj1));
+  EXPECT_TRUE(batch.contains(&obj2));
+}
+
+TEST_F(GraphicsLayerBatchTest, testBoundingRect) {
+  GraphicsLayer      layer(GraphicsLayer::sTopCopper);
+  GraphicsLayerBatch batch(layer);
+  int                obj1 = 0, obj2 = 0;
+  batch.setLine(&obj1, QLineF(0, 0, 10, 0), 2);
+  EXPECT_EQ(QRectF(-1, -1, 12, 2), batch.boundingRect());
+  QPainterPath area;
+  area.addRect(20, 20, 5, 5);
+  batch.setArea(&obj2, area);
+  EXPECT_EQ(QRectF(-1, -1, 26, 26), batch.boundingRect());
+}
+
+TEST_F(GraphicsLayerBatchTest, testPaint) {
+  GraphicsLayer layer(GraphicsLayer::sTopCopper);
+  layer.setColor(Qt::red);
+  GraphicsLayerBatch batch(layer);
+  int                obj1 = 0, obj2 = 0;
+  batch.setLine(&obj1, QLineF(10, 10, 90, 10), 4);
+  QPainterPath area;
+  area.addRect(40, 40, 20, 20);
+  batch.setArea(&obj2, area);
+  QImage image = render(batch);
+  EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(50, 10));
+  EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(50, 50));
+  EXPECT_EQ(QColor(Qt::white).rgb(), image.pixel(50, 30));
+
+  // removed objects must not be painted anymore
+  batch.remove(&obj2);
+  image = render(batch);
+  EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(50, 10));
+  EXPECT_EQ(QColor(Qt::white).rgb(), image.pixel(50, 50));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
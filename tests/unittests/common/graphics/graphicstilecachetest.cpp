@@ -0,0 +1,136 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicstilecache.h>
+
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsTileCacheTest : public ::testing::Test {
+protected:
+  QGraphicsScene mScene;
+
+  GraphicsTileCacheTest() {
+    mScene.addRect(QRectF(0, 0, 10, 10), QPen(Qt::red), QBrush(Qt::red));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsTileCacheTest, testDrawRendersVisibleTiles) {
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  QImage   image(250, 150, QImage::Format_ARGB32_Premultiplied);
+  QPainter painter(&image);
+  cache.draw(painter, image.rect(), QTransform());
+  EXPECT_EQ(6, cache.getTileCount());  // 3x2 tiles
+}
+
+TEST_F(GraphicsTileCacheTest, testDrawPaintsSceneContent) {
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::white);
+  QPainter painter(&image);
+  cache.draw(painter, image.rect(), QTransform::fromTranslate(20, 30));
+  painter.end();
+  EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(25, 35));
+  EXPECT_EQ(QColor(Qt::white).rgb(), image.pixel(5, 5));
+}
+
+TEST_F(GraphicsTileCacheTest, testInvalidateSceneRect) {
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  QImage   image(300, 300, QImage::Format_ARGB32_Premultiplied);
+  QPainter painter(&image);
+  cache.draw(painter, image.rect(), QTransform());
+  EXPECT_EQ(9, cache.getTileCount());
+  cache.invalidate(QRectF(150, 150, 10, 10));
+  EXPECT_EQ(8, cache.getTileCount());
+  cache.invalidate();
+  EXPECT_EQ(0, cache.getTileCount());
+}
+
+TEST_F(GraphicsTileCacheTest, testTransformChangeClearsCache) {
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  QImage   image(100, 100, QImage::Format_ARGB32_Premultiplied);
+  QPainter painter(&image);
+  cache.draw(painter, image.rect(), QTransform());
+  cache.setTransform(QTransform(), 1);  // unchanged
+  EXPECT_EQ(1, cache.getTileCount());
+  cache.setTransform(QTransform::fromScale(2, 2), 1);
+  EXPECT_EQ(0, cache.getTileCount());
+}
+
+TEST_F(GraphicsTileCacheTest, testPrefetch) {
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  QRect viewport(0, 0, 100, 100);
+  EXPECT_TRUE(cache.prefetch(viewport, QTransform(), 4));
+  EXPECT_EQ(4, cache.getTileCount());
+  EXPECT_FALSE(cache.prefetch(viewport, QTransform(), 100));
+  EXPECT_EQ(9, cache.getTileCount());  // visible tile + surrounding ring
+}
+
+TEST_F(GraphicsTileCacheTest, testViewTranslation) {
+  // the tiles must be rendered, drawn and invalidated with the same transform,
+  // even if the view transform (not only the scrolling) contains a translation
+  QTransform transform(2, 0, 0, 2, 50, 50);
+  GraphicsTileCache cache(100);
+  cache.setScene(&mScene);
+  cache.setTransform(transform, 1);
+  QImage image(300, 300, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::white);
+  QPainter painter(&image);
+  cache.draw(painter, image.rect(), transform);
+  painter.end();
+  EXPECT_EQ(QColor(Qt::red).rgb(), image.pixel(60, 60));
+  EXPECT_EQ(QColor(Qt::white).rgb(), image.pixel(45, 45));
+  EXPECT_EQ(QColor(Qt::white).rgb(), image.pixel(75, 75));
+  EXPECT_EQ(16, cache.getTileCount());  // 4x4 tiles
+
+  // scene rect 22.5..27 is at 45..54 in tile coordinates, i.e. in one tile
+  cache.invalidate(QRectF(22.5, 22.5, 4.5, 4.5));
+  EXPECT_EQ(15, cache.getTileCount());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
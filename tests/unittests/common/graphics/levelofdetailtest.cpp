@@ -0,0 +1,86 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/levelofdetail.h>
+
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LevelOfDetailTest : public ::testing::Test {
+protected:
+  static LevelOfDetail createLod(qreal scale) {
+    QImage   image(10, 10, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    painter.scale(scale, scale);
+    return LevelOfDetail(painter, QStyleOptionGraphicsItem());
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LevelOfDetailTest, testGetLod) {
+  EXPECT_DOUBLE_EQ(1, createLod(1).getLod());
+  EXPECT_DOUBLE_EQ(0.25, createLod(0.25).getLod());
+  EXPECT_FALSE(createLod(1).isPrinter());
+}
+
+TEST_F(LevelOfDetailTest, testIsTooSmall) {
+  EXPECT_FALSE(createLod(1).isTooSmall(QRectF(0, 0, 10, 1)));
+  EXPECT_TRUE(createLod(0.1).isTooSmall(QRectF(0, 0, 10, 1)));
+  EXPECT_FALSE(createLod(0.1).isTooSmall(100));
+  EXPECT_TRUE(createLod(0.01).isTooSmall(100));
+}
+
+TEST_F(LevelOfDetailTest, testIsTextVisible) {
+  EXPECT_TRUE(createLod(1).isTextVisible(1));
+  EXPECT_FALSE(createLod(0.5).isTextVisible(1));
+  EXPECT_TRUE(createLod(0.5).isTextVisible(2));
+}
+
+TEST_F(LevelOfDetailTest, testZoomBucket) {
+  EXPECT_EQ(0, createLod(1).getZoomBucket());
+  EXPECT_EQ(0, createLod(1.9).getZoomBucket());
+  EXPECT_EQ(1, createLod(2).getZoomBucket());
+  EXPECT_EQ(-1, createLod(0.5).getZoomBucket());
+  EXPECT_EQ(-2, createLod(0.3).getZoomBucket());
+  EXPECT_DOUBLE_EQ(0.25, LevelOfDetail::getZoomBucketScale(-2));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -164,6 +164,19 @@ TEST_F(SQLiteDatabaseTest, testInsert) {
   }
 }
 
+TEST_F(SQLiteDatabaseTest, testReadOnly) {
+  {
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec(
+        "CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+    db.exec("INSERT INTO test (name) VALUES ('hello')");
+  }
+  SQLiteDatabase db(mTempDbFilePath, true);
+  QSqlQuery      query = db.prepareQuery("SELECT COUNT(*) FROM test");
+  EXPECT_EQ(1, db.count(query));
+  EXPECT_THROW(db.exec("INSERT INTO test (name) VALUES ('hello')"), Exception);
+}
+
 TEST_F(SQLiteDatabaseTest, testClearExistingTable) {
   SQLiteDatabase db(mTempDbFilePath);
   db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
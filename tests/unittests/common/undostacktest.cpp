@@ -0,0 +1,290 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/if_bulkmutationtarget.h>
+#include <librepcb/common/undocommand.h>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/undostack.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Helpers
+ ******************************************************************************/
+
+class DummyCommand final : public UndoCommand {
+public:
+  explicit DummyCommand(int& value, int delta = 1, qint64 memoryUsage = 100,
+                        qint64 undoneMemoryUsage = -1) noexcept
+    : UndoCommand("Dummy"),
+      mValue(value),
+      mDelta(delta),
+      mMemoryUsage(memoryUsage),
+      mUndoneMemoryUsage(undoneMemoryUsage) {}
+  qint64 getMemoryUsage() const noexcept override {
+    if ((mUndoneMemoryUsage >= 0) && (!isCurrentlyExecuted())) {
+      return mUndoneMemoryUsage;  // e.g. an add command keeping its item
+    } else {
+      return mMemoryUsage;
+    }
+  }
+
+protected:
+  bool performExecute() override {
+    performRedo();
+    return true;
+  }
+  void performUndo() override { mValue -= mDelta; }
+  void performRedo() override { mValue += mDelta; }
+
+private:
+  int&   mValue;
+  int    mDelta;
+  qint64 mMemoryUsage;
+  qint64 mUndoneMemoryUsage;  ///< -1 = same as #mMemoryUsage
+};
+
+class BulkMutationTargetMock final : public IF_BulkMutationTarget {
+public:
+  BulkMutationTargetMock() noexcept : depth(0), maxDepth(0), endCount(0) {}
+  void beginBulkMutation() noexcept override {
+    maxDepth = qMax(maxDepth, ++depth);
+  }
+  void endBulkMutation() noexcept override {
+    --depth;
+    ++endCount;
+  }
+
+  int depth;
+  int maxDepth;
+  int endCount;
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UndoStackTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UndoStackTest, testExecUndoRedo) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new DummyCommand(value, 5));
+  EXPECT_EQ(5, value);
+  stack.undo();
+  EXPECT_EQ(0, value);
+  stack.redo();
+  EXPECT_EQ(5, value);
+}
+
+TEST_F(UndoStackTest, testStateModifiedWithoutBulkMutation) {
+  int       value = 0, signalCount = 0;
+  UndoStack stack;
+  QObject::connect(&stack, &UndoStack::stateModified,
+                   [&signalCount]() { ++signalCount; });
+  stack.beginCmdGroup("Group");
+  for (int i = 0; i < 10; ++i) {
+    stack.appendToCmdGroup(new DummyCommand(value));
+  }
+  EXPECT_EQ(11, signalCount);  // begin + 10 appends
+}
+
+TEST_F(UndoStackTest, testStateModifiedCoalescedInBulkMutation) {
+  int       value = 0, signalCount = 0;
+  UndoStack stack;
+  QObject::connect(&stack, &UndoStack::stateModified,
+                   [&signalCount]() { ++signalCount; });
+  stack.beginCmdGroup("Group");
+  signalCount = 0;
+  stack.beginBulkMutation();
+  stack.beginBulkMutation();  // nested
+  for (int i = 0; i < 10; ++i) {
+    stack.appendToCmdGroup(new DummyCommand(value));
+  }
+  stack.endBulkMutation();
+  EXPECT_EQ(0, signalCount);  // still in outer bulk mutation
+  stack.endBulkMutation();
+  EXPECT_EQ(1, signalCount);
+  EXPECT_EQ(10, value);
+}
+
+TEST_F(UndoStackTest, testNoStateModifiedInEmptyBulkMutation) {
+  int       signalCount = 0;
+  UndoStack stack;
+  QObject::connect(&stack, &UndoStack::stateModified,
+                   [&signalCount]() { ++signalCount; });
+  stack.beginBulkMutation();
+  stack.endBulkMutation();
+  EXPECT_EQ(0, signalCount);
+}
+
+TEST_F(UndoStackTest, testCommandGroupNotifiesBulkMutationTarget) {
+  int                    value = 0;
+  BulkMutationTargetMock target;
+  UndoStack              stack;
+  UndoCommandGroup*      group = new UndoCommandGroup("Group");
+  group->addBulkMutationTarget(target);
+  group->addBulkMutationTarget(target);  // added only once
+  for (int i = 0; i < 10; ++i) {
+    group->appendChild(new DummyCommand(value));
+  }
+  stack.execCmd(group);
+  EXPECT_EQ(10, value);
+  EXPECT_EQ(0, target.depth);
+  EXPECT_EQ(1, target.maxDepth);
+  EXPECT_EQ(1, target.endCount);
+  stack.undo();
+  EXPECT_EQ(0, value);
+  EXPECT_EQ(2, target.endCount);
+  stack.redo();
+  EXPECT_EQ(10, value);
+  EXPECT_EQ(3, target.endCount);
+  EXPECT_EQ(0, target.depth);
+}
+
+TEST_F(UndoStackTest, testMemoryUsage) {
+  int       value = 0;
+  UndoStack stack;
+  EXPECT_EQ(0, stack.getMemoryUsage());
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  stack.execCmd(new DummyCommand(value, 1, 200));
+  EXPECT_EQ(300, stack.getMemoryUsage());
+  stack.undo();
+  EXPECT_EQ(300, stack.getMemoryUsage());  // can still be redone
+  stack.execCmd(new DummyCommand(value, 1, 50));
+  EXPECT_EQ(150, stack.getMemoryUsage());  // redo command discarded
+  stack.clear();
+  EXPECT_EQ(0, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testUndoRedoUpdatesMemoryUsage) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  stack.execCmd(new DummyCommand(value, 1, 100, 1000));
+  EXPECT_EQ(200, stack.getMemoryUsage());
+  stack.undo();
+  EXPECT_EQ(1100, stack.getMemoryUsage());
+  stack.redo();
+  EXPECT_EQ(200, stack.getMemoryUsage());
+}
+
+TEST_F(UndoStackTest, testUndoTrimsToMemoryLimit) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMemoryLimit(1000);
+  for (int i = 0; i < 3; ++i) {
+    stack.execCmd(new DummyCommand(value, 1, 100));
+  }
+  stack.execCmd(new DummyCommand(value, 1, 100, 900));
+  EXPECT_EQ(400, stack.getMemoryUsage());
+  stack.undo();  // 1200 bytes, so the oldest two commands are deleted
+  EXPECT_EQ(1000, stack.getMemoryUsage());
+  EXPECT_EQ(3, value);
+  stack.undo();
+  EXPECT_EQ(2, value);
+  EXPECT_FALSE(stack.canUndo());
+  stack.redo();
+  stack.redo();
+  EXPECT_EQ(4, value);
+}
+
+TEST_F(UndoStackTest, testMemoryUsageOfCommandGroup) {
+  int       value = 0;
+  UndoStack stack;
+  stack.beginCmdGroup("Group");
+  for (int i = 0; i < 3; ++i) {
+    stack.appendToCmdGroup(new DummyCommand(value, 1, 100));
+  }
+  stack.commitCmdGroup();
+  EXPECT_GE(stack.getMemoryUsage(), 300);
+}
+
+TEST_F(UndoStackTest, testMemoryLimitDeletesOldestCommands) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMemoryLimit(250);
+  for (int i = 0; i < 5; ++i) {
+    stack.execCmd(new DummyCommand(value, 1, 100));
+  }
+  EXPECT_EQ(5, value);
+  EXPECT_EQ(200, stack.getMemoryUsage());
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(stack.canUndo());
+  stack.redo();
+  stack.redo();
+  EXPECT_EQ(5, value);
+}
+
+TEST_F(UndoStackTest, testMemoryLimitKeepsLastCommand) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMemoryLimit(50);
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  EXPECT_EQ(100, stack.getMemoryUsage());
+  EXPECT_TRUE(stack.canUndo());
+  stack.undo();
+  EXPECT_EQ(1, value);
+}
+
+TEST_F(UndoStackTest, testMemoryLimitInvalidatesDeletedCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setMemoryLimit(150);
+  EXPECT_TRUE(stack.isClean());
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  stack.execCmd(new DummyCommand(value, 1, 100));
+  stack.undo();
+  EXPECT_FALSE(stack.canUndo());
+  EXPECT_FALSE(stack.isClean());  // the clean state was deleted
+}
+
+TEST_F(UndoStackTest, testSetMemoryLimitTrimsExistingHistory) {
+  int       value = 0;
+  UndoStack stack;
+  for (int i = 0; i < 10; ++i) {
+    stack.execCmd(new DummyCommand(value, 1, 100));
+  }
+  EXPECT_EQ(1000, stack.getMemoryUsage());
+  stack.setMemoryLimit(300);
+  EXPECT_EQ(300, stack.getMemoryUsage());
+  EXPECT_EQ(300, stack.getMemoryLimit());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/boundingboxgrid.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoundingBoxGridTest : public ::testing::Test {
+protected:
+  static ClipperLib::IntRect rect(ClipperLib::cInt left, ClipperLib::cInt top,
+                                  ClipperLib::cInt right,
+                                  ClipperLib::cInt bottom) noexcept {
+    ClipperLib::IntRect r;
+    r.left   = left;
+    r.top    = top;
+    r.right  = right;
+    r.bottom = bottom;
+    return r;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoundingBoxGridTest, testEmpty) {
+  BoundingBoxGrid grid(PositiveLength(1000));
+  EXPECT_TRUE(grid.isEmpty());
+  EXPECT_EQ(0, grid.getCount());
+  EXPECT_EQ(QVector<int>(), grid.query(rect(-5000, -5000, 5000, 5000)));
+}
+
+TEST_F(BoundingBoxGridTest, testQuery) {
+  BoundingBoxGrid grid(PositiveLength(1000));
+  grid.insert(1, rect(0, 0, 500, 500));
+  grid.insert(2, rect(400, 400, 2500, 900));
+  grid.insert(3, rect(10000, 10000, 10100, 10100));
+  EXPECT_EQ(3, grid.getCount());
+  EXPECT_EQ(QVector<int>({1, 2}), grid.query(rect(450, 450, 460, 460)));
+  EXPECT_EQ(QVector<int>({2}), grid.query(rect(2000, 800, 2100, 850)));
+  EXPECT_EQ(QVector<int>({3}), grid.query(rect(10100, 10100, 20000, 20000)));
+  // same cell, but no overlap of the bounding boxes
+  EXPECT_EQ(QVector<int>(), grid.query(rect(600, 0, 900, 300)));
+}
+
+TEST_F(BoundingBoxGridTest, testNegativeCoordinates) {
+  BoundingBoxGrid grid(PositiveLength(1000));
+  grid.insert(1, rect(-1500, -1500, -500, -500));
+  grid.insert(2, rect(-100, -100, 100, 100));
+  EXPECT_EQ(QVector<int>({1}), grid.query(rect(-1000, -1000, -900, -900)));
+  EXPECT_EQ(QVector<int>({1, 2}), grid.query(rect(-600, -600, 0, 0)));
+  EXPECT_EQ(QVector<int>({2}), grid.query(rect(50, 50, 60, 60)));
+}
+
+TEST_F(BoundingBoxGridTest, testLargeObject) {
+  BoundingBoxGrid grid(PositiveLength(10));
+  grid.insert(1, rect(-1000000, -1000000, 1000000, 1000000));
+  grid.insert(2, rect(0, 0, 5, 5));
+  EXPECT_EQ(QVector<int>({1, 2}), grid.query(rect(1, 1, 2, 2)));
+  EXPECT_EQ(QVector<int>({1}),
+            grid.query(rect(900000, 900000, 900001, 900001)));
+  EXPECT_EQ(QVector<int>(), grid.query(rect(2000000, 0, 2000001, 1)));
+}
+
+TEST_F(BoundingBoxGridTest, testInvalidRectIsIgnored) {
+  BoundingBoxGrid grid(PositiveLength(1000));
+  grid.insert(1, rect(100, 100, 0, 0));
+  EXPECT_TRUE(grid.isEmpty());
+  EXPECT_EQ(QVector<int>(), grid.query(rect(-5000, -5000, 5000, 5000)));
+}
+
+TEST_F(BoundingBoxGridTest, testRemoveAndClear) {
+  BoundingBoxGrid grid(PositiveLength(1000));
+  grid.insert(1, rect(0, 0, 500, 500));
+  grid.insert(2, rect(0, 0, 100000, 100000));
+  grid.insert(3, rect(200, 200, 300, 300));
+  grid.remove(1);
+  grid.remove(2);
+  EXPECT_EQ(1, grid.getCount());
+  EXPECT_EQ(QVector<int>({3}), grid.query(rect(0, 0, 1000, 1000)));
+  grid.clear();
+  EXPECT_TRUE(grid.isEmpty());
+  EXPECT_EQ(QVector<int>(), grid.query(rect(0, 0, 1000, 1000)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -26,6 +26,8 @@
 
 #include <QtCore>
 
+#include <chrono>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -153,6 +155,46 @@ TEST(UuidTest, testCreateRandom) {
   }
 }
 
+// Benchmark only, disabled by default to not slow down the unit tests. Run it
+// with --gtest_also_run_disabled_tests --gtest_filter=*Performance.
+TEST(UuidTest, DISABLED_testHashLookupPerformance) {
+  // compare QHash lookups with Uuid keys against the same with string keys
+  QVector<Uuid>       uuids;
+  QHash<Uuid, int>    uuidHash;
+  QHash<QString, int> stringHash;
+  for (int i = 0; i < 100000; ++i) {
+    uuids.append(Uuid::createRandom());
+    uuidHash.insert(uuids.last(), i);
+    stringHash.insert(uuids.last().toStr(), i);
+  }
+  QStringList strings;
+  foreach (const Uuid& uuid, uuids) { strings.append(uuid.toStr()); }
+
+  std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+  qint64 uuidSum = 0;
+  start          = std::chrono::high_resolution_clock::now();
+  for (int n = 0; n < 10; ++n) {
+    foreach (const Uuid& uuid, uuids) { uuidSum += uuidHash.value(uuid); }
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> uuidSeconds = end - start;
+
+  qint64 stringSum = 0;
+  start            = std::chrono::high_resolution_clock::now();
+  for (int n = 0; n < 10; ++n) {
+    foreach (const QString& str, strings) {
+      stringSum += stringHash.value(str);
+    }
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> stringSeconds = end - start;
+
+  std::cout << "Needed " << uuidSeconds.count() << "s with Uuid keys and "
+            << stringSeconds.count() << "s with string keys for "
+            << (10 * uuids.count()) << " lookups\n";
+  EXPECT_EQ(stringSum, uuidSum);
+}
+
 TEST_P(UuidTest, testIsValid) {
   const UuidTestData& data = GetParam();
   EXPECT_EQ(data.valid, Uuid::isValid(data.uuid));
@@ -0,0 +1,127 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/library/libraryelementcache.h>
+#include <librepcb/library/sym/symbol.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LibraryElementCacheTest : public ::testing::Test {
+protected:
+  FilePath                                 mTempDir;
+  std::shared_ptr<TransactionalFileSystem> mFs;
+  Uuid                                     mUuid;
+
+  LibraryElementCacheTest() : mUuid(Uuid::createRandom()) {
+    mTempDir = FilePath::getRandomTempPath();
+    mFs      = TransactionalFileSystem::openRW(mTempDir);
+    writeSymbol("first", "Test Symbol");
+    writeSymbol("modified", "Modified Symbol");
+
+    // exact copy of the first symbol
+    foreach (const QString& file, mFs->getFiles("first/" % mUuid.toStr())) {
+      QString path = mUuid.toStr() % "/" % file;
+      mFs->write("second/" % path, mFs->read("first/" % path));
+    }
+  }
+
+  virtual ~LibraryElementCacheTest() {
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+
+  void writeSymbol(const QString& parentDir, const QString& name) {
+    Symbol sym(mUuid, Version::fromString("1"), "", ElementName(name), "", "");
+    TransactionalDirectory dir(mFs, parentDir);
+    sym.saveIntoParentDirectory(dir);
+  }
+
+  std::shared_ptr<Symbol> load(const QString& parentDir) {
+    TransactionalDirectory dir(mFs, parentDir % "/" % mUuid.toStr());
+    return LibraryElementCache::instance()->load<Symbol>(dir);
+  }
+
+  LibraryElementCache::Statistics getSymbolStatistics() const {
+    return LibraryElementCache::instance()->getStatistics().value("sym");
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LibraryElementCacheTest, testIdenticalElementsAreShared) {
+  std::shared_ptr<Symbol> sym1 = load("first");
+  std::shared_ptr<Symbol> sym2 = load("second");
+  EXPECT_EQ(sym1.get(), sym2.get());
+  EXPECT_EQ(mUuid, sym1->getUuid());
+  EXPECT_EQ(1, getSymbolStatistics().elements);
+  EXPECT_EQ(2, getSymbolStatistics().references);
+  EXPECT_GT(getSymbolStatistics().fileSize, 0);
+}
+
+TEST_F(LibraryElementCacheTest, testModifiedElementsAreNotShared) {
+  std::shared_ptr<Symbol> sym1 = load("first");
+  std::shared_ptr<Symbol> sym2 = load("modified");
+  EXPECT_NE(sym1.get(), sym2.get());
+  EXPECT_EQ("Test Symbol", *sym1->getNames().getDefaultValue());
+  EXPECT_EQ("Modified Symbol", *sym2->getNames().getDefaultValue());
+  EXPECT_EQ(2, getSymbolStatistics().elements);
+  EXPECT_EQ(2, getSymbolStatistics().references);
+}
+
+TEST_F(LibraryElementCacheTest, testReleasedElementsAreRemoved) {
+  std::shared_ptr<Symbol> sym = load("first");
+  EXPECT_EQ(1, getSymbolStatistics().elements);
+  sym.reset();
+  EXPECT_EQ(0, getSymbolStatistics().elements);
+  EXPECT_EQ(0, getSymbolStatistics().references);
+}
+
+TEST_F(LibraryElementCacheTest, testElementIsDetachedFromFileSystem) {
+  std::shared_ptr<Symbol> sym = load("first");
+  mFs->removeDirRecursively("first");
+  mFs.reset();
+  EXPECT_EQ(mUuid, sym->getUuid());
+  EXPECT_FALSE(sym->getDirectory().getAbsPath().isLocatedInDir(mTempDir));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace library
+}  // namespace librepcb
@@ -0,0 +1,180 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/toolbox.h>
+#include <librepcb/library/pkg/msg/msgpadoverlapswithplacement.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/pkg/packagecheck.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+namespace tests {
+
+/*******************************************************************************
+ *  Parametrized checkPadsOverlapWithPlacement() Tests
+ ******************************************************************************/
+
+struct PackageCheckPadsOverlapWithPlacementTestData {
+  const char*             layer;
+  qreal                   lineWidth;  // in mm, 0 for no outline
+  bool                    filled;
+  QVector<QPointF>        points;  // in mm, first point repeated if closed
+  FootprintPad::BoardSide padSide;
+  bool                    overlaps;
+};
+
+class PackageCheckPadsOverlapWithPlacementTest
+  : public ::testing::TestWithParam<
+        PackageCheckPadsOverlapWithPlacementTestData> {
+protected:
+  std::unique_ptr<Package> createPackage(
+      const PackageCheckPadsOverlapWithPlacementTestData& data) const {
+    std::unique_ptr<Package> pkg(new Package(Uuid::createRandom(),
+                                             Version::fromString("1"), "",
+                                             ElementName("Test"), "", ""));
+    std::shared_ptr<Footprint> footprint = std::make_shared<Footprint>(
+        Uuid::createRandom(), ElementName("default"), "");
+    // 1x1 mm pad, i.e. its stop mask reaches 0.65 mm from the origin
+    footprint->getPads().append(std::make_shared<FootprintPad>(
+        Uuid::createRandom(), Point(0, 0), Angle::deg0(),
+        FootprintPad::Shape::RECT, PositiveLength(1000000),
+        PositiveLength(1000000), UnsignedLength(0), data.padSide));
+    Path path;
+    foreach (const QPointF& point, data.points) {
+      path.addVertex(Point::fromMm(point));
+    }
+    footprint->getPolygons().append(std::make_shared<Polygon>(
+        Uuid::createRandom(), GraphicsLayerName(data.layer),
+        UnsignedLength(Length::fromMm(data.lineWidth)), data.filled, false,
+        path));
+    pkg->getFootprints().append(footprint);
+    return pkg;
+  }
+
+  static bool runCheck(const Package& pkg) {
+    PackageCheck check(pkg);
+    foreach (const auto& msg, check.runChecks()) {
+      if (dynamic_cast<const MsgPadOverlapsWithPlacement*>(msg.get())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The former implementation based on QPainterPath, i.e. the same shapes as
+  // the graphics items, which the check must still agree with.
+  static bool runFormerCheck(const Package& pkg) {
+    for (const Footprint& footprint : pkg.getFootprints()) {
+      QPainterPath topPlacement;
+      QPainterPath botPlacement;
+      for (const Polygon& polygon : footprint.getPolygons()) {
+        QPen pen(Qt::NoPen);
+        if (polygon.getLineWidth() > 0) {
+          pen.setStyle(Qt::SolidLine);
+          pen.setWidthF(polygon.getLineWidth()->toPx());
+        }
+        QBrush brush(Qt::NoBrush);
+        if (polygon.isFilled()) {
+          brush.setStyle(Qt::SolidPattern);
+        }
+        QPainterPath area = Toolbox::shapeFromPath(
+            polygon.getPath().toQPainterPathPx(), pen, brush);
+        if (polygon.getLayerName() == GraphicsLayer::sTopPlacement) {
+          topPlacement.addPath(area);
+        } else if (polygon.getLayerName() == GraphicsLayer::sBotPlacement) {
+          botPlacement.addPath(area);
+        }
+      }
+      for (const FootprintPad& pad : footprint.getPads()) {
+        Path stopMaskPath = pad.getOutline(Length(150000 - 10));
+        stopMaskPath.rotate(pad.getRotation()).translate(pad.getPosition());
+        QPainterPath stopMask = stopMaskPath.toQPainterPathPx();
+        if ((pad.isOnLayer(GraphicsLayer::sTopCopper) &&
+             stopMask.intersects(topPlacement)) ||
+            (pad.isOnLayer(GraphicsLayer::sBotCopper) &&
+             stopMask.intersects(botPlacement))) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+};
+
+TEST_P(PackageCheckPadsOverlapWithPlacementTest, test) {
+  const PackageCheckPadsOverlapWithPlacementTestData& data = GetParam();
+
+  std::unique_ptr<Package> pkg = createPackage(data);
+  EXPECT_EQ(data.overlaps, runCheck(*pkg));
+  EXPECT_EQ(data.overlaps, runFormerCheck(*pkg));
+}
+
+// clang-format off
+static PackageCheckPadsOverlapWithPlacementTestData
+    sPackageCheckPadsOverlapWithPlacementTestData[] = {
+// layer, line width, filled, points, pad side, overlaps
+  // far away or close to the stop mask
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 2}, {3, 2}},             FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 0.8}, {3, 0.8}},         FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 0.7}, {3, 0.7}},         FootprintPad::BoardSide::TOP, true},
+  // square caps
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 0}, {-0.8, 0}},          FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 0}, {-0.74, 0}},         FootprintPad::BoardSide::TOP, true},
+  // bevel joins of open and closed paths, pointing to the pad's corner
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{3, 0.71}, {0.71, 0.71}, {0.71, 3}},                 FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{3, 0.69}, {0.69, 0.69}, {0.69, 3}},                 FootprintPad::BoardSide::TOP, true},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{0.71, 0.71}, {3, 0.71}, {0.71, 3}, {0.71, 0.71}},   FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{0.69, 0.69}, {3, 0.69}, {0.69, 3}, {0.69, 0.69}},   FootprintPad::BoardSide::TOP, true},
+  // outline around the pad and filled area below the pad
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}, {-1, -1}},       FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sTopPlacement, 0.0, true,  {{-2, -2}, {2, -2}, {2, 2}, {-2, 2}, {-2, -2}},       FootprintPad::BoardSide::TOP, true},
+  // layers
+  {GraphicsLayer::sBotPlacement, 0.2, false, {{-3, 0.7}, {3, 0.7}},         FootprintPad::BoardSide::TOP, false},
+  {GraphicsLayer::sBotPlacement, 0.2, false, {{-3, 0.7}, {3, 0.7}},         FootprintPad::BoardSide::BOTTOM, true},
+  {GraphicsLayer::sBotPlacement, 0.2, false, {{-3, 0.7}, {3, 0.7}},         FootprintPad::BoardSide::THT, true},
+  {GraphicsLayer::sTopPlacement, 0.2, false, {{-3, 0.7}, {3, 0.7}},         FootprintPad::BoardSide::BOTTOM, false},
+  {GraphicsLayer::sTopDocumentation, 0.2, false, {{-3, 0.7}, {3, 0.7}},     FootprintPad::BoardSide::TOP, false},
+};
+// clang-format on
+
+INSTANTIATE_TEST_CASE_P(
+    PackageCheckPadsOverlapWithPlacementTest,
+    PackageCheckPadsOverlapWithPlacementTest,
+    ::testing::ValuesIn(sPackageCheckPadsOverlapWithPlacementTestData));
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace library
+}  // namespace librepcb
@@ -0,0 +1,200 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
+#include <librepcb/library/msg/msgmissingauthor.h>
+#include <librepcb/libraryeditor/common/editorwidgetbase.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class EditorWidgetBaseTest : public ::testing::Test {
+protected:
+  /**
+   * @brief Editor which runs dummy checks in a worker thread
+   *
+   * Each check run blocks until the gate is opened and returns as many
+   * messages as runs were prepared so far, to identify the run by its result.
+   */
+  class TestEditorWidget final : public EditorWidgetBase {
+  public:
+    TestEditorWidget(const Context& context, const FilePath& fp,
+                     std::shared_ptr<QSemaphore> gate)
+      : EditorWidgetBase(context, fp), mGate(gate), mPreparedRuns(0) {}
+
+    void       modify() noexcept { undoStackStateModified(); }
+    int        getPreparedRuns() const noexcept { return mPreparedRuns; }
+    QList<int> getResults() const noexcept { return mResults; }
+
+  protected:
+    bool isInterfaceBroken() const noexcept override { return false; }
+    bool runChecks(LibraryElementCheckMessageList& msgs) const override {
+      Q_UNUSED(msgs);
+      return false;
+    }
+    std::function<LibraryElementCheckMessageList()> prepareChecks()
+        const override {
+      int                         run  = ++mPreparedRuns;
+      std::shared_ptr<QSemaphore> gate = mGate;
+      return [run, gate]() {
+        gate->acquire();
+        LibraryElementCheckMessageList msgs;
+        for (int i = 0; i < run; ++i) {
+          msgs.append(std::make_shared<MsgMissingAuthor>());
+        }
+        return msgs;
+      };
+    }
+    void setCheckMessages(
+        const LibraryElementCheckMessageList& msgs) noexcept override {
+      mResults.append(msgs.count());
+    }
+
+  private:
+    bool processCheckMessage(std::shared_ptr<const LibraryElementCheckMessage>,
+                             bool) override {
+      return false;
+    }
+
+    std::shared_ptr<QSemaphore> mGate;
+    mutable int                 mPreparedRuns;
+    QList<int>                  mResults;
+  };
+
+  FilePath                             mWsDir;
+  QScopedPointer<workspace::Workspace> mWs;
+  DefaultGraphicsLayerProvider         mLayers;
+  std::shared_ptr<QSemaphore>          mGate;
+  QScopedPointer<TestEditorWidget>     mEditor;
+
+  EditorWidgetBaseTest()
+    : mWsDir(FilePath::getRandomTempPath()),
+      mGate(std::make_shared<QSemaphore>(0)) {
+    workspace::Workspace::createNewWorkspace(mWsDir);  // can throw
+    mWs.reset(new workspace::Workspace(mWsDir));       // can throw
+    FilePath elementDir = mWsDir.getPathTo("element");
+    FileUtils::makePath(elementDir);  // can throw
+    EditorWidgetBase::Context context{*mWs, mLayers, false, true};
+    mEditor.reset(new TestEditorWidget(context, elementDir, mGate));
+  }
+
+  virtual ~EditorWidgetBaseTest() {
+    mGate->release(1000);  // don't block the destructor of the editor
+    mEditor.reset();
+    mWs.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  static bool waitUntil(const std::function<bool()>& condition,
+                        int                          timeoutMs = 5000) {
+    QElapsedTimer timer;
+    timer.start();
+    while ((!condition()) && (timer.elapsed() < timeoutMs)) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return condition();
+  }
+
+  static void processEvents(int durationMs) {
+    waitUntil([]() { return false; }, durationMs);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(EditorWidgetBaseTest, testModificationsAreDebounced) {
+  mGate->release(1000);  // don't block the checks
+  for (int i = 0; i < 10; ++i) {
+    mEditor->modify();
+  }
+  ASSERT_TRUE(waitUntil([this]() { return !mEditor->getResults().isEmpty(); }));
+  processEvents(500);  // no further runs must follow
+  EXPECT_EQ(1, mEditor->getPreparedRuns());
+  EXPECT_EQ(QList<int>{1}, mEditor->getResults());
+}
+
+TEST_F(EditorWidgetBaseTest, testNoConcurrentRuns) {
+  ASSERT_TRUE(waitUntil([this]() { return mEditor->getPreparedRuns() == 1; }));
+
+  // modifications while the checks are running must not start another run,
+  // even if the debounce timer expires in the meantime
+  mEditor->modify();
+  processEvents(500);
+  EXPECT_EQ(1, mEditor->getPreparedRuns());
+  EXPECT_TRUE(mEditor->getResults().isEmpty());
+
+  // as soon as the first run finished, the checks are run again
+  mGate->release(1000);
+  ASSERT_TRUE(waitUntil([this]() { return !mEditor->getResults().isEmpty(); }));
+  EXPECT_EQ(2, mEditor->getPreparedRuns());
+}
+
+TEST_F(EditorWidgetBaseTest, testOutdatedResultIsDiscarded) {
+  ASSERT_TRUE(waitUntil([this]() { return mEditor->getPreparedRuns() == 1; }));
+
+  // modify the element while the first run is still running
+  mEditor->modify();
+  mGate->release();
+  ASSERT_TRUE(waitUntil([this]() { return mEditor->getPreparedRuns() == 2; }));
+  EXPECT_TRUE(mEditor->getResults().isEmpty());
+
+  // only the result of the second run is used
+  mGate->release();
+  ASSERT_TRUE(waitUntil([this]() { return !mEditor->getResults().isEmpty(); }));
+  EXPECT_EQ(QList<int>{2}, mEditor->getResults());
+}
+
+TEST_F(EditorWidgetBaseTest, testUnmodifiedResultIsUsed) {
+  ASSERT_TRUE(waitUntil([this]() { return mEditor->getPreparedRuns() == 1; }));
+  mGate->release();
+  ASSERT_TRUE(waitUntil([this]() { return !mEditor->getResults().isEmpty(); }));
+  processEvents(500);  // no further runs must follow
+  EXPECT_EQ(1, mEditor->getPreparedRuns());
+  EXPECT_EQ(QList<int>{1}, mEditor->getResults());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace library
+}  // namespace librepcb
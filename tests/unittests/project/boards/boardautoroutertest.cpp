@@ -0,0 +1,241 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardtestfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/project/boards/boardairwiresbuilder.h>
+#include <librepcb/project/boards/boardautorouter.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/projecteditor/cmd/cmdapplyboardautorouterresult.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardAutorouterTest : public BoardTestFixture {
+protected:
+  QList<QPair<Point, Point>> getAirWires(const Board& board) const {
+    QList<QPair<Point, Point>> airWires;
+    foreach (const NetSignal* netsignal,
+             mProject->getCircuit().getNetSignals()) {
+      foreach (const auto& airWire,
+               BoardAirWiresBuilder(board, *netsignal).buildAirWires()) {
+        airWires.append(airWire);
+      }
+    }
+    return airWires;
+  }
+
+  static bool connects(const BoardAutorouter::Route& route, const Point& p1,
+                       const Point& p2) noexcept {
+    const Point& first = route.vertices.first().position;
+    const Point& last  = route.vertices.last().position;
+    return ((first == p1) && (last == p2)) || ((first == p2) && (last == p1));
+  }
+
+  static qreal getDistance(const Point& p, const Point& s1,
+                           const Point& s2) noexcept {
+    QPointF a      = s1.toMmQPointF();
+    QPointF b      = s2.toMmQPointF();
+    QPointF c      = p.toMmQPointF();
+    QPointF s      = b - a;
+    qreal   length = QPointF::dotProduct(s, s);
+    qreal   t      = 0;
+    if (length > 0) {
+      t = qBound(qreal(0), QPointF::dotProduct(c - a, s) / length, qreal(1));
+    }
+    QPointF diff = c - (a + s * t);
+    return std::sqrt(QPointF::dotProduct(diff, diff));
+  }
+
+  /// Get the netsegment containing a via at the given position
+  static const BI_NetSegment* getNetSegmentOfVia(const Board& board,
+                                                 const Point& pos) noexcept {
+    foreach (const BI_Via* via, getVias(board)) {
+      if (via->getPosition() == pos) return &via->getNetSegment();
+    }
+    return nullptr;
+  }
+
+  /// Get the UUIDs and element counts of all netsegments of a board
+  static QStringList getNetSegmentsState(const Board& board) {
+    QStringList state;
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+      state.append(QString("%1: %2 vias, %3 netpoints, %4 netlines")
+                       .arg(netsegment->getUuid().toStr())
+                       .arg(netsegment->getVias().count())
+                       .arg(netsegment->getNetPoints().count())
+                       .arg(netsegment->getNetLines().count()));
+    }
+    state.sort();
+    return state;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAutorouterTest, testAllAirWiresAreProcessed) {
+  const Board&    board = getBoard();
+  BoardAutorouter autorouter(board, BoardAutorouter::Options());
+  autorouter.run();
+  QList<QPair<Point, Point>> airWires = getAirWires(board);
+  EXPECT_EQ(airWires.count(), autorouter.getAirWireCount());
+  EXPECT_EQ(autorouter.getAirWireCount(),
+            autorouter.getRoutes().count() +
+                autorouter.getUnroutedAirWires().count());
+  EXPECT_GE(autorouter.getIterationCount(), 1);
+  EXPECT_LE(autorouter.getIterationCount(),
+            autorouter.getOptions().maxIterations);
+  foreach (const BoardAutorouter::Route& route, autorouter.getRoutes()) {
+    ASSERT_GE(route.vertices.count(), 2);
+    bool found = false;
+    foreach (const auto& airWire, airWires) {
+      found = found || connects(route, airWire.first, airWire.second);
+    }
+    EXPECT_TRUE(found);
+  }
+}
+
+TEST_F(BoardAutorouterTest, testAbortLeavesAirWiresUnrouted) {
+  BoardAutorouter autorouter(getBoard(), BoardAutorouter::Options());
+  autorouter.prepare();
+  autorouter.abort();
+  autorouter.route();
+  EXPECT_EQ(0, autorouter.getRoutes().count());
+  EXPECT_EQ(autorouter.getAirWireCount(),
+            autorouter.getUnroutedAirWires().count());
+}
+
+TEST_F(BoardAutorouterTest, testBoardIsNotModified) {
+  const Board& board    = getBoard();
+  int          segments = board.getNetSegments().count();
+  BoardAutorouter autorouter(board, BoardAutorouter::Options());
+  autorouter.run();
+  EXPECT_EQ(segments, board.getNetSegments().count());
+}
+
+TEST_F(BoardAutorouterTest, testApplyResultUndoRedo) {
+  removeBoardOutline();
+  Point p1 = isolated();
+  Point p2 = isolated() + Point(10000000, 0);
+  addVia(getNetSignal(0), p1);
+  addVia(getNetSignal(0), p2);
+  addVia(getNetSignal(1), isolated() + Point(5000000, 0));
+
+  Board&                   board = getBoard();
+  BoardAutorouter::Options options;
+  options.gridInterval = PositiveLength(1000000);  // keep the grid small
+  options.clearance    = getClearance();
+  BoardAutorouter autorouter(board, options);
+  autorouter.run();
+  ASSERT_FALSE(autorouter.getRoutes().isEmpty());
+  QStringList stateBefore = getNetSegmentsState(board);
+  ASSERT_NE(getNetSegmentOfVia(board, p1), getNetSegmentOfVia(board, p2));
+
+  // apply the result, the vias of net 0 get connected
+  UndoStack undoStack;
+  undoStack.execCmd(new editor::CmdApplyBoardAutorouterResult(
+      board, autorouter.getRoutes(), options));
+  QStringList stateAfter = getNetSegmentsState(board);
+  EXPECT_NE(stateBefore, stateAfter);
+  const BI_NetSegment* segment = getNetSegmentOfVia(board, p1);
+  ASSERT_TRUE(segment != nullptr);
+  EXPECT_EQ(segment, getNetSegmentOfVia(board, p2));
+  EXPECT_GE(segment->getNetLines().count(), 1);
+
+  // undo restores the original netsegments
+  undoStack.undo();
+  EXPECT_EQ(stateBefore, getNetSegmentsState(board));
+  EXPECT_NE(getNetSegmentOfVia(board, p1), getNetSegmentOfVia(board, p2));
+
+  // redo adds exactly the same elements again
+  undoStack.redo();
+  EXPECT_EQ(stateAfter, getNetSegmentsState(board));
+  EXPECT_EQ(getNetSegmentOfVia(board, p1), getNetSegmentOfVia(board, p2));
+}
+
+TEST_F(BoardAutorouterTest, testRouteAroundViaOfOtherNet) {
+  removeBoardOutline();
+  Point   p1      = isolated();
+  Point   p2      = isolated() + Point(10000000, 0);
+  BI_Via& via1    = addVia(getNetSignal(0), p1);
+  BI_Via& via2    = addVia(getNetSignal(0), p2);
+  BI_Via& blocker = addVia(getNetSignal(1), isolated() + Point(5000000, 0));
+
+  BoardAutorouter::Options options;
+  options.gridInterval = PositiveLength(1000000);  // keep the grid small
+  options.clearance    = getClearance();
+  BoardAutorouter autorouter(getBoard(), options);
+  autorouter.run();
+
+  const BoardAutorouter::Route* route = nullptr;
+  foreach (const BoardAutorouter::Route& r, autorouter.getRoutes()) {
+    if (connects(r, via1.getPosition(), via2.getPosition())) {
+      route = &r;
+    }
+  }
+  ASSERT_TRUE(route != nullptr);
+  EXPECT_EQ(&getNetSignal(0), route->netSignal);
+  qreal minDistance = blocker.getSize()->toMm() / 2 +
+                      options.traceWidth->toMm() / 2 +
+                      options.clearance->toMm();
+  for (int i = 1; i < route->vertices.count(); ++i) {
+    EXPECT_GE(getDistance(blocker.getPosition(),
+                          route->vertices.at(i - 1).position,
+                          route->vertices.at(i).position),
+              minDistance - 0.001);  // 1um tolerance
+  }
+}
+
+TEST_F(BoardAutorouterTest, testTooLargeBoardThrows) {
+  removeBoardOutline();
+  addVia(getNetSignal(0), isolated());
+  addVia(getNetSignal(0), Point(500000000, 500000000));
+  BoardAutorouter autorouter(getBoard(), BoardAutorouter::Options());
+  EXPECT_THROW(autorouter.run(), Exception);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
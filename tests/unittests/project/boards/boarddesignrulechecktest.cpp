@@ -0,0 +1,264 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardtestfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_hole.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/erc/ercmsglist.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardDesignRuleCheckTest : public BoardTestFixture {
+protected:
+  static BoardDesignRuleCheck::Options noRules() noexcept {
+    BoardDesignRuleCheck::Options options;
+    options.minCopperWidth      = UnsignedLength(0);
+    options.minDrillDiameter    = UnsignedLength(0);
+    options.minAnnularRing      = UnsignedLength(0);
+    options.minOutlineClearance = UnsignedLength(0);
+    return options;
+  }
+
+  static int countViolations(const BoardDesignRuleCheck&         drc,
+                             BoardDesignRuleCheck::ViolationType type) {
+    int count = 0;
+    foreach (const BoardDesignRuleCheck::Violation& v, drc.getViolations()) {
+      if (v.type == type) ++count;
+    }
+    return count;
+  }
+
+  static QSet<QString> getViolationKeys(const BoardDesignRuleCheck& drc) {
+    QSet<QString> keys;
+    foreach (const BoardDesignRuleCheck::Violation& v, drc.getViolations()) {
+      keys.insert(QString("%1|%2|%3").arg(
+          BoardDesignRuleCheck::violationTypeToString(v.type), v.layerName,
+          v.objectKeys.join(",")));
+    }
+    return keys;
+  }
+
+  static QList<const BI_FootprintPad*> getThtPads(const Board& board) {
+    QList<const BI_FootprintPad*> pads;
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+      foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+        if ((pad->getLibPad().getBoardSide() ==
+             library::FootprintPad::BoardSide::THT) &&
+            (*pad->getLibPad().getDrillDiameter() > 0)) {
+          pads.append(pad);
+        }
+      }
+    }
+    return pads;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardDesignRuleCheckTest, testMinimumCopperWidth) {
+  Board&                        board   = getBoard();
+  BoardDesignRuleCheck::Options options = noRules();
+  options.minCopperWidth                = UnsignedLength(100000000);  // 10cm
+  board.getDesignRuleCheck().setOptions(options);
+  board.getDesignRuleCheck().execute();
+
+  int expected = board.getPlanes().count();
+  foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+    expected += netsegment->getNetLines().count();
+  }
+  EXPECT_EQ(expected,
+            countViolations(board.getDesignRuleCheck(),
+                            BoardDesignRuleCheck::ViolationType::CopperWidth));
+}
+
+TEST_F(BoardDesignRuleCheckTest, testDrillsAndAnnularRings) {
+  Board&                        board   = getBoard();
+  BoardDesignRuleCheck::Options options = noRules();
+  options.minDrillDiameter              = UnsignedLength(100000000);  // 10cm
+  options.minAnnularRing                = UnsignedLength(100000000);  // 10cm
+  board.getDesignRuleCheck().setOptions(options);
+  board.getDesignRuleCheck().execute();
+
+  int holes = board.getHoles().count();
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    holes += device->getFootprint().getLibFootprint().getHoles().count();
+  }
+  int rings = getVias(board).count() + getThtPads(board).count();
+  const BoardDesignRuleCheck& drc = board.getDesignRuleCheck();
+  EXPECT_EQ(rings + holes,
+            countViolations(
+                drc, BoardDesignRuleCheck::ViolationType::DrillDiameter));
+  EXPECT_EQ(rings, countViolations(
+                       drc, BoardDesignRuleCheck::ViolationType::AnnularRing));
+}
+
+TEST_F(BoardDesignRuleCheckTest, testCopperClearanceFindsAllPairs) {
+  // With a huge clearance, every pair of copper objects of different nets on
+  // the same layer must be reported, i.e. the broad phase must not miss any.
+  Board& board = getBoard();
+  board.getDesignRules().setCopperClearance(UnsignedLength(1000000000));  // 1m
+  board.getDesignRuleCheck().setOptions(noRules());
+  board.getDesignRuleCheck().execute();
+
+  int expected = 0;
+  foreach (const GraphicsLayer* layer, board.getLayerStack().getAllLayers()) {
+    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) continue;
+    QList<const NetSignal*> nets;  // nullptr = no net
+    foreach (const BI_Via* via, getVias(board)) {
+      nets.append(&via->getNetSignalOfNetSegment());
+    }
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+      foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+        if (netline->getLayer().getName() == layer->getName()) {
+          nets.append(&netsegment->getNetSignal());
+        }
+      }
+    }
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+      foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+        if (pad->isOnLayer(layer->getName())) {
+          nets.append(pad->getCompSigInstNetSignal());
+        }
+      }
+    }
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+      if ((*plane->getLayerName() == layer->getName()) &&
+          (!plane->getFragments().isEmpty())) {
+        nets.append(&plane->getNetSignal());
+      }
+    }
+    foreach (const BI_Polygon* polygon, board.getPolygons()) {
+      const Polygon& p = polygon->getPolygon();
+      if ((*p.getLayerName() == layer->getName()) &&
+          (p.isFilled() || (*p.getLineWidth() > 0))) {
+        nets.append(nullptr);
+      }
+    }
+    for (int i = 0; i < nets.count(); ++i) {
+      for (int k = i + 1; k < nets.count(); ++k) {
+        if ((!nets.at(i)) || (nets.at(i) != nets.at(k))) ++expected;
+      }
+    }
+  }
+  EXPECT_EQ(expected,
+            countViolations(
+                board.getDesignRuleCheck(),
+                BoardDesignRuleCheck::ViolationType::CopperClearance));
+}
+
+TEST_F(BoardDesignRuleCheckTest, testIncrementalUpdateEqualsFullCheck) {
+  Board&                        board   = getBoard();
+  BoardDesignRuleCheck::Options options = noRules();
+  options.minOutlineClearance           = UnsignedLength(1000000);  // 1mm
+  board.getDesignRules().setCopperClearance(UnsignedLength(1000000));  // 1mm
+  BoardDesignRuleCheck& drc = board.getDesignRuleCheck();
+  drc.setOptions(options);
+  drc.execute();
+  QSet<QString> initial = getViolationKeys(drc);
+
+  // without modifications, an update must not change anything
+  drc.update();
+  EXPECT_EQ(initial, getViolationKeys(drc));
+
+  // move every via onto another via or pad and compare with a full check
+  QList<Point> targets;
+  foreach (const BI_Via* via, getVias(board)) {
+    targets.append(via->getPosition());
+  }
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      targets.append(pad->getPosition());
+    }
+  }
+  QList<BI_Via*> vias;
+  foreach (BI_NetSegment* netsegment, board.getNetSegments()) {
+    foreach (BI_Via* via, netsegment->getVias()) { vias.append(via); }
+  }
+  for (int i = 0; i < vias.count(); ++i) {
+    vias.at(i)->setPosition(targets.at((i + 1) % targets.count()));
+    drc.update();
+    QSet<QString> incremental = getViolationKeys(drc);
+    drc.execute();
+    EXPECT_EQ(getViolationKeys(drc), incremental);
+  }
+}
+
+TEST_F(BoardDesignRuleCheckTest, testErcMessages) {
+  Board&                        board   = getBoard();
+  BoardDesignRuleCheck::Options options = noRules();
+  options.minDrillDiameter              = UnsignedLength(100000000);  // 10cm
+  board.getDesignRuleCheck().setOptions(options);
+  int messagesBefore = mProject->getErcMsgList().getItems().count();
+
+  board.getDesignRuleCheck().execute();
+  int violations = board.getDesignRuleCheck().getViolations().count();
+  EXPECT_EQ(messagesBefore + violations,
+            mProject->getErcMsgList().getItems().count());
+
+  // re-running must not duplicate the messages
+  board.getDesignRuleCheck().execute();
+  EXPECT_EQ(messagesBefore + violations,
+            mProject->getErcMsgList().getItems().count());
+
+  board.getDesignRuleCheck().clear();
+  EXPECT_EQ(0, board.getDesignRuleCheck().getViolations().count());
+  EXPECT_EQ(messagesBefore, mProject->getErcMsgList().getItems().count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
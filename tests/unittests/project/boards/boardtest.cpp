@@ -0,0 +1,362 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentadd.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentremove.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_hole.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/boards/items/bi_stroketext.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+#include <chrono>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief The BoardTest checks the hit-testing methods of
+ *        librepcb::project::Board
+ *
+ * The hit-testing methods use the spatial index of the graphics scene, so their
+ * results are compared against a brute-force search over all items.
+ */
+class BoardTest : public ::testing::Test {
+protected:
+  QScopedPointer<Project> mProject;
+
+  BoardTest() { mProject.reset(openProject()); }
+
+  static Project* openProject() {
+    FilePath projectFp(TEST_DATA_DIR
+                       "/unittests/librepcbproject/"
+                       "BoardPlaneFragmentsBuilderTest/test_project/"
+                       "test_project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    return new Project(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());
+  }
+
+  static QList<BI_Base*> getAllSelectableItems(const Board& board) {
+    QList<BI_Base*> items;
+    foreach (BI_Device* device, board.getDeviceInstances()) {
+      items.append(&device->getFootprint());
+      foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+        items.append(pad);
+      }
+      foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
+        items.append(text);
+      }
+    }
+    foreach (BI_NetSegment* netsegment, board.getNetSegments()) {
+      foreach (BI_Via* via, netsegment->getVias()) { items.append(via); }
+      foreach (BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+        items.append(netpoint);
+      }
+      foreach (BI_NetLine* netline, netsegment->getNetLines()) {
+        items.append(netline);
+      }
+    }
+    foreach (BI_Plane* plane, board.getPlanes()) { items.append(plane); }
+    foreach (BI_Polygon* polygon, board.getPolygons()) {
+      items.append(polygon);
+    }
+    foreach (BI_StrokeText* text, board.getStrokeTexts()) {
+      items.append(text);
+    }
+    foreach (BI_Hole* hole, board.getHoles()) { items.append(hole); }
+    return items;
+  }
+
+  /**
+   * @brief The former implementation of Board::getItemsAtScenePos()
+   */
+  static QList<BI_Base*> getItemsAtScenePosBruteForce(const Board& board,
+                                                      const Point& pos) {
+    QPointF         scenePosPx = pos.toPxQPointF();
+    QList<BI_Base*> vias, netpoints, netlines, list;
+    auto            isHit = [&scenePosPx](const BI_Base* item) {
+      return item->isSelectable() &&
+             item->getGrabAreaScenePx().contains(scenePosPx);
+    };
+    foreach (BI_NetSegment* netsegment, board.getNetSegments()) {
+      foreach (BI_Via* via, netsegment->getVias()) {
+        if (isHit(via)) vias.append(via);
+      }
+      foreach (BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+        if (isHit(netpoint)) netpoints.append(netpoint);
+      }
+      foreach (BI_NetLine* netline, netsegment->getNetLines()) {
+        if (isHit(netline)) netlines.append(netline);
+      }
+    }
+    list.append(vias);
+    list.append(netpoints);
+    list.append(netlines);
+    foreach (BI_Device* device, board.getDeviceInstances()) {
+      BI_Footprint& footprint = device->getFootprint();
+      if (isHit(&footprint)) {
+        if (footprint.getIsMirrored()) {
+          list.append(&footprint);
+        } else {
+          list.prepend(&footprint);
+        }
+      }
+      foreach (BI_FootprintPad* pad, footprint.getPads()) {
+        if (isHit(pad)) {
+          if (pad->getIsMirrored()) {
+            list.append(pad);
+          } else {
+            list.insert(qMin(1, list.count()), pad);
+          }
+        }
+      }
+      foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
+        if (isHit(text)) {
+          if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
+            list.prepend(text);
+          } else {
+            list.append(text);
+          }
+        }
+      }
+    }
+    foreach (BI_Plane* plane, board.getPlanes()) {
+      if (isHit(plane)) list.append(plane);
+    }
+    foreach (BI_Polygon* polygon, board.getPolygons()) {
+      if (isHit(polygon)) list.append(polygon);
+    }
+    foreach (BI_StrokeText* text, board.getStrokeTexts()) {
+      if (isHit(text)) list.append(text);
+    }
+    foreach (BI_Hole* hole, board.getHoles()) {
+      if (isHit(hole)) list.append(hole);
+    }
+    return list;
+  }
+
+  static QList<int> getTypes(const QList<BI_Base*>& items) {
+    QList<int> types;
+    foreach (const BI_Base* item, items) {
+      types.append(static_cast<int>(item->getType()));
+    }
+    return types;
+  }
+
+  static QList<BI_Base*> getFootprintItems(const QList<BI_Base*>& items) {
+    QList<BI_Base*> footprintItems;
+    foreach (BI_Base* item, items) {
+      const BI_StrokeText* text = dynamic_cast<BI_StrokeText*>(item);
+      if ((item->getType() == BI_Base::Type_t::Footprint) ||
+          (item->getType() == BI_Base::Type_t::FootprintPad) ||
+          (text && text->getFootprint())) {
+        footprintItems.append(item);
+      }
+    }
+    return footprintItems;
+  }
+
+  static QList<Point> getTestPositions(const Board& board) {
+    // the position of every item and a grid over the whole board
+    QList<Point> positions;
+    QRectF       boardRect;
+    foreach (BI_Base* item, getAllSelectableItems(board)) {
+      positions.append(item->getPosition());
+      boardRect = boardRect.united(item->getGrabAreaScenePx().boundingRect());
+    }
+    for (int x = 0; x <= 20; ++x) {
+      for (int y = 0; y <= 20; ++y) {
+        positions.append(
+            Point::fromPx(boardRect.topLeft() +
+                          QPointF(boardRect.width() * x / 20,
+                                  boardRect.height() * y / 20)));
+      }
+    }
+    return positions;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+// Benchmark only, disabled by default to not slow down the unit tests. Run it
+// with --gtest_also_run_disabled_tests --gtest_filter=*Performance.
+TEST_F(BoardTest, DISABLED_testLoadingPerformance) {
+  std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < 5; ++i) {
+    QScopedPointer<Project> project(openProject());
+    EXPECT_EQ(mProject->getBoards().count(), project->getBoards().count());
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed_seconds = end - start;
+  std::cout << "Needed " << elapsed_seconds.count()
+            << "s to load the project 5 times\n";
+}
+
+TEST_F(BoardTest, testGetItemsAtScenePos) {
+  Board& board = *mProject->getBoards().first();
+  foreach (const Point& pos, getTestPositions(board)) {
+    QList<BI_Base*> expected = getItemsAtScenePosBruteForce(board, pos);
+    QList<BI_Base*> actual   = board.getItemsAtScenePos(pos);
+    EXPECT_EQ(expected.toSet(), actual.toSet());
+    // The order of items of the same type does not matter, except for the
+    // footprints, pads and footprint texts since they are prepended or
+    // inserted after each other (e.g. each pad right after its footprint).
+    EXPECT_EQ(getTypes(expected), getTypes(actual));
+    EXPECT_EQ(getFootprintItems(expected), getFootprintItems(actual));
+  }
+}
+
+TEST_F(BoardTest, testGetNetLinesAtScenePos) {
+  Board& board = *mProject->getBoards().first();
+  foreach (const Point& pos, getTestPositions(board)) {
+    QSet<BI_NetLine*> expected;
+    foreach (BI_NetSegment* netsegment, board.getNetSegments()) {
+      foreach (BI_NetLine* netline, netsegment->getNetLines()) {
+        if (netline->isSelectable() &&
+            netline->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+          expected.insert(netline);
+        }
+      }
+    }
+    EXPECT_EQ(expected,
+              board.getNetLinesAtScenePos(pos, nullptr, nullptr).toSet());
+  }
+}
+
+TEST_F(BoardTest, testSetSelectionRect) {
+  Board&       board     = *mProject->getBoards().first();
+  QList<Point> positions = getTestPositions(board);
+  for (int i = 1; i < positions.count(); ++i) {
+    Point  p1     = positions.at(i - 1);
+    Point  p2     = positions.at(i);
+    QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    board.setSelectionRect(p1, p2, true);
+
+    auto isInRect = [&rectPx](const BI_Base& item) {
+      return item.isSelectable() &&
+             item.getGrabAreaScenePx().intersects(rectPx);
+    };
+    foreach (BI_Base* item, getAllSelectableItems(board)) {
+      // pads and texts of selected footprints are selected too
+      bool expected = isInRect(*item);
+      if (const BI_FootprintPad* pad = dynamic_cast<BI_FootprintPad*>(item)) {
+        expected = expected || isInRect(pad->getFootprint());
+      } else if (const BI_StrokeText* text =
+                     dynamic_cast<BI_StrokeText*>(item)) {
+        if (text->getFootprint()) {
+          expected = expected || isInRect(*text->getFootprint());
+        }
+      }
+      EXPECT_EQ(expected, item->isSelected());
+    }
+  }
+  board.setSelectionRect(Point(), Point(), false);
+}
+
+TEST_F(BoardTest, testMemoryUsageOfRemoveCommand) {
+  Board& board = *mProject->getBoards().first();
+  ASSERT_FALSE(board.getNetSegments().isEmpty());
+  BI_NetSegment& netsegment = *board.getNetSegments().first();
+  qint64         itemUsage  = netsegment.getMemoryUsage();
+  EXPECT_GT(itemUsage, qint64(sizeof(BI_NetSegment)));
+
+  // the removed net segment is only accounted while the command is executed
+  CmdBoardNetSegmentRemove cmd(netsegment);
+  qint64                   cmdUsage = cmd.getMemoryUsage();
+  cmd.execute();
+  EXPECT_EQ(cmdUsage + itemUsage, cmd.getMemoryUsage());
+  cmd.undo();
+  EXPECT_EQ(cmdUsage, cmd.getMemoryUsage());
+}
+
+TEST_F(BoardTest, testRemoveCommandDeletesRemovedItem) {
+  Board& board = *mProject->getBoards().first();
+  ASSERT_FALSE(board.getNetSegments().isEmpty());
+  QPointer<BI_NetSegment> netsegment = board.getNetSegments().first();
+
+  // undone command -> the board still owns the item
+  {
+    CmdBoardNetSegmentRemove cmd(*netsegment);
+    cmd.execute();
+    cmd.undo();
+  }
+  ASSERT_FALSE(netsegment.isNull());
+  EXPECT_TRUE(board.getNetSegments().contains(netsegment.data()));
+
+  // executed command -> the command owns the item
+  {
+    CmdBoardNetSegmentRemove cmd(*netsegment);
+    cmd.execute();
+    EXPECT_FALSE(netsegment.isNull());
+  }
+  EXPECT_TRUE(netsegment.isNull());
+}
+
+TEST_F(BoardTest, testReAddedItemIsNotDeleted) {
+  Board& board = *mProject->getBoards().first();
+  ASSERT_FALSE(board.getNetSegments().isEmpty());
+  QPointer<BI_NetSegment> netsegment = board.getNetSegments().first();
+  {
+    CmdBoardNetSegmentRemove cmdRemove(*netsegment);
+    CmdBoardNetSegmentAdd    cmdAdd(*netsegment);
+    cmdRemove.execute();
+    cmdAdd.execute();
+  }
+  ASSERT_FALSE(netsegment.isNull());
+  EXPECT_TRUE(board.getNetSegments().contains(netsegment.data()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
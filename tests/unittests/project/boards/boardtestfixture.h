@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef LIBREPCB_PROJECT_TESTS_BOARDTESTFIXTURE_H
+#define LIBREPCB_PROJECT_TESTS_BOARDTESTFIXTURE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Class BoardTestFixture
+ ******************************************************************************/
+
+/**
+ * @brief Test fixture providing the (read-only) board test project
+ */
+class BoardTestFixture : public ::testing::Test {
+protected:
+  QScopedPointer<Project> mProject;
+
+  BoardTestFixture() {
+    FilePath projectFp(TEST_DATA_DIR
+                       "/unittests/librepcbproject/"
+                       "BoardPlaneFragmentsBuilderTest/test_project/"
+                       "test_project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    mProject.reset(new Project(std::unique_ptr<TransactionalDirectory>(
+                                   new TransactionalDirectory(projectFs)),
+                               projectFp.getFilename()));
+  }
+
+  Board& getBoard() const { return *mProject->getBoards().first(); }
+
+  NetSignal& getNetSignal(int index) const {
+    return *mProject->getCircuit().getNetSignals().values().value(index);
+  }
+
+  /// The copper clearance of the design rules of the first board
+  UnsignedLength getClearance() const {
+    return getBoard().getDesignRules().getCopperClearance();
+  }
+
+  /// Add vias in a new net segment of the first board
+  QList<BI_Via*> addVias(NetSignal& netsignal, const QList<Point>& positions) {
+    QScopedPointer<BI_NetSegment> segment(
+        new BI_NetSegment(getBoard(), netsignal));
+    QList<BI_Via*> vias;
+    foreach (const Point& pos, positions) {
+      vias.append(new BI_Via(*segment, pos, BI_Via::Shape::Round,
+                             PositiveLength(500000), PositiveLength(250000)));
+    }
+    segment->addElements(vias, {}, {});
+    getBoard().addNetSegment(*segment.take());
+    return vias;
+  }
+
+  /// Add a via in a new net segment of the first board
+  BI_Via& addVia(NetSignal& netsignal, const Point& pos) {
+    return *addVias(netsignal, {pos}).first();
+  }
+
+  /// Remove the board outline to allow routing far away from everything
+  void removeBoardOutline() {
+    foreach (BI_Polygon* polygon, getBoard().getPolygons()) {
+      if (*polygon->getPolygon().getLayerName() ==
+          GraphicsLayer::sBoardOutlines) {
+        getBoard().removePolygon(*polygon);
+        delete polygon;
+      }
+    }
+  }
+
+  static QList<const BI_Via*> getVias(const Board& board) {
+    QList<const BI_Via*> vias;
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+      foreach (const BI_Via* via, netsegment->getVias()) { vias.append(via); }
+    }
+    return vias;
+  }
+
+  /// A location far away from all objects of the test project
+  static Point isolated() noexcept { return Point(-500000000, -500000000); }
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_TESTS_BOARDTESTFIXTURE_H
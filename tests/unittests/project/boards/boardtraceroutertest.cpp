@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardtestfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardtracerouter.h>
+
+#include <QtCore>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardTraceRouterTest : public BoardTestFixture {
+protected:
+  static const QString& layer() noexcept { return GraphicsLayer::sTopCopper; }
+  static PositiveLength width() noexcept { return PositiveLength(300000); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardTraceRouterTest, testViasOfOtherNetsAreObstacles) {
+  const Board& board = getBoard();
+  ASSERT_FALSE(getVias(board).isEmpty());
+  foreach (const BI_Via* via, getVias(board)) {
+    const NetSignal& net   = via->getNetSignalOfNetSegment();
+    const NetSignal& other = (&net == &getNetSignal(0)) ? getNetSignal(1)
+                                                        : getNetSignal(0);
+    BoardTraceRouter router(board, layer(), other, getClearance());
+    Point            pos = via->getPosition();
+    EXPECT_FALSE(router.isFree(pos, pos, width()));
+  }
+}
+
+TEST_F(BoardTraceRouterTest, testOwnNetIsNoObstacle) {
+  const BI_Via& via   = addVia(getNetSignal(0), isolated());
+  const Board&  board = getBoard();
+  BoardTraceRouter router(board, layer(), getNetSignal(0), getClearance());
+  Point            pos = via.getPosition();
+  EXPECT_TRUE(router.isFree(pos - Point(1000000, 0), pos, width()));
+}
+
+TEST_F(BoardTraceRouterTest, testHugObstacle) {
+  const BI_Via& via   = addVia(getNetSignal(0), isolated());
+  const Board&  board = getBoard();
+  BoardTraceRouter router(board, layer(), getNetSignal(1), getClearance());
+
+  // route straight towards the via, the trace must stop right in front of it
+  Point                    start = via.getPosition() - Point(5000000, 0);
+  BoardTraceRouter::Result result =
+      router.route(start, {start}, via.getPosition(), width());
+  Length distance = via.getPosition().getX() - result.endPoint.getX();
+  Length expected = *via.getSize() / 2 + *width() / 2 + *getClearance();
+  EXPECT_TRUE(result.blocked);
+  EXPECT_EQ(start, result.middlePoint);
+  EXPECT_EQ(via.getPosition().getY(), result.endPoint.getY());
+  EXPECT_GE(distance, expected);
+  EXPECT_LE(distance, expected + Length(2000));  // 2um tolerance
+  EXPECT_TRUE(router.isFree(start, result.endPoint, width()));
+}
+
+TEST_F(BoardTraceRouterTest, testWalkAroundObstacle) {
+  const BI_Via& via   = addVia(getNetSignal(0), isolated());
+  const Board&  board = getBoard();
+  BoardTraceRouter router(board, layer(), getNetSignal(1), getClearance());
+
+  // the straight path through the via collides, thus the detour is taken
+  Point start  = via.getPosition() + Point(-3000000, 0);
+  Point end    = via.getPosition() + Point(3000000, 0);
+  Point detour = via.getPosition() + Point(-3000000, 3000000);
+  BoardTraceRouter::Result result =
+      router.route(start, {start, detour}, end, width());
+  EXPECT_FALSE(result.blocked);
+  EXPECT_EQ(detour, result.middlePoint);
+  EXPECT_EQ(end, result.endPoint);
+}
+
+TEST_F(BoardTraceRouterTest, testRoutingLatencyOnDenseBoard) {
+  // add a grid of 100x100 vias with a pitch of 1mm, alternating two nets
+  QList<Point> positions1, positions2;
+  for (int x = 0; x < 100; ++x) {
+    for (int y = 0; y < 100; ++y) {
+      Point pos = isolated() + Point(x * 1000000, y * 1000000);
+      (((x + y) % 2) ? positions2 : positions1).append(pos);
+    }
+  }
+  addVias(getNetSignal(0), positions1);
+  addVias(getNetSignal(1), positions2);
+  const Board& board = getBoard();
+
+  QElapsedTimer timer;
+  timer.start();
+  BoardTraceRouter router(board, layer(), getNetSignal(0), getClearance());
+  qint64           collectionMs = timer.elapsed();
+  EXPECT_GE(router.getObstacleCount(), positions2.count());
+
+  // move the cursor around like a user would do
+  const int count = 1000;
+  Point     start = isolated() + Point(50000000, 50000000);
+  timer.restart();
+  for (int i = 0; i < count; ++i) {
+    Point cursor = isolated() + Point((i * 37 % 100) * 1000000 + 500000,
+                                      (i * 53 % 100) * 1000000 + 500000);
+    Point middle(cursor.getX(), start.getY());
+    router.route(start, {middle, start}, cursor, width());
+  }
+  qint64 averageUs = timer.nsecsElapsed() / count / 1000;
+
+  // To fit into one frame at 60 FPS, a route should take less than 16ms. The
+  // limits are much more generous since the timing depends on the machine
+  // (e.g. debug builds on a loaded CI server), but they still catch severe
+  // performance regressions.
+  std::cout << "Needed " << collectionMs << "ms to collect "
+            << router.getObstacleCount() << " obstacles and " << averageUs
+            << "us per route on average" << std::endl;
+  EXPECT_LT(collectionMs, 10000);
+  EXPECT_LT(averageUs, 100000);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
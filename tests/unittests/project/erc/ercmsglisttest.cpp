@@ -0,0 +1,181 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/project/erc/ercmsg.h>
+#include <librepcb/project/erc/ercmsglist.h>
+#include <librepcb/project/erc/if_ercmsgprovider.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ErcMsgListTest : public ::testing::Test {
+protected:
+  class TestOwner final : public IF_ErcMsgProvider {
+    DECLARE_ERC_MSG_CLASS_NAME(TestOwner)
+  };
+
+  FilePath  mProjectDir;
+  FilePath  mProjectFile;
+  TestOwner mOwner;
+
+  ErcMsgListTest() {
+    mProjectDir  = FilePath::getRandomTempPath().getPathTo("project");
+    mProjectFile = mProjectDir.getPathTo("project.lpp");
+
+    // create an empty project
+    QScopedPointer<Project> project(
+        Project::create(createDir(), mProjectFile.getFilename()));
+    project->save();
+    project->getDirectory().getFileSystem()->save();
+  }
+
+  virtual ~ErcMsgListTest() {
+    QDir(mProjectDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  std::unique_ptr<TransactionalDirectory> createDir() const noexcept {
+    return std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+        TransactionalFileSystem::openRW(mProjectDir)));
+  }
+
+  Project* openProject() const {
+    return new Project(createDir(), mProjectFile.getFilename());
+  }
+
+  void saveProject(Project& project) const {
+    project.save();
+    project.getDirectory().getFileSystem()->save();
+  }
+
+  FilePath getErcFilePath() const noexcept {
+    return mProjectDir.getPathTo("circuit/erc.lp");
+  }
+
+  void writeApproval(const QString& ownerKey, const QString& msgKey) const {
+    SExpression  root = SExpression::createList("librepcb_erc");
+    SExpression& node = root.appendList("approved", true);
+    node.appendChild("class", QString("TestOwner"), true);
+    node.appendChild("instance", ownerKey, true);
+    node.appendChild("message", msgKey, true);
+    FileUtils::writeFile(getErcFilePath(), root.toByteArray());
+  }
+
+  QStringList readApprovals() const {
+    SExpression root = SExpression::parse(FileUtils::readFile(getErcFilePath()),
+                                          getErcFilePath());
+    QStringList approvals;
+    foreach (const SExpression& node, root.getChildren("approved")) {
+      approvals.append(node.getValueByPath<QString>("class") % "|" %
+                       node.getValueByPath<QString>("instance") % "|" %
+                       node.getValueByPath<QString>("message"));
+    }
+    return approvals;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ErcMsgListTest, testApprovalOfUnseenMessageSurvivesSaveAndLoad) {
+  writeApproval("owner", "msg");
+
+  // open and save the project twice, without the message ever appearing
+  for (int i = 0; i < 2; ++i) {
+    QScopedPointer<Project> project(openProject());
+    saveProject(*project);
+    project.reset();
+    EXPECT_TRUE(readApprovals().contains("TestOwner|owner|msg"));
+  }
+}
+
+TEST_F(ErcMsgListTest, testApprovalIsAppliedWhenMessageAppearsFirstTime) {
+  writeApproval("owner", "msg");
+  QScopedPointer<Project> project(openProject());
+
+  // messages appearing after loading the project (e.g. from the DRC) are
+  // approved by the loaded approvals
+  ErcMsg msg(*project, mOwner, "owner", "msg",
+             ErcMsg::ErcMsgType_t::BoardError);
+  msg.setVisible(true);
+  EXPECT_TRUE(msg.isIgnored());
+  saveProject(*project);
+  EXPECT_TRUE(readApprovals().contains("TestOwner|owner|msg"));
+
+  // showing the message again resets its ignore state
+  msg.setVisible(false);
+  msg.setVisible(true);
+  EXPECT_FALSE(msg.isIgnored());
+  saveProject(*project);
+  EXPECT_FALSE(readApprovals().contains("TestOwner|owner|msg"));
+}
+
+TEST_F(ErcMsgListTest, testDisapprovedMessageIsNotSaved) {
+  writeApproval("owner", "msg");
+  QScopedPointer<Project> project(openProject());
+
+  ErcMsg msg(*project, mOwner, "owner", "msg",
+             ErcMsg::ErcMsgType_t::BoardError);
+  msg.setVisible(true);
+  ASSERT_TRUE(msg.isIgnored());
+  msg.setIgnored(false);
+  saveProject(*project);
+  EXPECT_FALSE(readApprovals().contains("TestOwner|owner|msg"));
+}
+
+TEST_F(ErcMsgListTest, testApprovalOfOtherMessageIsNotApplied) {
+  writeApproval("owner", "msg");
+  QScopedPointer<Project> project(openProject());
+
+  ErcMsg msg(*project, mOwner, "other owner", "msg",
+             ErcMsg::ErcMsgType_t::BoardError);
+  msg.setVisible(true);
+  EXPECT_FALSE(msg.isIgnored());
+  saveProject(*project);
+  EXPECT_TRUE(readApprovals().contains("TestOwner|owner|msg"));
+  EXPECT_FALSE(readApprovals().contains("TestOwner|other owner|msg"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
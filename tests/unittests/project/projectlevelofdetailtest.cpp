@@ -0,0 +1,272 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boards/boardtestfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/graphicsitems/bgi_footprint.h>
+#include <librepcb/project/boards/graphicsitems/bgi_footprintpad.h>
+#include <librepcb/project/boards/graphicsitems/bgi_via.h>
+#include <librepcb/project/schematics/graphicsitems/sgi_symbol.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/schematiclayerprovider.h>
+
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Helper Classes
+ ******************************************************************************/
+
+/**
+ * @brief Paint device which only counts the draw calls of a QPainter
+ */
+class DrawCallCounter final : public QPaintDevice {
+public:
+  int paths  = 0;
+  int rects  = 0;
+  int texts  = 0;
+  int others = 0;
+
+  DrawCallCounter() : mEngine(*this) {}
+
+  QPaintEngine* paintEngine() const override { return &mEngine; }
+
+protected:
+  int metric(PaintDeviceMetric metric) const override {
+    switch (metric) {
+      case PdmWidth:
+      case PdmHeight:
+        return 100000;
+      case PdmWidthMM:
+      case PdmHeightMM:
+        return 1000;
+      case PdmDpiX:
+      case PdmDpiY:
+      case PdmPhysicalDpiX:
+      case PdmPhysicalDpiY:
+        return 96;
+      case PdmDepth:
+        return 32;
+      default:
+        return QPaintDevice::metric(metric);
+    }
+  }
+
+private:
+  class Engine final : public QPaintEngine {
+  public:
+    explicit Engine(DrawCallCounter& c) : QPaintEngine(AllFeatures), mC(c) {}
+    bool begin(QPaintDevice*) override { return true; }
+    bool end() override { return true; }
+    void updateState(const QPaintEngineState&) override {}
+    Type type() const override { return User; }
+    void drawPath(const QPainterPath&) override { ++mC.paths; }
+    void drawRects(const QRect*, int count) override { mC.rects += count; }
+    void drawRects(const QRectF*, int count) override { mC.rects += count; }
+    void drawTextItem(const QPointF&, const QTextItem&) override { ++mC.texts; }
+    void drawEllipse(const QRectF&) override { ++mC.others; }
+    void drawLines(const QLineF*, int) override { ++mC.others; }
+    void drawPolygon(const QPointF*, int, PolygonDrawMode) override {
+      ++mC.others;
+    }
+    void drawPixmap(const QRectF&, const QPixmap&, const QRectF&) override {
+      ++mC.others;
+    }
+
+  private:
+    DrawCallCounter& mC;
+  };
+
+  mutable Engine mEngine;
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief Checks the level of detail of the board and schematic graphics items
+ *
+ * The items are painted with a large scale (all details) and a tiny scale
+ * (below librepcb::LevelOfDetail::sMinDetailSizePx) onto a device which only
+ * counts the draw calls.
+ */
+class ProjectLevelOfDetailTest : public BoardTestFixture {
+protected:
+  static constexpr qreal sDetailedScale = 100;
+  static constexpr qreal sTinyScale     = 0.01;
+
+  ProjectLevelOfDetailTest() {
+    foreach (GraphicsLayer* layer, getBoard().getLayerStack().getAllLayers()) {
+      layer->setVisible(true);
+    }
+    foreach (GraphicsLayer* layer, mProject->getLayers().getAllLayers()) {
+      layer->setVisible(true);
+    }
+  }
+
+  Schematic& getSchematic() const {
+    if (mProject->getSchematics().isEmpty()) {
+      throw LogicError(__FILE__, __LINE__, "Test project has no schematic.");
+    }
+    return *mProject->getSchematics().first();
+  }
+
+  template <typename T>
+  static QList<T*> getItems(const GraphicsScene& scene) {
+    QList<T*> items;
+    foreach (QGraphicsItem* item, scene.items()) {
+      if (T* casted = dynamic_cast<T*>(item)) {
+        items.append(casted);
+      }
+    }
+    return items;
+  }
+
+  static void paint(QGraphicsItem& item, qreal scale,
+                    DrawCallCounter& counter) {
+    QPainter painter(&counter);
+    painter.scale(scale, scale);
+    QStyleOptionGraphicsItem option;
+    item.paint(&painter, &option, nullptr);
+  }
+
+  static void render(GraphicsScene& scene, qreal scale,
+                     DrawCallCounter& counter) {
+    QPainter painter(&counter);
+    QRectF   source = scene.itemsBoundingRect();
+    QRectF   target(QPointF(0, 0), source.size() * scale);
+    scene.render(&painter, target, source);
+  }
+};
+
+constexpr qreal ProjectLevelOfDetailTest::sDetailedScale;
+constexpr qreal ProjectLevelOfDetailTest::sTinyScale;
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ProjectLevelOfDetailTest, testVia) {
+  addVia(getNetSignal(0), Point(0, 0));
+  QList<BGI_Via*> vias = getItems<BGI_Via>(getBoard().getGraphicsScene());
+  ASSERT_FALSE(vias.isEmpty());
+  foreach (BGI_Via* via, vias) {
+    DrawCallCounter detailed;
+    paint(*via, sDetailedScale, detailed);
+    EXPECT_GT(detailed.paths, 0);
+    EXPECT_GT(detailed.texts, 0);  // net name
+
+    DrawCallCounter tiny;
+    paint(*via, sTinyScale, tiny);
+    EXPECT_EQ(0, tiny.paths);
+    EXPECT_EQ(0, tiny.texts);
+    EXPECT_EQ(1, tiny.rects);  // simplified proxy
+  }
+}
+
+TEST_F(ProjectLevelOfDetailTest, testFootprintPad) {
+  QList<BGI_FootprintPad*> pads =
+      getItems<BGI_FootprintPad>(getBoard().getGraphicsScene());
+  ASSERT_FALSE(pads.isEmpty());
+  foreach (BGI_FootprintPad* pad, pads) {
+    DrawCallCounter detailed;
+    paint(*pad, sDetailedScale, detailed);
+    EXPECT_GT(detailed.paths, 0);
+
+    DrawCallCounter tiny;
+    paint(*pad, sTinyScale, tiny);
+    EXPECT_EQ(0, tiny.paths);
+    EXPECT_EQ(0, tiny.texts);
+    EXPECT_EQ(1, tiny.rects);  // simplified proxy
+  }
+}
+
+TEST_F(ProjectLevelOfDetailTest, testFootprint) {
+  QList<BGI_Footprint*> footprints =
+      getItems<BGI_Footprint>(getBoard().getGraphicsScene());
+  ASSERT_FALSE(footprints.isEmpty());
+  foreach (BGI_Footprint* footprint, footprints) {
+    // the pads and texts are separate items, so nothing is left to draw
+    DrawCallCounter tiny;
+    paint(*footprint, sTinyScale, tiny);
+    EXPECT_EQ(0, tiny.paths + tiny.rects + tiny.texts + tiny.others);
+  }
+}
+
+TEST_F(ProjectLevelOfDetailTest, testSymbol) {
+  QList<SGI_Symbol*> symbols =
+      getItems<SGI_Symbol>(getSchematic().getGraphicsScene());
+  ASSERT_FALSE(symbols.isEmpty());
+  foreach (SGI_Symbol* symbol, symbols) {
+    DrawCallCounter detailed;
+    paint(*symbol, sDetailedScale, detailed);
+    EXPECT_GT(detailed.paths + detailed.others, 0);
+    EXPECT_GT(detailed.texts, 0);  // e.g. name and value
+
+    DrawCallCounter tiny;
+    paint(*symbol, sTinyScale, tiny);
+    EXPECT_EQ(0, tiny.paths);
+    EXPECT_EQ(0, tiny.texts);
+    EXPECT_EQ(1, tiny.rects);  // simplified proxy
+  }
+}
+
+TEST_F(ProjectLevelOfDetailTest, testLargeScene) {
+  QList<Point> positions;
+  for (int x = 0; x < 100; ++x) {
+    for (int y = 0; y < 100; ++y) {
+      positions.append(isolated() + Point::fromMm(x, y));
+    }
+  }
+  addVias(getNetSignal(0), positions);
+
+  DrawCallCounter detailed;
+  render(getBoard().getGraphicsScene(), sDetailedScale, detailed);
+  EXPECT_GE(detailed.paths, positions.count());
+  EXPECT_GE(detailed.texts, positions.count());  // net names of the vias
+
+  // zoomed out, each via is only a rect and the expensive calls are gone
+  DrawCallCounter tiny;
+  render(getBoard().getGraphicsScene(), sTinyScale, tiny);
+  EXPECT_GE(tiny.rects, positions.count());
+  EXPECT_LT(tiny.paths + tiny.texts, positions.count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
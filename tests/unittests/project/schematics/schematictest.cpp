@@ -0,0 +1,304 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/toolbox.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/items/si_netlabel.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netsegment.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/items/si_symbolpin.h>
+#include <librepcb/project/schematics/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief The SchematicTest checks the hit-testing methods of
+ *        librepcb::project::Schematic
+ *
+ * The hit-testing methods use the spatial index of the graphics scene, so their
+ * results are compared against the former brute-force search over all items.
+ */
+class SchematicTest : public ::testing::Test {
+protected:
+  QScopedPointer<Project> mProject;
+
+  SchematicTest() {
+    FilePath projectFp(TEST_DATA_DIR
+                       "/unittests/librepcbproject/"
+                       "BoardPlaneFragmentsBuilderTest/test_project/"
+                       "test_project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    mProject.reset(new Project(std::unique_ptr<TransactionalDirectory>(
+                                   new TransactionalDirectory(projectFs)),
+                               projectFp.getFilename()));
+  }
+
+  Schematic& getSchematic() const {
+    if (mProject->getSchematics().isEmpty()) {
+      throw LogicError(__FILE__, __LINE__, "Test project has no schematic.");
+    }
+    return *mProject->getSchematics().first();
+  }
+
+  static QList<SI_Base*> getAllItems(const Schematic& schematic) {
+    QList<SI_Base*> items;
+    foreach (SI_Symbol* symbol, schematic.getSymbols()) {
+      items.append(symbol);
+      foreach (SI_SymbolPin* pin, symbol->getPins()) { items.append(pin); }
+    }
+    foreach (SI_NetSegment* netsegment, schematic.getNetSegments()) {
+      foreach (SI_NetPoint* netpoint, netsegment->getNetPoints()) {
+        items.append(netpoint);
+      }
+      foreach (SI_NetLine* netline, netsegment->getNetLines()) {
+        items.append(netline);
+      }
+      foreach (SI_NetLabel* netlabel, netsegment->getNetLabels()) {
+        items.append(netlabel);
+      }
+    }
+    return items;
+  }
+
+  static QList<Point> getTestPositions(const Schematic& schematic) {
+    // the position of every item and a grid over the whole schematic
+    QList<Point> positions;
+    QRectF       schematicRect;
+    foreach (SI_Base* item, getAllItems(schematic)) {
+      positions.append(item->getPosition());
+      schematicRect =
+          schematicRect.united(item->getGrabAreaScenePx().boundingRect());
+    }
+    for (int x = 0; x <= 20; ++x) {
+      for (int y = 0; y <= 20; ++y) {
+        positions.append(
+            Point::fromPx(schematicRect.topLeft() +
+                          QPointF(schematicRect.width() * x / 20,
+                                  schematicRect.height() * y / 20)));
+      }
+    }
+    return positions;
+  }
+
+  /**
+   * @brief The former implementation of Schematic::getItemsAtScenePos()
+   */
+  static QList<SI_Base*> getItemsAtScenePosBruteForce(
+      const Schematic& schematic, const Point& pos) {
+    QPointF         scenePosPx = pos.toPxQPointF();
+    QList<SI_Base*> netpoints, netlines, netlabels, list;
+    foreach (SI_NetSegment* netsegment, schematic.getNetSegments()) {
+      foreach (SI_NetPoint* netpoint, netsegment->getNetPoints()) {
+        if (netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
+          netpoints.append(netpoint);
+        }
+      }
+      foreach (SI_NetLine* netline, netsegment->getNetLines()) {
+        if (netline->getGrabAreaScenePx().contains(scenePosPx)) {
+          netlines.append(netline);
+        }
+      }
+      foreach (SI_NetLabel* netlabel, netsegment->getNetLabels()) {
+        if (netlabel->getGrabAreaScenePx().contains(scenePosPx)) {
+          netlabels.append(netlabel);
+        }
+      }
+    }
+    foreach (SI_Base* item, netpoints) {
+      if (static_cast<SI_NetPoint*>(item)->isVisibleJunction()) {
+        list.append(item);
+      }
+    }
+    foreach (SI_Base* item, netpoints) {
+      if (!static_cast<SI_NetPoint*>(item)->isVisibleJunction()) {
+        list.append(item);
+      }
+    }
+    list.append(netlines);
+    list.append(netlabels);
+    foreach (SI_Symbol* symbol, schematic.getSymbols()) {
+      foreach (SI_SymbolPin* pin, symbol->getPins()) {
+        if (pin->getGrabAreaScenePx().contains(scenePosPx)) list.append(pin);
+      }
+      if (symbol->getGrabAreaScenePx().contains(scenePosPx)) {
+        list.append(symbol);
+      }
+    }
+    return list;
+  }
+
+  /**
+   * @brief Get the priority of an item in Schematic::getItemsAtScenePos()
+   */
+  static int getPriority(const SI_Base& item) {
+    switch (item.getType()) {
+      case SI_Base::Type_t::NetPoint:
+        return static_cast<const SI_NetPoint&>(item).isVisibleJunction() ? 0
+                                                                          : 1;
+      case SI_Base::Type_t::NetLine:
+        return 2;
+      case SI_Base::Type_t::NetLabel:
+        return 3;
+      case SI_Base::Type_t::SymbolPin:
+        return 4;
+      case SI_Base::Type_t::Symbol:
+        return 5;
+      default:
+        return 6;
+    }
+  }
+
+  static QList<int> getPriorities(const QList<SI_Base*>& items) {
+    QList<int> priorities;
+    foreach (const SI_Base* item, items) {
+      priorities.append(getPriority(*item));
+    }
+    return priorities;
+  }
+
+  static Length getDistance(const SI_Base& item, const Point& pos) {
+    if (item.getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      return Length(0);
+    } else if (item.getType() == SI_Base::Type_t::NetLine) {
+      const SI_NetLine& netline = static_cast<const SI_NetLine&>(item);
+      return Toolbox::shortestDistanceBetweenPointAndLine(
+          pos, netline.getStartPoint().getPosition(),
+          netline.getEndPoint().getPosition());
+    } else {
+      return (item.getPosition() - pos).getLength();
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SchematicTest, testGetItemsAtScenePos) {
+  Schematic& schematic = getSchematic();
+  foreach (const Point& pos, getTestPositions(schematic)) {
+    QList<SI_Base*> expected = getItemsAtScenePosBruteForce(schematic, pos);
+    QList<SI_Base*> actual   = schematic.getItemsAtScenePos(pos);
+    EXPECT_EQ(expected.toSet(), actual.toSet());
+    // The order of items with the same priority does not matter, but all
+    // pins must be returned before the symbols (the former implementation
+    // returned each pin before its own symbol).
+    QList<int> expectedPriorities = getPriorities(expected);
+    std::stable_sort(expectedPriorities.begin(), expectedPriorities.end());
+    EXPECT_EQ(expectedPriorities, getPriorities(actual));
+    if (!expected.isEmpty()) {
+      EXPECT_EQ(expected.first()->getType(), actual.first()->getType());
+    }
+  }
+}
+
+TEST_F(SchematicTest, testPinsAreReturnedBeforeTheirSymbol) {
+  Schematic& schematic = getSchematic();
+  int        count     = 0;
+  foreach (SI_Symbol* symbol, schematic.getSymbols()) {
+    foreach (SI_SymbolPin* pin, symbol->getPins()) {
+      QList<SI_Base*> items = schematic.getItemsAtScenePos(pin->getPosition());
+      if (items.contains(symbol)) {
+        EXPECT_LT(items.indexOf(pin), items.indexOf(symbol));
+        ++count;
+      }
+    }
+  }
+  EXPECT_GT(count, 0);
+}
+
+TEST_F(SchematicTest, testGetPinsAtScenePos) {
+  Schematic& schematic = getSchematic();
+  foreach (const Point& pos, getTestPositions(schematic)) {
+    QSet<SI_SymbolPin*> expected;
+    foreach (SI_Symbol* symbol, schematic.getSymbols()) {
+      foreach (SI_SymbolPin* pin, symbol->getPins()) {
+        if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+          expected.insert(pin);
+        }
+      }
+    }
+    EXPECT_EQ(expected, schematic.getPinsAtScenePos(pos).toSet());
+  }
+}
+
+TEST_F(SchematicTest, testGetNetLinesAtScenePos) {
+  Schematic& schematic = getSchematic();
+  foreach (const Point& pos, getTestPositions(schematic)) {
+    QSet<SI_NetLine*> expected;
+    foreach (SI_NetSegment* netsegment, schematic.getNetSegments()) {
+      foreach (SI_NetLine* netline, netsegment->getNetLines()) {
+        if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+          expected.insert(netline);
+        }
+      }
+    }
+    EXPECT_EQ(expected, schematic.getNetLinesAtScenePos(pos).toSet());
+  }
+}
+
+TEST_F(SchematicTest, testGetItemsNearScenePos) {
+  Schematic&     schematic = getSchematic();
+  UnsignedLength maxDistance(2540000);
+  foreach (const Point& pos, getTestPositions(schematic)) {
+    QPainterPath circlePx;
+    circlePx.addEllipse(pos.toPxQPointF(), maxDistance->toPx(),
+                        maxDistance->toPx());
+    QSet<SI_Base*> expected;
+    foreach (SI_Base* item, getAllItems(schematic)) {
+      if (item->getGrabAreaScenePx().intersects(circlePx)) {
+        expected.insert(item);
+      }
+    }
+    QList<SI_Base*> actual = schematic.getItemsNearScenePos(pos, maxDistance);
+    EXPECT_EQ(expected, actual.toSet());
+    for (int i = 1; i < actual.count(); ++i) {
+      EXPECT_LE(getDistance(*actual.at(i - 1), pos),
+                getDistance(*actual.at(i), pos));
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
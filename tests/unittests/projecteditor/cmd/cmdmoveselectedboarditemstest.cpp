@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../project/boards/boardtestfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/projecteditor/cmd/cmdmoveselectedboarditems.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+namespace tests {
+
+using project::tests::BoardTestFixture;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class CmdMoveSelectedBoardItemsTest : public BoardTestFixture {
+protected:
+  /// Add selected vias on a grid far away from the rest of the board
+  QList<BI_Via*> addSelectedVias(int count) {
+    QList<Point> positions;
+    for (int i = 0; i < count; ++i) {
+      positions.append(isolated() +
+                       Point(1000000 * (i % 10), 1000000 * (i / 10)));
+    }
+    QList<BI_Via*> vias = addVias(getNetSignal(0), positions);
+    foreach (BI_Via* via, vias) { via->setSelected(true); }
+    return vias;
+  }
+
+  /// An offset on the board's grid
+  Point getOffset() const {
+    const Length interval = *getBoard().getGridProperties().getInterval();
+    return Point(interval * 10, interval * 5);
+  }
+
+  static QGraphicsItem* getGraphicsItem(const BI_Base& item) {
+    foreach (QGraphicsItem* graphicsItem,
+             item.getBoard().getGraphicsScene().items()) {
+      if (BI_Base::fromGraphicsItem(*graphicsItem) == &item) {
+        return graphicsItem;
+      }
+    }
+    throw LogicError(__FILE__, __LINE__, "Graphics item not found.");
+  }
+
+  static QHash<BI_Via*, Point> getPositions(const QList<BI_Via*>& vias) {
+    QHash<BI_Via*, Point> positions;
+    foreach (BI_Via* via, vias) { positions.insert(via, via->getPosition()); }
+    return positions;
+  }
+
+  /// Check the items and their graphics items, which must be at the same place
+  static void expectPositions(const QHash<BI_Via*, Point>& positions,
+                              const Point&                 offset) {
+    for (auto it = positions.begin(); it != positions.end(); ++it) {
+      EXPECT_EQ(it.value() + offset, it.key()->getPosition());
+      EXPECT_EQ(Point(0, 0), it.key()->getPreviewOffset());
+      EXPECT_EQ((it.value() + offset).toPxQPointF(),
+                getGraphicsItem(*it.key())->pos());
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(CmdMoveSelectedBoardItemsTest, testPreviewOfLargeSelection) {
+  QList<BI_Via*>        vias      = addSelectedVias(100);
+  QHash<BI_Via*, Point> positions = getPositions(vias);
+  Point                 offset    = getOffset();
+  Point                 startPos  = vias.first()->getPosition();
+
+  // while dragging, only the graphics items are moved
+  QScopedPointer<CmdMoveSelectedBoardItems> cmd(
+      new CmdMoveSelectedBoardItems(getBoard(), startPos));
+  cmd->setCurrentPosition(startPos + offset);
+  foreach (BI_Via* via, vias) {
+    EXPECT_EQ(positions.value(via), via->getPosition());
+    EXPECT_EQ(offset, via->getPreviewOffset());
+    EXPECT_EQ((positions.value(via) + offset).toPxQPointF(),
+              getGraphicsItem(*via)->pos());
+  }
+
+  // executing the command moves the items and drops the preview offset
+  UndoStack undoStack;
+  undoStack.execCmd(cmd.take());
+  expectPositions(positions, offset);
+
+  // undo and redo move the items without any preview offset
+  undoStack.undo();
+  expectPositions(positions, Point(0, 0));
+  undoStack.redo();
+  expectPositions(positions, offset);
+}
+
+TEST_F(CmdMoveSelectedBoardItemsTest, testAbortedPreviewOfLargeSelection) {
+  QList<BI_Via*>        vias      = addSelectedVias(100);
+  QHash<BI_Via*, Point> positions = getPositions(vias);
+  Point                 startPos  = vias.first()->getPosition();
+
+  // deleting the command without executing it restores the graphics items
+  QScopedPointer<CmdMoveSelectedBoardItems> cmd(
+      new CmdMoveSelectedBoardItems(getBoard(), startPos));
+  cmd->setCurrentPosition(startPos + getOffset());
+  cmd.reset();
+  expectPositions(positions, Point(0, 0));
+}
+
+TEST_F(CmdMoveSelectedBoardItemsTest, testSmallSelectionIsMovedImmediately) {
+  QList<BI_Via*>        vias      = addSelectedVias(1);
+  QHash<BI_Via*, Point> positions = getPositions(vias);
+  Point                 offset    = getOffset();
+  Point                 startPos  = vias.first()->getPosition();
+
+  QScopedPointer<CmdMoveSelectedBoardItems> cmd(
+      new CmdMoveSelectedBoardItems(getBoard(), startPos));
+  cmd->setCurrentPosition(startPos + offset);
+  expectPositions(positions, offset);
+
+  UndoStack undoStack;
+  undoStack.execCmd(cmd.take());
+  expectPositions(positions, offset);
+  undoStack.undo();
+  expectPositions(positions, Point(0, 0));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
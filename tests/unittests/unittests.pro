@@ -22,6 +22,8 @@ LIBS += \
     -L$${DESTDIR} \
     -lgoogletest \
     -llibrepcbeagleimport \
+    -llibrepcbprojecteditor \
+    -llibrepcblibraryeditor \
     -llibrepcbworkspace \
     -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
@@ -41,6 +43,8 @@ INCLUDEPATH += \
 
 DEPENDPATH += \
     ../../libs/librepcb/eagleimport \
+    ../../libs/librepcb/projecteditor \
+    ../../libs/librepcb/libraryeditor \
     ../../libs/librepcb/workspace \
     ../../libs/librepcb/project \
     ../../libs/librepcb/library \
@@ -53,6 +57,8 @@ DEPENDPATH += \
 PRE_TARGETDEPS += \
     $${DESTDIR}/libgoogletest.a \
     $${DESTDIR}/liblibrepcbeagleimport.a \
+    $${DESTDIR}/liblibrepcbprojecteditor.a \
+    $${DESTDIR}/liblibrepcblibraryeditor.a \
     $${DESTDIR}/liblibrepcbworkspace.a \
     $${DESTDIR}/liblibrepcbproject.a \
     $${DESTDIR}/liblibrepcblibrary.a \
@@ -72,6 +78,9 @@ SOURCES += \
     common/fileio/transactionalfilesystemtest.cpp \
     common/filepathtest.cpp \
     common/geometry/pathtest.cpp \
+    common/graphics/graphicslayerbatchtest.cpp \
+    common/graphics/graphicstilecachetest.cpp \
+    common/graphics/levelofdetailtest.cpp \
     common/lengthsnaptest.cpp \
     common/lengthtest.cpp \
     common/networkrequesttest.cpp \
@@ -81,6 +90,8 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/undostacktest.cpp \
+    common/utils/boundingboxgridtest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
@@ -89,16 +100,31 @@ SOURCES += \
     eagleimport/symbolconvertertest.cpp \
     library/componentsymbolvariantitemtest.cpp \
     library/librarybaseelementtest.cpp \
+    library/libraryelementcachetest.cpp \
+    library/pkg/packagechecktest.cpp \
+    libraryeditor/common/editorwidgetbasetest.cpp \
     main.cpp \
+    project/boards/boardautoroutertest.cpp \
+    project/boards/boarddesignrulechecktest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
+    project/boards/boardtest.cpp \
+    project/boards/boardtraceroutertest.cpp \
+    project/erc/ercmsglisttest.cpp \
     project/library/projectlibrarytest.cpp \
+    project/projectlevelofdetailtest.cpp \
     project/projecttest.cpp \
+    project/schematics/schematictest.cpp \
+    projecteditor/cmd/cmdmoveselectedboarditemstest.cpp \
+    workspace/library/librarythumbnailcachetest.cpp \
+    workspace/library/workspacelibrarydbtest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
     common/attributes/attributeproviderdummy.h \
     common/fileio/serializableobjectmock.h \
     common/networkrequestbasesignalreceiver.h \
+    project/boards/boardtestfixture.h \
+    workspace/library/workspacelibraryfixture.h \
 
 FORMS += \
 
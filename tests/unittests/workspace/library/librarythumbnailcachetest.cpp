@@ -0,0 +1,276 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/librarythumbnailcache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LibraryThumbnailCacheTest : public WorkspaceLibraryFixture {
+protected:
+  FilePath                              mLibDir;
+  FilePath                              mCacheDir;
+  QScopedPointer<LibraryThumbnailCache> mCache;
+  QList<QPair<FilePath, QImage>>        mThumbnails;  ///< Emitted thumbnails
+
+  // Fake clocks, to not depend on the timestamp resolution of the file system
+  qint64                    mNow;        ///< Current time [ms]
+  qint64                    mFileClock;  ///< Time of the last touch() [ms]
+  QMutex                    mFileTimesMutex;
+  QHash<QString, QDateTime> mFileTimes;  ///< Files touched with touch()
+
+  LibraryThumbnailCacheTest()
+    : WorkspaceLibraryFixture(),
+      mLibDir(addLibrary("Test")),
+      mNow(0),
+      mFileClock(0) {
+    mCacheDir = mWsDir.getPathTo("thumbnails");
+    createCache();
+  }
+
+  void createCache() {
+    mCache.reset(new LibraryThumbnailCache(getDb(), mCacheDir));
+    mCache->setClock([this]() { return mNow; },
+                     [this](const QFileInfo& info) {
+                       QMutexLocker lock(&mFileTimesMutex);
+                       return mFileTimes.value(
+                           FilePath(info.absoluteFilePath()).toStr(),
+                           QDateTime::fromMSecsSinceEpoch(0));
+                     });
+    QObject::connect(mCache.data(), &LibraryThumbnailCache::thumbnailAvailable,
+                     [this](const FilePath& dir, const QImage& image) {
+                       mThumbnails.append(qMakePair(dir, image));
+                     });
+  }
+
+  /**
+   * @brief Set the fake modification time of a file or a directory and all
+   *        files in it to a time newer than all previous touch() calls
+   */
+  void touch(const FilePath& fp) {
+    QMutexLocker lock(&mFileTimesMutex);
+    QDateTime    time = QDateTime::fromMSecsSinceEpoch(++mFileClock * 1000);
+    mFileTimes.insert(fp.toStr(), time);
+    foreach (const QFileInfo& info,
+             QDir(fp.toStr()).entryInfoList(QDir::Files | QDir::Hidden)) {
+      mFileTimes.insert(FilePath(info.absoluteFilePath()).toStr(), time);
+    }
+  }
+
+  template <typename ElementType>
+  FilePath addAndTouchElement(ElementType& element) {
+    FilePath dir = addElement(mLibDir, element);
+    touch(dir);
+    return dir;
+  }
+
+  bool waitForPendingRequests() {
+    return waitUntil([this]() { return !mCache->hasPendingRequests(); });
+  }
+
+  template <typename ElementType>
+  WorkspaceLibraryDb::ElementInfo getInfo(const FilePath& dir) {
+    foreach (const WorkspaceLibraryDb::ElementInfo& info,
+             getDb().getLibraryElementInfos<ElementType>(mLibDir,
+                                                         QStringList())) {
+      if (info.filePath == dir) {
+        return info;
+      }
+    }
+    throw LogicError(__FILE__, __LINE__);
+  }
+
+  template <typename ElementType>
+  QImage requestThumbnail(const FilePath& dir) {
+    mThumbnails.clear();
+    QImage image = mCache->getThumbnail<ElementType>(getInfo<ElementType>(dir));
+    if (!image.isNull()) {
+      return image;
+    }
+    EXPECT_TRUE(waitUntil([this]() { return !mThumbnails.isEmpty(); }));
+    EXPECT_EQ(1, mThumbnails.count());
+    EXPECT_EQ(dir, mThumbnails.value(0).first);
+    return mThumbnails.value(0).second;
+  }
+
+  static std::shared_ptr<Footprint> createFootprint() {
+    return std::make_shared<Footprint>(Uuid::createRandom(),
+                                       ElementName("default"), "");
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LibraryThumbnailCacheTest, testSymbolThumbnail) {
+  Symbol   sym(Uuid::createRandom(), Version::fromString("1.2"), "",
+               ElementName("Symbol"), "", "");
+  FilePath symDir = addAndTouchElement(sym);
+  rescanLibraries();
+
+  // first request renders the thumbnail asynchronously
+  QImage image = requestThumbnail<Symbol>(symDir);
+  EXPECT_FALSE(image.isNull());
+  EXPECT_EQ(QSize(128, 128), image.size());
+
+  // second request returns it from memory
+  EXPECT_FALSE(mCache->getThumbnail<Symbol>(getInfo<Symbol>(symDir)).isNull());
+
+  // the thumbnail is stored in the cache directory
+  FilePath png = mCache->getThumbnailFilePath("symbols", sym.getUuid(),
+                                              sym.getVersion());
+  EXPECT_EQ(
+      mCacheDir.getPathTo("symbols/" % sym.getUuid().toStr() % "_1.2.png"),
+      png);
+  EXPECT_TRUE(waitUntil([png]() { return png.isExistingFile(); }));
+}
+
+TEST_F(LibraryThumbnailCacheTest, testThumbnailIsLoadedFromFile) {
+  Symbol   sym(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("Symbol"), "", "");
+  FilePath symDir = addAndTouchElement(sym);
+  rescanLibraries();
+
+  // a thumbnail file newer than the element is used as-is
+  FilePath png = mCache->getThumbnailFilePath("symbols", sym.getUuid(),
+                                              sym.getVersion());
+  QImage   marker(1, 1, QImage::Format_ARGB32);
+  marker.fill(Qt::red);
+  FileUtils::makePath(png.getParentDir());
+  ASSERT_TRUE(marker.save(png.toStr(), "PNG"));
+  touch(png);
+  EXPECT_EQ(QSize(1, 1), requestThumbnail<Symbol>(symDir).size());
+
+  // a thumbnail file older than the element is rendered again
+  sym.setNames(LocalizedNameMap(ElementName("Modified Symbol")));
+  addAndTouchElement(sym);
+  createCache();
+  EXPECT_EQ(QSize(128, 128), requestThumbnail<Symbol>(symDir).size());
+}
+
+TEST_F(LibraryThumbnailCacheTest, testModifiedElementIsUpdatedInMemory) {
+  Symbol   sym(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("Symbol"), "", "");
+  FilePath symDir = addAndTouchElement(sym);
+  rescanLibraries();
+  mCache->setCheckInterval(1000);
+  EXPECT_FALSE(requestThumbnail<Symbol>(symDir).isNull());
+
+  // within the check interval: the element is not checked for modifications
+  mThumbnails.clear();
+  mNow += 999;
+  EXPECT_FALSE(mCache->getThumbnail<Symbol>(getInfo<Symbol>(symDir)).isNull());
+  EXPECT_FALSE(mCache->hasPendingRequests());
+
+  // unmodified element: the thumbnail is not delivered again
+  mNow += 1;
+  EXPECT_FALSE(mCache->getThumbnail<Symbol>(getInfo<Symbol>(symDir)).isNull());
+  EXPECT_TRUE(mCache->hasPendingRequests());
+  EXPECT_TRUE(waitForPendingRequests());
+  EXPECT_TRUE(mThumbnails.isEmpty());
+
+  // modified element: the old thumbnail is returned, the new one delivered
+  mNow += 1000;
+  sym.setNames(LocalizedNameMap(ElementName("Modified Symbol")));
+  addAndTouchElement(sym);
+  EXPECT_FALSE(mCache->getThumbnail<Symbol>(getInfo<Symbol>(symDir)).isNull());
+  EXPECT_TRUE(waitUntil([this]() { return !mThumbnails.isEmpty(); }));
+  EXPECT_EQ(symDir, mThumbnails.value(0).first);
+  EXPECT_FALSE(mThumbnails.value(0).second.isNull());
+}
+
+TEST_F(LibraryThumbnailCacheTest, testFailedThumbnailIsRetriedAfterChange) {
+  // a package without footprint can't be rendered
+  Package  pkg(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("Package"), "", "");
+  FilePath pkgDir = addAndTouchElement(pkg);
+  rescanLibraries();
+  mCache->setCheckInterval(0);
+  EXPECT_TRUE(requestThumbnail<Package>(pkgDir).isNull());
+
+  // not retried as long as the package is not modified
+  mThumbnails.clear();
+  EXPECT_TRUE(mCache->getThumbnail<Package>(getInfo<Package>(pkgDir)).isNull());
+  EXPECT_TRUE(waitForPendingRequests());
+  EXPECT_TRUE(mThumbnails.isEmpty());
+
+  // retried after adding a footprint
+  pkg.getFootprints().append(createFootprint());
+  addAndTouchElement(pkg);
+  EXPECT_FALSE(requestThumbnail<Package>(pkgDir).isNull());
+}
+
+TEST_F(LibraryThumbnailCacheTest, testDeviceThumbnailIsPackageThumbnail) {
+  Package pkg(Uuid::createRandom(), Version::fromString("2"), "",
+              ElementName("Package"), "", "");
+  pkg.getFootprints().append(createFootprint());
+  addAndTouchElement(pkg);
+  Device   dev(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("Device"), "", "", Uuid::createRandom(),
+               pkg.getUuid());
+  FilePath devDir = addAndTouchElement(dev);
+  rescanLibraries();
+
+  EXPECT_FALSE(requestThumbnail<Device>(devDir).isNull());
+  FilePath png = mCache->getThumbnailFilePath("packages", pkg.getUuid(),
+                                              pkg.getVersion());
+  EXPECT_TRUE(waitUntil([png]() { return png.isExistingFile(); }));
+}
+
+TEST_F(LibraryThumbnailCacheTest, testDeviceWithoutPackage) {
+  Device   dev(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("Device"), "", "", Uuid::createRandom(),
+               Uuid::createRandom());
+  FilePath devDir = addAndTouchElement(dev);
+  rescanLibraries();
+
+  EXPECT_TRUE(requestThumbnail<Device>(devDir).isNull());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
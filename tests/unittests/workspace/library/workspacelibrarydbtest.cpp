@@ -0,0 +1,229 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/library/sym/symbol.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryDbTest : public WorkspaceLibraryFixture {
+protected:
+  FilePath mLibDir1;
+  FilePath mLibDir2;
+
+  WorkspaceLibraryDbTest()
+    : WorkspaceLibraryFixture(),
+      mLibDir1(addLibrary("Test 1")),
+      mLibDir2(addLibrary("Test 2")) {}
+
+  /// Add a symbol to a library (each library can contain only one version)
+  FilePath addSymbol(const FilePath& libDir, const Uuid& uuid,
+                     const QString& version, const QString& name,
+                     const QSet<Uuid>& categories = {}) {
+    Symbol sym(uuid, Version::fromString(version), "", ElementName(name), "",
+               "");
+    sym.setCategories(categories);
+    return addElement(libDir, sym);
+  }
+
+  /// Remove all translations of a symbol from the database
+  void removeSymbolTranslations(const Uuid& uuid) {
+    SQLiteDatabase db(getDb().getFilePath());
+    QSqlQuery      query = db.prepareQuery(
+        "DELETE FROM symbols_tr WHERE symbol_id IN "
+        "(SELECT id FROM symbols WHERE uuid = :uuid)");
+    query.bindValue(":uuid", uuid.toStr());
+    db.exec(query);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testSearchReturnsLatestVersionOnly) {
+  Uuid uuid = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Resistor");
+  FilePath dir2 = addSymbol(mLibDir2, uuid, "2", "Resistor");
+  rescanLibraries();
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getElementInfosBySearchKeyword<Symbol>("Resistor", {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(uuid, infos.first().uuid);
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+  EXPECT_EQ(dir2, infos.first().filePath);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchReturnsLatestVersionOfOldMatch) {
+  // only the old version matches the keyword since the symbol was renamed
+  Uuid uuid = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Resistor");
+  FilePath dir2 = addSymbol(mLibDir2, uuid, "2", "Capacitor");
+  addSymbol(mLibDir1, Uuid::createRandom(), "1", "Inductor");
+  rescanLibraries();
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getElementInfosBySearchKeyword<Symbol>("Resistor", {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(uuid, infos.first().uuid);
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+  EXPECT_EQ(dir2, infos.first().filePath);
+  EXPECT_EQ("Capacitor", infos.first().name);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testCategoryReturnsLatestVersionOnly) {
+  Uuid category = Uuid::createRandom();
+  Uuid uuid     = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Symbol", {category});
+  FilePath dir2 = addSymbol(mLibDir2, uuid, "2", "Symbol", {category});
+  rescanLibraries();
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getElementInfosByCategory<Symbol>(category, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+  EXPECT_EQ(dir2, infos.first().filePath);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testCategoryReturnsLatestVersionOfOldMatch) {
+  // only the old version is in the category since the category was removed
+  Uuid category = Uuid::createRandom();
+  Uuid uuid     = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Symbol", {category});
+  FilePath dir2 = addSymbol(mLibDir2, uuid, "2", "Symbol");
+  rescanLibraries();
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getElementInfosByCategory<Symbol>(category, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+  EXPECT_EQ(dir2, infos.first().filePath);
+
+  infos = getDb().getElementInfosByCategory<Symbol>(tl::nullopt, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testLibraryReturnsAllVersions) {
+  Uuid uuid = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Symbol");
+  addSymbol(mLibDir2, uuid, "2", "Symbol");
+  rescanLibraries();
+
+  EXPECT_EQ(1, getDb().getLibraryElementInfos<Symbol>(mLibDir1, {}).count());
+  EXPECT_EQ(1, getDb().getLibraryElementInfos<Symbol>(mLibDir2, {}).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testLibraryReturnsInfosOfItsOwnVersion) {
+  Uuid     uuid = Uuid::createRandom();
+  FilePath dir1 = addSymbol(mLibDir1, uuid, "1", "Old");
+  FilePath dir2 = addSymbol(mLibDir2, uuid, "2", "New");
+  rescanLibraries();
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getLibraryElementInfos<Symbol>(mLibDir1, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(Version::fromString("1"), infos.first().version);
+  EXPECT_EQ(dir1, infos.first().filePath);
+  EXPECT_EQ("Old", infos.first().name);
+
+  // the category returns the latest version of all libraries
+  infos = getDb().getElementInfosByCategory<Symbol>(tl::nullopt, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(Version::fromString("2"), infos.first().version);
+  EXPECT_EQ(dir2, infos.first().filePath);
+  EXPECT_EQ("New", infos.first().name);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testInfosAreTranslatedInLocaleOrder) {
+  Symbol sym(Uuid::createRandom(), Version::fromString("1"), "",
+             ElementName("Default"), "Default description", "default");
+  LocalizedNameMap names = sym.getNames();
+  names.insert("de_DE", ElementName("Deutsch"));
+  sym.setNames(names);
+  LocalizedKeywordsMap keywords = sym.getKeywords();
+  keywords.insert("fr_FR", "francais");
+  sym.setKeywords(keywords);
+  addElement(mLibDir1, sym);
+  rescanLibraries();
+
+  // each column falls back to the next locale which provides a value
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getLibraryElementInfos<Symbol>(mLibDir1, {"fr_FR", "de_DE"});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ("Deutsch", infos.first().name);
+  EXPECT_EQ("Default description", infos.first().description);
+  EXPECT_EQ("francais", infos.first().keywords);
+
+  // without matching locale, the default values are used
+  infos = getDb().getElementInfosByCategory<Symbol>(tl::nullopt, {"it_IT"});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ("Default", infos.first().name);
+  EXPECT_EQ("Default description", infos.first().description);
+  EXPECT_EQ("default", infos.first().keywords);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testInfosWithoutTranslationsAreUnknown) {
+  Uuid uuid = Uuid::createRandom();
+  addSymbol(mLibDir1, uuid, "1", "Symbol");
+  rescanLibraries();
+  removeSymbolTranslations(uuid);
+
+  QList<WorkspaceLibraryDb::ElementInfo> infos =
+      getDb().getLibraryElementInfos<Symbol>(mLibDir1, {"de_DE"});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ(uuid, infos.first().uuid);
+  EXPECT_EQ("unknown", infos.first().name);
+  EXPECT_EQ("unknown", infos.first().description);
+  EXPECT_EQ("unknown", infos.first().keywords);
+
+  infos = getDb().getElementInfosByCategory<Symbol>(tl::nullopt, {});
+  ASSERT_EQ(1, infos.count());
+  EXPECT_EQ("unknown", infos.first().name);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
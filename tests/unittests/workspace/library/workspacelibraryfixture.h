@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WORKSPACE_TESTS_WORKSPACELIBRARYFIXTURE_H
+#define LIBREPCB_WORKSPACE_TESTS_WORKSPACELIBRARYFIXTURE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/library/library.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryFixture
+ ******************************************************************************/
+
+/**
+ * @brief Test fixture providing a temporary workspace with local libraries
+ */
+class WorkspaceLibraryFixture : public ::testing::Test {
+protected:
+  FilePath                  mWsDir;
+  QScopedPointer<Workspace> mWs;
+
+  WorkspaceLibraryFixture() : mWsDir(FilePath::getRandomTempPath()) {
+    Workspace::createNewWorkspace(mWsDir);  // can throw
+    mWs.reset(new Workspace(mWsDir));       // can throw
+  }
+
+  virtual ~WorkspaceLibraryFixture() {
+    mWs.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  WorkspaceLibraryDb& getDb() const { return mWs->getLibraryDb(); }
+
+  FilePath addLibrary(const QString& name) {
+    FilePath dir = mWs->getLocalLibrariesPath().getPathTo(name % ".lplib");
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(dir);  // can throw
+    TransactionalDirectory root(fs);
+    library::Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                         ElementName(name), "", "");  // can throw
+    lib.moveTo(root);                                 // can throw
+    fs->save();                                       // can throw
+    return dir;
+  }
+
+  template <typename ElementType>
+  FilePath addElement(const FilePath& libDir, ElementType& element) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(libDir);  // can throw
+    TransactionalDirectory dir(fs, element.getShortElementName());
+    element.saveIntoParentDirectory(dir);  // can throw
+    fs->save();                            // can throw
+    return libDir.getPathTo(element.getShortElementName() % "/" %
+                            element.getUuid().toStr());
+  }
+
+  void rescanLibraries() {
+    QEventLoop loop;
+    QObject::connect(&getDb(), &WorkspaceLibraryDb::scanFinished, &loop,
+                     &QEventLoop::quit);
+    getDb().startLibraryRescan();
+    loop.exec();
+  }
+
+  /**
+   * @brief Process events until a condition is met
+   *
+   * @param condition   The condition to wait for
+   * @param timeoutMs   Maximum time to wait
+   *
+   * @return Whether the condition is met
+   */
+  static bool waitUntil(const std::function<bool()>& condition,
+                        int                          timeoutMs = 10000) {
+    QElapsedTimer timer;
+    timer.start();
+    while ((!condition()) && (timer.elapsed() < timeoutMs)) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return condition();
+  }
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WORKSPACE_TESTS_WORKSPACELIBRARYFIXTURE_H
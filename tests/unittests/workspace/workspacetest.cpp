@@ -24,6 +24,7 @@
 #include <librepcb/common/application.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/versionfile.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/workspace/workspace.h>
 
 #include <QtCore>
@@ -108,6 +109,30 @@ TEST_F(WorkspaceTest, testIfOpeningWorkspaceMultipleTimesFails) {
   EXPECT_THROW(Workspace ws2(mWsDir), Exception);
 }
 
+TEST_F(WorkspaceTest, testLibraryDbQueryAsync) {
+  Workspace::createNewWorkspace(mWsDir);
+  Workspace    ws(mWsDir);
+  QThread*     queryThread = nullptr;
+  QFuture<int> future      = ws.getLibraryDb().queryAsync<int>(
+      [&queryThread](const WorkspaceLibraryDb& db) {
+        queryThread = QThread::currentThread();
+        return db.getLibraries().count();  // can throw
+      });
+  EXPECT_EQ(0, future.result());
+  EXPECT_NE(QThread::currentThread(), queryThread);
+}
+
+TEST_F(WorkspaceTest, testLibraryDbQueryAsyncException) {
+  Workspace::createNewWorkspace(mWsDir);
+  Workspace    ws(mWsDir);
+  QFuture<int> future = ws.getLibraryDb().queryAsync<int>(
+      [](const WorkspaceLibraryDb& db) -> int {
+        Q_UNUSED(db);
+        throw RuntimeError(__FILE__, __LINE__, "Query failed");
+      });
+  EXPECT_EQ(0, future.result());  // default constructed result
+}
+
 TEST_F(WorkspaceTest, testIsValidWorkspacePath) {
   EXPECT_FALSE(Workspace::isValidWorkspacePath(mWsDir));
   Workspace::createNewWorkspace(mWsDir);